@@ -263,7 +263,7 @@ ICULanguageBreakFactory::loadDictionaryMatcherFor(UScriptCode script) {
         }
         else if (trieType == DictionaryData::TRIE_TYPE_UCHARS) {
             const UChar *characters = (const UChar *)(data + offset);
-            m = new UCharsDictionaryMatcher(characters, file);
+            m = new IndexedUCharsDictionaryMatcher(characters, file);
         }
         if (m == NULL) {
             // no matcher exists to take ownership - either we are an invalid 
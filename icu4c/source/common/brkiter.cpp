@@ -31,6 +31,7 @@
 #include "unicode/ustring.h"
 #include "unicode/filteredbrk.h"
 #include "ucln_cmn.h"
+#include "cmemory.h"
 #include "cstring.h"
 #include "umutex.h"
 #include "servloc.h"
@@ -39,6 +40,7 @@
 #include "uassert.h"
 #include "ubrkimpl.h"
 #include "charstr.h"
+#include "ustr_imp.h"
 
 // *****************************************************************************
 // class BreakIterator
@@ -201,17 +203,20 @@ BreakIterator::getAvailableLocales(int32_t& count)
 BreakIterator::BreakIterator()
 {
     *validLocale = *actualLocale = 0;
+    poolKeyIndex = 0;
 }
 
 BreakIterator::BreakIterator(const BreakIterator &other) : UObject(other) {
     uprv_strncpy(actualLocale, other.actualLocale, sizeof(actualLocale));
     uprv_strncpy(validLocale, other.validLocale, sizeof(validLocale));
+    poolKeyIndex = other.poolKeyIndex;
 }
 
 BreakIterator &BreakIterator::operator =(const BreakIterator &other) {
     if (this != &other) {
         uprv_strncpy(actualLocale, other.actualLocale, sizeof(actualLocale));
         uprv_strncpy(validLocale, other.validLocale, sizeof(validLocale));
+        poolKeyIndex = other.poolKeyIndex;
     }
     return *this;
 }
@@ -220,6 +225,211 @@ BreakIterator::~BreakIterator()
 {
 }
 
+// ------------------------------------------
+//
+// Pool of released break iterators for acquireInstance() and releaseInstance().
+// As for the converter pool in ucnv_bld.cpp, there is no per-thread storage:
+// the pool is one global set of slots, each claimed with an atomic try-lock,
+// so that acquiring and releasing never block.
+// The key is the type digit, a colon, and the requested locale ID.
+// Keys are stored once in an append-only key table, and each iterator from
+// acquireInstance() only records the index of its key.
+// The key hash is readable without claiming a pool slot, so that a lookup
+// only claims slots which may hold a matching iterator.
+//
+//-------------------------------------------
+
+U_NAMESPACE_END
+
+#define BRKITER_POOL_SIZE 32
+#define BRKITER_POOL_KEY_COUNT 64
+#define BRKITER_POOL_KEY_CAPACITY (ULOC_FULLNAME_CAPACITY + 2)
+
+struct BreakIteratorPoolSlot {
+    icu::u_atomic_int32_t lock;
+    icu::u_atomic_int32_t hash;      // 0 if empty
+    icu::BreakIterator *bi;
+};
+
+// Entries are written once and then published with their hash.
+struct BreakIteratorPoolKey {
+    icu::u_atomic_int32_t lock;
+    icu::u_atomic_int32_t hash;      // 0 if unused
+    char key[BRKITER_POOL_KEY_CAPACITY];
+};
+
+static BreakIteratorPoolSlot gBreakIteratorPool[BRKITER_POOL_SIZE];
+static BreakIteratorPoolKey gBreakIteratorPoolKeys[BRKITER_POOL_KEY_COUNT];
+static icu::UInitOnce gBreakIteratorPoolInitOnce = U_INITONCE_INITIALIZER;
+
+static inline UBool
+tryLockPoolSlot(icu::u_atomic_int32_t *lock) {
+    if (icu::umtx_atomic_inc(lock) == 1) {
+        return TRUE;
+    }
+    icu::umtx_atomic_dec(lock);
+    return FALSE;
+}
+
+static inline void
+unlockPoolSlot(icu::u_atomic_int32_t *lock) {
+    icu::umtx_atomic_dec(lock);
+}
+
+// Never 0, which marks an empty slot.
+static inline int32_t
+getPoolHash(const char *key) {
+    return ustr_hashCharsN(key, (int32_t)uprv_strlen(key)) | 1;
+}
+
+// Returns the 1-based index of the key in gBreakIteratorPoolKeys,
+// adding it if necessary, or 0 if the key table is full.
+static int32_t
+getPoolKeyIndex(const char *key, int32_t hash) {
+    int32_t start = hash & (BRKITER_POOL_KEY_COUNT - 1);
+    for (int32_t i = 0; i < BRKITER_POOL_KEY_COUNT; ++i) {
+        int32_t index = (start + i) & (BRKITER_POOL_KEY_COUNT - 1);
+        BreakIteratorPoolKey *entry = gBreakIteratorPoolKeys + index;
+        int32_t entryHash = icu::umtx_loadAcquire(entry->hash);
+        if (entryHash == 0 && tryLockPoolSlot(&entry->lock)) {
+            entryHash = icu::umtx_loadAcquire(entry->hash);
+            if (entryHash == 0) {
+                uprv_strcpy(entry->key, key);
+                icu::umtx_storeRelease(entry->hash, hash);
+                entryHash = hash;
+            }
+            unlockPoolSlot(&entry->lock);
+        }
+        if (entryHash == hash && uprv_strcmp(entry->key, key) == 0) {
+            return index + 1;
+        }
+        // Another thread may be adding a key to this entry; at worst,
+        // the same key is added twice, and matching compares the key strings.
+    }
+    return 0;
+}
+
+// Deletes all pooled break iterators.
+static void
+flushBreakIteratorPool() {
+    for (int32_t i = 0; i < BRKITER_POOL_SIZE; ++i) {
+        BreakIteratorPoolSlot *slot = gBreakIteratorPool + i;
+        icu::BreakIterator *bi = NULL;
+        if (icu::umtx_loadAcquire(slot->hash) != 0) {
+            while (!tryLockPoolSlot(&slot->lock)) {}
+            if (icu::umtx_loadAcquire(slot->hash) != 0) {
+                bi = slot->bi;
+                slot->bi = NULL;
+                icu::umtx_storeRelease(slot->hash, 0);
+            }
+            unlockPoolSlot(&slot->lock);
+        }
+        delete bi;
+    }
+}
+
+U_CDECL_BEGIN
+static UBool U_CALLCONV breakiterator_pool_cleanup(void) {
+    flushBreakIteratorPool();
+    for (int32_t i = 0; i < BRKITER_POOL_KEY_COUNT; ++i) {
+        icu::umtx_storeRelease(gBreakIteratorPoolKeys[i].hash, 0);
+    }
+    gBreakIteratorPoolInitOnce.reset();
+    return TRUE;
+}
+U_CDECL_END
+U_NAMESPACE_BEGIN
+
+static void U_CALLCONV
+initBreakIteratorPool() {
+    ucln_common_registerCleanup(UCLN_COMMON_BREAKITERATOR_POOL, breakiterator_pool_cleanup);
+}
+
+BreakIterator* U_EXPORT2
+BreakIterator::acquireInstance(UBreakIteratorType type, const Locale& where, UErrorCode& status)
+{
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    char key[BRKITER_POOL_KEY_CAPACITY];
+    const char *name = where.getName();
+    int32_t nameLength = (int32_t)uprv_strlen(name);
+    int32_t keyIndex = 0;
+    if (0 <= type && type <= 9 && !where.isBogus() && (nameLength + 2) < (int32_t)sizeof(key)) {
+        key[0] = (char)('0' + type);
+        key[1] = ':';
+        uprv_memcpy(key + 2, name, nameLength + 1);
+        int32_t hash = getPoolHash(key);
+        int32_t start = hash & (BRKITER_POOL_SIZE - 1);
+        for (int32_t i = 0; i < BRKITER_POOL_SIZE; ++i) {
+            BreakIteratorPoolSlot *slot = gBreakIteratorPool + ((start + i) & (BRKITER_POOL_SIZE - 1));
+            if (umtx_loadAcquire(slot->hash) == hash && tryLockPoolSlot(&slot->lock)) {
+                BreakIterator *bi = NULL;
+                if (umtx_loadAcquire(slot->hash) == hash &&
+                        uprv_strcmp(gBreakIteratorPoolKeys[slot->bi->poolKeyIndex - 1].key, key) == 0) {
+                    bi = slot->bi;
+                    slot->bi = NULL;
+                    umtx_storeRelease(slot->hash, 0);
+                }
+                unlockPoolSlot(&slot->lock);
+                if (bi != NULL) {
+                    return bi;
+                }
+            }
+        }
+        umtx_initOnce(gBreakIteratorPoolInitOnce, &initBreakIteratorPool);
+        keyIndex = getPoolKeyIndex(key, hash);
+    }
+    BreakIterator *result = createInstance(where, type, status);
+    if (U_FAILURE(status)) {
+        delete result;
+        return NULL;
+    }
+    if (result == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    result->poolKeyIndex = keyIndex;
+    return result;
+}
+
+void U_EXPORT2
+BreakIterator::releaseInstance(BreakIterator* bi)
+{
+    if (bi == NULL) {
+        return;
+    }
+    if (bi->poolKeyIndex != 0) {
+        // Drop the reference to the caller's text, and move to the start.
+        UErrorCode status = U_ZERO_ERROR;
+        UText emptyText = UTEXT_INITIALIZER;
+        utext_openUChars(&emptyText, NULL, 0, &status);
+        bi->setText(&emptyText, status);
+        utext_close(&emptyText);
+        if (U_SUCCESS(status)) {
+            int32_t hash = umtx_loadAcquire(gBreakIteratorPoolKeys[bi->poolKeyIndex - 1].hash);
+            int32_t start = hash & (BRKITER_POOL_SIZE - 1);
+            // hash==0 only if the key table was cleaned up while bi was in use.
+            for (int32_t i = 0; hash != 0 && i < BRKITER_POOL_SIZE; ++i) {
+                BreakIteratorPoolSlot *slot = gBreakIteratorPool + ((start + i) & (BRKITER_POOL_SIZE - 1));
+                if (umtx_loadAcquire(slot->hash) == 0 && tryLockPoolSlot(&slot->lock)) {
+                    if (umtx_loadAcquire(slot->hash) == 0) {
+                        slot->bi = bi;
+                        umtx_storeRelease(slot->hash, hash);
+                        bi = NULL;
+                    }
+                    unlockPoolSlot(&slot->lock);
+                    if (bi == NULL) {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+    // not poolable, or the pool is full
+    delete bi;
+}
+
 // ------------------------------------------
 //
 // Registration
@@ -331,6 +541,8 @@ BreakIterator::registerInstance(BreakIterator* toAdopt, const Locale& locale, UB
         status = U_MEMORY_ALLOCATION_ERROR;
         return NULL;
     }
+    // Pooled instances may no longer be what createInstance() would return.
+    flushBreakIteratorPool();
     return service->registerInstance(toAdopt, locale, kind, status);
 }
 
@@ -341,6 +553,7 @@ BreakIterator::unregister(URegistryKey key, UErrorCode& status)
 {
     if (U_SUCCESS(status)) {
         if (hasService()) {
+            flushBreakIteratorPool();
             return gService->unregister(key, status);
         }
         status = U_MEMORY_ALLOCATION_ERROR;
@@ -496,7 +709,36 @@ int32_t BreakIterator::getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UE
     return 1;
 }
 
+// This implementation of getAllBoundaries iterates with the regular API,
+// for any derived BreakIterator classes that do not have a faster way.
+int32_t BreakIterator::getAllBoundaries(int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                                        UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (dest == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t count = 0;
+    for (int32_t b = first(); b != DONE; b = next()) {
+        if (count < capacity) {
+            dest[count] = b;
+            if (ruleStatus != NULL) {
+                ruleStatus[count] = getRuleStatus();
+            }
+        }
+        ++count;
+    }
+    first();
+    if (count > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return count;
+}
+
 BreakIterator::BreakIterator (const Locale& valid, const Locale& actual) {
+  poolKeyIndex = 0;
   U_LOCALE_BASED(locBased, (*this));
   locBased.setLocaleIDs(valid, actual);
 }
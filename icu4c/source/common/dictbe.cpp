@@ -1041,8 +1041,28 @@ foundBest:
  * CjkBreakEngine
  */
 static const uint32_t kuint32max = 0xFFFFFFFF;
+
+// Longest range, in native units, for which the engine's kept scratch space is used.
+static const int32_t kMaxScratchRangeLength = 0x4000;
+
+// Scratch space for CjkBreakEngine::divideUpDictionaryRange(), kept between calls
+// so that segmenting a range usually does not allocate memory.
+struct CjkScratch : public UMemory {
+    CjkScratch(UErrorCode &status)
+            : inputMap(status), normalizedMap(status), bestSnlp(status), prev(status),
+              boundaries(status) {}
+
+    UnicodeString text;             // copy of input text that is not in one UTF-16 chunk
+    UnicodeString normalizedText;   // NFKC normalized input text
+    UVector32 inputMap;
+    UVector32 normalizedMap;
+    UVector32 bestSnlp;
+    UVector32 prev;
+    UVector32 boundaries;
+};
+
 CjkBreakEngine::CjkBreakEngine(DictionaryMatcher *adoptDictionary, LanguageType type, UErrorCode &status)
-: DictionaryBreakEngine(), fDictionary(adoptDictionary) {
+: DictionaryBreakEngine(), fDictionary(adoptDictionary), fScratch(NULL), fScratchLock(0) {
     // Korean dictionary only includes Hangul syllables
     fHangulWordSet.applyPattern(UNICODE_STRING_SIMPLE("[\\uac00-\\ud7a3]"), status);
     fHanWordSet.applyPattern(UNICODE_STRING_SIMPLE("[:Han:]"), status);
@@ -1064,10 +1084,20 @@ CjkBreakEngine::CjkBreakEngine(DictionaryMatcher *adoptDictionary, LanguageType
             setCharacters(cjSet);
         }
     }
+    if (U_SUCCESS(status)) {
+        // If this fails, then divideUpDictionaryRange() uses temporary scratch space.
+        UErrorCode scratchStatus = U_ZERO_ERROR;
+        fScratch = new CjkScratch(scratchStatus);
+        if (fScratch != NULL && U_FAILURE(scratchStatus)) {
+            delete fScratch;
+            fScratch = NULL;
+        }
+    }
 }
 
 CjkBreakEngine::~CjkBreakEngine(){
     delete fDictionary;
+    delete fScratch;
 }
 
 // The katakanaCost values below are based on the length frequencies of all
@@ -1113,12 +1143,38 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         return 0;
     }
 
+    // Use the scratch space kept by this engine, unless another thread is using it.
+    // Long ranges use temporary scratch space, so that the kept one stays small;
+    // for them, the allocations cost little compared with the segmentation itself.
+    if (fScratch != NULL && rangeEnd - rangeStart <= kMaxScratchRangeLength) {
+        if (umtx_atomic_inc(&fScratchLock) == 1) {
+            int32_t numBreaks = divideUpDictionaryRange(inText, rangeStart, rangeEnd, foundBreaks, *fScratch);
+            umtx_atomic_dec(&fScratchLock);
+            return numBreaks;
+        }
+        umtx_atomic_dec(&fScratchLock);
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    CjkScratch scratch(status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    return divideUpDictionaryRange(inText, rangeStart, rangeEnd, foundBreaks, scratch);
+}
+
+int32_t 
+CjkBreakEngine::divideUpDictionaryRange( UText *inText,
+        int32_t rangeStart,
+        int32_t rangeEnd,
+        UVector32 &foundBreaks,
+        CjkScratch &scratch ) const {
     // UnicodeString version of input UText, NFKC normalized if necessary.
+    // Read-only alias of either the input text or of a scratch string.
     UnicodeString inString;
 
     // inputMap[inStringIndex] = corresponding native index from UText inText.
     // If NULL then mapping is 1:1
-    LocalPointer<UVector32>     inputMap;
+    UVector32     *inputMap    = NULL;
 
     UErrorCode     status      = U_ZERO_ERROR;
 
@@ -1135,7 +1191,7 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                        inText->chunkContents + rangeStart - inText->chunkNativeStart,
                        rangeEnd - rangeStart);
     } else {
-        // Copy the text from the original inText (UText) to inString (UnicodeString).
+        // Copy the text from the original inText (UText) to a scratch UnicodeString.
         // Create a map from UnicodeString indices -> UText offsets.
         utext_setNativeIndex(inText, rangeStart);
         int32_t limit = rangeEnd;
@@ -1143,34 +1199,46 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         if (limit > utext_nativeLength(inText)) {
             limit = (int32_t)utext_nativeLength(inText);
         }
-        inputMap.adoptInsteadAndCheckErrorCode(new UVector32(status), status);
-        if (U_FAILURE(status)) {
-            return 0;
-        }
+        UnicodeString &text = scratch.text;
+        text.remove();
+        inputMap = &scratch.inputMap;
+        inputMap->removeAllElements();
         while (utext_getNativeIndex(inText) < limit) {
             int32_t nativePosition = (int32_t)utext_getNativeIndex(inText);
             UChar32 c = utext_next32(inText);
             U_ASSERT(c != U_SENTINEL);
-            inString.append(c);
-            while (inputMap->size() < inString.length()) {
+            text.append(c);
+            while (inputMap->size() < text.length()) {
                 inputMap->addElement(nativePosition, status);
             }
         }
         inputMap->addElement(limit, status);
+        if (U_FAILURE(status) || text.isBogus()) {
+            return 0;
+        }
+        inString.setTo(FALSE, text.getBuffer(), text.length());
     }
 
 
-    if (!nfkcNorm2->isNormalized(inString, status)) {
-        UnicodeString normalizedInput;
+    // Normalize the text to NFKC. The part that passes the NFKC quick check,
+    // usually all of it, is already normalized, and is not copied or mapped again.
+    int32_t normalizedPrefixLength = nfkcNorm2->spanQuickCheckYes(inString, status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (normalizedPrefixLength < inString.length()) {
+        UnicodeString &normalizedInput = scratch.normalizedText;
         //  normalizedMap[normalizedInput position] ==  original UText position.
-        LocalPointer<UVector32> normalizedMap(new UVector32(status), status);
-        if (U_FAILURE(status)) {
-            return 0;
+        UVector32 *normalizedMap = &scratch.normalizedMap;
+        normalizedInput.setTo(inString, 0, normalizedPrefixLength);
+        normalizedMap->removeAllElements();
+        for (int32_t i = 0; i < normalizedPrefixLength; ++i) {
+            normalizedMap->addElement(inputMap != NULL ? inputMap->elementAti(i) : i+rangeStart, status);
         }
         
         UnicodeString fragment;
         UnicodeString normalizedFragment;
-        for (int32_t srcI = 0; srcI < inString.length();) {  // Once per normalization chunk
+        for (int32_t srcI = normalizedPrefixLength; srcI < inString.length();) {  // Once per normalization chunk
             fragment.remove();
             int32_t fragmentStartI = srcI;
             UChar32 c = inString.char32At(srcI);
@@ -1190,7 +1258,7 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
 
             // Map every position in the normalized chunk to the start of the chunk
             //   in the original input.
-            int32_t fragmentOriginalStart = inputMap.isValid() ?
+            int32_t fragmentOriginalStart = inputMap != NULL ?
                     inputMap->elementAti(fragmentStartI) : fragmentStartI+rangeStart;
             while (normalizedMap->size() < normalizedInput.length()) {
                 normalizedMap->addElement(fragmentOriginalStart, status);
@@ -1198,14 +1266,20 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                     break;
                 }
             }
+            if (U_FAILURE(status)) {
+                return 0;
+            }
         }
         U_ASSERT(normalizedMap->size() == normalizedInput.length());
-        int32_t nativeEnd = inputMap.isValid() ?
+        int32_t nativeEnd = inputMap != NULL ?
                 inputMap->elementAti(inString.length()) : inString.length()+rangeStart;
         normalizedMap->addElement(nativeEnd, status);
+        if (U_FAILURE(status) || normalizedInput.isBogus()) {
+            return 0;
+        }
 
-        inputMap.moveFrom(normalizedMap);
-        inString.moveFrom(normalizedInput);
+        inputMap = normalizedMap;
+        inString.setTo(FALSE, normalizedInput.getBuffer(), normalizedInput.length());
     }
 
     int32_t numCodePts = inString.countChar32();
@@ -1215,12 +1289,10 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         //   not in terms of code unit string indexes.
         // Use the inputMap mechanism to take care of this in addition to indexing differences
         //    from normalization and/or UTF-8 input.
-        UBool hadExistingMap = inputMap.isValid();
+        UBool hadExistingMap = inputMap != NULL;
         if (!hadExistingMap) {
-            inputMap.adoptInsteadAndCheckErrorCode(new UVector32(status), status);
-            if (U_FAILURE(status)) {
-                return 0;
-            }
+            inputMap = &scratch.inputMap;
+            inputMap->removeAllElements();
         }
         int32_t cpIdx = 0;
         for (int32_t cuIdx = 0; ; cuIdx = inString.moveIndex32(cuIdx, 1)) {
@@ -1235,32 +1307,38 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                break;
             }
         }
+        if (U_FAILURE(status)) {
+            return 0;
+        }
     }
                 
     // bestSnlp[i] is the snlp of the best segmentation of the first i
     // code points in the range to be matched.
-    UVector32 bestSnlp(numCodePts + 1, status);
-    bestSnlp.addElement(0, status);
-    for(int32_t i = 1; i <= numCodePts; i++) {
-        bestSnlp.addElement(kuint32max, status);
-    }
-
-
     // prev[i] is the index of the last CJK code point in the previous word in 
     // the best segmentation of the first i characters.
-    UVector32 prev(numCodePts + 1, status);
+    scratch.bestSnlp.setSize(numCodePts + 1);
+    scratch.prev.setSize(numCodePts + 1);
+    if (scratch.bestSnlp.size() != numCodePts + 1 || scratch.prev.size() != numCodePts + 1) {
+        return 0;
+    }
+    uint32_t *bestSnlp = (uint32_t *)scratch.bestSnlp.getBuffer();
+    int32_t *prev = scratch.prev.getBuffer();
+    bestSnlp[0] = 0;
+    for(int32_t i = 1; i <= numCodePts; i++) {
+        bestSnlp[i] = kuint32max;
+    }
     for(int32_t i = 0; i <= numCodePts; i++){
-        prev.addElement(-1, status);
+        prev[i] = -1;
     }
 
+    // A match is at most maxWordSize code units long, so there are at most
+    // maxWordSize matches, plus the single-character word added below.
     const int32_t maxWordSize = 20;
-    UVector32 values(numCodePts, status);
-    values.setSize(numCodePts);
-    UVector32 lengths(numCodePts, status);
-    lengths.setSize(numCodePts);
+    int32_t values[maxWordSize + 1];
+    int32_t lengths[maxWordSize + 1];
 
-    UText fu = UTEXT_INITIALIZER;
-    utext_openUnicodeString(&fu, &inString, &status);
+    const UChar *inBuffer = inString.getBuffer();
+    int32_t inLength = inString.length();
 
     // Dynamic programming to find the best segmentation.
 
@@ -1270,14 +1348,12 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     int32_t ix = 0;
     bool is_prev_katakana = false;
     for (int32_t i = 0;  i < numCodePts;  ++i, ix = inString.moveIndex32(ix, 1)) {
-        if ((uint32_t)bestSnlp.elementAti(i) == kuint32max) {
+        if (bestSnlp[i] == kuint32max) {
             continue;
         }
 
-        int32_t count;
-        utext_setNativeIndex(&fu, ix);
-        count = fDictionary->matches(&fu, maxWordSize, numCodePts,
-                             NULL, lengths.getBuffer(), values.getBuffer(), NULL);
+        int32_t count = fDictionary->matchesUChars(inBuffer + ix, inLength - ix, maxWordSize, maxWordSize,
+                             NULL, lengths, values, NULL);
                              // Note: lengths is filled with code point lengths
                              //       The NULL parameter is the ignored code unit lengths.
 
@@ -1286,18 +1362,18 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // with the highest value possible, i.e. the least likely to occur.
         // Exclude Korean characters from this treatment, as they should be left
         // together by default.
-        if ((count == 0 || lengths.elementAti(0) != 1) &&
+        if ((count == 0 || lengths[0] != 1) &&
                 !fHangulWordSet.contains(inString.char32At(ix))) {
-            values.setElementAt(maxSnlp, count);   // 255
-            lengths.setElementAt(1, count++);
+            values[count] = maxSnlp;   // 255
+            lengths[count++] = 1;
         }
 
         for (int32_t j = 0; j < count; j++) {
-            uint32_t newSnlp = (uint32_t)bestSnlp.elementAti(i) + (uint32_t)values.elementAti(j);
-            int32_t ln_j_i = lengths.elementAti(j) + i;
-            if (newSnlp < (uint32_t)bestSnlp.elementAti(ln_j_i)) {
-                bestSnlp.setElementAt(newSnlp, ln_j_i);
-                prev.setElementAt(i, ln_j_i);
+            uint32_t newSnlp = bestSnlp[i] + (uint32_t)values[j];
+            int32_t ln_j_i = lengths[j] + i;
+            if (newSnlp < bestSnlp[ln_j_i]) {
+                bestSnlp[ln_j_i] = newSnlp;
+                prev[ln_j_i] = i;
             }
         }
 
@@ -1318,34 +1394,34 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                 katakanaRunLength++;
             }
             if (katakanaRunLength < kMaxKatakanaGroupLength) {
-                uint32_t newSnlp = bestSnlp.elementAti(i) + getKatakanaCost(katakanaRunLength);
-                if (newSnlp < (uint32_t)bestSnlp.elementAti(i+katakanaRunLength)) {
-                    bestSnlp.setElementAt(newSnlp, i+katakanaRunLength);
-                    prev.setElementAt(i, i+katakanaRunLength);  // prev[j] = i;
+                uint32_t newSnlp = bestSnlp[i] + getKatakanaCost(katakanaRunLength);
+                if (newSnlp < bestSnlp[i+katakanaRunLength]) {
+                    bestSnlp[i+katakanaRunLength] = newSnlp;
+                    prev[i+katakanaRunLength] = i;  // prev[j] = i;
                 }
             }
         }
         is_prev_katakana = is_katakana;
     }
-    utext_close(&fu);
 
     // Start pushing the optimal offset index into t_boundary (t for tentative).
     // prev[numCodePts] is guaranteed to be meaningful.
     // We'll first push in the reverse order, i.e.,
     // t_boundary[0] = numCodePts, and afterwards do a swap.
-    UVector32 t_boundary(numCodePts+1, status);
+    UVector32 &t_boundary = scratch.boundaries;
+    t_boundary.removeAllElements();
 
     int32_t numBreaks = 0;
     // No segmentation found, set boundary to end of range
-    if ((uint32_t)bestSnlp.elementAti(numCodePts) == kuint32max) {
+    if (bestSnlp[numCodePts] == kuint32max) {
         t_boundary.addElement(numCodePts, status);
         numBreaks++;
     } else {
-        for (int32_t i = numCodePts; i > 0; i = prev.elementAti(i)) {
+        for (int32_t i = numCodePts; i > 0; i = prev[i]) {
             t_boundary.addElement(i, status);
             numBreaks++;
         }
-        U_ASSERT(prev.elementAti(t_boundary.elementAti(numBreaks - 1)) == 0);
+        U_ASSERT(prev[t_boundary.elementAti(numBreaks - 1)] == 0);
     }
 
     // Add a break for the start of the dictionary range if there is not one
@@ -1354,6 +1430,9 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         t_boundary.addElement(0, status);
         numBreaks++;
     }
+    if (U_FAILURE(status)) {
+        return 0;
+    }
 
     // Now that we're done, convert positions in t_boundary[] (indices in 
     // the normalized input string) back to indices in the original input UText
@@ -1363,7 +1442,7 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     for (int32_t i = numBreaks-1; i >= 0; i--) {
         int32_t cpPos = t_boundary.elementAti(i);
         U_ASSERT(cpPos > prevCPPos);
-        int32_t utextPos =  inputMap.isValid() ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
+        int32_t utextPos =  inputMap != NULL ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
         U_ASSERT(utextPos >= prevUTextPos);
         if (utextPos > prevUTextPos) {
             // Boundaries are added to foundBreaks output in ascending order.
@@ -1380,8 +1459,6 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     }
     (void)prevCPPos; // suppress compiler warnings about unused variable
 
-    // inString goes out of scope
-    // inputMap goes out of scope
     return numBreaks;
 }
 #endif
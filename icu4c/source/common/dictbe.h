@@ -16,11 +16,13 @@
 
 #include "brkeng.h"
 #include "uvectr32.h"
+#include "umutex.h"
 
 U_NAMESPACE_BEGIN
 
 class DictionaryMatcher;
 class Normalizer2;
+struct CjkScratch;
 
 /*******************************************************************
  * DictionaryBreakEngine
@@ -361,6 +363,14 @@ class CjkBreakEngine : public DictionaryBreakEngine {
   DictionaryMatcher        *fDictionary;
   const Normalizer2        *nfkcNorm2;
 
+    /**
+     * Scratch space for divideUpDictionaryRange(), reused between calls.
+     * A thread claims it with fScratchLock; if it is busy, temporary scratch space is used.
+     * @internal
+     */
+  CjkScratch               *fScratch;
+  mutable u_atomic_int32_t  fScratchLock;
+
  public:
 
     /**
@@ -392,6 +402,19 @@ class CjkBreakEngine : public DictionaryBreakEngine {
           int32_t rangeEnd,
           UVector32 &foundBreaks ) const;
 
+ private:
+    /**
+     * <p>Divide up a range of known dictionary characters, using the given scratch space.</p>
+     *
+     * @param scratch Scratch space that only the calling thread uses
+     * @internal
+     */
+  int32_t divideUpDictionaryRange( UText *text,
+          int32_t rangeStart,
+          int32_t rangeEnd,
+          UVector32 &foundBreaks,
+          CjkScratch &scratch ) const;
+
 };
 
 #endif
@@ -15,6 +15,9 @@
 #include "unicode/ucharstrie.h"
 #include "unicode/bytestrie.h"
 #include "unicode/udata.h"
+#include "unicode/appendable.h"
+#include "unicode/unistr.h"
+#include "unicode/utf16.h"
 #include "cmemory.h"
 
 #if !UCONFIG_NO_BREAK_ITERATION
@@ -34,6 +37,23 @@ const int32_t  DictionaryData::TRANSFORM_OFFSET_MASK = 0x1fffff;
 DictionaryMatcher::~DictionaryMatcher() {
 }
 
+int32_t DictionaryMatcher::matchesUChars(const UChar *text, int32_t textLength,
+                            int32_t maxLength, int32_t limit,
+                            int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                            int32_t *prefix) const {
+    UErrorCode status = U_ZERO_ERROR;
+    UText ut = UTEXT_INITIALIZER;
+    utext_openUChars(&ut, text, textLength, &status);
+    int32_t wordCount = 0;
+    if (U_SUCCESS(status)) {
+        wordCount = matches(&ut, maxLength, limit, lengths, cpLengths, values, prefix);
+    } else if (prefix != NULL) {
+        *prefix = 0;
+    }
+    utext_close(&ut);
+    return wordCount;
+}
+
 UCharsDictionaryMatcher::~UCharsDictionaryMatcher() {
     udata_close(file);
 }
@@ -52,7 +72,7 @@ int32_t UCharsDictionaryMatcher::matches(UText *text, int32_t maxLength, int32_t
     int32_t codePointsMatched = 0;
 
     for (UChar32 c = utext_next32(text); c >= 0; c=utext_next32(text)) {
-        UStringTrieResult result = (codePointsMatched == 0) ? uct.first(c) : uct.next(c);
+        UStringTrieResult result = (codePointsMatched == 0) ? firstChar(uct, c) : uct.next(c);
         int32_t lengthMatched = (int32_t)utext_getNativeIndex(text) - startingTextIndex;
         codePointsMatched += 1;
         if (USTRINGTRIE_HAS_VALUE(result)) {
@@ -86,6 +106,102 @@ int32_t UCharsDictionaryMatcher::matches(UText *text, int32_t maxLength, int32_t
     return wordCount;
 }
 
+int32_t UCharsDictionaryMatcher::matchesUChars(const UChar *text, int32_t textLength,
+                            int32_t maxLength, int32_t limit,
+                            int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                            int32_t *prefix) const {
+    UCharsTrie uct(characters);
+    int32_t wordCount = 0;
+    int32_t codePointsMatched = 0;
+
+    for (int32_t i = 0; i < textLength;) {
+        UChar32 c;
+        U16_NEXT(text, i, textLength, c);
+        UStringTrieResult result = (codePointsMatched == 0) ? firstChar(uct, c) : uct.next(c);
+        int32_t lengthMatched = i;
+        codePointsMatched += 1;
+        if (USTRINGTRIE_HAS_VALUE(result)) {
+            if (wordCount < limit) {
+                if (values != NULL) {
+                    values[wordCount] = uct.getValue();
+                }
+                if (lengths != NULL) {
+                    lengths[wordCount] = lengthMatched;
+                }
+                if (cpLengths != NULL) {
+                    cpLengths[wordCount] = codePointsMatched;
+                }
+                ++wordCount;
+            }
+            if (result == USTRINGTRIE_FINAL_VALUE) {
+                break;
+            }
+        }
+        else if (result == USTRINGTRIE_NO_MATCH) {
+            break;
+        }
+        if (lengthMatched >= maxLength) {
+            break;
+        }
+    }
+
+    if (prefix != NULL) {
+        *prefix = codePointsMatched;
+    }
+    return wordCount;
+}
+
+UStringTrieResult UCharsDictionaryMatcher::firstChar(UCharsTrie &uct, UChar32 c) const {
+    return uct.first(c);
+}
+
+IndexedUCharsDictionaryMatcher::IndexedUCharsDictionaryMatcher(const UChar *c, UDataMemory *f)
+        : UCharsDictionaryMatcher(c, f), index(NULL), states(NULL) {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString firstUnits;
+    UnicodeStringAppendable appendable(firstUnits);
+    UCharsTrie uct(characters);
+    int32_t count = uct.getNextUChars(appendable);
+    if (count == 0) {
+        return;
+    }
+    states = new UCharsTrie::State[count];
+    if (states == NULL) {
+        return;
+    }
+    index = utrie2_open(USTRINGTRIE_NO_MATCH, USTRINGTRIE_NO_MATCH, &status);
+    for (int32_t i = 0; i < count && U_SUCCESS(status); ++i) {
+        UChar unit = firstUnits.charAt(i);
+        UStringTrieResult result = uct.first(unit);
+        uct.saveState(states[i]);
+        utrie2_set32(index, unit, ((uint32_t)i << 2) | result, &status);
+    }
+    utrie2_freeze(index, UTRIE2_32_VALUE_BITS, &status);
+    if (U_FAILURE(status)) {
+        utrie2_close(index);
+        index = NULL;
+        delete[] states;
+        states = NULL;
+    }
+}
+
+IndexedUCharsDictionaryMatcher::~IndexedUCharsDictionaryMatcher() {
+    utrie2_close(index);
+    delete[] states;
+}
+
+UStringTrieResult IndexedUCharsDictionaryMatcher::firstChar(UCharsTrie &uct, UChar32 c) const {
+    if (index == NULL || c > 0xffff) {
+        return uct.first(c);
+    }
+    uint32_t value = UTRIE2_GET32(index, c);
+    UStringTrieResult result = (UStringTrieResult)(value & 3);
+    if (result != USTRINGTRIE_NO_MATCH) {
+        uct.resetToState(states[value >> 2]);
+    }
+    return result;
+}
+
 BytesDictionaryMatcher::~BytesDictionaryMatcher() {
     udata_close(file);
 }
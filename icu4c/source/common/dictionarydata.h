@@ -23,10 +23,11 @@
 #include "udataswp.h"
 #include "unicode/uobject.h"
 #include "unicode/ustringtrie.h"
+#include "unicode/ucharstrie.h"
+#include "utrie2.h"
 
 U_NAMESPACE_BEGIN
 
-class UCharsTrie;
 class BytesTrie;
 
 class U_COMMON_API DictionaryData : public UMemory {
@@ -94,6 +95,17 @@ public:
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const = 0;
 
+    /*  Same as matches(), but for text in a UTF-16 buffer. Matching begins at text[0].
+     *  Lengths and maxLength are in UTF-16 code units.
+     *  The default implementation calls matches() with a UText for the buffer.
+     *
+     *  @param textLength The number of code units in text.
+     */
+    virtual int32_t matchesUChars(const UChar *text, int32_t textLength,
+                                  int32_t maxLength, int32_t limit,
+                                  int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                                  int32_t *prefix) const;
+
     /** @return DictionaryData::TRIE_TYPE_XYZ */
     virtual int32_t getType() const = 0;
 };
@@ -108,12 +120,41 @@ public:
     virtual int32_t matches(UText *text, int32_t maxLength, int32_t limit,
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const;
+    virtual int32_t matchesUChars(const UChar *text, int32_t textLength,
+                                  int32_t maxLength, int32_t limit,
+                                  int32_t *lengths, int32_t *cpLengths, int32_t *values,
+                                  int32_t *prefix) const;
     virtual int32_t getType() const;
-private:
+protected:
+    // Starts matching a word with its first code point c, like uct.first(c).
+    virtual UStringTrieResult firstChar(UCharsTrie &uct, UChar32 c) const;
+
     const UChar *characters;
+private:
     UDataMemory *file;
 };
 
+// UCharsDictionaryMatcher with a direct-indexed first level, as in a double-array trie.
+// The trie state after the first code unit of a word is looked up in a UTrie2,
+// rather than found by searching the root branch node of the UCharsTrie.
+// For the Chinese/Japanese dictionary that node has some 16,000 branches,
+// and searching it takes about as long as matching all of the following characters.
+class U_COMMON_API IndexedUCharsDictionaryMatcher : public UCharsDictionaryMatcher {
+public:
+    // constructs a new IndexedUCharsDictionaryMatcher.
+    // The UDataMemory * will be closed on this object's destruction.
+    // If the index cannot be built, then this works like a UCharsDictionaryMatcher.
+    IndexedUCharsDictionaryMatcher(const UChar *c, UDataMemory *f);
+    virtual ~IndexedUCharsDictionaryMatcher();
+protected:
+    virtual UStringTrieResult firstChar(UCharsTrie &uct, UChar32 c) const;
+private:
+    // first code unit -> (index into states) << 2 | UStringTrieResult
+    UTrie2 *index;
+    // states[i] = trie state after the i-th first code unit
+    UCharsTrie::State *states;
+};
+
 // Implementation of the DictionaryMatcher interface for a BytesTrie dictionary
 class U_COMMON_API BytesDictionaryMatcher : public DictionaryMatcher {
 public:
@@ -35,6 +35,7 @@
 #include "putilimp.h"
 #include "uassert.h"
 #include "uset_imp.h"
+#include "usimd.h"
 #include "utrie2.h"
 #include "uvector.h"
 
@@ -58,6 +59,90 @@ inline uint8_t leadByteForCP(UChar32 c) {
     }
 }
 
+/**
+ * Number of code units that skipCodeUnitsBelow() and skipBytesBelow() check
+ * one at a time before they use SIMD, so that short runs between
+ * characters above the threshold (as in most non-Latin text) cost little.
+ */
+constexpr int32_t SCALAR_SKIP_LENGTH = 4;
+
+/**
+ * Skips code units below minCP (which must be >0) in [src, limit[
+ * and returns the first one that is not below, or a position near limit.
+ * With SIMD, compares 8 code units at a time; the quick check loops then
+ * continue one at a time from where this stops.
+ * Without SIMD, returns src.
+ */
+inline const UChar *skipCodeUnitsBelow(const UChar *src, const UChar *limit, UChar minCP) {
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    for (int32_t i = 0; i < SCALAR_SKIP_LENGTH; ++i, ++src) {
+        if (src == limit || *src >= minCP) { return src; }
+    }
+#endif
+#if U_SIMD_SSE2
+    // v<minCP <=> saturated (v-(minCP-1))==0, avoiding SSE2's lack of unsigned comparisons.
+    __m128i minCPMinus1 = _mm_set1_epi16((int16_t)(minCP - 1));
+    __m128i zero = _mm_setzero_si128();
+    while ((limit - src) >= 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)src);
+        __m128i isBelow = _mm_cmpeq_epi16(_mm_subs_epu16(v, minCPMinus1), zero);
+        if (_mm_movemask_epi8(isBelow) != 0xffff) {
+            while (*src < minCP) { ++src; }
+            break;
+        }
+        src += 8;
+    }
+#elif U_SIMD_NEON
+    uint16x8_t minCPVector = vdupq_n_u16(minCP);
+    while ((limit - src) >= 8) {
+        if (vminvq_u16(vcltq_u16(vld1q_u16((const uint16_t *)src), minCPVector)) == 0) {
+            while (*src < minCP) { ++src; }
+            break;
+        }
+        src += 8;
+    }
+#else
+    (void)limit;
+    (void)minCP;
+#endif
+    return src;
+}
+
+/** Same as the UTF-16 version, but for bytes, 16 at a time. */
+inline const uint8_t *skipBytesBelow(const uint8_t *src, const uint8_t *limit, uint8_t minByte) {
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    for (int32_t i = 0; i < SCALAR_SKIP_LENGTH; ++i, ++src) {
+        if (src == limit || *src >= minByte) { return src; }
+    }
+#endif
+#if U_SIMD_SSE2
+    __m128i minByteMinus1 = _mm_set1_epi8((char)(minByte - 1));
+    __m128i zero = _mm_setzero_si128();
+    while ((limit - src) >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)src);
+        __m128i isBelow = _mm_cmpeq_epi8(_mm_subs_epu8(v, minByteMinus1), zero);
+        if (_mm_movemask_epi8(isBelow) != 0xffff) {
+            while (*src < minByte) { ++src; }
+            break;
+        }
+        src += 16;
+    }
+#elif U_SIMD_NEON
+    uint8x16_t minByteVector = vdupq_n_u8(minByte);
+    while ((limit - src) >= 16) {
+        if (vminvq_u8(vcltq_u8(vld1q_u8(src), minByteVector)) == 0) {
+            while (*src < minByte) { ++src; }
+            break;
+        }
+        src += 16;
+    }
+#else
+    (void)limit;
+    (void)minByte;
+#endif
+    return src;
+}
+
 /**
  * Returns the code point from one single well-formed UTF-8 byte sequence
  * between cpStart and cpLimit.
@@ -632,9 +717,9 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
         for(prevSrc=src; src!=limit;) {
-            if( (c=*src)<minNoCP ||
-                isMostDecompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoCP) {
+                src=skipCodeUnitsBelow(src+1, limit, (UChar)minNoCP);
+            } else if(isMostDecompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else if(!U16_IS_SURROGATE(c)) {
                 break;
@@ -839,6 +924,148 @@ Normalizer2Impl::decomposeShort(const uint8_t *src, const uint8_t *limit,
     return src;
 }
 
+UBool
+Normalizer2Impl::decomposeUTF8(uint32_t options,
+                               const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, Edits *edits, UErrorCode &errorCode) const {
+    U_ASSERT(limit != nullptr);
+    UnicodeString s16;
+    uint8_t minNoLead = leadByteForCP(minDecompNoCP);
+    const uint8_t *prevBoundary = src;
+    // Run of in-order combining marks that are copied without decomposition.
+    const uint8_t *marksStart = src, *marksLimit = nullptr;
+    uint8_t prevCC = 0;
+
+    for (;;) {
+        // Fast path: Scan over a sequence of characters below the minimum "no" code point,
+        // or with (decompYes && ccc==0) properties.
+        const uint8_t *prevSrc;
+        uint16_t norm16 = 0;
+        for (;;) {
+            if (src == limit) {
+                if (prevBoundary != limit && sink != nullptr) {
+                    ByteSinkUtil::appendUnchanged(prevBoundary, limit,
+                                                  *sink, options, edits, errorCode);
+                }
+                return TRUE;
+            }
+            if (*src < minNoLead) {
+                src = skipBytesBelow(src + 1, limit, minNoLead);
+            } else {
+                prevSrc = src;
+                UTRIE2_U8_NEXT16(normTrie, src, limit, norm16);
+                if (!isMostDecompYesAndZeroCC(norm16)) {
+                    break;
+                }
+            }
+        }
+        // The current character has a decomposition or a non-zero ccc.
+        if (prevSrc != marksLimit || norm16HasDecompBoundaryBefore(norm16)) {
+            // There is a boundary before the current character: Any previous character
+            // passed the (decompYes && ccc==0) test or ended the previous segment,
+            // or the current character does not reorder with preceding marks.
+            marksStart = prevSrc;
+            prevCC = 0;
+        }
+        if (norm16 >= MIN_NORMAL_MAYBE_YES) {
+            // Medium-fast path: A combining mark without decomposition
+            // remains unchanged if it is in canonical order.
+            uint8_t cc = getCCFromNormalYesOrMaybe(norm16);
+            if (prevCC <= cc) {
+                prevCC = cc;
+                marksLimit = src;
+                continue;
+            }
+        } else if (minYesNo <= norm16 && norm16 < limitNoNo && marksStart == prevSrc) {
+            // Medium-fast path: A character with a boundary before it
+            // maps to its decomposition if nothing following reorders with it,
+            // that is, if the decomposition has tccc==0
+            // or if there is a boundary after the character.
+            const uint16_t *mapping = nullptr;
+            int32_t length;
+            char16_t jamos[3];
+            if (isHangulLV(norm16) || isHangulLVT(norm16)) {
+                length = Hangul::decompose(codePointFromValidUTF8(prevSrc, src), jamos);
+            } else {
+                mapping = getMapping(norm16);
+                uint16_t firstUnit = *mapping++;
+                length = firstUnit & MAPPING_LENGTH_MASK;
+                if (firstUnit > 0xff && src != limit && *src >= minNoLead) {  // tccc!=0
+                    const uint8_t *nextSrc = src;
+                    uint16_t nextNorm16;
+                    UTRIE2_U8_NEXT16(normTrie, nextSrc, limit, nextNorm16);
+                    if (!norm16HasDecompBoundaryBefore(nextNorm16)) {
+                        mapping = nullptr;
+                        length = -1;
+                    }
+                }
+            }
+            if (length >= 0) {
+                if (sink == nullptr) {
+                    return FALSE;
+                }
+                if (prevBoundary != prevSrc &&
+                        !ByteSinkUtil::appendUnchanged(prevBoundary, prevSrc,
+                                                       *sink, options, edits, errorCode)) {
+                    break;
+                }
+                if (!ByteSinkUtil::appendChange(prevSrc, src,
+                                                mapping != nullptr ? (const char16_t *)mapping : jamos,
+                                                length, *sink, edits, errorCode)) {
+                    break;
+                }
+                prevBoundary = src;
+                continue;
+            }
+        }
+
+        // Slow path: Decompose and reorder until the next boundary,
+        // then compare with the original text.
+        // Start with the preceding in-order marks, if any,
+        // because the current character may need to be reordered with them.
+        prevSrc = marksStart;
+        ReorderingBuffer buffer(*this, s16, errorCode);
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        decomposeShort(prevSrc, src, FALSE /* !stopAtCompBoundary */, FALSE,
+                       buffer, errorCode);
+        while (src != limit && *src >= minNoLead) {
+            const uint8_t *nextSrc = src;
+            UTRIE2_U8_NEXT16(normTrie, nextSrc, limit, norm16);
+            if (norm16HasDecompBoundaryBefore(norm16)) {
+                break;
+            }
+            decomposeShort(src, nextSrc, FALSE /* !stopAtCompBoundary */, FALSE,
+                           buffer, errorCode);
+            src = nextSrc;
+        }
+        if (U_FAILURE(errorCode)) {
+            break;
+        }
+        if ((src - prevSrc) > INT32_MAX) {  // guard before buffer.equals()
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            return TRUE;
+        }
+        if (!buffer.equals(prevSrc, src)) {
+            if (sink == nullptr) {
+                return FALSE;
+            }
+            if (prevBoundary != prevSrc &&
+                    !ByteSinkUtil::appendUnchanged(prevBoundary, prevSrc,
+                                                   *sink, options, edits, errorCode)) {
+                break;
+            }
+            if (!ByteSinkUtil::appendChange(prevSrc, src, buffer.getStart(), buffer.length(),
+                                            *sink, edits, errorCode)) {
+                break;
+            }
+            prevBoundary = src;
+        }
+    }
+    return TRUE;
+}
+
 const UChar *
 Normalizer2Impl::getDecomposition(UChar32 c, UChar buffer[4], int32_t &length) const {
     uint16_t norm16;
@@ -1358,9 +1585,9 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
                 }
                 return TRUE;
             }
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                src=skipCodeUnitsBelow(src+1, limit, (UChar)minNoMaybeCP);
+            } else if(isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else {
                 prevSrc = src++;
@@ -1625,9 +1852,9 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
             if(src==limit) {
                 return src;
             }
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                src=skipCodeUnitsBelow(src+1, limit, (UChar)minNoMaybeCP);
+            } else if(isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else {
                 prevSrc = src++;
@@ -1783,7 +2010,7 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
                 return TRUE;
             }
             if (*src < minNoMaybeLead) {
-                ++src;
+                src = skipBytesBelow(src + 1, limit, minNoMaybeLead);
             } else {
                 prevSrc = src;
                 UTRIE2_U8_NEXT16(normTrie, src, limit, norm16);
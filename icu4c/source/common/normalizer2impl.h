@@ -479,6 +479,11 @@ public:
                             UnicodeString &safeMiddle,
                             ReorderingBuffer &buffer,
                             UErrorCode &errorCode) const;
+
+    /** sink==nullptr: isNormalized() */
+    UBool decomposeUTF8(uint32_t options,
+                        const uint8_t *src, const uint8_t *limit,
+                        ByteSink *sink, icu::Edits *edits, UErrorCode &errorCode) const;
     UBool compose(const UChar *src, const UChar *limit,
                   UBool onlyContiguous,
                   UBool doCompose,
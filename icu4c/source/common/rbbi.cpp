@@ -23,6 +23,7 @@
 #include "unicode/uchriter.h"
 #include "unicode/uclean.h"
 #include "unicode/udata.h"
+#include "unicode/utf16.h"
 
 #include "brkeng.h"
 #include "ucln_cmn.h"
@@ -32,7 +33,9 @@
 #include "rbbi_cache.h"
 #include "rbbirb.h"
 #include "uassert.h"
+#include "ustr_imp.h"
 #include "umutex.h"
+#include "uvector.h"
 #include "uvectr32.h"
 
 // if U_LOCAL_SERVICE_HOOK is defined, then localsvc.cpp is expected to be included.
@@ -224,11 +227,31 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
 
     if (fLanguageBreakEngines != NULL) {
         delete fLanguageBreakEngines;
-        fLanguageBreakEngines = NULL;   // Just rebuild for now
+        fLanguageBreakEngines = NULL;
     }
-    // TODO: clone fLanguageBreakEngines from "that"
     UErrorCode status = U_ZERO_ERROR;
+    if (that.fLanguageBreakEngines != NULL) {
+        // The dictionary break engines are shared and immutable; take over the ones
+        // that "that" has already looked up. The unhandled engine is per-iterator state,
+        // and is rebuilt on demand.
+        fLanguageBreakEngines = new UStack(that.fLanguageBreakEngines->size(), status);
+        if (fLanguageBreakEngines == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        }
+        for (int32_t i = 0; U_SUCCESS(status) && i < that.fLanguageBreakEngines->size(); ++i) {
+            void *engine = that.fLanguageBreakEngines->elementAt(i);
+            if (engine != that.fUnhandledBreakEngine) {
+                fLanguageBreakEngines->push(engine, status);
+            }
+        }
+        if (U_FAILURE(status)) {
+            delete fLanguageBreakEngines;
+            fLanguageBreakEngines = NULL;
+            status = U_ZERO_ERROR;
+        }
+    }
     utext_clone(&fText, &that.fText, FALSE, TRUE, &status);
+    checkUTF16Text();
 
     if (fCharIter != &fSCharIter) {
         delete fCharIter;
@@ -262,8 +285,12 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
     //       Current position could be within a dictionary range. Trying to continue
     //       the iteration without the caches present would go to the rules, with
     //       the assumption that the current position is on a rule boundary.
-    fBreakCache->reset(fPosition, fRuleStatusIndex);
-    fDictionaryCache->reset();
+    if (fBreakCache != NULL) {
+        fBreakCache->reset(fPosition, fRuleStatusIndex);
+    }
+    if (fDictionaryCache != NULL) {
+        fDictionaryCache->reset();
+    }
 
     return *this;
 }
@@ -287,6 +314,7 @@ void RuleBasedBreakIterator::init(UErrorCode &status) {
     fUnhandledBreakEngine = NULL;
     fBreakCache           = NULL;
     fDictionaryCache      = NULL;
+    fTextUTF16Length      = -1;
 
     // Note: IBM xlC is unable to assign or initialize member fText from UTEXT_INITIALIZER.
     // fText                 = UTEXT_INITIALIZER;
@@ -297,12 +325,11 @@ void RuleBasedBreakIterator::init(UErrorCode &status) {
         return;
     }
 
+    // The break cache and the dictionary cache are allocated on first use,
+    // so that clones which are only used briefly, or only with getAllBoundaries(),
+    // do not pay for them.
     utext_openUChars(&fText, NULL, 0, &status);
-    fDictionaryCache = new DictionaryCache(this, status);
-    fBreakCache      = new BreakCache(this, status);
-    if (U_SUCCESS(status) && (fDictionaryCache == NULL || fBreakCache == NULL)) {
-        status = U_MEMORY_ALLOCATION_ERROR;
-    }
+    checkUTF16Text();
 
 #ifdef RBBI_DEBUG
     static UBool debugInitDone = FALSE;
@@ -330,6 +357,51 @@ RuleBasedBreakIterator::clone(void) const {
     return new RuleBasedBreakIterator(*this);
 }
 
+
+//-----------------------------------------------------------------------------
+//
+//    initBreakCache(), initDictionaryCache()
+//                Allocate the caches on first use. The break cache starts out
+//                holding just the current boundary, as after a reset.
+//                Return FALSE if out of memory.
+//
+//-----------------------------------------------------------------------------
+UBool RuleBasedBreakIterator::initBreakCache() {
+    if (fBreakCache == NULL) {
+        UErrorCode status = U_ZERO_ERROR;
+        BreakCache *cache = new BreakCache(this, status);
+        if (cache == NULL || U_FAILURE(status)) {
+            delete cache;
+            return FALSE;
+        }
+        cache->reset(fPosition, fRuleStatusIndex);
+        fBreakCache = cache;
+    }
+    return TRUE;
+}
+
+UBool RuleBasedBreakIterator::initDictionaryCache() {
+    if (fDictionaryCache == NULL) {
+        UErrorCode status = U_ZERO_ERROR;
+        DictionaryCache *cache = new DictionaryCache(this, status);
+        if (cache == NULL || U_FAILURE(status)) {
+            delete cache;
+            return FALSE;
+        }
+        fDictionaryCache = cache;
+    }
+    return TRUE;
+}
+
+void RuleBasedBreakIterator::resetCaches() {
+    if (fBreakCache != NULL) {
+        fBreakCache->reset();
+    }
+    if (fDictionaryCache != NULL) {
+        fDictionaryCache->reset();
+    }
+}
+
 /**
  * Equality operator.  Returns TRUE if both BreakIterators are of the
  * same class, have the same behavior, and iterate over the same text.
@@ -388,9 +460,9 @@ void RuleBasedBreakIterator::setText(UText *ut, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return;
     }
-    fBreakCache->reset();
-    fDictionaryCache->reset();
+    resetCaches();
     utext_clone(&fText, ut, FALSE, TRUE, &status);
+    checkUTF16Text();
 
     // Set up a dummy CharacterIterator to be returned if anyone
     //   calls getText().  With input from UText, there is no reasonable
@@ -410,6 +482,20 @@ void RuleBasedBreakIterator::setText(UText *ut, UErrorCode &status) {
 }
 
 
+void RuleBasedBreakIterator::checkUTF16Text() {
+    // Do not compute the length of a NUL-terminated string here.
+    fTextUTF16Length = -1;
+    if (fText.magic == UTEXT_MAGIC &&
+            !utext_isLengthExpensive(&fText) &&
+            fText.chunkNativeStart == 0 &&
+            fText.chunkNativeLimit == fText.chunkLength &&
+            fText.nativeIndexingLimit == fText.chunkLength &&
+            fText.chunkNativeLimit == utext_nativeLength(&fText)) {
+        fTextUTF16Length = fText.chunkLength;
+    }
+}
+
+
 UText *RuleBasedBreakIterator::getUText(UText *fillIn, UErrorCode &status) const {
     UText *result = utext_clone(fillIn, &fText, FALSE, TRUE, &status);
     return result;
@@ -443,8 +529,7 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
 
     fCharIter = newText;
     UErrorCode status = U_ZERO_ERROR;
-    fBreakCache->reset();
-    fDictionaryCache->reset();
+    resetCaches();
     if (newText==NULL || newText->startIndex() != 0) {
         // startIndex !=0 wants to be an error, but there's no way to report it.
         // Make the iterator text be an empty string.
@@ -452,6 +537,7 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
     } else {
         utext_openCharacterIterator(&fText, newText, &status);
     }
+    checkUTF16Text();
     this->first();
 }
 
@@ -463,9 +549,9 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
 void
 RuleBasedBreakIterator::setText(const UnicodeString& newText) {
     UErrorCode status = U_ZERO_ERROR;
-    fBreakCache->reset();
-    fDictionaryCache->reset();
+    resetCaches();
     utext_openConstUnicodeString(&fText, &newText, &status);
+    checkUTF16Text();
 
     // Set up a character iterator on the string.
     //   Needed in case someone calls getText().
@@ -500,6 +586,7 @@ RuleBasedBreakIterator &RuleBasedBreakIterator::refreshInputText(UText *input, U
     int64_t pos = utext_getNativeIndex(&fText);
     //  Shallow read-only clone of the new UText into the existing input UText
     utext_clone(&fText, input, FALSE, TRUE, &status);
+    checkUTF16Text();
     if (U_FAILURE(status)) {
         return *this;
     }
@@ -520,6 +607,14 @@ RuleBasedBreakIterator &RuleBasedBreakIterator::refreshInputText(UText *input, U
  * @return The new iterator position, which is zero.
  */
 int32_t RuleBasedBreakIterator::first(void) {
+    if (fBreakCache == NULL) {
+        // Position zero is always a boundary, with rule status 0.
+        // The break cache will be started from here when it is first needed.
+        fPosition = 0;
+        fRuleStatusIndex = 0;
+        fDone = FALSE;
+        return 0;
+    }
     UErrorCode status = U_ZERO_ERROR;
     if (!fBreakCache->seek(0)) {
         fBreakCache->populateNear(0, status);
@@ -572,6 +667,9 @@ int32_t RuleBasedBreakIterator::next(int32_t n) {
  * @return The position of the first boundary after this one.
  */
 int32_t RuleBasedBreakIterator::next(void) {
+    if (fBreakCache == NULL && !initBreakCache()) {
+        return UBRK_DONE;
+    }
     fBreakCache->next();
     return fDone ? UBRK_DONE : fPosition;
 }
@@ -585,6 +683,9 @@ int32_t RuleBasedBreakIterator::next(void) {
  * @return The position of the boundary position immediately preceding the starting position.
  */
 int32_t RuleBasedBreakIterator::previous(void) {
+    if (fBreakCache == NULL && !initBreakCache()) {
+        return UBRK_DONE;
+    }
     UErrorCode status = U_ZERO_ERROR;
     fBreakCache->previous(status);
     return fDone ? UBRK_DONE : fPosition;
@@ -608,6 +709,9 @@ int32_t RuleBasedBreakIterator::following(int32_t startPos) {
     utext_setNativeIndex(&fText, startPos);
     startPos = (int32_t)utext_getNativeIndex(&fText);
 
+    if (fBreakCache == NULL && !initBreakCache()) {
+        return UBRK_DONE;
+    }
     UErrorCode status = U_ZERO_ERROR;
     fBreakCache->following(startPos, status);
     return fDone ? UBRK_DONE : fPosition;
@@ -630,6 +734,9 @@ int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
     utext_setNativeIndex(&fText, offset);
     int32_t adjustedOffset = utext_getNativeIndex(&fText);
 
+    if (fBreakCache == NULL && !initBreakCache()) {
+        return UBRK_DONE;
+    }
     UErrorCode status = U_ZERO_ERROR;
     fBreakCache->preceding(adjustedOffset, status);
     return fDone ? UBRK_DONE : fPosition;
@@ -657,6 +764,9 @@ UBool RuleBasedBreakIterator::isBoundary(int32_t offset) {
     utext_setNativeIndex(&fText, offset);
     int32_t adjustedOffset = utext_getNativeIndex(&fText);
 
+    if (fBreakCache == NULL && !initBreakCache()) {
+        return FALSE;
+    }
     bool result = false;
     UErrorCode status = U_ZERO_ERROR;
     if (fBreakCache->seek(adjustedOffset) || fBreakCache->populateNear(adjustedOffset, status)) {
@@ -750,6 +860,73 @@ struct LookAheadResults {
 };
 
 
+//-----------------------------------------------------------------------------------
+//
+//  Text readers for handleNextLoop()
+//
+//      handleNext() picks the one that best fits the text being iterated.
+//      next32() returns U_SENTINEL at the end of the text, like UTEXT_NEXT32(),
+//      and nativeIndex() returns the native index following the last code point returned.
+//
+//      The UTF-16 and UTF-8 readers do not move fText. That is fine because
+//      every user of fText sets its native index before reading.
+//
+//-----------------------------------------------------------------------------------
+namespace {
+
+// Any text: go through the UText.
+class UTextReader {
+public:
+    UTextReader(UText *ut) : fUT(ut) {}
+    inline UChar32 next32() { return UTEXT_NEXT32(fUT); }
+    inline int32_t nativeIndex() const { return (int32_t)UTEXT_GETNATIVEINDEX(fUT); }
+private:
+    UText *fUT;
+};
+
+// Text in a single UTF-16 chunk, as for a UnicodeString:
+// read the chunk directly, the same way as UTEXT_NEXT32() does.
+class UTF16Reader {
+public:
+    UTF16Reader(const UChar *s, int32_t start, int32_t length) : fS(s), fIndex(start), fLength(length) {}
+    inline UChar32 next32() {
+        if (fIndex >= fLength) {
+            return U_SENTINEL;
+        }
+        UChar32 c;
+        U16_NEXT(fS, fIndex, fLength, c);
+        return c;
+    }
+    inline int32_t nativeIndex() const { return fIndex; }
+private:
+    const UChar *fS;
+    int32_t fIndex;
+    int32_t fLength;
+};
+
+// Text from utext_openUTF8(): decode the bytes directly,
+// the same way as the UTF-8 UText provider does.
+class UTF8Reader {
+public:
+    UTF8Reader(const uint8_t *s, int32_t start, int32_t length) : fS(s), fIndex(start), fLength(length) {}
+    inline UChar32 next32() {
+        if (fIndex >= fLength) {
+            return U_SENTINEL;
+        }
+        UChar32 c;
+        U8_NEXT_OR_FFFD(fS, fIndex, fLength, c);
+        return c;
+    }
+    inline int32_t nativeIndex() const { return fIndex; }
+private:
+    const uint8_t *fS;
+    int32_t fIndex;
+    int32_t fLength;
+};
+
+}  // namespace
+
+
 //-----------------------------------------------------------------------------------
 //
 //  handleNext()
@@ -757,6 +934,40 @@ struct LookAheadResults {
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleNext() {
+    int32_t length = fTextUTF16Length;
+    if (length >= 0 && fText.chunkNativeStart == 0 && fText.chunkLength == length &&
+            fPosition >= 0 && fPosition <= length) {
+        // Not in the middle of a surrogate pair, where UTEXT_SETNATIVEINDEX() would back up.
+        const UChar *s = fText.chunkContents;
+        if (fPosition == 0 || fPosition == length ||
+                !U16_IS_TRAIL(s[fPosition]) || !U16_IS_LEAD(s[fPosition - 1])) {
+            UTF16Reader text(s, fPosition, length);
+            return handleNextLoop(text);
+        }
+    }
+
+    const uint8_t *s8 = (const uint8_t *)uprv_getUTF8TextContents(&fText, &length);
+    if (s8 != NULL && fPosition >= 0 && fPosition <= length &&
+            (fPosition == length || !U8_IS_TRAIL(s8[fPosition]))) {
+        UTF8Reader text(s8, fPosition, length);
+        return handleNextLoop(text);
+    }
+
+    UTEXT_SETNATIVEINDEX(&fText, fPosition);
+    UTextReader text(&fText);
+    return handleNextLoop(text);
+}
+
+
+//-----------------------------------------------------------------------------------
+//
+//  handleNextLoop()
+//     The state machine of handleNext(), reading from a text that
+//     is already positioned at fPosition.
+//
+//-----------------------------------------------------------------------------------
+template<typename TextReader>
+int32_t RuleBasedBreakIterator::handleNextLoop(TextReader &text) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIRunMode         mode;
@@ -783,9 +994,8 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
     // if we're already at the end of the text, return DONE.
     initialPosition = fPosition;
-    UTEXT_SETNATIVEINDEX(&fText, initialPosition);
     result          = initialPosition;
-    c               = UTEXT_NEXT32(&fText);
+    c               = text.next32();
     if (c==U_SENTINEL) {
         fDone = TRUE;
         return UBRK_DONE;
@@ -832,7 +1042,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
             // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
             //        not the size of the character going in, which is a UChar32.
             //
-            category = UTRIE2_GET16(fData->fTrie, c);
+            category = fData->getCategory(c);
 
             // Check the dictionary bit in the character's category.
             //    Counter is only used by dictionary based iteration.
@@ -848,7 +1058,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
        #ifdef RBBI_DEBUG
             if (gTrace) {
-                RBBIDebugPrintf("             %4ld   ", utext_getNativeIndex(&fText));
+                RBBIDebugPrintf("             %4d   ", text.nativeIndex());
                 if (0x20<=c && c<0x7f) {
                     RBBIDebugPrintf("\"%c\"  ", c);
                 } else {
@@ -872,7 +1082,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         if (row->fAccepting == -1) {
             // Match found, common case.
             if (mode != RBBI_START) {
-                result = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+                result = text.nativeIndex();
             }
             fRuleStatusIndex = row->fTagIdx;   // Remember the break status (tag) values.
         }
@@ -890,7 +1100,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         int16_t rule = row->fLookAhead;
         if (rule != 0) {
             // At the position of a '/' in a look-ahead match. Record it.
-            int32_t  pos = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+            int32_t  pos = text.nativeIndex();
             lookAheadMatches.setPosition(rule, pos);
         }
 
@@ -906,7 +1116,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         //    the input position.  The next iteration will be processing the
         //    first real input character.
         if (mode == RBBI_RUN) {
-            c = UTEXT_NEXT32(&fText);
+            c = text.next32();
         } else {
             if (mode == RBBI_START) {
                 mode = RBBI_RUN;
@@ -982,7 +1192,7 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
         //        not the size of the character going in, which is a UChar32.
         //
         //  And off the dictionary flag bit. For reverse iteration it is not used.
-        category = UTRIE2_GET16(fData->fTrie, c);
+        category = fData->getCategory(c);
         category &= ~0x4000;
 
         #ifdef RBBI_DEBUG
@@ -1064,6 +1274,363 @@ int32_t RuleBasedBreakIterator::getRuleStatusVec(
 
 
 
+//-------------------------------------------------------------------------------
+//
+//   getAllBoundaries()    Run the rules from the start of the text to its end,
+//                         storing the boundaries directly into the caller's arrays.
+//                         Follows BreakCache::populateFollowing(), but without
+//                         the cache, and the rule status indexes are resolved
+//                         to status values as in getRuleStatus().
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::getAllBoundaries(int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                                                 UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (dest == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const int32_t *statusTable = fData->fRuleStatusTable;
+    int32_t count = 0;
+    int32_t pos = 0;
+    int32_t ruleStatusIdx = 0;
+    if (fDictionaryCache != NULL) {
+        fDictionaryCache->reset();
+    }
+    for (;;) {
+        if (count < capacity) {
+            dest[count] = pos;
+            if (ruleStatus != NULL) {
+                ruleStatus[count] = statusTable[ruleStatusIdx + statusTable[ruleStatusIdx]];
+            }
+        }
+        ++count;
+
+        int32_t fromPosition = pos;
+        int32_t fromRuleStatusIdx = ruleStatusIdx;
+        if (fDictionaryCache != NULL && fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx)) {
+            continue;
+        }
+        fPosition = fromPosition;
+        pos = handleNext();
+        if (pos == UBRK_DONE) {
+            break;
+        }
+        ruleStatusIdx = fRuleStatusIndex;
+        if (fDictionaryCharCount > 0 && initDictionaryCache()) {
+            fDictionaryCache->populateDictionary(fromPosition, pos, fromRuleStatusIdx, ruleStatusIdx);
+            fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx);
+        }
+    }
+
+    // handleNext() moved the iterator without updating the break cache.
+    first();
+    if (count > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return count;
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   getAllBoundariesParallel()
+//
+//   The text is split into chunks, and a run of the rules is collected for each one.
+//   The run for the first chunk starts at the start of the text. The runs for the
+//   other chunks start at the safe position that the reverse rules find before
+//   the chunk start; their first few boundaries may be wrong.
+//   Each run continues past the end of its chunk to a restart point, a boundary
+//   from which the following boundary is found with handleNext() rather than
+//   from the dictionary cache. Everything that comes after a restart point
+//   depends only on its position.
+//
+//   The runs are then joined in order. The joined boundaries so far are correct,
+//   and end with a restart point at or after the start of the next chunk.
+//   When the next run has a restart point that is also one in the joined run,
+//   the rest of the next run is appended after it. Otherwise the chunk is
+//   segmented again on this thread, from the end of the joined run.
+//
+//-------------------------------------------------------------------------------
+
+// Chunks shorter than this are not worth a task.
+static const int32_t kMinChunkLength = 0x8000;
+// Split the text into up to this many chunks per task, to balance the load.
+static const int32_t kChunksPerTask = 4;
+
+struct RuleBasedBreakIterator::BoundaryRun : public UObject {
+    BoundaryRun(UErrorCode &status) :
+            fPositions(status), fRuleStatusIndexes(status), fDictionaryRanges(status) {}
+
+    // Is the boundary at the index a restart point of this run?
+    UBool isRestartPoint(int32_t index) const;
+
+    UVector32 fPositions;
+    UVector32 fRuleStatusIndexes;
+    // (start, limit) pairs of the ranges that were segmented with the dictionary cache.
+    // The boundaries strictly inside of a range are not restart points.
+    UVector32 fDictionaryRanges;
+};
+
+UBool RuleBasedBreakIterator::BoundaryRun::isRestartPoint(int32_t index) const {
+    int32_t pos = fPositions.elementAti(index);
+    // Binary search for the last range that starts before pos.
+    int32_t start = 0;
+    int32_t limit = fDictionaryRanges.size() / 2;
+    while (start < limit) {
+        int32_t i = (start + limit) / 2;
+        if (fDictionaryRanges.elementAti(2 * i) < pos) {
+            start = i + 1;
+        } else {
+            limit = i;
+        }
+    }
+    return start == 0 || pos >= fDictionaryRanges.elementAti(2 * start - 1);
+}
+
+struct RuleBasedBreakIterator::ParallelSegmentation {
+    int32_t *chunkStarts;           // numChunks+1 entries, the last one is the text length
+    int32_t numChunks;
+    UVector *runs;                  // BoundaryRun for each chunk
+    u_atomic_int32_t next;          // number of chunks taken by any task
+    RuleBasedBreakIterator **iterators;  // one per task
+    UErrorCode *errorCodes;         // one per task
+};
+
+void RuleBasedBreakIterator::collectBoundaries(int32_t start, int32_t limit, BoundaryRun &run,
+                                               UErrorCode &status) {
+    if (fDictionaryCache != NULL) {
+        fDictionaryCache->reset();
+    }
+    int32_t pos = start;
+    int32_t ruleStatusIdx = 0;
+    for (;;) {
+        run.fPositions.addElement(pos, status);
+        run.fRuleStatusIndexes.addElement(ruleStatusIdx, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+
+        int32_t fromPosition = pos;
+        int32_t fromRuleStatusIdx = ruleStatusIdx;
+        if (fDictionaryCache != NULL && fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx)) {
+            continue;
+        }
+        if (fromPosition >= limit) {
+            break;
+        }
+        fPosition = fromPosition;
+        pos = handleNext();
+        if (pos == UBRK_DONE) {
+            break;
+        }
+        ruleStatusIdx = fRuleStatusIndex;
+        if (fDictionaryCharCount > 0 && initDictionaryCache()) {
+            fDictionaryCache->populateDictionary(fromPosition, pos, fromRuleStatusIdx, ruleStatusIdx);
+            if (fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx)) {
+                run.fDictionaryRanges.addElement(fDictionaryCache->fStart, status);
+                run.fDictionaryRanges.addElement(fDictionaryCache->fLimit, status);
+            }
+        }
+    }
+}
+
+void RuleBasedBreakIterator::collectChunks(ParallelSegmentation *segmentation, UErrorCode *status) {
+    int32_t i;
+    while ((i = umtx_atomic_inc(&segmentation->next) - 1) < segmentation->numChunks &&
+            U_SUCCESS(*status)) {
+        int32_t start = 0;
+        if (i > 0) {
+            start = handleSafePrevious(segmentation->chunkStarts[i]);
+        }
+        BoundaryRun *run = static_cast<BoundaryRun *>(segmentation->runs->elementAt(i));
+        collectBoundaries(start, segmentation->chunkStarts[i + 1], *run, *status);
+    }
+}
+
+void U_CALLCONV RuleBasedBreakIterator::collectChunksTask(void *context, int32_t index) {
+    ParallelSegmentation *segmentation = static_cast<ParallelSegmentation *>(context);
+    segmentation->iterators[index]->collectChunks(segmentation, &segmentation->errorCodes[index]);
+}
+
+int32_t RuleBasedBreakIterator::getAllBoundariesParallel(int32_t *dest, int32_t *ruleStatus,
+                                                         int32_t capacity, int32_t maxTasks,
+                                                         UBreakIteratorRunner *runner,
+                                                         const void *runnerContext,
+                                                         UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (dest == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t numTasks = runner != NULL ? maxTasks : 1;
+    int32_t textLength = (int32_t)utext_nativeLength(&fText);
+    int32_t numChunks = textLength / kMinChunkLength;
+    if (numTasks > numChunks) {
+        numTasks = numChunks;
+    }
+    if (numTasks <= 1) {
+        return getAllBoundaries(dest, ruleStatus, capacity, status);
+    }
+    if (numChunks > numTasks * kChunksPerTask) {
+        numChunks = numTasks * kChunksPerTask;
+    }
+
+    MaybeStackArray<int32_t, 64> chunkStarts;
+    UVector runs(uprv_deleteUObject, NULL, numChunks, status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (chunkStarts.resize(numChunks + 1) == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    for (int32_t i = 0; i < numChunks; ++i) {
+        chunkStarts[i] = (int32_t)(((int64_t)textLength * i) / numChunks);
+        BoundaryRun *run = new BoundaryRun(status);
+        if (run == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        }
+        runs.addElement(run, status);
+        if (U_FAILURE(status)) {
+            delete run;
+            return 0;
+        }
+    }
+    chunkStarts[numChunks] = textLength;
+
+    // Each task uses its own iterator: task 0 uses this one, the others use clones.
+    MaybeStackArray<RuleBasedBreakIterator *, 8> iterators;
+    MaybeStackArray<UErrorCode, 8> errorCodes;
+    UVector clones(uprv_deleteUObject, NULL, numTasks - 1, status);
+    if (U_SUCCESS(status) &&
+            (iterators.resize(numTasks) == NULL || errorCodes.resize(numTasks) == NULL)) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    iterators[0] = this;
+    for (int32_t i = 1; i < numTasks && U_SUCCESS(status); ++i) {
+        RuleBasedBreakIterator *clone = static_cast<RuleBasedBreakIterator *>(this->clone());
+        if (clone == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        }
+        clones.addElement(clone, status);
+        if (U_FAILURE(status)) {
+            delete clone;
+        }
+        iterators[i] = clone;
+    }
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+
+    ParallelSegmentation segmentation;
+    segmentation.chunkStarts = chunkStarts.getAlias();
+    segmentation.numChunks = numChunks;
+    segmentation.runs = &runs;
+    segmentation.next = 0;
+    segmentation.iterators = iterators.getAlias();
+    segmentation.errorCodes = errorCodes.getAlias();
+    for (int32_t i = 0; i < numTasks; ++i) {
+        errorCodes[i] = U_ZERO_ERROR;
+    }
+    runner(runnerContext, collectChunksTask, &segmentation, numTasks);
+    for (int32_t i = 0; i < numTasks; ++i) {
+        if (U_FAILURE(errorCodes[i]) && U_SUCCESS(status)) {
+            status = errorCodes[i];
+        }
+    }
+
+    // Join the runs.
+    BoundaryRun &joined = *static_cast<BoundaryRun *>(runs.elementAt(0));
+    for (int32_t chunk = 1; chunk < numChunks && U_SUCCESS(status); ++chunk) {
+        const BoundaryRun &run = *static_cast<BoundaryRun *>(runs.elementAt(chunk));
+        // Look for the first restart point of the joined run that is also one in the chunk's run.
+        // Both runs are in increasing order of position.
+        int32_t joinedIdx = joined.fPositions.size() - 1;
+        while (joinedIdx > 0 && joined.fPositions.elementAti(joinedIdx - 1) >= run.fPositions.elementAti(0)) {
+            --joinedIdx;
+        }
+        int32_t runIdx = 0;
+        UBool found = FALSE;
+        while (joinedIdx < joined.fPositions.size() && runIdx < run.fPositions.size()) {
+            int32_t joinedPos = joined.fPositions.elementAti(joinedIdx);
+            int32_t runPos = run.fPositions.elementAti(runIdx);
+            if (joinedPos < runPos) {
+                ++joinedIdx;
+            } else if (joinedPos > runPos) {
+                ++runIdx;
+            } else if (joined.isRestartPoint(joinedIdx) && run.isRestartPoint(runIdx)) {
+                found = TRUE;
+                break;
+            } else {
+                ++joinedIdx;
+                ++runIdx;
+            }
+        }
+
+        const BoundaryRun *tail = &run;
+        LocalPointer<BoundaryRun> again;
+        if (found) {
+            // The boundaries after the restart point are the same in both runs.
+            // Keep the joined run's rule status for the restart point itself.
+            joined.fPositions.setSize(joinedIdx + 1);
+            joined.fRuleStatusIndexes.setSize(joinedIdx + 1);
+        } else {
+            // The runs did not meet. Segment the chunk again, continuing the joined run.
+            again.adoptInsteadAndCheckErrorCode(new BoundaryRun(status), status);
+            if (U_FAILURE(status)) {
+                break;
+            }
+            collectBoundaries(joined.fPositions.lastElementi(), chunkStarts[chunk + 1], *again, status);
+            tail = again.getAlias();
+            runIdx = 0;
+        }
+        int32_t restartPos = tail->fPositions.elementAti(runIdx);
+        int32_t numRanges = joined.fDictionaryRanges.size();
+        while (numRanges > 0 && joined.fDictionaryRanges.elementAti(numRanges - 2) >= restartPos) {
+            numRanges -= 2;
+        }
+        joined.fDictionaryRanges.setSize(numRanges);
+        for (int32_t i = runIdx + 1; i < tail->fPositions.size(); ++i) {
+            joined.fPositions.addElement(tail->fPositions.elementAti(i), status);
+            joined.fRuleStatusIndexes.addElement(tail->fRuleStatusIndexes.elementAti(i), status);
+        }
+        for (int32_t i = 0; i < tail->fDictionaryRanges.size(); i += 2) {
+            if (tail->fDictionaryRanges.elementAti(i) >= restartPos) {
+                joined.fDictionaryRanges.addElement(tail->fDictionaryRanges.elementAti(i), status);
+                joined.fDictionaryRanges.addElement(tail->fDictionaryRanges.elementAti(i + 1), status);
+            }
+        }
+    }
+
+    // collectBoundaries() moved the iterator without updating the break cache.
+    first();
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    const int32_t *statusTable = fData->fRuleStatusTable;
+    int32_t count = joined.fPositions.size();
+    for (int32_t i = 0; i < count && i < capacity; ++i) {
+        dest[i] = joined.fPositions.elementAti(i);
+        if (ruleStatus != NULL) {
+            int32_t ruleStatusIdx = joined.fRuleStatusIndexes.elementAti(i);
+            ruleStatus[i] = statusTable[ruleStatusIdx + statusTable[ruleStatusIdx]];
+        }
+    }
+    if (count > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return count;
+}
+
+
 //-------------------------------------------------------------------------------
 //
 //   getBinaryRules        Access to the compiled form of the rules,
@@ -1246,7 +1813,9 @@ RuleBasedBreakIterator::getLanguageBreakEngine(UChar32 c) {
 }
 
 void RuleBasedBreakIterator::dumpCache() {
-    fBreakCache->dumpCache();
+    if (fBreakCache != NULL) {
+        fBreakCache->dumpCache();
+    }
 }
 
 void RuleBasedBreakIterator::dumpTables() {
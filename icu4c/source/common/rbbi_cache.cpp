@@ -146,13 +146,13 @@ void RuleBasedBreakIterator::DictionaryCache::populateDictionary(int32_t startPo
 
     utext_setNativeIndex(text, rangeStart);
     UChar32     c = utext_current32(text);
-    category = UTRIE2_GET16(fBI->fData->fTrie, c);
+    category = fBI->fData->getCategory(c);
 
     while(U_SUCCESS(status)) {
         while((current = (int32_t)UTEXT_GETNATIVEINDEX(text)) < rangeEnd && (category & 0x4000) == 0) {
             utext_next32(text);           // TODO: cleaner loop structure.
             c = utext_current32(text);
-            category = UTRIE2_GET16(fBI->fData->fTrie, c);
+            category = fBI->fData->getCategory(c);
         }
         if (current >= rangeEnd) {
             break;
@@ -170,7 +170,7 @@ void RuleBasedBreakIterator::DictionaryCache::populateDictionary(int32_t startPo
 
         // Reload the loop variables for the next go-round
         c = utext_current32(text);
-        category = UTRIE2_GET16(fBI->fData->fTrie, c);
+        category = fBI->fData->getCategory(c);
     }
 
     // If we found breaks, ensure that the first and last entries are
@@ -431,7 +431,7 @@ UBool RuleBasedBreakIterator::BreakCache::populateFollowing() {
     int32_t pos = 0;
     int32_t ruleStatusIdx = 0;
 
-    if (fBI->fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx)) {
+    if (fBI->fDictionaryCache != NULL && fBI->fDictionaryCache->following(fromPosition, &pos, &ruleStatusIdx)) {
         addFollowing(pos, ruleStatusIdx, UpdateCachePosition);
         return TRUE;
     }
@@ -443,7 +443,7 @@ UBool RuleBasedBreakIterator::BreakCache::populateFollowing() {
     }
 
     ruleStatusIdx = fBI->fRuleStatusIndex;
-    if (fBI->fDictionaryCharCount > 0) {
+    if (fBI->fDictionaryCharCount > 0 && fBI->initDictionaryCache()) {
         // The text segment obtained from the rules includes dictionary characters.
         // Subdivide it, with subdivided results going into the dictionary cache.
         fBI->fDictionaryCache->populateDictionary(fromPosition, pos, fromRuleStatusIdx, ruleStatusIdx);
@@ -489,7 +489,7 @@ UBool RuleBasedBreakIterator::BreakCache::populatePreceding(UErrorCode &status)
     int32_t position = 0;
     int32_t positionStatusIdx = 0;
 
-    if (fBI->fDictionaryCache->preceding(fromPosition, &position, &positionStatusIdx)) {
+    if (fBI->fDictionaryCache != NULL && fBI->fDictionaryCache->preceding(fromPosition, &position, &positionStatusIdx)) {
         addPreceding(position, positionStatusIdx, UpdateCachePosition);
         return TRUE;
     }
@@ -546,7 +546,7 @@ UBool RuleBasedBreakIterator::BreakCache::populatePreceding(UErrorCode &status)
         }
 
         UBool segmentHandledByDictionary = FALSE;
-        if (fBI->fDictionaryCharCount != 0) {
+        if (fBI->fDictionaryCharCount != 0 && fBI->initDictionaryCache()) {
             // Segment from the rules includes dictionary characters.
             // Subdivide it, with subdivided results going into the dictionary cache.
             int32_t dictSegEndPosition = position;
@@ -118,6 +118,9 @@ void RBBIDataWrapper::init(const RBBIDataHeader *data, UErrorCode &status) {
     if (U_FAILURE(status)) {
         return;
     }
+    for (UChar32 c = 0; c < UPRV_LENGTHOF(fLatin1Categories); ++c) {
+        fLatin1Categories[c] = UTRIE2_GET16(fTrie, c);
+    }
 
     fRuleSource   = (UChar *)((char *)data + fHeader->fRuleSource);
     fRuleString.setTo(TRUE, fRuleSource, -1);
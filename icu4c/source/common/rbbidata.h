@@ -178,6 +178,18 @@ public:
 
     UTrie2             *fTrie;
 
+    /* Categories of U+0000..U+00FF, copied from fTrie.   */
+    /*   These are by far the most frequently looked up.  */
+    uint16_t            fLatin1Categories[0x100];
+
+    /**
+     * Get the character category of c, including the dictionary flag bit.
+     * @param c A code point, or U_SENTINEL.
+     */
+    inline uint16_t getCategory(UChar32 c) const {
+        return (uint32_t)c <= 0xff ? fLatin1Categories[c] : UTRIE2_GET16(fTrie, c);
+    }
+
 private:
     u_atomic_int32_t    fRefCount;
     UDataMemory        *fUDataMem;
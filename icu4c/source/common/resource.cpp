@@ -19,4 +19,10 @@ ResourceValue::~ResourceValue() {}
 
 ResourceSink::~ResourceSink() {}
 
+ResourceVisitor::~ResourceVisitor() {}
+
+UBool ResourceVisitor::acceptKey(const char * /*key*/) {
+    return TRUE;
+}
+
 U_NAMESPACE_END
@@ -34,6 +34,7 @@ struct ResourceData;
 U_NAMESPACE_BEGIN
 
 class ResourceValue;
+class ResourceVisitor;
 
 // Note: In C++, we use const char * pointers for keys,
 // rather than an abstraction like Java UResource.Key.
@@ -61,6 +62,17 @@ public:
      */
     UBool getValue(int32_t i, ResourceValue &value) const;
 
+    /**
+     * Calls visitor.visit(NULL, i, value) for each array item in order,
+     * reusing the value object and without creating a UResourceBundle per item.
+     *
+     * @param value Receives each item's value in turn.
+     * @param visitor Called for each item.
+     * @return TRUE if all items were visited,
+     *     FALSE if the visitor stopped early or errorCode indicates failure.
+     */
+    UBool visit(ResourceValue &value, ResourceVisitor &visitor, UErrorCode &errorCode) const;
+
     /** Only for implementation use. @internal */
     uint32_t internalGetResource(const ResourceData *pResData, int32_t i) const;
 
@@ -95,6 +107,28 @@ public:
      */
     UBool getKeyAndValue(int32_t i, const char *&key, ResourceValue &value) const;
 
+    /**
+     * Looks up a table item by key with a binary search.
+     *
+     * @param key Table item key.
+     * @param value Output-only, receives the value of the item with this key.
+     * @return TRUE if the table contains the key.
+     */
+    UBool findValue(const char *key, ResourceValue &value) const;
+
+    /**
+     * Calls visitor.visit(key, i, value) for each table item in key order
+     * whose key the visitor accepts,
+     * reusing the value object and without creating a UResourceBundle per item.
+     * The value of a rejected item is not read.
+     *
+     * @param value Receives each accepted item's value in turn.
+     * @param visitor Filters keys and is called for each accepted item.
+     * @return TRUE if all items were visited or skipped,
+     *     FALSE if the visitor stopped early or errorCode indicates failure.
+     */
+    UBool visit(ResourceValue &value, ResourceVisitor &visitor, UErrorCode &errorCode) const;
+
 private:
     const uint16_t *keys16;
     const int32_t *keys32;
@@ -274,6 +308,44 @@ private:
     ResourceSink &operator=(const ResourceSink &);  // no assignment operator
 };
 
+/**
+ * Visitor for the items of an array or table resource,
+ * see ResourceArray::visit(), ResourceTable::visit() and ures_visitItems().
+ * Unlike with a ResourceSink, table items can be skipped by key
+ * before their values are read, and the traversal can be stopped early.
+ * A visitor can traverse nested arrays and tables from its visit() method,
+ * reusing the value object.
+ */
+class U_COMMON_API ResourceVisitor : public UObject {
+public:
+    ResourceVisitor() {}
+    virtual ~ResourceVisitor();
+
+    /**
+     * Key filter for table items, called before the item's value is read.
+     * The default implementation accepts all keys.
+     *
+     * @param key Table item key.
+     * @return TRUE if visit() is to be called for this item.
+     */
+    virtual UBool acceptKey(const char *key);
+
+    /**
+     * Called for each array item and for each accepted table item.
+     *
+     * @param key Table item key, or NULL for an array item.
+     * @param index Array or table item index.
+     * @param value The item's value. Only valid until the next item is read into it.
+     * @return TRUE to continue, FALSE to stop the traversal.
+     */
+    virtual UBool visit(const char *key, int32_t index, ResourceValue &value,
+                        UErrorCode &errorCode) = 0;
+
+private:
+    ResourceVisitor(const ResourceVisitor &);  // no copy constructor
+    ResourceVisitor &operator=(const ResourceVisitor &);  // no assignment operator
+};
+
 U_NAMESPACE_END
 
 #endif
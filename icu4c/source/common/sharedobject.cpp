@@ -47,6 +47,11 @@ SharedObject::removeRef() const {
 }
 
 
+int32_t
+SharedObject::getMemoryFootprint() const {
+    return 0;
+}
+
 int32_t
 SharedObject::getRefCount() const {
     return umtx_loadAcquire(hardRefCount);
@@ -57,14 +57,16 @@ public:
     SharedObject() :
             softRefCount(0),
             hardRefCount(0),
-            cachePtr(NULL) {}
+            cachePtr(NULL),
+            cacheFootprint(0) {}
 
     /** Initializes totalRefCount, softRefCount to 0. */
     SharedObject(const SharedObject &other) :
             UObject(other),
             softRefCount(0),
             hardRefCount(0),
-            cachePtr(NULL) {}
+            cachePtr(NULL),
+            cacheFootprint(0) {}
 
     virtual ~SharedObject();
 
@@ -101,6 +103,15 @@ public:
      */
     inline UBool hasHardReferences() const { return getRefCount() != 0; }
 
+    /**
+     * Returns an estimate of the number of bytes of memory held by this object,
+     * including memory that it owns exclusively. Used for size-weighted cache
+     * eviction. The cache calls this when it adds the object, without holding
+     * its locks, and stores the result with the object.
+     * The default implementation returns 0, meaning unknown.
+     */
+    virtual int32_t getMemoryFootprint() const;
+
     /**
      * Deletes this object if it has no references.
      * Available for non-cached SharedObjects only. Ownership of cached objects
@@ -165,9 +176,10 @@ private:
      * The number of references from the UnifiedCache, which is
      * the number of times that the sharedObject is stored as a hash table value.
      * For use by UnifiedCache implementation code only.
-     * All access is synchronized by UnifiedCache's gCacheMutex
+     * Atomic, because keys in different stripes of the UnifiedCache
+     * may share the same value.
      */
-    mutable int32_t softRefCount;
+    mutable u_atomic_int32_t softRefCount;
     friend class UnifiedCache;
 
     /**
@@ -177,6 +189,12 @@ private:
     
     mutable const UnifiedCacheBase *cachePtr;
 
+    /**
+     * getMemoryFootprint() as of when the UnifiedCache added this object.
+     * For use by UnifiedCache implementation code only.
+     */
+    mutable int32_t cacheFootprint;
+
 };
 
 U_NAMESPACE_END
@@ -182,6 +182,33 @@ ubrk_close(UBreakIterator *bi)
     delete (BreakIterator *)bi;
 }
 
+U_CAPI UBreakIterator* U_EXPORT2
+ubrk_acquire(UBreakIteratorType type,
+             const char *locale,
+             const UChar *text,
+             int32_t textLength,
+             UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    BreakIterator *result = BreakIterator::acquireInstance(type, Locale(locale), *status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    UBreakIterator *uBI = (UBreakIterator *)result;
+    if (text != NULL) {
+        ubrk_setText(uBI, text, textLength, status);
+    }
+    return uBI;
+}
+
+U_CAPI void U_EXPORT2
+ubrk_release(UBreakIterator *bi)
+{
+    BreakIterator::releaseInstance((BreakIterator *)bi);
+}
+
 U_CAPI void U_EXPORT2
 ubrk_setText(UBreakIterator* bi,
              const UChar*    text,
@@ -319,6 +346,44 @@ ubrk_refreshUText(UBreakIterator *bi,
     bii->refreshInputText(text, *status);
 }
 
+U_CAPI int32_t U_EXPORT2
+ubrk_getAllBoundaries(UBreakIterator *bi,
+                      int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                      UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    if (bi == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    return ((BreakIterator*)bi)->getAllBoundaries(dest, ruleStatus, capacity, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ubrk_getAllBoundariesParallel(UBreakIterator *bi,
+                              int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                              int32_t maxTasks,
+                              UBreakIteratorRunner *runner, const void *runnerContext,
+                              UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    if (bi == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    BreakIterator *bii = reinterpret_cast<BreakIterator *>(bi);
+    RuleBasedBreakIterator *rbbi = dynamic_cast<RuleBasedBreakIterator *>(bii);
+    if (rbbi == NULL) {
+        return bii->getAllBoundaries(dest, ruleStatus, capacity, *status);
+    }
+    return rbbi->getAllBoundariesParallel(dest, ruleStatus, capacity,
+                                          maxTasks, runner, runnerContext, *status);
+}
+
 U_CAPI int32_t U_EXPORT2
 ubrk_getBinaryRules(UBreakIterator *bi,
                     uint8_t *       binaryRules, int32_t rulesCapacity,
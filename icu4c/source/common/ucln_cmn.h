@@ -35,6 +35,7 @@ typedef enum ECleanupCommonType {
     UCLN_COMMON_START = -1,
     UCLN_COMMON_NUMPARSE_UNISETS,
     UCLN_COMMON_USPREP,
+    UCLN_COMMON_BREAKITERATOR_POOL,
     UCLN_COMMON_BREAKITERATOR,
     UCLN_COMMON_RBBI,
     UCLN_COMMON_SERVICE,
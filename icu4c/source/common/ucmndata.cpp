@@ -211,6 +211,128 @@ pointerTOCPrefixBinarySearch(const char *s, const PointerTOCEntry *toc, int32_t
     return -1;
 }
 
+/*
+ * FNV-1a over the name bytes, with the high bits folded in
+ * because the table index uses only the low bits.
+ */
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCName(const char *name) {
+    uint32_t hash=0x811c9dc5;
+    uint8_t c;
+    while((c=(uint8_t)*name++)!=0) {
+        hash=(hash^c)*0x01000193;
+    }
+    return hash^(hash>>16);
+}
+
+U_CAPI uint32_t U_EXPORT2
+udata_checksumOffsetTOC(const UDataOffsetTOCEntry *entries, int32_t count) {
+    uint32_t checksum=0x811c9dc5;
+    int32_t i;
+    for(i=0; i<count; ++i) {
+        checksum=(checksum^entries[i].nameOffset)*0x01000193;
+        checksum=(checksum^entries[i].dataOffset)*0x01000193;
+    }
+    return checksum;
+}
+
+static int32_t
+offsetTOCHashSearch(const char *s, const char *names,
+                    const UDataOffsetTOCEntry *toc, const UDataTOCHash *hash) {
+    /* offsetTOCFindHash() checked that all slot values are in range. */
+    uint32_t slotCount=hash->slotCount;
+    uint32_t mask=slotCount-1;
+    uint32_t i=udata_hashTOCName(s)&mask;
+    for(uint32_t probes=0; probes<slotCount; ++probes) {
+        int32_t number=hash->slots[i];
+        if(number==UDATA_TOC_HASH_EMPTY) {
+            break;
+        }
+        if(uprv_strcmp(s, names+toc[number].nameOffset)==0) {
+            return number;
+        }
+        i=(i+1)&mask;
+    }
+    return -1;
+}
+
+/*
+ * Find the package's UDataTOCHash item and return it if it is valid for this TOC.
+ */
+static const UDataTOCHash *
+offsetTOCFindHash(const UDataOffsetTOC *toc) {
+    const char *base=(const char *)toc;
+    int32_t count=(int32_t)toc->count;
+    if(count<=0 || count>=UDATA_TOC_HASH_EMPTY) {
+        return NULL;
+    }
+
+    /* The hash item has the package prefix of the first item name. */
+    char name[64];
+    const char *firstName=base+toc->entry[0].nameOffset;
+    const char *prefixLimit=uprv_strchr(firstName, U_TREE_ENTRY_SEP_CHAR);
+    int32_t prefixLength;
+    if(prefixLimit==NULL ||
+            (prefixLength=(int32_t)(prefixLimit+1-firstName))+
+                (int32_t)sizeof(UDATA_TOC_HASH_ITEM_NAME)>(int32_t)sizeof(name)) {
+        return NULL;
+    }
+    uprv_memcpy(name, firstName, prefixLength);
+    uprv_strcpy(name+prefixLength, UDATA_TOC_HASH_ITEM_NAME);
+    int32_t number=offsetTOCPrefixBinarySearch(name, base, toc->entry, count);
+    if(number<0) {
+        return NULL;
+    }
+
+    const DataHeader *pHeader=(const DataHeader *)(base+toc->entry[number].dataOffset);
+    const UDataInfo *pInfo=&pHeader->info;
+    if(!(pHeader->dataHeader.magic1==0xda &&
+            pHeader->dataHeader.magic2==0x27 &&
+            pInfo->isBigEndian==U_IS_BIG_ENDIAN &&
+            pInfo->charsetFamily==U_CHARSET_FAMILY &&
+            pInfo->dataFormat[0]==0x54 &&   /* dataFormat="TocH" */
+            pInfo->dataFormat[1]==0x6f &&
+            pInfo->dataFormat[2]==0x63 &&
+            pInfo->dataFormat[3]==0x48 &&
+            pInfo->formatVersion[0]==1)) {
+        return NULL;
+    }
+    const UDataTOCHash *hash=
+        (const UDataTOCHash *)((const char *)pHeader+udata_getHeaderSize(pHeader));
+    uint32_t slotCount=hash->slotCount;
+    if(hash->itemCount!=(uint32_t)count ||
+            slotCount<=(uint32_t)count || slotCount>0x10000 || (slotCount&(slotCount-1))!=0) {
+        return NULL;
+    }
+    if((number+1)<count &&
+            (const char *)(hash->slots+slotCount)>base+toc->entry[number+1].dataOffset) {
+        return NULL;
+    }
+    if(hash->checksum!=udata_checksumOffsetTOC(toc->entry, count)) {
+        /* the TOC was changed without rebuilding the hash table */
+        return NULL;
+    }
+    /*
+     * Each slot must be empty or hold a valid TOC entry index,
+     * and there must be exactly one slot per item.
+     * Otherwise corrupt data could index past the TOC.
+     */
+    int32_t usedSlots=0;
+    for(uint32_t i=0; i<slotCount; ++i) {
+        int32_t slotValue=hash->slots[i];
+        if(slotValue!=UDATA_TOC_HASH_EMPTY) {
+            if(slotValue>=count) {
+                return NULL;
+            }
+            ++usedSlots;
+        }
+    }
+    if(usedSlots!=count) {
+        return NULL;
+    }
+    return hash;
+}
+
 U_CDECL_BEGIN
 static uint32_t U_CALLCONV
 offsetTOCEntryCount(const UDataMemory *pData) {
@@ -240,7 +362,11 @@ offsetTOCLookupFn(const UDataMemory *pData,
             fprintf(stderr, "\tx%d: %s\n", number, &base[toc->entry[number].nameOffset]);
         }
 #endif
-        number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        if(pData->tocHash!=NULL) {
+            number=offsetTOCHashSearch(tocEntryName, base, toc->entry, pData->tocHash);
+        } else {
+            number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        }
         if(number>=0) {
             /* found it */
             const UDataOffsetTOCEntry *entry=toc->entry+number;
@@ -347,6 +473,7 @@ U_CFUNC void udata_checkCommonData(UDataMemory *udm, UErrorCode *err) {
         /* dataFormat="CmnD" */
         udm->vFuncs = &CmnDFuncs;
         udm->toc=(const char *)udm->pHeader+udata_getHeaderSize(udm->pHeader);
+        udm->tocHash=offsetTOCFindHash((const UDataOffsetTOC *)udm->toc);
     }
     else if(udm->pHeader->info.dataFormat[0]==0x54 &&
         udm->pHeader->info.dataFormat[1]==0x6f &&
@@ -372,6 +499,35 @@ U_CFUNC void udata_checkCommonData(UDataMemory *udm, UErrorCode *err) {
     }
 }
 
+/*
+ * Returns the number of bytes from the start of the common data
+ * through the end of the header of its last item.
+ * Offset-TOC packages do not store their total length, and linked-in data
+ * has no file length, but the item headers are enough for advising the OS
+ * about the memory that item lookups will touch.
+ * Returns 0 if the extent is not known (pointer TOC).
+ */
+U_CFUNC int32_t udata_getCommonDataExtent(const UDataMemory *udm) {
+    if(udm==NULL || udm->pHeader==NULL) {
+        return 0;
+    }
+    if(udm->length>0) {
+        return udm->length;
+    }
+    if(udm->vFuncs==&CmnDFuncs && udm->toc!=NULL) {
+        const UDataOffsetTOC *toc=(const UDataOffsetTOC *)udm->toc;
+        const char *base=(const char *)toc;
+        if(toc->count==0) {
+            return (int32_t)(base+4-(const char *)udm->pHeader);
+        }
+        const DataHeader *last=
+            (const DataHeader *)(base+toc->entry[toc->count-1].dataOffset);
+        return (int32_t)((const char *)last+udata_getHeaderSize(last)-
+                         (const char *)udm->pHeader);
+    }
+    return 0;
+}
+
 /*
  * TODO: Add a udata_swapPackageHeader() function that swaps an ICU .dat package
  * header but not its sub-items.
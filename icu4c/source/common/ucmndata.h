@@ -59,6 +59,57 @@ typedef struct {
     UDataOffsetTOCEntry entry[1];
 } UDataOffsetTOC;
 
+/*
+ * Optional hash table for an offset TOC, for O(1) item lookup.
+ * It is stored as a package item named UDATA_TOC_HASH_ITEM_NAME
+ * (with the package prefix) with dataFormat "TocH" and formatVersion 1.
+ * Readers that do not know it see one more ordinary item.
+ *
+ * After the item's DataHeader:
+ *   uint32_t itemCount;  number of TOC entries that the table was built for
+ *   uint32_t checksum;   udata_checksumOffsetTOC() of those TOC entries
+ *   uint32_t slotCount;  a power of 2 larger than itemCount
+ *   uint32_t reserved;   0
+ *   uint16_t slots[slotCount];  TOC entry index, or UDATA_TOC_HASH_EMPTY
+ *
+ * An item name is looked up with linear probing from
+ * udata_hashTOCName(name)&(slotCount-1).
+ * A table whose itemCount or checksum does not match the TOC
+ * (for example, in a package modified by an older tool) is ignored.
+ */
+typedef struct {
+    uint32_t itemCount;
+    uint32_t checksum;
+    uint32_t slotCount;
+    uint32_t reserved;
+    /**
+     * Variable-length array declared with length 1 to disable bounds checkers.
+     * The actual array length is in the slotCount field.
+     */
+    uint16_t slots[1];
+} UDataTOCHash;
+
+#define UDATA_TOC_HASH_ITEM_NAME "tochash.icu"
+#define UDATA_TOC_HASH_EMPTY 0xffff
+
+/**
+ * Hash function for the item names in a UDataTOCHash.
+ * Hashes the bytes of the name as stored in the package.
+ *
+ * @internal
+ */
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCName(const char *name);
+
+/**
+ * Checksum over the name and data offsets of TOC entries
+ * (with platform-endian values) for validating a UDataTOCHash.
+ *
+ * @internal
+ */
+U_CAPI uint32_t U_EXPORT2
+udata_checksumOffsetTOC(const UDataOffsetTOCEntry *entries, int32_t count);
+
 /**
  * Get the header size from a const DataHeader *udh.
  * Handles opposite-endian data.
@@ -114,4 +165,10 @@ typedef struct {
  */
 U_CFUNC void udata_checkCommonData(UDataMemory *pData, UErrorCode *pErrorCode);
 
+/*
+ * Returns the number of bytes of a common data package that item lookups
+ * may touch, or 0 if that is not known.
+ */
+U_CFUNC int32_t udata_getCommonDataExtent(const UDataMemory *pData);
+
 #endif
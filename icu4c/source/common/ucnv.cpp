@@ -1835,7 +1835,356 @@ ucnv_toUChars(UConverter *cnv,
     return u_terminateUChars(originalDest, destCapacity, destLength, pErrorCode);
 }
 
-/* ucnv_getNextUChar() ------------------------------------------------------ */
+/* chunked conversion to Unicode -------------------------------------------- */
+
+/* how conversion to Unicode can be split for a converter */
+enum {
+    CHUNK_NONE,
+    CHUNK_ANY,
+    CHUNK_END_BYTES,
+    CHUNK_UTF8,
+    CHUNK_UTF16BE,
+    CHUNK_UTF16LE,
+    CHUNK_UTF32
+};
+
+static int32_t
+getChunkKind(const UConverter *cnv, UBool isEndByte[256]) {
+    switch(cnv->sharedData->staticData->conversionType) {
+    case UCNV_US_ASCII:
+    case UCNV_LATIN_1:
+        return CHUNK_ANY;
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+        /* .cnv files store SBCS and DBCS tables as UCNV_MBCS; handle the old types the same way */
+    case UCNV_MBCS:
+        /*
+         * Even an SBCS table can have multi-byte extension toUnicode mappings
+         * (e.g., ESC sequences in GSM 03.38), so always check the end bytes.
+         */
+        if(ucnv_MBCSGetChunkEndBytes(cnv->sharedData, isEndByte)) {
+            int32_t b;
+            for(b=0; b<=0xff && isEndByte[b]; ++b) {}
+            return b>0xff ? CHUNK_ANY : CHUNK_END_BYTES;
+        } else {
+            return CHUNK_NONE;
+        }
+#endif
+    case UCNV_UTF8:
+        return CHUNK_UTF8;
+    case UCNV_UTF16_BigEndian:
+        return CHUNK_UTF16BE;
+    case UCNV_UTF16_LittleEndian:
+        return CHUNK_UTF16LE;
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        return CHUNK_UTF32;
+    default:
+        return CHUNK_NONE;
+    }
+}
+
+/* Can conversion to Unicode be split before s[i]? 0<i<length */
+static UBool
+isChunkBoundary(int32_t kind, const UBool isEndByte[256],
+                const uint8_t *s, int32_t i, int32_t length) {
+    switch(kind) {
+    case CHUNK_ANY:
+        return TRUE;
+    case CHUNK_END_BYTES:
+        return isEndByte[s[i-1]];
+    case CHUNK_UTF8:
+        return !U8_IS_TRAIL(s[i]);
+    case CHUNK_UTF16BE:
+        /* not before a trail surrogate */
+        return (i&1)==0 && (s[i]&0xfc)!=0xdc;
+    case CHUNK_UTF16LE:
+        return (i&1)==0 && (i+1==length || (s[i+1]&0xfc)!=0xdc);
+    case CHUNK_UTF32:
+        return (i&3)==0;
+    default:
+        return FALSE;
+    }
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_getToUChunkLimits(const UConverter *cnv,
+                       const char *src, int32_t srcLength,
+                       int32_t maxChunks, int32_t limits[],
+                       UErrorCode *pErrorCode) {
+    UBool isEndByte[256];
+    const uint8_t *s=(const uint8_t *)src;
+    int32_t kind, count, start, i, k;
+
+    /* check arguments */
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    if( cnv==NULL ||
+        srcLength<-1 || (srcLength!=0 && src==NULL) ||
+        maxChunks<1 || limits==NULL)
+    {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    if(srcLength==-1) {
+        srcLength=(int32_t)uprv_strlen(src);
+    }
+    count=0;
+    kind=getChunkKind(cnv, isEndByte);
+    if(kind!=CHUNK_NONE) {
+        /* move each even split point forward to the next boundary */
+        start=0;
+        for(k=1; k<maxChunks; ++k) {
+            i=(int32_t)(((int64_t)srcLength*k)/maxChunks);
+            if(i<=start) {
+                i=start+1;
+            }
+            while(i<srcLength && !isChunkBoundary(kind, isEndByte, s, i, srcLength)) {
+                ++i;
+            }
+            if(i>=srcLength) {
+                break;
+            }
+            limits[count++]=start=i;
+        }
+    }
+    limits[count++]=srcLength;
+    return count;
+}
+
+/* one chunk for ucnv_toUCharsInChunks() */
+typedef struct UCnvToUChunk {
+    const UConverter *cnv;
+    const char *src;
+    int32_t srcStart, srcLimit;
+    /*
+     * Output buffers, initially a region of the caller's buffers if they are large enough.
+     * isOwned if they were allocated.
+     */
+    UChar *dest;
+    int32_t *offsets;
+    int32_t capacity, length;
+    UBool withOffsets, isOwned;
+    UErrorCode errorCode;
+} UCnvToUChunk;
+
+/* replaces the chunk output buffers with new ones; does not copy their contents */
+static UBool
+allocChunk(UCnvToUChunk *chunk, int32_t capacity) {
+    UChar *newDest;
+    int32_t *newOffsets=NULL;
+
+    newDest=(UChar *)uprv_malloc(capacity*U_SIZEOF_UCHAR);
+    if(chunk->withOffsets) {
+        newOffsets=(int32_t *)uprv_malloc(capacity*sizeof(int32_t));
+    }
+    if(newDest==NULL || (chunk->withOffsets && newOffsets==NULL)) {
+        uprv_free(newDest);
+        uprv_free(newOffsets);
+        return FALSE;
+    }
+    if(chunk->isOwned) {
+        uprv_free(chunk->dest);
+        uprv_free(chunk->offsets);
+    }
+    chunk->dest=newDest;
+    chunk->offsets=newOffsets;
+    chunk->capacity=capacity;
+    chunk->isOwned=TRUE;
+    return TRUE;
+}
+
+static void U_CALLCONV
+toUChunkTask(void *context, int32_t index) {
+    UCnvToUChunk *chunk=(UCnvToUChunk *)context+index;
+    UErrorCode *pErrorCode=&chunk->errorCode;
+    UConverter *clone;
+    const char *s;
+    UChar *d;
+    int32_t i;
+
+    clone=ucnv_safeClone(chunk->cnv, NULL, NULL, pErrorCode);
+    if(U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    *pErrorCode=U_ZERO_ERROR;  /* ignore U_SAFECLONE_ALLOCATED_WARNING */
+
+    /* most charsets yield at most one UChar per byte; grow for callback output etc. */
+    if(chunk->dest==NULL && !allocChunk(chunk, chunk->srcLimit-chunk->srcStart+16)) {
+        *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+    }
+    while(U_SUCCESS(*pErrorCode)) {
+        /*
+         * Convert the whole chunk in one call:
+         * Output that was held back in the converter on overflow would get offsets of -1.
+         */
+        ucnv_resetToUnicode(clone);
+        s=chunk->src+chunk->srcStart;
+        d=chunk->dest;
+        ucnv_toUnicode(clone, &d, chunk->dest+chunk->capacity, &s, chunk->src+chunk->srcLimit,
+                       chunk->offsets, TRUE, pErrorCode);
+        chunk->length=(int32_t)(d-chunk->dest);
+        if(*pErrorCode!=U_BUFFER_OVERFLOW_ERROR) {
+            break;
+        }
+        *pErrorCode=U_ZERO_ERROR;
+        if(!allocChunk(chunk, 2*chunk->capacity)) {
+            *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+        }
+    }
+    if(U_SUCCESS(*pErrorCode) && chunk->withOffsets && chunk->srcStart>0) {
+        /* ucnv_toUnicode() offsets are relative to the chunk start */
+        for(i=0; i<chunk->length; ++i) {
+            if(chunk->offsets[i]>=0) {
+                chunk->offsets[i]+=chunk->srcStart;
+            }
+        }
+    }
+    ucnv_close(clone);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_toUCharsInChunks(const UConverter *cnv,
+                      UChar *dest, int32_t destCapacity, int32_t *offsets,
+                      const char *src, int32_t srcLength,
+                      int32_t maxChunks,
+                      UConverterChunkRunner *runner, const void *runnerContext,
+                      UErrorCode *pErrorCode) {
+    int32_t stackLimits[16];
+    int32_t *limits;
+    UCnvToUChunk *chunks;
+    UBool inPlace;
+    int32_t count, destLength, i, n;
+
+    /* check arguments */
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    if( cnv==NULL ||
+        destCapacity<0 || (destCapacity>0 && dest==NULL) ||
+        srcLength<-1 || (srcLength!=0 && src==NULL) ||
+        maxChunks<1)
+    {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    if(srcLength==-1) {
+        srcLength=(int32_t)uprv_strlen(src);
+    }
+    if(maxChunks<=UPRV_LENGTHOF(stackLimits)) {
+        limits=stackLimits;
+    } else {
+        limits=(int32_t *)uprv_malloc(maxChunks*sizeof(int32_t));
+        if(limits==NULL) {
+            *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+            return 0;
+        }
+    }
+    count=ucnv_getToUChunkLimits(cnv, src, srcLength, maxChunks, limits, pErrorCode);
+    chunks=(UCnvToUChunk *)uprv_malloc(count*sizeof(UCnvToUChunk));
+    if(U_SUCCESS(*pErrorCode) && chunks==NULL) {
+        *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+    }
+    if(U_FAILURE(*pErrorCode)) {
+        uprv_free(chunks);
+        if(limits!=stackLimits) {
+            uprv_free(limits);
+        }
+        return 0;
+    }
+    /*
+     * If the caller's buffers are large enough, then each chunk starts writing
+     * into its own region of them, at its source start index plus 16 per previous chunk.
+     */
+    inPlace=(UBool)(destCapacity>=srcLength+16*count);
+    uprv_memset(chunks, 0, count*sizeof(UCnvToUChunk));
+    for(i=0; i<count; ++i) {
+        UCnvToUChunk *chunk=chunks+i;
+        chunk->cnv=cnv;
+        chunk->src=src;
+        chunk->srcStart= i==0 ? 0 : limits[i-1];
+        chunk->srcLimit=limits[i];
+        chunk->withOffsets=(UBool)(offsets!=NULL);
+        if(inPlace) {
+            n=chunk->srcStart+16*i;
+            chunk->dest=dest+n;
+            chunk->offsets= offsets!=NULL ? offsets+n : NULL;
+            chunk->capacity=chunk->srcLimit-chunk->srcStart+16;
+        }
+    }
+    if(limits!=stackLimits) {
+        uprv_free(limits);
+    }
+
+    /* convert */
+    if(runner!=NULL && count>1) {
+        runner(runnerContext, toUChunkTask, chunks, count);
+    } else {
+        for(i=0; i<count; ++i) {
+            toUChunkTask(chunks, i);
+        }
+    }
+
+    /* concatenate */
+    destLength=0;
+    for(i=0; i<count; ++i) {
+        UCnvToUChunk *chunk=chunks+i;
+        if(U_FAILURE(chunk->errorCode)) {
+            if(U_SUCCESS(*pErrorCode)) {
+                *pErrorCode=chunk->errorCode;
+            }
+        } else if(!chunk->isOwned && destLength>(int32_t)(chunk->dest-dest)) {
+            /*
+             * An earlier chunk grew beyond its region, and this one would be moved up.
+             * Move it out of the way first.
+             */
+            UChar *oldDest=chunk->dest;
+            int32_t *oldOffsets=chunk->offsets;
+            if(allocChunk(chunk, chunk->length+1)) {
+                uprv_memcpy(chunk->dest, oldDest, chunk->length*U_SIZEOF_UCHAR);
+                if(offsets!=NULL) {
+                    uprv_memcpy(chunk->offsets, oldOffsets, chunk->length*sizeof(int32_t));
+                }
+            } else {
+                *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+            }
+        }
+        destLength+=chunk->length;
+    }
+    destLength=0;
+    for(i=0; i<count; ++i) {
+        UCnvToUChunk *chunk=chunks+i;
+        if(U_SUCCESS(*pErrorCode)) {
+            n=chunk->length;
+            if(n>destCapacity-destLength) {
+                n=destCapacity-destLength;
+            }
+            if(n>0 && chunk->dest!=dest+destLength) {
+                /* in-place chunks only move down */
+                uprv_memmove(dest+destLength, chunk->dest, n*U_SIZEOF_UCHAR);
+                if(offsets!=NULL) {
+                    uprv_memmove(offsets+destLength, chunk->offsets, n*sizeof(int32_t));
+                }
+            }
+            destLength+=chunk->length;
+        }
+        if(chunk->isOwned) {
+            uprv_free(chunk->dest);
+            uprv_free(chunk->offsets);
+        }
+    }
+    uprv_free(chunks);
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    return u_terminateUChars(dest, destCapacity, destLength, pErrorCode);
+}
 
 U_CAPI UChar32 U_EXPORT2
 ucnv_getNextUChar(UConverter *cnv,
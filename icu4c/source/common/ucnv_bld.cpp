@@ -45,6 +45,7 @@
 #include "cmemory.h"
 #include "ucln_cmn.h"
 #include "ustr_cnv.h"
+#include "ustr_imp.h"
 
 
 #if 0
@@ -195,8 +196,51 @@ static struct {
 /*initializes some global variables */
 static UHashtable *SHARED_DATA_HASHTABLE = NULL;
 static UMutex cnvCacheMutex = U_MUTEX_INITIALIZER;  /* Mutex for synchronizing cnv cache access. */
-                                                    /*  Note:  the global mutex is used for      */
-                                                    /*         reference count updates.          */
+                                                    /*  Note:  reference counts are updated      */
+                                                    /*         atomically, see refCount().       */
+
+/*
+ * Lock-free lookup of cached shared data.
+ *
+ * Shared data in SHARED_DATA_HASHTABLE is also published in a small direct-mapped
+ * table which ucnv_loadSharedData() reads without locking cnvCacheMutex.
+ * A slot is only written while cnvCacheMutex is held and the slot is empty;
+ * its sharedData becomes visible with a release-store of isSet.
+ * Each slot counts the lookups in progress, so that ucnv_flushCache()
+ * can empty the slots and then wait for those lookups to finish
+ * before it deletes any shared data.
+ */
+#define UCNV_FAST_CACHE_SIZE 64
+
+typedef struct UConverterCacheSlot {
+    icu::u_atomic_int32_t isSet;
+    icu::u_atomic_int32_t readers;
+    UConverterSharedData *sharedData;
+} UConverterCacheSlot;
+
+static UConverterCacheSlot gFastCache[UCNV_FAST_CACHE_SIZE];
+
+/*
+ * Pool of reset converters for ucnv_acquire() and ucnv_release().
+ * Each slot is claimed with an atomic try-lock; the pool lookup never blocks.
+ * The key is the canonical converter name followed by the options string
+ * that was passed to ucnv_acquire(). ucnv_acquire() stores it in
+ * UConverter.poolKey, and ucnv_release() pools the converter under it.
+ * ucnv_getName() cannot serve as the key: It omits the options of converters
+ * without a getName() implementation, for example the LMBCS locale.
+ * The key hash is readable without claiming the slot, so that a lookup
+ * only claims slots which may hold a matching converter.
+ */
+#define UCNV_POOL_SIZE 32
+#define UCNV_POOL_NAME_CAPACITY UCNV_MAX_CONVERTER_NAME_LENGTH
+
+typedef struct UConverterPoolSlot {
+    icu::u_atomic_int32_t lock;
+    icu::u_atomic_int32_t hash;      /* 0 if empty */
+    UConverter *cnv;
+} UConverterPoolSlot;
+
+static UConverterPoolSlot gConverterPool[UCNV_POOL_SIZE];
 
 static const char **gAvailableConverters = NULL;
 static uint16_t gAvailableConverterCount = 0;
@@ -282,6 +326,15 @@ isCnvAcceptable(void * /*context*/,
         pInfo->formatVersion[0]==6);  /* Everything will be version 6 */
 }
 
+/*
+ * The reference counter is a plain uint32_t so that UConverterSharedData can
+ * be statically initialized and copied; all changes to it are atomic.
+ */
+static inline icu::u_atomic_int32_t *
+refCount(UConverterSharedData *sharedData) {
+    return (icu::u_atomic_int32_t *)&sharedData->referenceCounter;
+}
+
 /**
  * Un flatten shared data from a UDATA..
  */
@@ -497,6 +550,64 @@ ucnv_getSharedConverterData(const char *name)
     }
 }
 
+static inline UConverterCacheSlot *
+getFastCacheSlot(const char *name) {
+    return gFastCache +
+        (ustr_hashCharsN(name, (int32_t)uprv_strlen(name)) & (UCNV_FAST_CACHE_SIZE - 1));
+}
+
+/*  Publish cached shared data for lock-free lookup if its slot is still empty. */
+/*    cnvCacheMutex must be held by the caller.                                */
+static void
+ucnv_publishSharedConverterData(UConverterSharedData *data)
+{
+    UConverterCacheSlot *slot = getFastCacheSlot(data->staticData->name);
+    if (icu::umtx_loadAcquire(slot->isSet) == 0) {
+        slot->sharedData = data;
+        icu::umtx_storeRelease(slot->isSet, 1);
+    }
+}
+
+/*  Look up a converter name in the published shared data, without locking. */
+/*    Returns the shared data with its reference counter incremented,        */
+/*    or NULL if it is not published.                                        */
+static UConverterSharedData *
+ucnv_getPublishedConverterData(const char *name)
+{
+    UConverterCacheSlot *slot = getFastCacheSlot(name);
+    UConverterSharedData *rc = NULL;
+
+    icu::umtx_atomic_inc(&slot->readers);
+    if (icu::umtx_loadAcquire(slot->isSet) != 0 &&
+            uprv_strcmp(slot->sharedData->staticData->name, name) == 0) {
+        rc = slot->sharedData;
+        icu::umtx_atomic_inc(refCount(rc));
+    }
+    icu::umtx_atomic_dec(&slot->readers);
+    return rc;
+}
+
+/*  Empty all slots and wait for lock-free lookups that are in progress.     */
+/*    cnvCacheMutex must be held by the caller.                              */
+/*    Afterwards, shared data with a zero reference count can be deleted.    */
+static void
+ucnv_unpublishSharedConverterData()
+{
+    int32_t i;
+    for (i = 0; i < UCNV_FAST_CACHE_SIZE; ++i) {
+        UConverterCacheSlot *slot = gFastCache + i;
+        icu::umtx_storeRelease(slot->isSet, 0);
+        /*
+         * The read-modify-write orders the isSet store before reading the
+         * number of readers: A lookup that starts later sees the empty slot,
+         * and one that started earlier is counted until it is done.
+         */
+        icu::umtx_atomic_inc(&slot->readers);
+        icu::umtx_atomic_dec(&slot->readers);
+        while (icu::umtx_loadAcquire(slot->readers) != 0) {}
+    }
+}
+
 /*frees the string of memory blocks associates with a sharedConverter
  *if and only if the referenceCounter == 0
  */
@@ -514,7 +625,7 @@ ucnv_deleteSharedConverterData(UConverterSharedData * deadSharedData)
     UTRACE_ENTRY_OC(UTRACE_UCNV_UNLOAD);
     UTRACE_DATA2(UTRACE_OPEN_CLOSE, "unload converter %s shared data %p", deadSharedData->staticData->name, deadSharedData);
 
-    if (deadSharedData->referenceCounter > 0) {
+    if (icu::umtx_loadAcquire(*refCount(deadSharedData)) > 0) {
         UTRACE_EXIT_VALUE((int32_t)FALSE);
         return FALSE;
     }
@@ -565,13 +676,15 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
         {
             /* share it with other library clients */
             ucnv_shareConverterData(mySharedConverterData);
+            ucnv_publishSharedConverterData(mySharedConverterData);
         }
     }
     else
     {
         /* The data for this converter was already in the cache.            */
         /* Update the reference counter on the shared data: one more client */
-        mySharedConverterData->referenceCounter++;
+        icu::umtx_atomic_inc(refCount(mySharedConverterData));
+        ucnv_publishSharedConverterData(mySharedConverterData);
     }
 
     return mySharedConverterData;
@@ -585,11 +698,12 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
 U_CAPI void
 ucnv_unload(UConverterSharedData *sharedData) {
     if(sharedData != NULL) {
-        if (sharedData->referenceCounter > 0) {
-            sharedData->referenceCounter--;
+        int32_t count = icu::umtx_loadAcquire(*refCount(sharedData));
+        if (count > 0) {
+            count = icu::umtx_atomic_dec(refCount(sharedData));
         }
 
-        if((sharedData->referenceCounter <= 0)&&(sharedData->sharedDataCached == FALSE)) {
+        if((count <= 0)&&(sharedData->sharedDataCached == FALSE)) {
             ucnv_deleteSharedConverterData(sharedData);
         }
     }
@@ -599,19 +713,23 @@ U_CFUNC void
 ucnv_unloadSharedDataIfReady(UConverterSharedData *sharedData)
 {
     if(sharedData != NULL && sharedData->isReferenceCounted) {
-        umtx_lock(&cnvCacheMutex);
-        ucnv_unload(sharedData);
-        umtx_unlock(&cnvCacheMutex);
+        if(sharedData->sharedDataCached) {
+            /* Cached shared data is only deleted by ucnv_flushCache(). */
+            icu::umtx_atomic_dec(refCount(sharedData));
+        } else {
+            umtx_lock(&cnvCacheMutex);
+            ucnv_unload(sharedData);
+            umtx_unlock(&cnvCacheMutex);
+        }
     }
 }
 
 U_CFUNC void
 ucnv_incrementRefCount(UConverterSharedData *sharedData)
 {
+    /* The caller holds a reference, so the shared data cannot be deleted concurrently. */
     if(sharedData != NULL && sharedData->isReferenceCounted) {
-        umtx_lock(&cnvCacheMutex);
-        sharedData->referenceCounter++;
-        umtx_unlock(&cnvCacheMutex);
+        icu::umtx_atomic_inc(refCount(sharedData));
     }
 }
 
@@ -805,6 +923,11 @@ ucnv_loadSharedData(const char *converterName,
     if (mySharedConverterData == NULL)
     {
         /* it is a data-based converter, get its shared data.               */
+        /* Try the lock-free lookup of cached shared data first.            */
+        mySharedConverterData = ucnv_getPublishedConverterData(pArgs->name);
+    }
+    if (mySharedConverterData == NULL)
+    {
         /* Hold the cnvCacheMutex through the whole process of checking the */
         /*   converter data cache, and adding new entries to the cache      */
         /*   to prevent other threads from modifying the cache during the   */
@@ -1025,6 +1148,177 @@ ucnv_createConverterFromSharedData(UConverter *myUConverter,
     return myUConverter;
 }
 
+/* Converter pool for ucnv_acquire() and ucnv_release() ---------------------- */
+
+static inline UBool
+tryLockPoolSlot(UConverterPoolSlot *slot) {
+    if (icu::umtx_atomic_inc(&slot->lock) == 1) {
+        return TRUE;
+    }
+    icu::umtx_atomic_dec(&slot->lock);
+    return FALSE;
+}
+
+static inline void
+unlockPoolSlot(UConverterPoolSlot *slot) {
+    icu::umtx_atomic_dec(&slot->lock);
+}
+
+/* Never 0, which marks an empty slot. */
+static inline int32_t
+getPoolHash(const char *name, int32_t length) {
+    return ustr_hashCharsN(name, length) | 1;
+}
+
+/*
+ * Writes the pool key for converterName: the canonical name, followed by the options.
+ * Returns the key length, or -1 if the name cannot be resolved here
+ * or is too long for the pool.
+ */
+static int32_t
+getPoolKey(const char *converterName, char *key) {
+    UConverterNamePieces pieces;
+    UConverterLoadArgs args=UCNV_LOAD_ARGS_INITIALIZER;
+    UErrorCode errorCode = U_ZERO_ERROR;
+    const char *name, *options;
+    int32_t nameLength, optionsLength;
+    UBool mayContainOption = TRUE;
+
+    if (converterName == NULL) {
+        name = ucnv_getDefaultName();
+        options = "";
+    } else if (UCNV_FAST_IS_UTF8(converterName)) {
+        name = "UTF-8";
+        options = "";
+    } else {
+        pieces.cnvName[0] = 0;
+        pieces.locale[0] = 0;
+        pieces.options = 0;
+        parseConverterOptions(converterName, &pieces, &args, &errorCode);
+        if (U_FAILURE(errorCode)) {
+            return -1;
+        }
+        name = ucnv_io_getConverterName(pieces.cnvName, &mayContainOption, &errorCode);
+        if (U_FAILURE(errorCode) || name == NULL) {
+            name = pieces.cnvName;
+        }
+        options = converterName + uprv_strlen(pieces.cnvName);
+    }
+    if (name == NULL) {
+        return -1;
+    }
+    nameLength = (int32_t)uprv_strlen(name);
+    optionsLength = (int32_t)uprv_strlen(options);
+    if ((nameLength + optionsLength) >= UCNV_POOL_NAME_CAPACITY) {
+        return -1;
+    }
+    uprv_memcpy(key, name, nameLength);
+    uprv_memcpy(key + nameLength, options, optionsLength + 1);
+    return nameLength + optionsLength;
+}
+
+U_CAPI UConverter * U_EXPORT2
+ucnv_acquire(const char *converterName, UErrorCode *err) {
+    char key[UCNV_POOL_NAME_CAPACITY];
+    int32_t length, hash, i, start;
+
+    if (err == NULL || U_FAILURE(*err)) {
+        return NULL;
+    }
+
+    length = getPoolKey(converterName, key);
+    if (length >= 0) {
+        hash = getPoolHash(key, length);
+        start = hash & (UCNV_POOL_SIZE - 1);
+        for (i = 0; i < UCNV_POOL_SIZE; ++i) {
+            UConverterPoolSlot *slot = gConverterPool + ((start + i) & (UCNV_POOL_SIZE - 1));
+            if (icu::umtx_loadAcquire(slot->hash) == hash && tryLockPoolSlot(slot)) {
+                UConverter *cnv = NULL;
+                if (icu::umtx_loadAcquire(slot->hash) == hash && uprv_strcmp(slot->cnv->poolKey, key) == 0) {
+                    cnv = slot->cnv;
+                    slot->cnv = NULL;
+                    icu::umtx_storeRelease(slot->hash, 0);
+                }
+                unlockPoolSlot(slot);
+                if (cnv != NULL) {
+                    return cnv;
+                }
+            }
+        }
+    }
+    UConverter *cnv = ucnv_open(converterName, err);
+    if (cnv != NULL && length >= 0) {
+        uprv_memcpy(cnv->poolKey, key, length + 1);
+    }
+    return cnv;
+}
+
+U_CAPI void U_EXPORT2
+ucnv_release(UConverter *cnv) {
+    int32_t length, hash, i, start;
+
+    if (cnv == NULL) {
+        return;
+    }
+
+    /*
+     * Only pool a converter that has a key from ucnv_acquire(),
+     * and that ucnv_reset() returns to the state of a newly opened one:
+     * default callbacks and substitution character, and no fallbacks.
+     */
+    if (cnv->poolKey[0] != 0 && !cnv->isCopyLocal &&
+            cnv->fromCharErrorBehaviour == UCNV_TO_U_DEFAULT_CALLBACK &&
+            cnv->fromUCharErrorBehaviour == UCNV_FROM_U_DEFAULT_CALLBACK &&
+            cnv->toUContext == NULL && cnv->fromUContext == NULL &&
+            !cnv->useFallback && !cnv->useSubChar1 &&
+            cnv->subChars == (uint8_t *)cnv->subUChars &&
+            cnv->subCharLen == cnv->sharedData->staticData->subCharLen &&
+            cnv->subChar1 == cnv->sharedData->staticData->subChar1 &&
+            (cnv->subCharLen <= 0 ||
+                uprv_memcmp(cnv->subChars, cnv->sharedData->staticData->subChar, cnv->subCharLen) == 0)) {
+        ucnv_reset(cnv);
+        length = (int32_t)uprv_strlen(cnv->poolKey);
+        hash = getPoolHash(cnv->poolKey, length);
+        start = hash & (UCNV_POOL_SIZE - 1);
+        for (i = 0; i < UCNV_POOL_SIZE; ++i) {
+            UConverterPoolSlot *slot = gConverterPool + ((start + i) & (UCNV_POOL_SIZE - 1));
+            if (icu::umtx_loadAcquire(slot->hash) == 0 && tryLockPoolSlot(slot)) {
+                if (icu::umtx_loadAcquire(slot->hash) == 0) {
+                    slot->cnv = cnv;
+                    icu::umtx_storeRelease(slot->hash, hash);
+                    cnv = NULL;
+                }
+                unlockPoolSlot(slot);
+                if (cnv == NULL) {
+                    return;
+                }
+            }
+        }
+    }
+    /* not poolable, or the pool is full */
+    ucnv_close(cnv);
+}
+
+/* Closes all pooled converters. */
+static void
+ucnv_flushConverterPool() {
+    int32_t i;
+    for (i = 0; i < UCNV_POOL_SIZE; ++i) {
+        UConverterPoolSlot *slot = gConverterPool + i;
+        UConverter *cnv = NULL;
+        if (icu::umtx_loadAcquire(slot->hash) != 0) {
+            while (!tryLockPoolSlot(slot)) {}
+            if (icu::umtx_loadAcquire(slot->hash) != 0) {
+                cnv = slot->cnv;
+                slot->cnv = NULL;
+                icu::umtx_storeRelease(slot->hash, 0);
+            }
+            unlockPoolSlot(slot);
+            ucnv_close(cnv);
+        }
+    }
+}
+
 /*Frees all shared immutable objects that aren't referred to (reference count = 0)
  */
 U_CAPI int32_t U_EXPORT2
@@ -1042,6 +1336,9 @@ ucnv_flushCache ()
     /* Close the default converter without creating a new one so that everything will be flushed. */
     u_flushDefaultConverter();
 
+    /* Close the pooled converters so that their shared data can be flushed. */
+    ucnv_flushConverterPool();
+
     /*if shared data hasn't even been lazy evaluated yet
     * return 0
     */
@@ -1059,9 +1356,11 @@ ucnv_flushCache ()
     *                   ucnv_close while the iteration is in process, but this is
     *                   benign.  It can't be incremented (in ucnv_createConverter())
     *                   because the sequence of looking up in the cache + incrementing
-    *                   is protected by cnvCacheMutex.
+    *                   is protected by cnvCacheMutex, and the lock-free lookup
+    *                   is disabled while the mutex is held here.
     */
     umtx_lock(&cnvCacheMutex);
+    ucnv_unpublishSharedConverterData();
     /*
      * double loop: A delta/extension-only converter has a pointer to its base table's
      * shared data; the first iteration of the outer loop may see the delta converter
@@ -1076,7 +1375,7 @@ ucnv_flushCache ()
         {
             mySharedData = (UConverterSharedData *) e->value.pointer;
             /*deletes only if reference counter == 0 */
-            if (mySharedData->referenceCounter == 0)
+            if (icu::umtx_loadAcquire(*refCount(mySharedData)) == 0)
             {
                 tableDeletedNum++;
 
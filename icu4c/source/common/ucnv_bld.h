@@ -238,6 +238,9 @@ struct UConverter {
 
     /* new fields for ICU 4.0 */
     UConverterCallbackReason toUCallbackReason; /* (*fromCharErrorBehaviour) reason, set when error is detected */
+
+    /* new fields for ICU 63 */
+    char poolKey[UCNV_MAX_CONVERTER_NAME_LENGTH]; /* ucnv_acquire() pool key; empty if not poolable */
 };
 
 U_CDECL_END /* end of UConverter */
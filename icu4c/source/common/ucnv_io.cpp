@@ -45,6 +45,7 @@
 #include "ucnv_io.h"
 #include "uenumimp.h"
 #include "ucln_cmn.h"
+#include "uinvchar.h"
 
 /* Format of cnvalias.icu -----------------------------------------------------
  *
@@ -115,6 +116,15 @@
  * and all strings lowercased. In the future, the options in section 7 may state
  * other types of normalization.
  *
+ * 10) Starting in ICU 63, when present this is a perfect hash of the normalized
+ * alias names in section 3, so that an alias can be found without a binary search.
+ * It contains the number of buckets B, the number of slots S, B displacement
+ * values, and S indexes into section 3 (0xffff for an empty slot).
+ * A normalized name is in the bucket ucnv_io_hashNormalizedName(name, 0)%B,
+ * and in the slot ucnv_io_hashNormalizedName(name, displacement)%S.
+ * The hash is computed over the ASCII form of the name, so that only the
+ * section 3 indexes change when the strings are swapped to another charset family.
+ *
  * Here is the concept of section 5 and 6. It's a 3D cube. Each tag
  * has a unique alias among all converters. That same alias can
  * be mentioned in other standards on different converters,
@@ -188,6 +198,7 @@ enum {
     tableOptionsIndex=7,
     stringTableIndex=8,
     normalizedStringTableIndex=9,
+    aliasHashIndex=10,
     offsetsCount,    /* length of the swapper's temporary offsets[] */
     minTocLength=8 /* min. tocLength in the file, does not count the tocLengthIndex! */
 };
@@ -267,6 +278,9 @@ static void U_CALLCONV initAliasData(UErrorCode &errCode) {
     if (tableStart > 8) {
         gMainTable.normalizedStringTableSize = sectionSizes[9];
     }
+    if (tableStart > 9) {
+        gMainTable.aliasHashSize = sectionSizes[10];
+    }
 
     currOffset = tableStart * (sizeof(uint32_t)/sizeof(uint16_t)) + (sizeof(uint32_t)/sizeof(uint16_t));
     gMainTable.converterList = table + currOffset;
@@ -306,6 +320,17 @@ static void U_CALLCONV initAliasData(UErrorCode &errCode) {
     currOffset += gMainTable.stringTableSize;
     gMainTable.normalizedStringTable = ((gMainTable.optionTable->stringNormalizationType == UCNV_IO_UNNORMALIZED)
         ? gMainTable.stringTable : (table + currOffset));
+
+    currOffset += gMainTable.normalizedStringTableSize;
+    gMainTable.aliasHash = table + currOffset;
+    if (gMainTable.optionTable->stringNormalizationType == UCNV_IO_UNNORMALIZED
+        || gMainTable.aliasHashSize < 2 || gMainTable.aliasHash[0] == 0
+        || gMainTable.aliasHashSize != 2 + (uint32_t)gMainTable.aliasHash[0] + gMainTable.aliasHash[1])
+    {
+        /* No usable hash, use the binary search. */
+        gMainTable.aliasHash = NULL;
+        gMainTable.aliasHashSize = 0;
+    }
 }
 
 
@@ -453,6 +478,23 @@ ucnv_io_stripEBCDICForCompare(char *dst, const char *name) {
     return dst;
 }
 
+/* @see ucnv_io_hashNormalizedName in ucnv_io.h */
+U_CAPI uint32_t U_CALLCONV
+ucnv_io_hashNormalizedName(const char *name, uint32_t seed) {
+    /* FNV-1a, with the seed mixed into the offset basis */
+    uint32_t hash = 0x811c9dc5 ^ (seed * 0x9e3779b9);
+    uint8_t c;
+
+    while ((c = (uint8_t)*name++) != 0) {
+#if U_CHARSET_FAMILY==U_EBCDIC_FAMILY
+        /* hash the ASCII form so that the hash survives ucnv_swapAliases() */
+        c = (uint8_t)uprv_ebcdicToLowercaseAscii((char)c);
+#endif
+        hash = (hash ^ c) * 0x01000193;
+    }
+    return hash ^ (hash >> 16);
+}
+
 /**
  * Do a fuzzy compare of two converter/alias names.
  * The comparison is case-insensitive, ignores leading zeroes if they are not
@@ -544,6 +586,26 @@ ucnv_compareNames(const char *name1, const char *name2) {
     }
 }
 
+/*
+ * Look up a normalized alias in the perfect hash.
+ * return the index for gMainTable.aliasList, or UINT32_MAX if it is not an alias
+ */
+static inline uint32_t
+findHashedAlias(const char *normalizedAlias) {
+    const uint16_t *aliasHash = gMainTable.aliasHash;
+    uint32_t bucketCount = aliasHash[0];
+    uint32_t slotCount = aliasHash[1];
+    uint32_t displacement = aliasHash[2 + ucnv_io_hashNormalizedName(normalizedAlias, 0) % bucketCount];
+    uint32_t idx = aliasHash[2 + bucketCount + ucnv_io_hashNormalizedName(normalizedAlias, displacement) % slotCount];
+
+    if (idx < gMainTable.untaggedConvArraySize
+        && uprv_strcmp(normalizedAlias, GET_NORMALIZED_STRING(gMainTable.aliasList[idx])) == 0)
+    {
+        return idx;
+    }
+    return UINT32_MAX;
+}
+
 /*
  * search for an alias
  * return the converter number index for gConverterList
@@ -567,50 +629,58 @@ findConverter(const char *alias, UBool *containsOption, UErrorCode *pErrorCode)
         alias = strippedName;
     }
 
-    /* do a binary search for the alias */
-    start = 0;
-    limit = gMainTable.untaggedConvArraySize;
-    mid = limit;
-    lastMid = UINT32_MAX;
-
-    for (;;) {
-        mid = (uint32_t)((start + limit) / 2);
-        if (lastMid == mid) {   /* Have we moved? */
-            break;  /* We haven't moved, and it wasn't found. */
-        }
-        lastMid = mid;
-        if (isUnnormalized) {
-            result = ucnv_compareNames(alias, GET_STRING(gMainTable.aliasList[mid]));
-        }
-        else {
-            result = uprv_strcmp(alias, GET_NORMALIZED_STRING(gMainTable.aliasList[mid]));
+    if (gMainTable.aliasHash != NULL) {
+        /* The hash is only built over normalized strings. */
+        mid = findHashedAlias(alias);
+        if (mid == UINT32_MAX) {
+            return UINT32_MAX;
         }
-
-        if (result < 0) {
-            limit = mid;
-        } else if (result > 0) {
-            start = mid;
-        } else {
-            /* Since the gencnval tool folds duplicates into one entry,
-             * this alias in gAliasList is unique, but different standards
-             * may map an alias to different converters.
-             */
-            if (gMainTable.untaggedConvArray[mid] & UCNV_AMBIGUOUS_ALIAS_MAP_BIT) {
-                *pErrorCode = U_AMBIGUOUS_ALIAS_WARNING;
+    } else {
+        /* do a binary search for the alias */
+        start = 0;
+        limit = gMainTable.untaggedConvArraySize;
+        mid = limit;
+        lastMid = UINT32_MAX;
+
+        for (;;) {
+            mid = (uint32_t)((start + limit) / 2);
+            if (lastMid == mid) {   /* Have we moved? */
+                return UINT32_MAX;  /* We haven't moved, and it wasn't found. */
+            }
+            lastMid = mid;
+            if (isUnnormalized) {
+                result = ucnv_compareNames(alias, GET_STRING(gMainTable.aliasList[mid]));
             }
-            /* State whether the canonical converter name contains an option.
-            This information is contained in this list in order to maintain backward & forward compatibility. */
-            if (containsOption) {
-                UBool containsCnvOptionInfo = (UBool)gMainTable.optionTable->containsCnvOptionInfo;
-                *containsOption = (UBool)((containsCnvOptionInfo
-                    && ((gMainTable.untaggedConvArray[mid] & UCNV_CONTAINS_OPTION_BIT) != 0))
-                    || !containsCnvOptionInfo);
+            else {
+                result = uprv_strcmp(alias, GET_NORMALIZED_STRING(gMainTable.aliasList[mid]));
+            }
+
+            if (result < 0) {
+                limit = mid;
+            } else if (result > 0) {
+                start = mid;
+            } else {
+                break;
             }
-            return gMainTable.untaggedConvArray[mid] & UCNV_CONVERTER_INDEX_MASK;
         }
     }
 
-    return UINT32_MAX;
+    /* Since the gencnval tool folds duplicates into one entry,
+     * this alias in gAliasList is unique, but different standards
+     * may map an alias to different converters.
+     */
+    if (gMainTable.untaggedConvArray[mid] & UCNV_AMBIGUOUS_ALIAS_MAP_BIT) {
+        *pErrorCode = U_AMBIGUOUS_ALIAS_WARNING;
+    }
+    /* State whether the canonical converter name contains an option.
+    This information is contained in this list in order to maintain backward & forward compatibility. */
+    if (containsOption) {
+        UBool containsCnvOptionInfo = (UBool)gMainTable.optionTable->containsCnvOptionInfo;
+        *containsOption = (UBool)((containsCnvOptionInfo
+            && ((gMainTable.untaggedConvArray[mid] & UCNV_CONTAINS_OPTION_BIT) != 0))
+            || !containsCnvOptionInfo);
+    }
+    return gMainTable.untaggedConvArray[mid] & UCNV_CONVERTER_INDEX_MASK;
 }
 
 /*
@@ -1240,6 +1310,11 @@ ucnv_swapAliases(const UDataSwapper *ds,
                             2*(int32_t)(offsets[stringTableIndex]-offsets[converterListIndex]),
                             outTable+offsets[converterListIndex],
                             pErrorCode);
+            ds->swapArray16(ds,
+                            inTable+offsets[aliasHashIndex],
+                            2*(int32_t)toc[aliasHashIndex],
+                            outTable+offsets[aliasHashIndex],
+                            pErrorCode);
         } else {
             /* allocate the temporary table for sorting */
             count=toc[aliasListIndex];
@@ -1290,6 +1365,35 @@ ucnv_swapAliases(const UDataSwapper *ds,
                            io_compareRows, &tempTable,
                            FALSE, pErrorCode);
 
+            if(U_SUCCESS(*pErrorCode) && toc[aliasHashIndex]>=2) {
+                /*
+                 * The alias hash does not depend on the charset family,
+                 * but its slots contain aliasList indexes which are permutated.
+                 * Swap the hash before permutating in-place with tempTable.resort.
+                 */
+                uint16_t *r=tempTable.resort;
+                uint16_t hashCount;
+
+                p=inTable+offsets[aliasHashIndex];
+                q=outTable+offsets[aliasHashIndex];
+                hashCount=(uint16_t)(2+ds->readUInt16(p[0]));
+                if(hashCount>toc[aliasHashIndex]) {
+                    hashCount=(uint16_t)toc[aliasHashIndex];
+                }
+                ds->swapArray16(ds, p, 2*hashCount, q, pErrorCode);
+
+                for(i=0; i<count; ++i) {
+                    r[tempTable.rows[i].sortIndex]=(uint16_t)i;
+                }
+                for(i=hashCount; i<toc[aliasHashIndex]; ++i) {
+                    oldIndex=ds->readUInt16(p[i]);
+                    ds->writeUInt16(q+i, oldIndex<count ? r[oldIndex] : oldIndex);
+                }
+
+                p=inTable+offsets[aliasListIndex];
+                q=outTable+offsets[aliasListIndex];
+            }
+
             if(U_SUCCESS(*pErrorCode)) {
                 /* copy/swap/permutate items */
                 if(p!=q) {
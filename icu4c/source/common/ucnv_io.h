@@ -48,6 +48,7 @@ typedef struct UConverterAlias {
     const UConverterAliasOptions *optionTable;
     const uint16_t *stringTable;
     const uint16_t *normalizedStringTable;
+    const uint16_t *aliasHash;
 
     uint32_t converterListSize;
     uint32_t tagListSize;
@@ -58,6 +59,7 @@ typedef struct UConverterAlias {
     uint32_t optionTableSize;
     uint32_t stringTableSize;
     uint32_t normalizedStringTableSize;
+    uint32_t aliasHashSize;
 } UConverterAlias;
 
 /**
@@ -83,6 +85,16 @@ ucnv_io_stripASCIIForCompare(char *dst, const char *name);
 U_CAPI char * U_CALLCONV
 ucnv_io_stripEBCDICForCompare(char *dst, const char *name);
 
+/**
+ * Hash function for the perfect hash of normalized alias names in cnvalias.icu.
+ * gencnval builds the hash with this function, and findConverter() looks it up.
+ * @param name A normalized alias name, see ucnv_io_stripForCompare.
+ * @param seed 0 for selecting the bucket, or the bucket's displacement value.
+ * @return the hash code
+ */
+U_CAPI uint32_t U_CALLCONV
+ucnv_io_hashNormalizedName(const char *name, uint32_t seed);
+
 /**
  * Map a converter alias name to a canonical converter name.
  * The alias is searched for case-insensitively, the converter name
@@ -60,6 +60,7 @@
 #include "cstring.h"
 #include "umutex.h"
 #include "ustr_imp.h"
+#include "usimd.h"
 
 /* control optimizations according to the platform */
 #define MBCS_UNROLL_SINGLE_TO_BMP 1
@@ -431,6 +432,16 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                   UConverterToUnicodeArgs *pToUArgs,
                   UErrorCode *pErrorCode);
 
+static void U_CALLCONV
+ucnv_MBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                  UConverterToUnicodeArgs *pToUArgs,
+                  UErrorCode *pErrorCode);
+
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode);
+
 static const UConverterImpl _SBCSUTF8Impl={
     UCNV_MBCS,
 
@@ -453,7 +464,7 @@ static const UConverterImpl _SBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_SBCSFromUTF8
 };
 
@@ -479,11 +490,11 @@ static const UConverterImpl _DBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_DBCSFromUTF8
 };
 
-static const UConverterImpl _MBCSImpl={
+static const UConverterImpl _MBCSUTF8Impl={
     UCNV_MBCS,
 
     ucnv_MBCSLoad,
@@ -504,7 +515,33 @@ static const UConverterImpl _MBCSImpl={
     ucnv_MBCSWriteSub,
     NULL,
     ucnv_MBCSGetUnicodeSet,
+
+    ucnv_MBCSToUTF8,
+    ucnv_MBCSFromUTF8
+};
+
+static const UConverterImpl _MBCSImpl={
+    UCNV_MBCS,
+
+    ucnv_MBCSLoad,
+    ucnv_MBCSUnload,
+
+    ucnv_MBCSOpen,
+    NULL,
     NULL,
+
+    ucnv_MBCSToUnicodeWithOffsets,
+    ucnv_MBCSToUnicodeWithOffsets,
+    ucnv_MBCSFromUnicodeWithOffsets,
+    ucnv_MBCSFromUnicodeWithOffsets,
+    ucnv_MBCSGetNextUChar,
+
+    ucnv_MBCSGetStarters,
+    ucnv_MBCSGetName,
+    ucnv_MBCSWriteSub,
+    NULL,
+    ucnv_MBCSGetUnicodeSet,
+    ucnv_MBCSToUTF8,
     NULL
 };
 
@@ -1866,6 +1903,26 @@ ucnv_MBCSLoad(UConverterSharedData *sharedData,
             }
         }
     }
+    if(sharedData->impl==&_MBCSImpl && !(mbcsTable->unicodeMask&UCNV_HAS_SURROGATES)) {
+        /*
+         * Stateless multi-byte tables without the UTF-8-friendly index
+         * still convert from UTF-8 without pivoting through UTF-16.
+         * Tables with surrogate mappings would map a supplementary code point
+         * differently than its surrogate pair, and SI/SO and DBCS-only tables
+         * need the fromUnicode state handling.
+         */
+        switch(mbcsTable->outputType) {
+        case MBCS_OUTPUT_2:
+        case MBCS_OUTPUT_3:
+        case MBCS_OUTPUT_4:
+        case MBCS_OUTPUT_3_EUC:
+        case MBCS_OUTPUT_4_EUC:
+            sharedData->impl=&_MBCSUTF8Impl;
+            break;
+        default:
+            break;
+        }
+    }
 
     if(mbcsTable->outputType==MBCS_OUTPUT_DBCS_ONLY || mbcsTable->outputType==MBCS_OUTPUT_2_SISO) {
         /*
@@ -2175,6 +2232,67 @@ ucnv_MBCSSingleToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
     pArgs->offsets=offsets;
 }
 
+#if U_SIMD_SSE2 || U_SIMD_NEON
+
+/*
+ * Block converters for single-byte codepages where all of ASCII round-trips
+ * (asciiRoundtrips==0xffffffff).
+ */
+
+/*
+ * If the 16 bytes are all ASCII, then converts them to 16 UChars and returns TRUE,
+ * otherwise writes nothing and returns FALSE.
+ */
+static inline UBool
+asciiBlockToUnicode(const uint8_t *src, UChar *dest) {
+#if U_SIMD_SSE2
+    __m128i v=_mm_loadu_si128((const __m128i *)src);
+    if(_mm_movemask_epi8(v)!=0) {
+        return FALSE;
+    }
+    __m128i zero=_mm_setzero_si128();
+    _mm_storeu_si128((__m128i *)dest, _mm_unpacklo_epi8(v, zero));
+    _mm_storeu_si128((__m128i *)(dest+8), _mm_unpackhi_epi8(v, zero));
+#else  /* U_SIMD_NEON */
+    uint8x16_t v=vld1q_u8(src);
+    if(vmaxvq_u8(v)>0x7f) {
+        return FALSE;
+    }
+    vst1q_u16((uint16_t *)dest, vmovl_u8(vget_low_u8(v)));
+    vst1q_u16((uint16_t *)(dest+8), vmovl_u8(vget_high_u8(v)));
+#endif
+    return TRUE;
+}
+
+/*
+ * Converts whole blocks of 8 ASCII UChars to bytes, for at most length UChars,
+ * and stops before the first block with a non-ASCII UChar.
+ * Returns the number of UChars converted.
+ */
+static int32_t
+asciiBlocksFromUnicode(const UChar *src, uint8_t *dest, int32_t length) {
+    int32_t i=0;
+    for(; (length-i)>=8; i+=8) {
+#if U_SIMD_SSE2
+        __m128i v=_mm_loadu_si128((const __m128i *)(src+i));
+        __m128i isASCII=_mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((short)0xff80)), _mm_setzero_si128());
+        if(_mm_movemask_epi8(isASCII)!=0xffff) {
+            break;
+        }
+        _mm_storel_epi64((__m128i *)(dest+i), _mm_packus_epi16(v, v));
+#else  /* U_SIMD_NEON */
+        uint16x8_t v=vld1q_u16((const uint16_t *)(src+i));
+        if(vmaxvq_u16(v)>0x7f) {
+            break;
+        }
+        vst1_u8(dest+i, vmovn_u16(v));
+#endif
+    }
+    return i;
+}
+
+#endif
+
 /*
  * This version of ucnv_MBCSSingleToUnicodeWithOffsets() is optimized for single-byte, single-state codepages
  * that only map to and from the BMP.
@@ -2197,6 +2315,10 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
     int32_t entry;
     uint8_t action;
 
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    UBool asciiBlocks;
+#endif
+
     /* set up the local pointers */
     cnv=pArgs->converter;
     source=(const uint8_t *)pArgs->source;
@@ -2211,6 +2333,12 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
         stateTable=cnv->sharedData->mbcs.stateTable;
     }
 
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    /* convert all-ASCII blocks with SIMD if ASCII bytes map to themselves */
+    asciiBlocks=(UBool)(cnv->sharedData->mbcs.asciiRoundtrips==0xffffffff &&
+                        stateTable==cnv->sharedData->mbcs.stateTable);
+#endif
+
     /* sourceIndex=-1 if the current character began in the previous buffer */
     sourceIndex=0;
     lastSource=source;
@@ -2233,6 +2361,13 @@ unrolled:
 
         loops=count=targetCapacity>>4;
         do {
+#if U_SIMD_SSE2 || U_SIMD_NEON
+            if(asciiBlocks && asciiBlockToUnicode(source, target)) {
+                source+=16;
+                target+=16;
+                continue;
+            }
+#endif
             oredEntries=entry=stateTable[0][*source++];
             *target++=(UChar)MBCS_ENTRY_FINAL_VALUE_16(entry);
             oredEntries|=entry=stateTable[0][*source++];
@@ -3829,6 +3964,10 @@ ucnv_MBCSSingleFromBMPWithOffsets(UConverterFromUnicodeArgs *pArgs,
     uint32_t asciiRoundtrips;
     uint16_t value, minValue;
 
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    UBool asciiBlocks;
+#endif
+
     /* set up the local pointers */
     cnv=pArgs->converter;
     source=pArgs->source;
@@ -3844,6 +3983,10 @@ ucnv_MBCSSingleFromBMPWithOffsets(UConverterFromUnicodeArgs *pArgs,
         results=(uint16_t *)cnv->sharedData->mbcs.fromUnicodeBytes;
     }
     asciiRoundtrips=cnv->sharedData->mbcs.asciiRoundtrips;
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    /* convert all-ASCII blocks with SIMD if ASCII characters map to themselves */
+    asciiBlocks=(UBool)(asciiRoundtrips==0xffffffff && (cnv->options&UCNV_OPTION_SWAP_LFNL)==0);
+#endif
 
     if(cnv->useFallback) {
         /* use all roundtrip and fallback results */
@@ -3940,6 +4083,15 @@ unrolled:
             *target++=(uint8_t)c;
             --targetCapacity;
             c=0;
+#if U_SIMD_SSE2 || U_SIMD_NEON
+            /* ASCII often comes in runs */
+            if(asciiBlocks && targetCapacity>=8 && *source<=0x7f) {
+                length=asciiBlocksFromUnicode(source, target, targetCapacity);
+                source+=length;
+                target+=length;
+                targetCapacity-=length;
+            }
+#endif
             continue;
         }
         value=MBCS_SINGLE_RESULT_FROM_U(table, results, c);
@@ -5622,6 +5774,477 @@ unassigned:
     pFromUArgs->target=(char *)target;
 }
 
+/*
+ * From UTF-8 for stateless multi-byte tables that do not have the
+ * UTF-8-friendly mbcsIndex (3-byte, 4-byte, EUC, and other 2-byte tables).
+ * Well-formed characters are looked up in the regular fromUnicode trie.
+ * Partial, truncated and ill-formed UTF-8 sequences are left to the
+ * UTF-8 converter by temporarily reverting to pivoting.
+ */
+static void U_CALLCONV
+ucnv_MBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                  UConverterToUnicodeArgs *pToUArgs,
+                  UErrorCode *pErrorCode) {
+    UConverter *utf8, *cnv;
+    const uint8_t *source, *sourceLimit;
+    uint8_t *target;
+    int32_t targetCapacity;
+
+    const uint16_t *table;
+    const uint8_t *p, *bytes;
+    uint8_t outputType;
+
+    UChar32 c;
+    int32_t i, length;
+
+    uint32_t stage2Entry;
+    uint32_t asciiRoundtrips;
+    uint32_t value;
+    UBool hasSupplementary;
+
+    /* set up the local pointers */
+    utf8=pToUArgs->converter;
+    cnv=pFromUArgs->converter;
+
+    if(utf8->toULength>0) {
+        /* finish a partial UTF-8 character from the previous buffer with pivoting */
+        *pErrorCode=U_USING_DEFAULT_WARNING;
+        return;
+    }
+
+    source=(uint8_t *)pToUArgs->source;
+    sourceLimit=(uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetCapacity=(int32_t)(pFromUArgs->targetLimit-pFromUArgs->target);
+
+    table=cnv->sharedData->mbcs.fromUnicodeTable;
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        bytes=cnv->sharedData->mbcs.swapLFNLFromUnicodeBytes;
+    } else {
+        bytes=cnv->sharedData->mbcs.fromUnicodeBytes;
+    }
+    outputType=cnv->sharedData->mbcs.outputType;
+    asciiRoundtrips=cnv->sharedData->mbcs.asciiRoundtrips;
+
+    hasSupplementary=(UBool)(cnv->sharedData->mbcs.unicodeMask&UCNV_HAS_SUPPLEMENTARY);
+
+    /* conversion loop */
+    while(source<sourceLimit) {
+        if(targetCapacity<=0) {
+            /* target is full */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+
+        c=*source;
+        if(U8_IS_SINGLE(c) && IS_ASCII_ROUNDTRIP(c, asciiRoundtrips)) {
+            /* convert ASCII */
+            ++source;
+            *target++=(uint8_t)c;
+            --targetCapacity;
+            continue;
+        }
+
+        i=0;
+        length=(int32_t)(sourceLimit-source);
+        U8_NEXT(source, i, length, c);
+        if(c<0) {
+            /*
+             * Ill-formed or truncated UTF-8 sequence:
+             * Return and revert to pivoting so that the UTF-8 converter
+             * collects a partial character or calls the error callback.
+             */
+            *pErrorCode=U_USING_DEFAULT_WARNING;
+            break;
+        }
+        source+=i;
+
+        if(c>0xffff && !hasSupplementary) {
+            /* BMP-only codepages are stored without stage 1 entries for supplementary code points */
+            goto unassigned;
+        }
+
+        stage2Entry=MBCS_STAGE_2_FROM_U(table, c);
+
+        /* get the bytes and the length for the output */
+        switch(outputType) {
+        case MBCS_OUTPUT_2:
+            value=MBCS_VALUE_2_FROM_STAGE_2(bytes, stage2Entry, c);
+            if(value<=0xff) {
+                length=1;
+            } else {
+                length=2;
+            }
+            break;
+        case MBCS_OUTPUT_3:
+            p=MBCS_POINTER_3_FROM_STAGE_2(bytes, stage2Entry, c);
+            value=((uint32_t)*p<<16)|((uint32_t)p[1]<<8)|p[2];
+            if(value<=0xff) {
+                length=1;
+            } else if(value<=0xffff) {
+                length=2;
+            } else {
+                length=3;
+            }
+            break;
+        case MBCS_OUTPUT_4:
+            value=MBCS_VALUE_4_FROM_STAGE_2(bytes, stage2Entry, c);
+            if(value<=0xff) {
+                length=1;
+            } else if(value<=0xffff) {
+                length=2;
+            } else if(value<=0xffffff) {
+                length=3;
+            } else {
+                length=4;
+            }
+            break;
+        case MBCS_OUTPUT_3_EUC:
+            value=MBCS_VALUE_2_FROM_STAGE_2(bytes, stage2Entry, c);
+            /* EUC 16-bit fixed-length representation */
+            if(value<=0xff) {
+                length=1;
+            } else if((value&0x8000)==0) {
+                value|=0x8e8000;
+                length=3;
+            } else if((value&0x80)==0) {
+                value|=0x8f0080;
+                length=3;
+            } else {
+                length=2;
+            }
+            break;
+        case MBCS_OUTPUT_4_EUC:
+            p=MBCS_POINTER_3_FROM_STAGE_2(bytes, stage2Entry, c);
+            value=((uint32_t)*p<<16)|((uint32_t)p[1]<<8)|p[2];
+            /* EUC 16-bit fixed-length representation applied to the first two bytes */
+            if(value<=0xff) {
+                length=1;
+            } else if(value<=0xffff) {
+                length=2;
+            } else if((value&0x800000)==0) {
+                value|=0x8e800000;
+                length=4;
+            } else if((value&0x8000)==0) {
+                value|=0x8f008000;
+                length=4;
+            } else {
+                length=3;
+            }
+            break;
+        default:
+            /* must not occur, see ucnv_MBCSLoad() */
+            value=stage2Entry=0; /* stage2Entry=0 to reset roundtrip flags */
+            length=0;
+            break;
+        }
+
+        /* is this code point assigned, or do we use fallbacks? */
+        if(!(MBCS_FROM_U_IS_ROUNDTRIP(stage2Entry, c)!=0 ||
+             (UCNV_FROM_U_USE_FALLBACK(cnv, c) && value!=0))
+        ) {
+            goto unassigned;
+        }
+
+        /* write the output character bytes from value and length */
+        /* from the first if in the loop we know that targetCapacity>0 */
+        if(length<=targetCapacity) {
+            switch(length) {
+                /* each branch falls through to the next one */
+            case 4:
+                *target++=(uint8_t)(value>>24);
+                U_FALLTHROUGH;
+            case 3:
+                *target++=(uint8_t)(value>>16);
+                U_FALLTHROUGH;
+            case 2:
+                *target++=(uint8_t)(value>>8);
+                U_FALLTHROUGH;
+            case 1:
+                *target++=(uint8_t)value;
+                U_FALLTHROUGH;
+            default:
+                /* will never occur */
+                break;
+            }
+            targetCapacity-=length;
+        } else {
+            uint8_t *charErrorBuffer;
+
+            /*
+             * As in ucnv_MBCSFromUnicodeWithOffsets(), first output
+             * to the overflow buffer what does not fit into the regular target.
+             */
+            /* we know that 1<=targetCapacity<length<=4 */
+            length-=targetCapacity;
+            charErrorBuffer=(uint8_t *)cnv->charErrorBuffer;
+            switch(length) {
+                /* each branch falls through to the next one */
+            case 3:
+                *charErrorBuffer++=(uint8_t)(value>>16);
+                U_FALLTHROUGH;
+            case 2:
+                *charErrorBuffer++=(uint8_t)(value>>8);
+                U_FALLTHROUGH;
+            case 1:
+                *charErrorBuffer=(uint8_t)value;
+                U_FALLTHROUGH;
+            default:
+                /* will never occur */
+                break;
+            }
+            cnv->charErrorBufferLength=(int8_t)length;
+
+            /* now output what fits into the regular target */
+            value>>=8*length; /* length was reduced by targetCapacity */
+            switch(targetCapacity) {
+                /* each branch falls through to the next one */
+            case 3:
+                *target++=(uint8_t)(value>>16);
+                U_FALLTHROUGH;
+            case 2:
+                *target++=(uint8_t)(value>>8);
+                U_FALLTHROUGH;
+            case 1:
+                *target++=(uint8_t)value;
+                U_FALLTHROUGH;
+            default:
+                /* will never occur */
+                break;
+            }
+
+            /* target overflow */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+        continue;
+
+unassigned:
+        {
+            /*
+             * Try an extension mapping, as in ucnv_DBCSFromUTF8().
+             * This also handles the GB 18030 four-byte ranges.
+             * If we have a partial match on c, we will return and revert
+             * to UTF-8->UTF-16->charset conversion.
+             */
+            static const UChar nul=0;
+            const UChar *noSource=&nul;
+            c=_extFromU(cnv, cnv->sharedData,
+                        c, &noSource, noSource,
+                        &target, target+targetCapacity,
+                        NULL, -1,
+                        pFromUArgs->flush,
+                        pErrorCode);
+
+            if(U_FAILURE(*pErrorCode)) {
+                /* not mappable or buffer overflow */
+                cnv->fromUChar32=c;
+                break;
+            } else if(cnv->preFromUFirstCP>=0) {
+                /* partial match, return and revert to pivoting */
+                *pErrorCode=U_USING_DEFAULT_WARNING;
+                break;
+            } else {
+                /* a mapping was written to the target, continue */
+
+                /* recalculate the targetCapacity after an extension mapping */
+                targetCapacity=(int32_t)(pFromUArgs->targetLimit-(char *)target);
+                continue;
+            }
+        }
+    }
+
+    /* write back the updated pointers */
+    pToUArgs->source=(char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
+/* MBCS-to-UTF-8 conversion functions --------------------------------------- */
+
+/*
+ * To UTF-8 for all MBCS tables.
+ * Complete byte sequences with roundtrip mappings are converted directly.
+ * For anything else (fallbacks, unassigned and illegal sequences,
+ * partial characters at the end of the input, extension mappings)
+ * we return and revert to pivoting, starting again with that sequence.
+ */
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode) {
+    UConverter *cnv, *utf8;
+    const uint8_t *source, *sourceLimit, *start;
+    uint8_t *target;
+    int32_t targetCapacity;
+
+    const int32_t (*stateTable)[256];
+    const uint16_t *unicodeCodeUnits;
+
+    uint32_t offset;
+    uint8_t state, startState, dbcsOnlyState;
+
+    int32_t entry, finalEntry;
+    uint8_t action;
+    UChar32 c;
+
+    /* set up the local pointers */
+    cnv=pToUArgs->converter;
+    utf8=pFromUArgs->converter;
+
+    if(cnv->toULength>0 || utf8->fromUChar32!=0) {
+        /* finish a partial character from the previous buffer with pivoting */
+        *pErrorCode=U_USING_DEFAULT_WARNING;
+        return;
+    }
+
+    source=(const uint8_t *)pToUArgs->source;
+    sourceLimit=(const uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetCapacity=(int32_t)(pFromUArgs->targetLimit-pFromUArgs->target);
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+    } else {
+        stateTable=cnv->sharedData->mbcs.stateTable;
+    }
+    unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
+
+    /* see ucnv_MBCSToUnicodeWithOffsets() for the DBCS-only state */
+    dbcsOnlyState=cnv->sharedData->mbcs.dbcsOnlyState;
+    if((state=(uint8_t)(cnv->mode))==0) {
+        state=dbcsOnlyState;
+    }
+
+    /* conversion loop */
+    while(source<sourceLimit) {
+        if(targetCapacity<=0) {
+            /* target is full */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+
+        /* fast path for single-byte and two-byte BMP characters, as in ucnv_MBCSToUnicodeWithOffsets() */
+        entry=stateTable[state][*source];
+        if(MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(entry)) {
+            ++source;
+            c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+        } else if( MBCS_ENTRY_IS_TRANSITION(entry) &&
+                   (source+1)<sourceLimit &&
+                   MBCS_ENTRY_IS_FINAL(finalEntry=stateTable[MBCS_ENTRY_TRANSITION_STATE(entry)][source[1]]) &&
+                   MBCS_ENTRY_FINAL_ACTION(finalEntry)==MBCS_STATE_VALID_16 &&
+                   (c=unicodeCodeUnits[MBCS_ENTRY_TRANSITION_OFFSET(entry)+MBCS_ENTRY_FINAL_VALUE_16(finalEntry)])<0xfffe
+        ) {
+            source+=2;
+            state=(uint8_t)MBCS_ENTRY_FINAL_STATE(finalEntry); /* typically 0 */
+        } else {
+            start=source;
+            startState=state;
+            offset=0;
+            for(;;) {
+                entry=stateTable[state][*source++];
+                if(MBCS_ENTRY_IS_FINAL(entry)) {
+                    break;
+                }
+                state=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
+                offset+=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+                if(source>=sourceLimit) {
+                    break;
+                }
+            }
+
+            if(MBCS_ENTRY_IS_TRANSITION(entry)) {
+                /* partial character at the end of the input */
+                c=-1;
+            } else {
+                state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+                action=(uint8_t)(MBCS_ENTRY_FINAL_ACTION(entry));
+                if(action==MBCS_STATE_VALID_DIRECT_16) {
+                    c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+                } else if(action==MBCS_STATE_VALID_16) {
+                    c=unicodeCodeUnits[offset+MBCS_ENTRY_FINAL_VALUE_16(entry)];
+                    if(c>=0xfffe) {
+                        /* fallback or illegal */
+                        c=-1;
+                    }
+                } else if(action==MBCS_STATE_VALID_16_PAIR) {
+                    offset+=MBCS_ENTRY_FINAL_VALUE_16(entry);
+                    c=unicodeCodeUnits[offset++];
+                    if(c<0xd800) {
+                        /* roundtrip BMP code point below 0xd800 */
+                    } else if(c<=0xdbff) {
+                        /* roundtrip surrogate pair */
+                        c=U16_GET_SUPPLEMENTARY(c, unicodeCodeUnits[offset]);
+                    } else if(c==0xe000) {
+                        /* roundtrip BMP code point above 0xd800 */
+                        c=unicodeCodeUnits[offset];
+                    } else {
+                        /* fallback or illegal */
+                        c=-1;
+                    }
+                } else if(action==MBCS_STATE_VALID_DIRECT_20) {
+                    c=(UChar32)MBCS_ENTRY_FINAL_VALUE(entry)+0x10000;
+                } else if(action==MBCS_STATE_CHANGE_ONLY && dbcsOnlyState==0) {
+                    /* state change without any output, e.g., Shift-In/Shift-Out */
+                    continue;
+                } else {
+                    /* fallback, unassigned, illegal, or SI/SO for DBCS-only conversion */
+                    c=-1;
+                }
+            }
+
+            if(c<0) {
+                /* revert to pivoting for this sequence */
+                source=start;
+                state=startState;
+                *pErrorCode=U_USING_DEFAULT_WARNING;
+                break;
+            }
+        }
+
+        /* write the code point as UTF-8 */
+        /* from the first if in the loop we know that targetCapacity>0 */
+        if(c<=0x7f) {
+            *target++=(uint8_t)c;
+            --targetCapacity;
+        } else if(targetCapacity>=U8_MAX_LENGTH) {
+            int32_t length=0;
+            U8_APPEND_UNSAFE(target, length, c);
+            target+=length;
+            targetCapacity-=length;
+        } else {
+            uint8_t u8[U8_MAX_LENGTH];
+            int32_t i, length=0;
+            U8_APPEND_UNSAFE(u8, length, c);
+            if(length<=targetCapacity) {
+                for(i=0; i<length; ++i) {
+                    *target++=u8[i];
+                }
+                targetCapacity-=length;
+            } else {
+                for(i=0; i<targetCapacity; ++i) {
+                    *target++=u8[i];
+                }
+                /* the rest goes into the UTF-8 converter's overflow buffer */
+                length-=i;
+                uprv_memcpy(utf8->charErrorBuffer, u8+i, length);
+                utf8->charErrorBufferLength=(int8_t)length;
+
+                /* target overflow */
+                *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+                break;
+            }
+        }
+    }
+
+    /* set the converter state back into UConverter */
+    cnv->mode=state;
+
+    /* write back the updated pointers */
+    pToUArgs->source=(const char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
 /* miscellaneous ------------------------------------------------------------ */
 
 static void U_CALLCONV
@@ -5720,4 +6343,62 @@ ucnv_MBCSGetType(const UConverter* converter) {
     return (UConverterType)UCNV_MBCS;
 }
 
+/* marks the bytes that lead to another extension toUnicode section */
+static void
+markExtToUPartialBytes(const uint32_t *toUTable, const uint32_t *toUSection,
+                       int32_t depth, UBool isEndByte[256]) {
+    int32_t i, count;
+    uint32_t word, value;
+
+    if(depth>=UCNV_EXT_MAX_BYTES) {
+        return;  /* guard against malformed data */
+    }
+    count=(int32_t)UCNV_EXT_TO_U_GET_BYTE(*toUSection);
+    for(i=1; i<=count; ++i) {
+        word=toUSection[i];
+        value=UCNV_EXT_TO_U_GET_VALUE(word);
+        if(value!=0 && UCNV_EXT_TO_U_IS_PARTIAL(value)) {
+            isEndByte[UCNV_EXT_TO_U_GET_BYTE(word)]=FALSE;
+            markExtToUPartialBytes(toUTable, toUTable+UCNV_EXT_TO_U_GET_PARTIAL_INDEX(value),
+                                   depth+1, isEndByte);
+        }
+    }
+}
+
+U_CFUNC UBool
+ucnv_MBCSGetChunkEndBytes(const UConverterSharedData *sharedData, UBool isEndByte[256]) {
+    const UConverterMBCSTable *mbcsTable=&sharedData->mbcs;
+    const int32_t *extIndexes;
+    int32_t state, b, entry;
+    UBool hasEndByte=FALSE;
+
+    if((mbcsTable->outputType&0xff)==MBCS_OUTPUT_2_SISO) {
+        return FALSE;
+    }
+    /* a byte ends a character in every state and returns to the initial state */
+    for(b=0; b<=0xff; ++b) {
+        isEndByte[b]=TRUE;
+        for(state=0; state<mbcsTable->countStates; ++state) {
+            entry=mbcsTable->stateTable[state][b];
+            if( MBCS_ENTRY_IS_TRANSITION(entry) ||
+                MBCS_ENTRY_FINAL_STATE(entry)!=0 ||
+                MBCS_ENTRY_FINAL_ACTION(entry)==MBCS_STATE_CHANGE_ONLY
+            ) {
+                isEndByte[b]=FALSE;
+                break;
+            }
+        }
+    }
+    /* extension toUnicode mappings may continue with more bytes */
+    extIndexes=mbcsTable->extIndexes;
+    if(extIndexes!=NULL && extIndexes[UCNV_EXT_TO_U_LENGTH]>0) {
+        const uint32_t *toUTable=UCNV_EXT_ARRAY(extIndexes, UCNV_EXT_TO_U_INDEX, uint32_t);
+        markExtToUPartialBytes(toUTable, toUTable, 0, isEndByte);
+    }
+    for(b=0; b<=0xff; ++b) {
+        hasEndByte|=isEndByte[b];
+    }
+    return hasEndByte;
+}
+
 #endif /* #if !UCONFIG_NO_LEGACY_CONVERSION */
@@ -566,6 +566,15 @@ ucnv_MBCSSingleFromUChar32(UConverterSharedData *sharedData,
 U_CFUNC UConverterType
 ucnv_MBCSGetType(const UConverter* converter);
 
+/**
+ * Sets isEndByte[b] for each byte b which ends a character in every toUnicode state
+ * and returns to the initial state, also taking extension mappings into account.
+ * Conversion to Unicode can be split after such a byte.
+ * @return TRUE if there is at least one such byte
+ */
+U_CFUNC UBool
+ucnv_MBCSGetChunkEndBytes(const UConverterSharedData *sharedData, UBool isEndByte[256]);
+
 U_CFUNC void 
 ucnv_MBCSFromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
                             UErrorCode *pErrorCode);
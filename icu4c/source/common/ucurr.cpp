@@ -894,6 +894,64 @@ static int U_CALLCONV currencyNameComparator(const void* a, const void* b) {
 }
 
 
+namespace {
+
+// Counts the names in a Currencies or CurrencyPlurals table
+// without creating a UResourceBundle per currency.
+class CurrencyNameCountVisitor : public ResourceVisitor {
+public:
+    CurrencyNameCountVisitor(const icu::Hashtable *symbolsEquiv) :
+            currencySymbolsEquiv(symbolsEquiv), isPlurals(FALSE),
+            nameCount(0), symbolCount(0) {}
+    virtual ~CurrencyNameCountVisitor();
+
+    virtual UBool visit(const char * /*key*/, int32_t /*index*/, ResourceValue &value,
+                        UErrorCode & /*errorCode*/) {
+        // Count every item even if its data is bad,
+        // so that the result is at least as large as what collectCurrencyNames() stores.
+        UErrorCode ec = U_ZERO_ERROR;
+        if (isPlurals) {
+            nameCount += value.getTable(ec).getSize();
+            return TRUE;
+        }
+        ResourceArray names = value.getArray(ec);
+        int32_t len;
+        const UChar *s = NULL;
+        if (names.getValue(UCURR_SYMBOL_NAME, value)) {
+            s = value.getString(len, ec);
+        }
+        ++symbolCount;  // currency symbol
+        if (currencySymbolsEquiv != NULL && U_SUCCESS(ec) && s != NULL) {
+            symbolCount += countEquivalent(*currencySymbolsEquiv, UnicodeString(TRUE, s, len));
+        }
+        ++symbolCount;  // iso code
+        ++nameCount;  // long name
+        return TRUE;
+    }
+
+    const icu::Hashtable *currencySymbolsEquiv;
+    UBool isPlurals;
+    int32_t nameCount;
+    int32_t symbolCount;
+};
+
+CurrencyNameCountVisitor::~CurrencyNameCountVisitor() {}
+
+// Visits the items of one locale's Currencies or CurrencyPlurals table.
+// The table is looked up with ures_getByKey() rather than with the
+// ures_getByKeyWithFallback() path lookup of ures_visitItems(),
+// so that the callers' own locale fallback loop sees each table once.
+void visitCurrencyTable(const UResourceBundle *rb, const char *key,
+                        ResourceVisitor &visitor, UErrorCode &errorCode) {
+    UResourceBundle table;
+    ures_initStackObject(&table);
+    ures_getByKey(rb, key, &table, &errorCode);
+    ures_visitItems(&table, "", visitor, errorCode);
+    ures_close(&table);
+}
+
+}  // namespace
+
 // Give a locale, return the maximum number of currency names associated with
 // this locale.
 // It gets currency names from resource bundles using fallback.
@@ -905,48 +963,28 @@ static int U_CALLCONV currencyNameComparator(const void* a, const void* b) {
 static void
 getCurrencyNameCount(const char* loc, int32_t* total_currency_name_count, int32_t* total_currency_symbol_count) {
     U_NAMESPACE_USE
-    *total_currency_name_count = 0;
-    *total_currency_symbol_count = 0;
-    const UChar* s = NULL;
     char locale[ULOC_FULLNAME_CAPACITY];
     uprv_strcpy(locale, loc);
-    const icu::Hashtable *currencySymbolsEquiv = getCurrSymbolsEquiv();
+    CurrencyNameCountVisitor visitor(getCurrSymbolsEquiv());
     for (;;) {
         UErrorCode ec2 = U_ZERO_ERROR;
         // TODO: ures_openDirect?
         UResourceBundle* rb = ures_open(U_ICUDATA_CURR, locale, &ec2);
-        UResourceBundle* curr = ures_getByKey(rb, CURRENCIES, NULL, &ec2);
-        int32_t n = ures_getSize(curr);
-        for (int32_t i=0; i<n; ++i) {
-            UResourceBundle* names = ures_getByIndex(curr, i, NULL, &ec2);
-            int32_t len;
-            s = ures_getStringByIndex(names, UCURR_SYMBOL_NAME, &len, &ec2);
-            ++(*total_currency_symbol_count);  // currency symbol
-            if (currencySymbolsEquiv != NULL) {
-                *total_currency_symbol_count += countEquivalent(*currencySymbolsEquiv, UnicodeString(TRUE, s, len));
-            }
-            ++(*total_currency_symbol_count); // iso code
-            ++(*total_currency_name_count); // long name
-            ures_close(names);
-        }
+        visitor.isPlurals = FALSE;
+        visitCurrencyTable(rb, CURRENCIES, visitor, ec2);
 
         // currency plurals
         UErrorCode ec3 = U_ZERO_ERROR;
-        UResourceBundle* curr_p = ures_getByKey(rb, CURRENCYPLURALS, NULL, &ec3);
-        n = ures_getSize(curr_p);
-        for (int32_t i=0; i<n; ++i) {
-            UResourceBundle* names = ures_getByIndex(curr_p, i, NULL, &ec3);
-            *total_currency_name_count += ures_getSize(names);
-            ures_close(names);
-        }
-        ures_close(curr_p);
-        ures_close(curr);
+        visitor.isPlurals = TRUE;
+        visitCurrencyTable(rb, CURRENCYPLURALS, visitor, ec3);
         ures_close(rb);
 
         if (!fallback(locale)) {
             break;
         }
     }
+    *total_currency_name_count = visitor.nameCount;
+    *total_currency_symbol_count = visitor.symbolCount;
 }
 
 static UChar* 
@@ -965,6 +1003,133 @@ toUpperCase(const UChar* source, int32_t len, const char* locale) {
 }
 
 
+namespace {
+
+// Collects the names from a Currencies or CurrencyPlurals table
+// into the arrays allocated by collectCurrencyNames(),
+// without creating a UResourceBundle per currency.
+// The ISO codes point to the resource bundle keys.
+class CurrencyNameCollectVisitor : public ResourceVisitor {
+public:
+    CurrencyNameCollectVisitor(const char *loc, const icu::Hashtable *symbolsEquiv,
+                               CurrencyNameStruct *names, int32_t &nameCount,
+                               CurrencyNameStruct *symbols, int32_t &symbolCount) :
+            locale(loc), currencySymbolsEquiv(symbolsEquiv),
+            currencyNames(names), total_currency_name_count(nameCount),
+            currencySymbols(symbols), total_currency_symbol_count(symbolCount),
+            isoCodes(NULL), localeLevel(0), isPlurals(FALSE), hashErrorCode(NULL) {}
+    virtual ~CurrencyNameCollectVisitor();
+
+    // Sets up for the next table. The hash table removes duplicates caused by locale fallback.
+    void setTable(UHashtable *codes, int32_t level, UBool plurals, UErrorCode &ec) {
+        isoCodes = codes;
+        localeLevel = level;
+        isPlurals = plurals;
+        hashErrorCode = &ec;
+    }
+
+    virtual UBool visit(const char *key, int32_t /*index*/, ResourceValue &value,
+                        UErrorCode &errorCode) {
+        // TODO: uhash_put wont change key/value?
+        char *iso = const_cast<char *>(key);
+        if (localeLevel == 0) {
+            uhash_put(isoCodes, iso, iso, hashErrorCode);
+        } else {
+            if (uhash_get(isoCodes, iso) != NULL) {
+                return TRUE;
+            } else {
+                uhash_put(isoCodes, iso, iso, hashErrorCode);
+            }
+        }
+        if (isPlurals) {
+            addPluralNames(iso, value, errorCode);
+        } else {
+            addNamesAndSymbols(iso, value, errorCode);
+        }
+        return TRUE;
+    }
+
+private:
+    void addNamesAndSymbols(char *iso, ResourceValue &value, UErrorCode &errorCode) {
+        ResourceArray names = value.getArray(errorCode);
+        const UChar *s = NULL;
+        int32_t len = 0;
+        if (names.getValue(UCURR_SYMBOL_NAME, value)) {
+            s = value.getString(len, errorCode);
+        }
+        // Add currency symbol.
+        currencySymbols[total_currency_symbol_count].IsoCode = iso;
+        currencySymbols[total_currency_symbol_count].currencyName = (UChar*)s;
+        currencySymbols[total_currency_symbol_count].flag = 0;
+        currencySymbols[total_currency_symbol_count++].currencyNameLen = len;
+        // Add equivalent symbols
+        if (currencySymbolsEquiv != NULL) {
+            UnicodeString str(TRUE, s, len);
+            icu::EquivIterator iter(*currencySymbolsEquiv, str);
+            const UnicodeString *symbol;
+            while ((symbol = iter.next()) != NULL) {
+                currencySymbols[total_currency_symbol_count].IsoCode = iso;
+                currencySymbols[total_currency_symbol_count].currencyName =
+                    const_cast<UChar*>(symbol->getBuffer());
+                currencySymbols[total_currency_symbol_count].flag = 0;
+                currencySymbols[total_currency_symbol_count++].currencyNameLen = symbol->length();
+            }
+        }
+
+        // Add currency long name.
+        s = NULL;
+        len = 0;
+        if (names.getValue(UCURR_LONG_NAME, value)) {
+            s = value.getString(len, errorCode);
+        }
+        currencyNames[total_currency_name_count].IsoCode = iso;
+        UChar* upperName = toUpperCase(s, len, locale);
+        currencyNames[total_currency_name_count].currencyName = upperName;
+        currencyNames[total_currency_name_count].flag = NEED_TO_BE_DELETED;
+        currencyNames[total_currency_name_count++].currencyNameLen = len;
+
+        // put (iso, 3, and iso) in to array
+        // Add currency ISO code.
+        currencySymbols[total_currency_symbol_count].IsoCode = iso;
+        currencySymbols[total_currency_symbol_count].currencyName = (UChar*)uprv_malloc(sizeof(UChar)*3);
+        // Must convert iso[] into Unicode
+        u_charsToUChars(iso, currencySymbols[total_currency_symbol_count].currencyName, 3);
+        currencySymbols[total_currency_symbol_count].flag = NEED_TO_BE_DELETED;
+        currencySymbols[total_currency_symbol_count++].currencyNameLen = 3;
+    }
+
+    void addPluralNames(char *iso, ResourceValue &value, UErrorCode &errorCode) {
+        ResourceTable names = value.getTable(errorCode);
+        const char *pluralKey;
+        for (int32_t j = 0; names.getKeyAndValue(j, pluralKey, value); ++j) {
+            // TODO: remove duplicates between singular name and 
+            // currency long name?
+            int32_t len = 0;
+            const UChar *s = value.getString(len, errorCode);
+            currencyNames[total_currency_name_count].IsoCode = iso;
+            UChar* upperName = toUpperCase(s, len, locale);
+            currencyNames[total_currency_name_count].currencyName = upperName;
+            currencyNames[total_currency_name_count].flag = NEED_TO_BE_DELETED;
+            currencyNames[total_currency_name_count++].currencyNameLen = len;
+        }
+    }
+
+    const char *locale;
+    const icu::Hashtable *currencySymbolsEquiv;
+    CurrencyNameStruct *currencyNames;
+    int32_t &total_currency_name_count;
+    CurrencyNameStruct *currencySymbols;
+    int32_t &total_currency_symbol_count;
+    UHashtable *isoCodes;
+    int32_t localeLevel;
+    UBool isPlurals;
+    UErrorCode *hashErrorCode;
+};
+
+CurrencyNameCollectVisitor::~CurrencyNameCollectVisitor() {}
+
+}  // namespace
+
 // Collect all available currency names associated with the given locale
 // (enable fallback chain).
 // Read currenc names defined in resource bundle "Currencies" and
@@ -1003,9 +1168,6 @@ collectCurrencyNames(const char* locale,
 
     if (U_FAILURE(ec)) return;
 
-    const UChar* s = NULL;  // currency name
-    char* iso = NULL;  // currency ISO code
-
     *total_currency_name_count = 0;
     *total_currency_symbol_count = 0;
 
@@ -1015,101 +1177,20 @@ collectCurrencyNames(const char* locale,
     // Using hash to remove duplicates caused by locale fallback
     UHashtable* currencyIsoCodes = uhash_open(uhash_hashChars, uhash_compareChars, NULL, &ec3);
     UHashtable* currencyPluralIsoCodes = uhash_open(uhash_hashChars, uhash_compareChars, NULL, &ec4);
+    CurrencyNameCollectVisitor visitor(locale, currencySymbolsEquiv,
+                                       *currencyNames, *total_currency_name_count,
+                                       *currencySymbols, *total_currency_symbol_count);
     for (int32_t localeLevel = 0; ; ++localeLevel) {
         ec2 = U_ZERO_ERROR;
         // TODO: ures_openDirect
         UResourceBundle* rb = ures_open(U_ICUDATA_CURR, loc, &ec2);
-        UResourceBundle* curr = ures_getByKey(rb, CURRENCIES, NULL, &ec2);
-        int32_t n = ures_getSize(curr);
-        for (int32_t i=0; i<n; ++i) {
-            UResourceBundle* names = ures_getByIndex(curr, i, NULL, &ec2);
-            int32_t len;
-            s = ures_getStringByIndex(names, UCURR_SYMBOL_NAME, &len, &ec2);
-            // TODO: uhash_put wont change key/value?
-            iso = (char*)ures_getKey(names);
-            if (localeLevel == 0) {
-                uhash_put(currencyIsoCodes, iso, iso, &ec3); 
-            } else {
-                if (uhash_get(currencyIsoCodes, iso) != NULL) {
-                    ures_close(names);
-                    continue;
-                } else {
-                    uhash_put(currencyIsoCodes, iso, iso, &ec3); 
-                }
-            }
-            // Add currency symbol.
-            (*currencySymbols)[*total_currency_symbol_count].IsoCode = iso;
-            (*currencySymbols)[*total_currency_symbol_count].currencyName = (UChar*)s;
-            (*currencySymbols)[*total_currency_symbol_count].flag = 0;
-            (*currencySymbols)[(*total_currency_symbol_count)++].currencyNameLen = len;
-            // Add equivalent symbols
-            if (currencySymbolsEquiv != NULL) {
-                UnicodeString str(TRUE, s, len);
-                icu::EquivIterator iter(*currencySymbolsEquiv, str);
-                const UnicodeString *symbol;
-                while ((symbol = iter.next()) != NULL) {
-                    (*currencySymbols)[*total_currency_symbol_count].IsoCode = iso;
-                    (*currencySymbols)[*total_currency_symbol_count].currencyName =
-                        const_cast<UChar*>(symbol->getBuffer());
-                    (*currencySymbols)[*total_currency_symbol_count].flag = 0;
-                    (*currencySymbols)[(*total_currency_symbol_count)++].currencyNameLen = symbol->length();
-                }
-            }
-
-            // Add currency long name.
-            s = ures_getStringByIndex(names, UCURR_LONG_NAME, &len, &ec2);
-            (*currencyNames)[*total_currency_name_count].IsoCode = iso;
-            UChar* upperName = toUpperCase(s, len, locale);
-            (*currencyNames)[*total_currency_name_count].currencyName = upperName;
-            (*currencyNames)[*total_currency_name_count].flag = NEED_TO_BE_DELETED;
-            (*currencyNames)[(*total_currency_name_count)++].currencyNameLen = len;
-
-            // put (iso, 3, and iso) in to array
-            // Add currency ISO code.
-            (*currencySymbols)[*total_currency_symbol_count].IsoCode = iso;
-            (*currencySymbols)[*total_currency_symbol_count].currencyName = (UChar*)uprv_malloc(sizeof(UChar)*3);
-            // Must convert iso[] into Unicode
-            u_charsToUChars(iso, (*currencySymbols)[*total_currency_symbol_count].currencyName, 3);
-            (*currencySymbols)[*total_currency_symbol_count].flag = NEED_TO_BE_DELETED;
-            (*currencySymbols)[(*total_currency_symbol_count)++].currencyNameLen = 3;
-
-            ures_close(names);
-        }
+        visitor.setTable(currencyIsoCodes, localeLevel, FALSE, ec3);
+        visitCurrencyTable(rb, CURRENCIES, visitor, ec2);
 
         // currency plurals
         UErrorCode ec3 = U_ZERO_ERROR;
-        UResourceBundle* curr_p = ures_getByKey(rb, CURRENCYPLURALS, NULL, &ec3);
-        n = ures_getSize(curr_p);
-        for (int32_t i=0; i<n; ++i) {
-            UResourceBundle* names = ures_getByIndex(curr_p, i, NULL, &ec3);
-            iso = (char*)ures_getKey(names);
-            // Using hash to remove duplicated ISO codes in fallback chain.
-            if (localeLevel == 0) {
-                uhash_put(currencyPluralIsoCodes, iso, iso, &ec4); 
-            } else {
-                if (uhash_get(currencyPluralIsoCodes, iso) != NULL) {
-                    ures_close(names);
-                    continue;
-                } else {
-                    uhash_put(currencyPluralIsoCodes, iso, iso, &ec4); 
-                }
-            }
-            int32_t num = ures_getSize(names);
-            int32_t len;
-            for (int32_t j = 0; j < num; ++j) {
-                // TODO: remove duplicates between singular name and 
-                // currency long name?
-                s = ures_getStringByIndex(names, j, &len, &ec3);
-                (*currencyNames)[*total_currency_name_count].IsoCode = iso;
-                UChar* upperName = toUpperCase(s, len, locale);
-                (*currencyNames)[*total_currency_name_count].currencyName = upperName;
-                (*currencyNames)[*total_currency_name_count].flag = NEED_TO_BE_DELETED;
-                (*currencyNames)[(*total_currency_name_count)++].currencyNameLen = len;
-            }
-            ures_close(names);
-        }
-        ures_close(curr_p);
-        ures_close(curr);
+        visitor.setTable(currencyPluralIsoCodes, localeLevel, TRUE, ec4);
+        visitCurrencyTable(rb, CURRENCYPLURALS, visitor, ec3);
         ures_close(rb);
 
         if (!fallback(loc)) {
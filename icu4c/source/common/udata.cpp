@@ -40,6 +40,7 @@ might have to #include some other header
 #include "uhash.h"
 #include "umapfile.h"
 #include "umutex.h"
+#include "ustr_imp.h"
 
 /***********************************************************************
 *
@@ -110,6 +111,16 @@ static u_atomic_int32_t gHaveTriedToLoadCommonData = ATOMIC_INT32_T_INITIALIZER(
 static UHashtable  *gCommonDataCache = NULL;  /* Global hash table of opened ICU data files.  */
 static icu::UInitOnce gCommonDataCacheInitOnce = U_INITONCE_INITIALIZER;
 
+/*
+ * Lock-free mirror of the first entries of gCommonDataCache.
+ * Entries are only appended (under the global mutex) and published by
+ * incrementing the count, so readers need no lock.
+ * Lookups fall back to the locked hash table only when the mirror is full.
+ */
+struct DataCacheElement;
+static const DataCacheElement *gCachedElements[16] = { NULL };
+static u_atomic_int32_t gCachedElementCount = ATOMIC_INT32_T_INITIALIZER(0);
+
 #if U_PLATFORM_HAS_WINUWP_API == 0 
 static UDataFileAccess  gDataFileAccess = UDATA_DEFAULT_ACCESS;  // Access not synchronized.
                                                                  // Modifying is documented as thread-unsafe.
@@ -117,6 +128,16 @@ static UDataFileAccess  gDataFileAccess = UDATA_DEFAULT_ACCESS;  // Access not s
 static UDataFileAccess  gDataFileAccess = UDATA_NO_FILES;        // Windows UWP looks in one spot explicitly
 #endif
 
+static int32_t gMappingHints = UDATA_MAP_NO_HINTS;  // Access not synchronized, like gDataFileAccess.
+
+/*
+ * Names of the ICU data items loaded while UDATA_MAP_RECORD_ITEMS is set.
+ * Maps each name (owned by the table) to its 1-based position in the order of first use.
+ * udata_getRecordedItems() builds the list from it.
+ */
+static UHashtable *gRecordedItems = NULL;
+static UMutex gRecordedItemsMutex = U_MUTEX_INITIALIZER;
+
 static UBool U_CALLCONV
 udata_cleanup(void)
 {
@@ -127,6 +148,7 @@ udata_cleanup(void)
         gCommonDataCache = NULL;        /*   Cleanup is not thread safe.                */
     }
     gCommonDataCacheInitOnce.reset();
+    gCachedElementCount = 0;
 
     for (i = 0; i < UPRV_LENGTHOF(gCommonICUDataArray) && gCommonICUDataArray[i] != NULL; ++i) {
         udata_close(gCommonICUDataArray[i]);
@@ -134,6 +156,9 @@ udata_cleanup(void)
     }
     gHaveTriedToLoadCommonData = 0;
 
+    uhash_close(gRecordedItems);
+    gRecordedItems = NULL;
+
     return TRUE;                   /* Everything was cleaned up */
 }
 
@@ -206,6 +231,17 @@ setCommonICUData(UDataMemory *pData,     /*  The new common data.  Belongs to ca
     return didUpdate;
 }
 
+/*
+ * Apply the package-level mapping hints to newly loaded common data.
+ */
+static void
+adviseCommonData(const UDataMemory *pData) {
+    int32_t hints = gMappingHints & (UDATA_MAP_WILL_NEED|UDATA_MAP_POPULATE|UDATA_MAP_HUGE_PAGES);
+    if (hints != 0) {
+        uprv_adviseMemory(pData->pHeader, udata_getCommonDataExtent(pData), hints);
+    }
+}
+
 #if U_PLATFORM_HAS_WINUWP_API == 0 
 
 static UBool
@@ -214,7 +250,11 @@ setCommonICUDataPointer(const void *pData, UBool /*warn*/, UErrorCode *pErrorCod
     UDataMemory_init(&tData);
     UDataMemory_setData(&tData, pData);
     udata_checkCommonData(&tData, pErrorCode);
-    return setCommonICUData(&tData, FALSE, pErrorCode);
+    UBool didUpdate = setCommonICUData(&tData, FALSE, pErrorCode);
+    if (didUpdate) {
+        adviseCommonData(&tData);
+    }
+    return didUpdate;
 }
 
 #endif
@@ -313,6 +353,16 @@ static UDataMemory *udata_findCachedData(const char *path, UErrorCode &err)
     }
 
     baseName = findBasename(path);   /* Cache remembers only the base name, not the full path. */
+    int32_t count = umtx_loadAcquire(gCachedElementCount);
+    for (int32_t i = 0; i < count; ++i) {
+        if (uprv_strcmp(gCachedElements[i]->name, baseName) == 0) {
+            return gCachedElements[i]->item;
+        }
+    }
+    if (count < UPRV_LENGTHOF(gCachedElements)) {
+        /* Every cached item is in the mirror while it has room. */
+        return NULL;
+    }
     umtx_lock(NULL);
     el = (DataCacheElement *)uhash_get(htable, baseName);
     umtx_unlock(NULL);
@@ -378,6 +428,11 @@ static UDataMemory *udata_cacheDataItem(const char *path, UDataMemory *item, UEr
             newElement->name,               /* Key   */
             newElement,                     /* Value */
             &subErr);
+        int32_t count = gCachedElementCount;
+        if (U_SUCCESS(subErr) && count < UPRV_LENGTHOF(gCachedElements)) {
+            gCachedElements[count] = newElement;
+            umtx_storeRelease(gCachedElementCount, count + 1);
+        }
     }
     umtx_unlock(NULL);
 
@@ -784,6 +839,9 @@ openCommonData(const char *path,          /*  Path from OpenChoice?          */
 
     /* we have mapped a file, check its header */
     udata_checkCommonData(&tData, pErrorCode);
+    if (U_SUCCESS(*pErrorCode)) {
+        adviseCommonData(&tData);
+    }
 
 
     /* Cache the UDataMemory struct for this .dat file,
@@ -793,6 +851,33 @@ openCommonData(const char *path,          /*  Path from OpenChoice?          */
 }
 
 
+/*
+ * Add the name of an ICU data item to the recorded items, if it is not there yet.
+ */
+static void
+recordDataItem(const char *tocEntryName) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    icu::Mutex lock(&gRecordedItemsMutex);
+    if (gRecordedItems == NULL) {
+        gRecordedItems = uhash_open(uhash_hashChars, uhash_compareChars, NULL, &errorCode);
+        if (U_FAILURE(errorCode)) {
+            gRecordedItems = NULL;
+            return;
+        }
+        uhash_setKeyDeleter(gRecordedItems, uprv_free);
+        ucln_common_registerCleanup(UCLN_COMMON_UDATA, udata_cleanup);
+    }
+    if (uhash_geti(gRecordedItems, tocEntryName) == 0) {
+        char *key = uprv_strdup(tocEntryName);
+        if (key == NULL) {
+            return;
+        }
+        /* uhash_puti() deletes the key if it fails */
+        uhash_puti(gRecordedItems, key, uhash_count(gRecordedItems) + 1, &errorCode);
+    }
+}
+
+
 /*----------------------------------------------------------------------*
  *                                                                      *
  *   extendICUData   If the full set of ICU data was not loaded at      *
@@ -1072,6 +1157,9 @@ static UDataMemory *doLoadFromCommonData(UBool isICUData, const char * /*pkgName
                 }
                 if (pEntryData != NULL) {
                     pEntryData->length = length;
+                    if (isICUData && (gMappingHints & UDATA_MAP_RECORD_ITEMS) != 0) {
+                        recordDataItem(tocEntryName);
+                    }
                     return pEntryData;
                 }
             }
@@ -1434,3 +1522,117 @@ U_CAPI void U_EXPORT2 udata_setFileAccess(UDataFileAccess access, UErrorCode * /
     // Note: this function is documented as not thread safe.
     gDataFileAccess = access;
 }
+
+U_CAPI void U_EXPORT2
+udata_setMappingHints(int32_t hints, UErrorCode *status)
+{
+    // Note: this function is documented as not thread safe.
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    gMappingHints = hints;
+}
+
+U_CAPI int32_t U_EXPORT2
+udata_getRecordedItems(char *dest, int32_t capacity, UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    if (capacity < 0 || (dest == NULL && capacity > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    icu::Mutex lock(&gRecordedItemsMutex);
+    int32_t count = gRecordedItems == NULL ? 0 : uhash_count(gRecordedItems);
+    if (count == 0) {
+        return u_terminateChars(dest, capacity, 0, status);
+    }
+    /* put the names in the order of first use, and add up the length with the '\n' separators */
+    icu::MaybeStackArray<const char *, 64> names;
+    if (names.resize(count) == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    int32_t length = count - 1;
+    int32_t pos = UHASH_FIRST;
+    const UHashElement *element;
+    while ((element = uhash_nextElement(gRecordedItems, &pos)) != NULL) {
+        const char *name = (const char *)element->key.pointer;
+        names[element->value.integer - 1] = name;
+        length += (int32_t)uprv_strlen(name);
+    }
+    if (length <= capacity) {
+        char *p = dest;
+        for (int32_t i = 0; i < count; ++i) {
+            if (i > 0) {
+                *p++ = '\n';
+            }
+            int32_t nameLength = (int32_t)uprv_strlen(names[i]);
+            uprv_memcpy(p, names[i], nameLength);
+            p += nameLength;
+        }
+    }
+    return u_terminateChars(dest, capacity, length, status);
+}
+
+U_CAPI void U_EXPORT2
+udata_prefetchItems(const char *items, int32_t length, UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    if (items == NULL ? length != 0 : length < -1) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if (length < 0) {
+        length = (int32_t)uprv_strlen(items);
+    }
+
+    /* Make sure that all of the ICU data packages are loaded. */
+    UErrorCode subErrorCode = U_ZERO_ERROR;
+    UDataMemory *packages[UPRV_LENGTHOF(gCommonICUDataArray)];
+    int32_t packageCount = 0;
+    UBool checkedExtendedICUData = FALSE;
+    while (packageCount < UPRV_LENGTHOF(packages)) {
+        UDataMemory *pCommonData = openCommonData(NULL, packageCount, &subErrorCode);
+        if (pCommonData != NULL) {
+            packages[packageCount++] = pCommonData;
+        } else if (!checkedExtendedICUData && extendICUData(&subErrorCode)) {
+            checkedExtendedICUData = TRUE;
+        } else {
+            break;
+        }
+    }
+
+    icu::CharString name;
+    const char *limit = items + length;
+    while (items < limit) {
+        const char *nameLimit = items;
+        while (nameLimit < limit && *nameLimit != '\n') {
+            ++nameLimit;
+        }
+        UErrorCode errorCode = U_ZERO_ERROR;
+        name.clear().append(items, (int32_t)(nameLimit - items), errorCode);
+        if (U_FAILURE(errorCode)) {
+            *status = errorCode;
+            return;
+        }
+        for (int32_t i = 0; i < packageCount && !name.isEmpty(); ++i) {
+            int32_t itemLength;
+            errorCode = U_ZERO_ERROR;
+            const DataHeader *pHeader =
+                packages[i]->vFuncs->Lookup(packages[i], name.data(), &itemLength, &errorCode);
+            if (pHeader != NULL && U_SUCCESS(errorCode)) {
+                if (itemLength < 0) {
+                    /* the last item of a package: advise at least its header */
+                    itemLength = udata_getHeaderSize(pHeader);
+                }
+                uprv_adviseMemory(pHeader, itemLength, UDATA_MAP_WILL_NEED);
+                break;
+            }
+        }
+        items = nameLimit + 1;
+    }
+}
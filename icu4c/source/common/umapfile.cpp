@@ -76,6 +76,21 @@
 #   define IS_MAP(map) ((map)!=NULL)
 #endif
 
+#if MAP_IMPLEMENTATION==MAP_WIN32 || MAP_IMPLEMENTATION==MAP_POSIX
+    /* Read one byte per page so that all pages of the range are mapped. */
+    static void
+    umap_touchPages(const void *start, int32_t length, int32_t pageSize) {
+        const volatile char *p=(const volatile char *)start;
+        const volatile char *limit=p+length;
+        char sum=0;
+        for(; p<limit; p+=pageSize) {
+            sum^=*p;
+        }
+        sum^=*(limit-1);
+        (void)sum;
+    }
+#endif
+
 /*----------------------------------------------------------------------------*
  *                                                                            *
  *   Memory Mapped File support.  Platform dependent implementation of        *
@@ -92,6 +107,10 @@
     U_CFUNC void uprv_unmapFile(UDataMemory *pData) {
         /* nothing to do */
     }
+
+    U_CFUNC void uprv_adviseMemory(const void * /*start*/, int32_t /*length*/, int32_t /*hints*/) {
+        /* nothing to do */
+    }
 #elif MAP_IMPLEMENTATION==MAP_WIN32
     U_CFUNC UBool
     uprv_mapFile(
@@ -189,6 +208,16 @@
         }
     }
 
+    U_CFUNC void
+    uprv_adviseMemory(const void *start, int32_t length, int32_t hints) {
+        /* Only UDATA_MAP_POPULATE is supported: touch each page. */
+        if((hints&UDATA_MAP_POPULATE)!=0 && start!=NULL && length>0) {
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            umap_touchPages(start, length, (int32_t)info.dwPageSize);
+        }
+    }
+
 
 
 #elif MAP_IMPLEMENTATION==MAP_POSIX
@@ -245,6 +274,42 @@
         }
     }
 
+    U_CFUNC void
+    uprv_adviseMemory(const void *start, int32_t length, int32_t hints) {
+        long pageSize;
+        char *pageStart;
+        size_t pageLength;
+
+        if(start==NULL || length<=0 || (hints&(UDATA_MAP_WILL_NEED|UDATA_MAP_POPULATE|UDATA_MAP_HUGE_PAGES))==0) {
+            return;
+        }
+        pageSize=sysconf(_SC_PAGESIZE);
+        if(pageSize<=0) {
+            return;
+        }
+        /* madvise() requires a page-aligned start address */
+        pageStart=(char *)((size_t)start & ~(size_t)(pageSize-1));
+        pageLength=(size_t)((const char *)start-pageStart)+(size_t)length;
+
+        /* The advice is best-effort: errors are ignored. */
+#if defined(MADV_HUGEPAGE)
+        if((hints&UDATA_MAP_HUGE_PAGES)!=0) {
+            madvise(pageStart, pageLength, MADV_HUGEPAGE);
+        }
+#endif
+        if((hints&(UDATA_MAP_WILL_NEED|UDATA_MAP_POPULATE))!=0) {
+            posix_madvise(pageStart, pageLength, POSIX_MADV_WILLNEED);
+        }
+        if((hints&UDATA_MAP_POPULATE)!=0) {
+#if defined(MADV_POPULATE_READ)
+            if(madvise(pageStart, pageLength, MADV_POPULATE_READ)==0) {
+                return;
+            }
+#endif
+            umap_touchPages(pageStart, (int32_t)pageLength, (int32_t)pageSize);
+        }
+    }
+
 
 
 #elif MAP_IMPLEMENTATION==MAP_STDIO
@@ -313,6 +378,11 @@
         }
     }
 
+    U_CFUNC void
+    uprv_adviseMemory(const void * /*start*/, int32_t /*length*/, int32_t /*hints*/) {
+        /* nothing to do: the whole file was read into memory */
+    }
+
 
 #elif MAP_IMPLEMENTATION==MAP_390DLL
     /*  390 specific Library Loading.
@@ -493,6 +563,10 @@
         }   
     }
 
+    U_CFUNC void uprv_adviseMemory(const void * /*start*/, int32_t /*length*/, int32_t /*hints*/) {
+        /* nothing to do */
+    }
+
 #else
 #   error MAP_IMPLEMENTATION is set incorrectly
 #endif
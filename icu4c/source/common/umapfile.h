@@ -32,6 +32,12 @@
 U_CFUNC UBool uprv_mapFile(UDataMemory *pdm, const char *path);
 U_CFUNC void  uprv_unmapFile(UDataMemory *pData);
 
+/**
+ * Applies UDataMappingHint bits to a range of memory-mapped or linked-in data.
+ * The range need not be page-aligned. Unsupported hints are ignored.
+ */
+U_CFUNC void  uprv_adviseMemory(const void *start, int32_t length, int32_t hints);
+
 /* MAP_NONE: no memory mapping, no file access at all */
 #define MAP_NONE        0
 #define MAP_WIN32       1
@@ -342,6 +342,38 @@ public:
     */
     virtual int32_t getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UErrorCode &status);
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft method since it is virtual. */
+    /**
+     * Find all of the boundaries in the text, from its start to its end,
+     * and store them into a caller-provided array, together with their rule status values.
+     * The result is the same as that of iterating with first() and next(),
+     * calling getRuleStatus() at each boundary, but for RuleBasedBreakIterator
+     * it is considerably faster because the boundaries are not cached for
+     * random access by the iterator.
+     * <p>
+     * The boundaries include the start and the end of the text.
+     * Supports preflighting with dest=NULL, ruleStatus=NULL and capacity=0.
+     * If capacity is insufficient, then the arrays are filled up to capacity,
+     * a U_BUFFER_OVERFLOW_ERROR is signaled, and the total number of boundaries is returned.
+     * <p>
+     * After this function returns, the iteration position is at the start of the text.
+     *
+     * @param dest       an array to be filled in with the boundary positions,
+     *                   in ascending order.
+     * @param ruleStatus an array to be filled in with the rule status value
+     *                   (as from getRuleStatus()) for each boundary in dest;
+     *                   can be NULL if the status values are not needed.
+     * @param capacity   the length of dest, and of ruleStatus if not NULL.
+     * @param status     receives error codes.
+     * @return           the number of boundaries in the text.
+     * @see first
+     * @see next
+     * @see getRuleStatus
+     * @draft ICU 63
+     */
+    virtual int32_t getAllBoundaries(int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                                     UErrorCode &status);
+
     /**
      * Create BreakIterator for word-breaks using the given locale.
      * Returns an instance of a BreakIterator implementing word breaks.
@@ -456,6 +488,45 @@ public:
     static BreakIterator* U_EXPORT2
     createTitleInstance(const Locale& where, UErrorCode& status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Returns a BreakIterator of the given type for the given locale, reusing
+     * one that was returned with releaseInstance() if possible.
+     * A reused BreakIterator is in the same state as a newly created one,
+     * with empty text; its internal caches are kept, so that reusing it
+     * does not allocate memory.
+     * Otherwise this function creates a new BreakIterator like
+     * createWordInstance() etc.
+     *
+     * Released BreakIterators are pooled by type and requested locale ID.
+     * Acquiring and releasing a pooled BreakIterator does not lock a mutex.
+     *
+     * @param type  the type of BreakIterator.
+     * @param where the locale.
+     * @param status The error code.
+     * @return A BreakIterator; release it with releaseInstance(), or delete it.
+     * @see releaseInstance
+     * @draft ICU 63
+     */
+    static BreakIterator* U_EXPORT2
+    acquireInstance(UBreakIteratorType type, const Locale& where, UErrorCode& status);
+
+    /**
+     * Returns a BreakIterator to the pool for reuse by acquireInstance(),
+     * or deletes it if it cannot be pooled.
+     * Only BreakIterators that were returned by acquireInstance(), and their clones,
+     * are pooled, and only while the pool has room.
+     * The BreakIterator must not be used after this call.
+     *
+     * u_cleanup() and registerInstance() delete all pooled BreakIterators.
+     *
+     * @param bi the BreakIterator; can be NULL.
+     * @see acquireInstance
+     * @draft ICU 63
+     */
+    static void U_EXPORT2 releaseInstance(BreakIterator* bi);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Get the set of Locales for which TextBoundaries are installed.
      * <p><b>Note:</b> this will not return locales added through the register
@@ -641,6 +712,8 @@ private:
     /** @internal (private) */
     char actualLocale[ULOC_FULLNAME_CAPACITY];
     char validLocale[ULOC_FULLNAME_CAPACITY];
+    /** @internal (private) 1-based index of the acquireInstance() pool key (type and requested locale), or 0. */
+    int32_t poolKeyIndex;
 };
 
 #ifndef U_HIDE_DEPRECATED_API
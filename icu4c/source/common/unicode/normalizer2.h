@@ -225,7 +225,8 @@ public:
      *
      * Currently implemented completely only for "compose" modes,
      * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS),
+     * and for "decompose" modes such as NFD and NFKD (UNORM2_DECOMPOSE).
      * Otherwise currently converts to & from UTF-16 and does not support edits.
      *
      * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT and U_EDITS_NO_RESET.
@@ -382,7 +383,8 @@ public:
      * This works for all normalization modes,
      * but it is currently optimized for UTF-8 only for "compose" modes,
      * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS),
+     * and for "decompose" modes such as NFD and NFKD (UNORM2_DECOMPOSE).
      * For other modes it currently converts to UTF-16 and calls isNormalized().
      *
      * @param s UTF-8 input string
@@ -543,7 +545,8 @@ public:
      *
      * Currently implemented completely only for "compose" modes,
      * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS),
+     * and for "decompose" modes such as NFD and NFKD (UNORM2_DECOMPOSE).
      * Otherwise currently converts to & from UTF-16 and does not support edits.
      *
      * @param options   Options bit set, usually 0. See U_OMIT_UNCHANGED_TEXT and U_EDITS_NO_RESET.
@@ -677,7 +680,8 @@ public:
      * This works for all normalization modes,
      * but it is currently optimized for UTF-8 only for "compose" modes,
      * such as for NFC, NFKC, and NFKC_Casefold
-     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS).
+     * (UNORM2_COMPOSE and UNORM2_COMPOSE_CONTIGUOUS),
+     * and for "decompose" modes such as NFD and NFKD (UNORM2_DECOMPOSE).
      * For other modes it currently converts to UTF-16 and calls isNormalized().
      *
      * @param s UTF-8 input string
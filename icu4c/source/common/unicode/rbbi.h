@@ -59,6 +59,14 @@ private:
      */
     UText  fText;
 
+    /**
+     * The length of the text if fText holds all of it in one UTF-16 chunk
+     * with native indexes equal to UTF-16 indexes, as for a UnicodeString;
+     * otherwise -1. handleNext() then reads the chunk directly.
+     * @internal (private)
+     */
+    int32_t fTextUTF16Length;
+
 #ifndef U_HIDE_INTERNAL_API
 public:
 #endif /* U_HIDE_INTERNAL_API */
@@ -83,6 +91,7 @@ private:
 
     /**
      *   Cache of previously determined boundary positions.
+     *   Allocated on first use.
      */
     class BreakCache;
     BreakCache         *fBreakCache;
@@ -90,6 +99,7 @@ private:
     /**
      *  Cache of boundary positions within a region of text that has been
      *  sub-divided by dictionary based breaking.
+     *  Allocated on first use.
      */
     class DictionaryCache;
     DictionaryCache *fDictionaryCache;
@@ -510,6 +520,63 @@ public:
     */
     virtual int32_t getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UErrorCode &status);
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft method since it is virtual. */
+    /**
+     * Find all of the boundaries in the text, from its start to its end,
+     * and store them into a caller-provided array, together with their rule status values.
+     * This runs the rules straight through the text, without adding
+     * the boundaries to the iterator's cache.
+     *
+     * @param dest       an array to be filled in with the boundary positions.
+     * @param ruleStatus an array to be filled in with the rule status value
+     *                   for each boundary in dest; can be NULL.
+     * @param capacity   the length of dest, and of ruleStatus if not NULL.
+     * @param status     receives error codes.
+     * @return           the number of boundaries in the text.
+     * @see BreakIterator::getAllBoundaries
+     * @draft ICU 63
+     */
+    virtual int32_t getAllBoundaries(int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                                     UErrorCode &status);
+
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Find all of the boundaries in the text, like getAllBoundaries(),
+     * sharing the work among several concurrent tasks.
+     *
+     * A long text is split into chunks. The chunks are segmented by tasks that the
+     * runner calls, each with its own clone of this iterator, starting from a safe
+     * position found with the reverse rules just before each chunk. The chunks are
+     * then joined at the first boundary where neighboring runs agree, so the results
+     * are identical to those of getAllBoundaries().
+     *
+     * ICU does not start threads itself. The caller passes a UBreakIteratorRunner,
+     * for example one that runs the tasks on a thread pool.
+     * A short text, or a NULL runner, is segmented on the calling thread.
+     *
+     * The text must be safe to read concurrently through shallow clones of its UText,
+     * as are all of the UText implementations provided by ICU.
+     *
+     * @param dest       an array to be filled in with the boundary positions.
+     * @param ruleStatus an array to be filled in with the rule status value
+     *                   for each boundary in dest; can be NULL.
+     * @param capacity   the length of dest, and of ruleStatus if not NULL.
+     * @param maxTasks   the maximum number of tasks to pass to the runner,
+     *                   for example the number of threads in its pool.
+     * @param runner     runs the segmentation tasks; if NULL, then the text is
+     *                   segmented on this thread like getAllBoundaries() does.
+     * @param runnerContext the context pointer for the runner.
+     * @param status     receives error codes.
+     * @return           the number of boundaries in the text.
+     * @see getAllBoundaries
+     * @draft ICU 63
+     */
+    int32_t getAllBoundariesParallel(int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                                     int32_t maxTasks,
+                                     UBreakIteratorRunner *runner, const void *runnerContext,
+                                     UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Returns a unique class ID POLYMORPHICALLY.  Pure virtual override.
      * This method is to implement a simple version of RTTI, since not all
@@ -631,6 +698,33 @@ private:
       */
     void init(UErrorCode &status);
 
+    /**
+     * Allocate the break cache if this iterator does not have one yet,
+     * holding only the current boundary.
+     * @return FALSE if out of memory.
+     * @internal (private)
+     */
+    UBool initBreakCache();
+
+    /**
+     * Allocate the dictionary cache if this iterator does not have one yet.
+     * @return FALSE if out of memory.
+     * @internal (private)
+     */
+    UBool initDictionaryCache();
+
+    /**
+     * Reset the caches that have been allocated, for new text.
+     * @internal (private)
+     */
+    void resetCaches();
+
+    /**
+     * Set fTextUTF16Length after fText changed.
+     * @internal (private)
+     */
+    void checkUTF16Text();
+
     /**
      * Iterate backwards from an arbitrary position in the input text using the
      * synthesized Safe Reverse rules.
@@ -656,6 +750,52 @@ private:
      */
     int32_t handleNext();
 
+    /**
+     * The state machine loop of handleNext(), reading the text with a
+     * TextReader that is specialized for how the text is stored.
+     * @param text A reader positioned at fPosition.
+     * @internal (private)
+     */
+    template<typename TextReader>
+    int32_t handleNextLoop(TextReader &text);
+
+    /**
+     * The boundaries from one run of the rules over a chunk of the text,
+     * for getAllBoundariesParallel().
+     * @internal (private)
+     */
+    struct BoundaryRun;
+
+    /**
+     * The chunks of the text and their runs, shared by the tasks of
+     * getAllBoundariesParallel().
+     * @internal (private)
+     */
+    struct ParallelSegmentation;
+
+    /**
+     * Run the rules from start, as getAllBoundaries() does from the start of the text,
+     * until reaching a boundary at or after limit from which the following
+     * boundary is found with handleNext().
+     * @internal (private)
+     */
+    void collectBoundaries(int32_t start, int32_t limit, BoundaryRun &run, UErrorCode &status);
+
+    /**
+     * Segment chunks for getAllBoundariesParallel() until all of them have been taken.
+     * @internal (private)
+     */
+    void collectChunks(ParallelSegmentation *segmentation, UErrorCode *status);
+
+    /**
+     * UBreakIteratorTask for getAllBoundariesParallel():
+     * Calls collectChunks() on the iterator for the task index.
+     * @param context the ParallelSegmentation
+     * @param index the task index
+     * @internal (private)
+     */
+    static void U_CALLCONV collectChunksTask(void *context, int32_t index);
+
 
     /**
      * This function returns the appropriate LanguageBreakEngine for a
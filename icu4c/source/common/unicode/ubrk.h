@@ -356,6 +356,51 @@ U_NAMESPACE_END
 
 #endif
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Returns a UBreakIterator of the given type for the given locale, reusing one
+ * that was returned with ubrk_release() if possible, and sets its text.
+ * A reused UBreakIterator is in the same state as a newly opened one;
+ * its internal caches are kept, so that reusing it does not allocate memory.
+ * Otherwise this function opens a new UBreakIterator like ubrk_open().
+ *
+ * Released break iterators are pooled by type and locale ID.
+ * Acquiring and releasing a pooled break iterator does not lock a mutex.
+ *
+ * @param type       The type of UBreakIterator, see ubrk_open().
+ * @param locale     The locale specifying the text-breaking conventions.
+ * @param text       The text to be iterated over. May be null, in which case
+ *                   ubrk_setText() is used to specify the text to be iterated.
+ * @param textLength The number of characters in text, or -1 if null-terminated.
+ * @param status     A UErrorCode to receive any errors.
+ * @return A UBreakIterator; release it with ubrk_release() or close it with ubrk_close().
+ * @see ubrk_release
+ * @see ubrk_open
+ * @draft ICU 63
+ */
+U_DRAFT UBreakIterator* U_EXPORT2
+ubrk_acquire(UBreakIteratorType type,
+             const char *locale,
+             const UChar *text,
+             int32_t textLength,
+             UErrorCode *status);
+
+/**
+ * Returns a UBreakIterator to the pool for reuse by ubrk_acquire(),
+ * or closes it if it cannot be pooled.
+ * Only break iterators that were returned by ubrk_acquire(), and their clones,
+ * are pooled, and only while the pool has room.
+ * The UBreakIterator must not be used after this call.
+ *
+ * @param bi The break iterator; can be NULL.
+ * @see ubrk_acquire
+ * @see ubrk_close
+ * @draft ICU 63
+ */
+U_DRAFT void U_EXPORT2
+ubrk_release(UBreakIterator *bi);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Sets an existing iterator to point to a new piece of text.
  * The break iterator retains a pointer to the supplied text.
@@ -623,6 +668,100 @@ ubrk_getBinaryRules(UBreakIterator *bi,
                     uint8_t *       binaryRules, int32_t rulesCapacity,
                     UErrorCode *    status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Find all of the boundaries in the text, from its start to its end,
+ * and store them into a caller-provided array, together with their rule status values.
+ * The result is the same as that of iterating with ubrk_first() and ubrk_next(),
+ * calling ubrk_getRuleStatus() at each boundary, but considerably faster
+ * because the boundaries are not cached for random access by the iterator.
+ * The boundaries include the start and the end of the text.
+ * Supports preflighting (with dest=NULL, ruleStatus=NULL and capacity=0).
+ * After this function returns, the iteration position is at the start of the text.
+ *
+ * @param bi         The break iterator to use.
+ * @param dest       Buffer to receive the boundary positions, in ascending order;
+ *                   set to NULL for preflighting.
+ * @param ruleStatus Buffer to receive the rule status value for each boundary in dest;
+ *                   can be NULL if the status values are not needed.
+ * @param capacity   Capacity of dest, and of ruleStatus if not NULL;
+ *                   set to 0 for preflighting. Must be >= 0.
+ * @param status     Pointer to UErrorCode to receive any errors, such as
+ *                   U_BUFFER_OVERFLOW_ERROR or U_ILLEGAL_ARGUMENT_ERROR.
+ * @return           The number of boundaries in the text. If this is larger than
+ *                   capacity, *status is set to U_BUFFER_OVERFLOW_ERROR.
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_getAllBoundaries(UBreakIterator *bi,
+                      int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                      UErrorCode *status);
+
+/**
+ * Task function for UBreakIteratorRunner.
+ * @param context the taskContext passed into the runner
+ * @param index the index of the task
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UBreakIteratorTask(void *context, int32_t index);
+
+/**
+ * Function type for running independent segmentation tasks,
+ * for example on a thread pool.
+ * It must call task(taskContext, i) exactly once for each i from 0 to count-1,
+ * in any order and possibly concurrently, and return only after all calls have returned.
+ *
+ * @param context the runnerContext passed into ubrk_getAllBoundariesParallel()
+ * @param task the task function
+ * @param taskContext the context for the task function
+ * @param count the number of tasks
+ * @see ubrk_getAllBoundariesParallel
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UBreakIteratorRunner(const void *context,
+                                             UBreakIteratorTask *task, void *taskContext,
+                                             int32_t count);
+
+/**
+ * Find all of the boundaries in the text, like ubrk_getAllBoundaries(),
+ * sharing the work of segmenting a long text among several concurrent tasks.
+ * The text is split into chunks that are segmented by the tasks, each starting
+ * from a safe position found with the reverse rules, and the chunks are joined
+ * so that the results are identical to those of ubrk_getAllBoundaries().
+ *
+ * ICU does not start threads itself. The caller passes a UBreakIteratorRunner,
+ * for example one that runs the tasks on a thread pool.
+ * A short text, a NULL runner, or a break iterator that is not rule-based
+ * is segmented on the calling thread.
+ * After this function returns, the iteration position is at the start of the text.
+ *
+ * @param bi         The break iterator to use.
+ * @param dest       Buffer to receive the boundary positions, in ascending order;
+ *                   set to NULL for preflighting.
+ * @param ruleStatus Buffer to receive the rule status value for each boundary in dest;
+ *                   can be NULL if the status values are not needed.
+ * @param capacity   Capacity of dest, and of ruleStatus if not NULL;
+ *                   set to 0 for preflighting. Must be >= 0.
+ * @param maxTasks   The maximum number of tasks to pass to the runner,
+ *                   for example the number of threads in its pool.
+ * @param runner     Runs the segmentation tasks; if NULL, then the text is
+ *                   segmented on this thread like ubrk_getAllBoundaries() does.
+ * @param runnerContext The context pointer for the runner.
+ * @param status     Pointer to UErrorCode to receive any errors, such as
+ *                   U_BUFFER_OVERFLOW_ERROR or U_ILLEGAL_ARGUMENT_ERROR.
+ * @return           The number of boundaries in the text. If this is larger than
+ *                   capacity, *status is set to U_BUFFER_OVERFLOW_ERROR.
+ * @see ubrk_getAllBoundaries
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_getAllBoundariesParallel(UBreakIterator *bi,
+                              int32_t *dest, int32_t *ruleStatus, int32_t capacity,
+                              int32_t maxTasks,
+                              UBreakIteratorRunner *runner, const void *runnerContext,
+                              UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
 
 #endif
@@ -0,0 +1,94 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   file name:  ucache.h
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*/
+
+#ifndef UCACHE_H
+#define UCACHE_H
+
+#include "unicode/utypes.h"
+
+/**
+ * \file
+ * \brief C API: Statistics of the ICU object cache.
+ *
+ * ICU shares immutable objects that are expensive to create, such as
+ * the number format data, plural rules, calendars, date format symbols,
+ * collation tailorings and measure and relative date/time format data of
+ * each locale, through an internal cache. Unused objects are evicted
+ * when the cache grows beyond its limits.
+ *
+ * These functions report how often each type of object was found in the
+ * cache, had to be created, and was evicted, so that an application can
+ * tell whether it creates more distinct objects than the cache holds.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Cache statistics for one type of cached object.
+ * @see ucache_getStatistics
+ * @draft ICU 63
+ */
+typedef struct UCacheStatistics {
+    /**
+     * The name of the cache key type. It identifies the type of the cached
+     * object, but its format is implementation-specific.
+     * Valid until u_cleanup().
+     * @draft ICU 63
+     */
+    const char *keyType;
+    /**
+     * Number of lookups that found an object in the cache.
+     * @draft ICU 63
+     */
+    int64_t hits;
+    /**
+     * Number of lookups that had to create the object.
+     * @draft ICU 63
+     */
+    int64_t misses;
+    /**
+     * Number of objects evicted automatically to keep the cache within its limits.
+     * @draft ICU 63
+     */
+    int64_t evictions;
+} UCacheStatistics;
+
+/**
+ * Turns collection of cache statistics on or off.
+ * Collection is off by default because it costs a hash table lookup
+ * on every cache access.
+ * Turning collection off keeps the counts collected so far.
+ *
+ * @param enabled TRUE to collect statistics
+ * @param status ICU error code. Set to an error if the cache cannot be created.
+ * @draft ICU 63
+ */
+U_DRAFT void U_EXPORT2
+ucache_setStatisticsEnabled(UBool enabled, UErrorCode *status);
+
+/**
+ * Fetches the hit, miss and eviction counts of each type of cached object
+ * seen while statistics collection was on.
+ *
+ * @param dest receives one entry per type, in no particular order.
+ *             Can be NULL if capacity is 0, for preflighting.
+ * @param capacity the number of entries that dest can hold
+ * @param status ICU error code. Set to U_BUFFER_OVERFLOW_ERROR
+ *               if there are more than capacity types.
+ * @return the number of types
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ucache_getStatistics(UCacheStatistics *dest, int32_t capacity, UErrorCode *status);
+
+#endif  /* U_HIDE_DRAFT_API */
+
+#endif
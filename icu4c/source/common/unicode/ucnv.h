@@ -589,6 +589,52 @@ U_NAMESPACE_END
 
 #endif
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Returns a converter for the given name, reusing one that was returned
+ * with ucnv_release() if possible.
+ * A reused converter is in the same state as a newly opened one:
+ * It has been reset and has the default callbacks and substitution character.
+ * Otherwise this function opens a new converter like ucnv_open().
+ *
+ * Released converters are pooled by their canonical name and the options
+ * in converterName, so different aliases of the same converter
+ * share pooled converters.
+ * Converter names with different options do not share pooled converters,
+ * even if ucnv_getName() returns the same name for both.
+ * Acquiring and releasing a pooled converter does not lock a mutex
+ * and does not allocate memory.
+ *
+ * @param converterName name of the converter, see ucnv_open()
+ * @param err error status
+ * @return the converter; release it with ucnv_release() or close it with ucnv_close()
+ * @see ucnv_release
+ * @see ucnv_open
+ * @draft ICU 63
+ */
+U_DRAFT UConverter * U_EXPORT2
+ucnv_acquire(const char *converterName, UErrorCode *err);
+
+/**
+ * Returns a converter to the pool for reuse by ucnv_acquire(),
+ * or closes it if it cannot be pooled.
+ * Converters with custom callbacks, a custom substitution string or fallbacks
+ * turned on are closed rather than pooled, as are converters
+ * that were not returned by ucnv_acquire() (or cloned from such a converter)
+ * and converters that do not fit into the pool.
+ * The converter must not be used after this call.
+ *
+ * ucnv_flushCache() closes all pooled converters.
+ *
+ * @param cnv the converter; can be NULL
+ * @see ucnv_acquire
+ * @see ucnv_close
+ * @draft ICU 63
+ */
+U_DRAFT void U_EXPORT2
+ucnv_release(UConverter *cnv);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Fills in the output parameter, subChars, with the substitution characters
  * as multiple bytes.
@@ -1284,6 +1330,114 @@ ucnv_toUChars(UConverter *cnv,
               const char *src, int32_t srcLength,
               UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Splits a codepage string into chunks that can be converted to Unicode independently.
+ * Each chunk ends at a character boundary where the converter is in its initial state,
+ * so that converting each chunk with a reset converter and concatenating the results
+ * yields the same Unicode string as converting the whole string at once.
+ *
+ * The chunks are about srcLength/maxChunks bytes long; they are longer
+ * where there is no suitable boundary nearby, and then there are fewer chunks.
+ * Conversion can be split for SBCS, US-ASCII, ISO-8859-1, UTF-8,
+ * UTF-16BE/LE, UTF-32BE/LE, and for DBCS and MBCS codepages like Shift-JIS and GB18030
+ * after bytes that always end a character (typically ASCII controls and punctuation).
+ * For other converters, including stateful ones like ISO-2022-JP,
+ * the whole string is returned as one chunk.
+ *
+ * This is also useful for streaming conversion of large inputs:
+ * Input up to the last chunk limit can be converted and the rest carried over.
+ *
+ * @param cnv the converter object; it is not modified
+ * @param src the input codepage string
+ * @param srcLength the input string length, or -1 if NUL-terminated
+ * @param maxChunks the maximum number of chunks; must be at least 1
+ * @param limits array of maxChunks chunk limits, filled in by this function:
+ *               chunk i is src[limits[i-1]..limits[i]-1] (with limits[-1]=0)
+ *               and the last limit is srcLength
+ * @param pErrorCode normal ICU error code
+ * @return the number of chunks, at most maxChunks; 1 if the string is empty
+ * @see ucnv_toUCharsInChunks
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_getToUChunkLimits(const UConverter *cnv,
+                       const char *src, int32_t srcLength,
+                       int32_t maxChunks, int32_t limits[],
+                       UErrorCode *pErrorCode);
+
+/**
+ * Task function for UConverterChunkRunner.
+ * @param context the taskContext passed into the runner
+ * @param index the index of the task
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UConverterChunkTask(void *context, int32_t index);
+
+/**
+ * Function type for running independent conversion tasks,
+ * for example on a thread pool.
+ * It must call task(taskContext, i) exactly once for each i from 0 to count-1,
+ * in any order and possibly concurrently, and return only after all calls have returned.
+ *
+ * @param context the runnerContext passed into ucnv_toUCharsInChunks()
+ * @param task the task function
+ * @param taskContext the context for the task function
+ * @param count the number of tasks
+ * @see ucnv_toUCharsInChunks
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UConverterChunkRunner(const void *context,
+                                              UConverterChunkTask *task, void *taskContext,
+                                              int32_t count);
+
+/**
+ * Converts a codepage string into a Unicode string, like ucnv_toUChars(),
+ * by splitting the input with ucnv_getToUChunkLimits() and converting the chunks
+ * independently with clones of the converter.
+ * If a runner is provided, then the chunks can be converted concurrently,
+ * which makes the conversion of large inputs much faster on multi-core machines.
+ * Chunks should be large, at least tens of kilobytes each.
+ * If destCapacity is at least srcLength+16*maxChunks, then the chunks are usually
+ * converted directly into dest, otherwise into temporary buffers.
+ *
+ * The converter's toUnicode callback and its context are used for all chunks,
+ * possibly concurrently. The standard callbacks are fine.
+ * If a chunk fails, then the error of the first failing chunk is returned
+ * and the contents of dest and offsets are undefined.
+ *
+ * @param cnv the converter object to be used; it is not modified
+ * @param dest destination string buffer, can be NULL if destCapacity==0
+ * @param destCapacity the number of UChars available at dest
+ * @param offsets if not NULL, then an array of destCapacity offsets is filled in
+ *                with the index of the source byte for each output UChar,
+ *                like ucnv_toUnicode() does; can be NULL
+ * @param src the input codepage string
+ * @param srcLength the input string length, or -1 if NUL-terminated
+ * @param maxChunks the maximum number of chunks, for example the number of threads
+ * @param runner runs the conversion tasks; if NULL, then the chunks are converted
+ *               one after the other on this thread
+ * @param runnerContext the context pointer for the runner
+ * @param pErrorCode normal ICU error code;
+ *                  common error codes that may be set by this function include
+ *                  U_BUFFER_OVERFLOW_ERROR, U_STRING_NOT_TERMINATED_WARNING,
+ *                  U_ILLEGAL_ARGUMENT_ERROR, and conversion errors
+ * @return the length of the output string, not counting the terminating NUL;
+ *         if the length is greater than destCapacity, then the string will not fit
+ *         and a buffer of the indicated length would need to be passed in
+ * @see ucnv_toUChars
+ * @see ucnv_getToUChunkLimits
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_toUCharsInChunks(const UConverter *cnv,
+                      UChar *dest, int32_t destCapacity, int32_t *offsets,
+                      const char *src, int32_t srcLength,
+                      int32_t maxChunks,
+                      UConverterChunkRunner *runner, const void *runnerContext,
+                      UErrorCode *pErrorCode);
+#endif  // U_HIDE_DRAFT_API
+
 /**
  * Convert a codepage buffer into Unicode one character at a time.
  * The input is completely consumed when the U_INDEX_OUTOFBOUNDS_ERROR is set.
@@ -1677,6 +1831,7 @@ ucnv_fromAlgorithmic(UConverter *cnv,
 
 /**
  * Frees up memory occupied by unused, cached converter shared data.
+ * Also closes the converters that were pooled by ucnv_release().
  *
  * @return the number of cached converters successfully deleted
  * @see ucnv_close
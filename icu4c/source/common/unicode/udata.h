@@ -432,6 +432,93 @@ typedef enum UDataFileAccess {
 U_STABLE void U_EXPORT2
 udata_setFileAccess(UDataFileAccess access, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Bit flags for udata_setMappingHints().
+ * They tell ICU how to treat the memory of data packages (.dat files and
+ * the data library), in order to avoid page faults spread across the first uses
+ * of many data items. All hints are ignored where the platform does not support them.
+ * @see udata_setMappingHints
+ * @draft ICU 63
+ */
+typedef enum UDataMappingHint {
+    /** No hints; the operating system pages in data on first use. (default) @draft ICU 63 */
+    UDATA_MAP_NO_HINTS = 0,
+    /**
+     * Ask the operating system to read ahead the whole package
+     * when it is loaded, for example with madvise(MADV_WILLNEED).
+     * @draft ICU 63
+     */
+    UDATA_MAP_WILL_NEED = 1,
+    /**
+     * Map all pages of the package when it is loaded, so that
+     * later data accesses do not take page faults.
+     * This blocks until the package has been read.
+     * @draft ICU 63
+     */
+    UDATA_MAP_POPULATE = 2,
+    /**
+     * Ask for transparent huge pages for the package where possible,
+     * for example with madvise(MADV_HUGEPAGE).
+     * @draft ICU 63
+     */
+    UDATA_MAP_HUGE_PAGES = 4,
+    /**
+     * Record the names of the data items loaded from packages,
+     * so that they can be prefetched on the next start.
+     * @see udata_getRecordedItems
+     * @see udata_prefetchItems
+     * @draft ICU 63
+     */
+    UDATA_MAP_RECORD_ITEMS = 8
+} UDataMappingHint;
+
+/**
+ * This function may be called to control how ICU treats the memory of data packages.
+ * Like udata_setFileAccess(), it should be called before any ICU data is loaded:
+ * The memory hints apply to packages loaded afterwards, and only
+ * items loaded afterwards are recorded.
+ * This function is not multithread safe.
+ * @param hints A bit set of UDataMappingHint values.
+ * @param status Error code.
+ * @see UDataMappingHint
+ * @draft ICU 63
+ */
+U_DRAFT void U_EXPORT2
+udata_setMappingHints(int32_t hints, UErrorCode *status);
+
+/**
+ * Returns the names of the data items that were loaded from ICU data packages
+ * while UDATA_MAP_RECORD_ITEMS was set, in the order of their first use.
+ * The names are separated by newline characters ('\n')
+ * and can be passed to udata_prefetchItems() on the next start.
+ * The string is NUL-terminated if there is space for the NUL.
+ * @param dest Destination buffer. Can be NULL if capacity is 0 for preflighting.
+ * @param capacity Number of chars in dest.
+ * @param status Error code. Set to U_BUFFER_OVERFLOW_ERROR if dest is too short.
+ * @return the length of the list of names
+ * @see UDATA_MAP_RECORD_ITEMS
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+udata_getRecordedItems(char *dest, int32_t capacity, UErrorCode *status);
+
+/**
+ * Asks the operating system to read ahead the memory of the named ICU data items,
+ * for example with madvise(MADV_WILLNEED), and returns without waiting for it.
+ * This loads the ICU data packages if they are not loaded yet.
+ * Names that are not found in the ICU data packages are ignored.
+ * @param items Data item names separated by newline characters ('\n'),
+ *              as returned by udata_getRecordedItems().
+ * @param length Length of items, or -1 if it is NUL-terminated.
+ * @param status Error code.
+ * @see udata_getRecordedItems
+ * @draft ICU 63
+ */
+U_DRAFT void U_EXPORT2
+udata_prefetchItems(const char *items, int32_t length, UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 U_CDECL_END
 
 #endif
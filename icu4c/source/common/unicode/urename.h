@@ -193,6 +193,7 @@
 #define res_getString U_ICU_ENTRY_POINT_RENAME(res_getString)
 #define res_getTableItemByIndex U_ICU_ENTRY_POINT_RENAME(res_getTableItemByIndex)
 #define res_getTableItemByKey U_ICU_ENTRY_POINT_RENAME(res_getTableItemByKey)
+#define res_getUTF8String U_ICU_ENTRY_POINT_RENAME(res_getUTF8String)
 #define res_load U_ICU_ENTRY_POINT_RENAME(res_load)
 #define res_read U_ICU_ENTRY_POINT_RENAME(res_read)
 #define res_unload U_ICU_ENTRY_POINT_RENAME(res_unload)
@@ -213,6 +214,7 @@
 #define u_charsToUChars U_ICU_ENTRY_POINT_RENAME(u_charsToUChars)
 #define u_cleanup U_ICU_ENTRY_POINT_RENAME(u_cleanup)
 #define u_countChar32 U_ICU_ENTRY_POINT_RENAME(u_countChar32)
+#define u_countUTF8CodePoints U_ICU_ENTRY_POINT_RENAME(u_countUTF8CodePoints)
 #define u_digit U_ICU_ENTRY_POINT_RENAME(u_digit)
 #define u_enumCharNames U_ICU_ENTRY_POINT_RENAME(u_enumCharNames)
 #define u_enumCharTypes U_ICU_ENTRY_POINT_RENAME(u_enumCharTypes)
@@ -396,6 +398,7 @@
 #define u_uastrncpy U_ICU_ENTRY_POINT_RENAME(u_uastrncpy)
 #define u_unescape U_ICU_ENTRY_POINT_RENAME(u_unescape)
 #define u_unescapeAt U_ICU_ENTRY_POINT_RENAME(u_unescapeAt)
+#define u_validateUTF8 U_ICU_ENTRY_POINT_RENAME(u_validateUTF8)
 #define u_versionFromString U_ICU_ENTRY_POINT_RENAME(u_versionFromString)
 #define u_versionFromUString U_ICU_ENTRY_POINT_RENAME(u_versionFromUString)
 #define u_versionToString U_ICU_ENTRY_POINT_RENAME(u_versionToString)
@@ -413,6 +416,7 @@
 #define u_vsprintf_u U_ICU_ENTRY_POINT_RENAME(u_vsprintf_u)
 #define u_vsscanf U_ICU_ENTRY_POINT_RENAME(u_vsscanf)
 #define u_vsscanf_u U_ICU_ENTRY_POINT_RENAME(u_vsscanf_u)
+#define u_warmup U_ICU_ENTRY_POINT_RENAME(u_warmup)
 #define u_writeIdenticalLevelRun U_ICU_ENTRY_POINT_RENAME(u_writeIdenticalLevelRun)
 #define ubidi_addPropertyStarts U_ICU_ENTRY_POINT_RENAME(ubidi_addPropertyStarts)
 #define ubidi_close U_ICU_ENTRY_POINT_RENAME(ubidi_close)
@@ -473,11 +477,14 @@
 #define ubiditransform_open U_ICU_ENTRY_POINT_RENAME(ubiditransform_open)
 #define ubiditransform_transform U_ICU_ENTRY_POINT_RENAME(ubiditransform_transform)
 #define ublock_getCode U_ICU_ENTRY_POINT_RENAME(ublock_getCode)
+#define ubrk_acquire U_ICU_ENTRY_POINT_RENAME(ubrk_acquire)
 #define ubrk_close U_ICU_ENTRY_POINT_RENAME(ubrk_close)
 #define ubrk_countAvailable U_ICU_ENTRY_POINT_RENAME(ubrk_countAvailable)
 #define ubrk_current U_ICU_ENTRY_POINT_RENAME(ubrk_current)
 #define ubrk_first U_ICU_ENTRY_POINT_RENAME(ubrk_first)
 #define ubrk_following U_ICU_ENTRY_POINT_RENAME(ubrk_following)
+#define ubrk_getAllBoundaries U_ICU_ENTRY_POINT_RENAME(ubrk_getAllBoundaries)
+#define ubrk_getAllBoundariesParallel U_ICU_ENTRY_POINT_RENAME(ubrk_getAllBoundariesParallel)
 #define ubrk_getAvailable U_ICU_ENTRY_POINT_RENAME(ubrk_getAvailable)
 #define ubrk_getBinaryRules U_ICU_ENTRY_POINT_RENAME(ubrk_getBinaryRules)
 #define ubrk_getLocaleByType U_ICU_ENTRY_POINT_RENAME(ubrk_getLocaleByType)
@@ -492,13 +499,16 @@
 #define ubrk_preceding U_ICU_ENTRY_POINT_RENAME(ubrk_preceding)
 #define ubrk_previous U_ICU_ENTRY_POINT_RENAME(ubrk_previous)
 #define ubrk_refreshUText U_ICU_ENTRY_POINT_RENAME(ubrk_refreshUText)
+#define ubrk_release U_ICU_ENTRY_POINT_RENAME(ubrk_release)
 #define ubrk_safeClone U_ICU_ENTRY_POINT_RENAME(ubrk_safeClone)
 #define ubrk_setText U_ICU_ENTRY_POINT_RENAME(ubrk_setText)
 #define ubrk_setUText U_ICU_ENTRY_POINT_RENAME(ubrk_setUText)
 #define ubrk_swap U_ICU_ENTRY_POINT_RENAME(ubrk_swap)
 #define ucache_compareKeys U_ICU_ENTRY_POINT_RENAME(ucache_compareKeys)
 #define ucache_deleteKey U_ICU_ENTRY_POINT_RENAME(ucache_deleteKey)
+#define ucache_getStatistics U_ICU_ENTRY_POINT_RENAME(ucache_getStatistics)
 #define ucache_hashKeys U_ICU_ENTRY_POINT_RENAME(ucache_hashKeys)
+#define ucache_setStatisticsEnabled U_ICU_ENTRY_POINT_RENAME(ucache_setStatisticsEnabled)
 #define ucal_add U_ICU_ENTRY_POINT_RENAME(ucal_add)
 #define ucal_clear U_ICU_ENTRY_POINT_RENAME(ucal_clear)
 #define ucal_clearField U_ICU_ENTRY_POINT_RENAME(ucal_clearField)
@@ -587,12 +597,14 @@
 #define ucln_registerCleanup U_ICU_ENTRY_POINT_RENAME(ucln_registerCleanup)
 #define ucnv_MBCSFromUChar32 U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSFromUChar32)
 #define ucnv_MBCSFromUnicodeWithOffsets U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSFromUnicodeWithOffsets)
+#define ucnv_MBCSGetChunkEndBytes U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetChunkEndBytes)
 #define ucnv_MBCSGetFilteredUnicodeSetForUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetFilteredUnicodeSetForUnicode)
 #define ucnv_MBCSGetType U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetType)
 #define ucnv_MBCSGetUnicodeSetForUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSGetUnicodeSetForUnicode)
 #define ucnv_MBCSIsLeadByte U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSIsLeadByte)
 #define ucnv_MBCSSimpleGetNextUChar U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSSimpleGetNextUChar)
 #define ucnv_MBCSToUnicodeWithOffsets U_ICU_ENTRY_POINT_RENAME(ucnv_MBCSToUnicodeWithOffsets)
+#define ucnv_acquire U_ICU_ENTRY_POINT_RENAME(ucnv_acquire)
 #define ucnv_bld_countAvailableConverters U_ICU_ENTRY_POINT_RENAME(ucnv_bld_countAvailableConverters)
 #define ucnv_bld_getAvailableConverter U_ICU_ENTRY_POINT_RENAME(ucnv_bld_getAvailableConverter)
 #define ucnv_canCreateConverter U_ICU_ENTRY_POINT_RENAME(ucnv_canCreateConverter)
@@ -651,12 +663,14 @@
 #define ucnv_getStandardName U_ICU_ENTRY_POINT_RENAME(ucnv_getStandardName)
 #define ucnv_getStarters U_ICU_ENTRY_POINT_RENAME(ucnv_getStarters)
 #define ucnv_getSubstChars U_ICU_ENTRY_POINT_RENAME(ucnv_getSubstChars)
+#define ucnv_getToUChunkLimits U_ICU_ENTRY_POINT_RENAME(ucnv_getToUChunkLimits)
 #define ucnv_getToUCallBack U_ICU_ENTRY_POINT_RENAME(ucnv_getToUCallBack)
 #define ucnv_getType U_ICU_ENTRY_POINT_RENAME(ucnv_getType)
 #define ucnv_getUnicodeSet U_ICU_ENTRY_POINT_RENAME(ucnv_getUnicodeSet)
 #define ucnv_incrementRefCount U_ICU_ENTRY_POINT_RENAME(ucnv_incrementRefCount)
 #define ucnv_io_countKnownConverters U_ICU_ENTRY_POINT_RENAME(ucnv_io_countKnownConverters)
 #define ucnv_io_getConverterName U_ICU_ENTRY_POINT_RENAME(ucnv_io_getConverterName)
+#define ucnv_io_hashNormalizedName U_ICU_ENTRY_POINT_RENAME(ucnv_io_hashNormalizedName)
 #define ucnv_io_stripASCIIForCompare U_ICU_ENTRY_POINT_RENAME(ucnv_io_stripASCIIForCompare)
 #define ucnv_io_stripEBCDICForCompare U_ICU_ENTRY_POINT_RENAME(ucnv_io_stripEBCDICForCompare)
 #define ucnv_isAmbiguous U_ICU_ENTRY_POINT_RENAME(ucnv_isAmbiguous)
@@ -669,6 +683,7 @@
 #define ucnv_openPackage U_ICU_ENTRY_POINT_RENAME(ucnv_openPackage)
 #define ucnv_openStandardNames U_ICU_ENTRY_POINT_RENAME(ucnv_openStandardNames)
 #define ucnv_openU U_ICU_ENTRY_POINT_RENAME(ucnv_openU)
+#define ucnv_release U_ICU_ENTRY_POINT_RENAME(ucnv_release)
 #define ucnv_reset U_ICU_ENTRY_POINT_RENAME(ucnv_reset)
 #define ucnv_resetFromUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetFromUnicode)
 #define ucnv_resetToUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_resetToUnicode)
@@ -683,6 +698,7 @@
 #define ucnv_swapAliases U_ICU_ENTRY_POINT_RENAME(ucnv_swapAliases)
 #define ucnv_toAlgorithmic U_ICU_ENTRY_POINT_RENAME(ucnv_toAlgorithmic)
 #define ucnv_toUChars U_ICU_ENTRY_POINT_RENAME(ucnv_toUChars)
+#define ucnv_toUCharsInChunks U_ICU_ENTRY_POINT_RENAME(ucnv_toUCharsInChunks)
 #define ucnv_toUCountPending U_ICU_ENTRY_POINT_RENAME(ucnv_toUCountPending)
 #define ucnv_toUWriteCodePoint U_ICU_ENTRY_POINT_RENAME(ucnv_toUWriteCodePoint)
 #define ucnv_toUWriteUChars U_ICU_ENTRY_POINT_RENAME(ucnv_toUWriteUChars)
@@ -723,6 +739,10 @@
 #define ucol_getRulesEx U_ICU_ENTRY_POINT_RENAME(ucol_getRulesEx)
 #define ucol_getShortDefinitionString U_ICU_ENTRY_POINT_RENAME(ucol_getShortDefinitionString)
 #define ucol_getSortKey U_ICU_ENTRY_POINT_RENAME(ucol_getSortKey)
+#define ucol_getSortKeys U_ICU_ENTRY_POINT_RENAME(ucol_getSortKeys)
+#define ucol_getSortKeysUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_getSortKeysUTF8)
+#define ucol_getSortKeysWithPrefixes U_ICU_ENTRY_POINT_RENAME(ucol_getSortKeysWithPrefixes)
+#define ucol_getSortKeysWithPrefixesUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_getSortKeysWithPrefixesUTF8)
 #define ucol_getStrength U_ICU_ENTRY_POINT_RENAME(ucol_getStrength)
 #define ucol_getTailoredSet U_ICU_ENTRY_POINT_RENAME(ucol_getTailoredSet)
 #define ucol_getUCAVersion U_ICU_ENTRY_POINT_RENAME(ucol_getUCAVersion)
@@ -832,24 +852,30 @@
 #define udat_toPatternRelativeTime U_ICU_ENTRY_POINT_RENAME(udat_toPatternRelativeTime)
 #define udat_unregisterOpener U_ICU_ENTRY_POINT_RENAME(udat_unregisterOpener)
 #define udata_checkCommonData U_ICU_ENTRY_POINT_RENAME(udata_checkCommonData)
+#define udata_checksumOffsetTOC U_ICU_ENTRY_POINT_RENAME(udata_checksumOffsetTOC)
 #define udata_close U_ICU_ENTRY_POINT_RENAME(udata_close)
 #define udata_closeSwapper U_ICU_ENTRY_POINT_RENAME(udata_closeSwapper)
+#define udata_getCommonDataExtent U_ICU_ENTRY_POINT_RENAME(udata_getCommonDataExtent)
 #define udata_getHeaderSize U_ICU_ENTRY_POINT_RENAME(udata_getHeaderSize)
 #define udata_getInfo U_ICU_ENTRY_POINT_RENAME(udata_getInfo)
 #define udata_getInfoSize U_ICU_ENTRY_POINT_RENAME(udata_getInfoSize)
 #define udata_getLength U_ICU_ENTRY_POINT_RENAME(udata_getLength)
 #define udata_getMemory U_ICU_ENTRY_POINT_RENAME(udata_getMemory)
 #define udata_getRawMemory U_ICU_ENTRY_POINT_RENAME(udata_getRawMemory)
+#define udata_getRecordedItems U_ICU_ENTRY_POINT_RENAME(udata_getRecordedItems)
+#define udata_hashTOCName U_ICU_ENTRY_POINT_RENAME(udata_hashTOCName)
 #define udata_open U_ICU_ENTRY_POINT_RENAME(udata_open)
 #define udata_openChoice U_ICU_ENTRY_POINT_RENAME(udata_openChoice)
 #define udata_openSwapper U_ICU_ENTRY_POINT_RENAME(udata_openSwapper)
 #define udata_openSwapperForInputData U_ICU_ENTRY_POINT_RENAME(udata_openSwapperForInputData)
+#define udata_prefetchItems U_ICU_ENTRY_POINT_RENAME(udata_prefetchItems)
 #define udata_printError U_ICU_ENTRY_POINT_RENAME(udata_printError)
 #define udata_readInt16 U_ICU_ENTRY_POINT_RENAME(udata_readInt16)
 #define udata_readInt32 U_ICU_ENTRY_POINT_RENAME(udata_readInt32)
 #define udata_setAppData U_ICU_ENTRY_POINT_RENAME(udata_setAppData)
 #define udata_setCommonData U_ICU_ENTRY_POINT_RENAME(udata_setCommonData)
 #define udata_setFileAccess U_ICU_ENTRY_POINT_RENAME(udata_setFileAccess)
+#define udata_setMappingHints U_ICU_ENTRY_POINT_RENAME(udata_setMappingHints)
 #define udata_swapDataHeader U_ICU_ENTRY_POINT_RENAME(udata_swapDataHeader)
 #define udata_swapInvStringBlock U_ICU_ENTRY_POINT_RENAME(udata_swapInvStringBlock)
 #define udatpg_addPattern U_ICU_ENTRY_POINT_RENAME(udatpg_addPattern)
@@ -1221,6 +1247,7 @@
 #define uprops_getSource U_ICU_ENTRY_POINT_RENAME(uprops_getSource)
 #define upropsvec_addPropertyStarts U_ICU_ENTRY_POINT_RENAME(upropsvec_addPropertyStarts)
 #define uprv_add32_overflow U_ICU_ENTRY_POINT_RENAME(uprv_add32_overflow)
+#define uprv_adviseMemory U_ICU_ENTRY_POINT_RENAME(uprv_adviseMemory)
 #define uprv_aestrncpy U_ICU_ENTRY_POINT_RENAME(uprv_aestrncpy)
 #define uprv_asciiFromEbcdic U_ICU_ENTRY_POINT_RENAME(uprv_asciiFromEbcdic)
 #define uprv_asciitolower U_ICU_ENTRY_POINT_RENAME(uprv_asciitolower)
@@ -1338,6 +1365,7 @@
 #define uprv_getRawUTCtime U_ICU_ENTRY_POINT_RENAME(uprv_getRawUTCtime)
 #define uprv_getStaticCurrencyName U_ICU_ENTRY_POINT_RENAME(uprv_getStaticCurrencyName)
 #define uprv_getUTCtime U_ICU_ENTRY_POINT_RENAME(uprv_getUTCtime)
+#define uprv_getUTF8TextContents U_ICU_ENTRY_POINT_RENAME(uprv_getUTF8TextContents)
 #define uprv_int32Comparator U_ICU_ENTRY_POINT_RENAME(uprv_int32Comparator)
 #define uprv_isASCIILetter U_ICU_ENTRY_POINT_RENAME(uprv_isASCIILetter)
 #define uprv_isInfinite U_ICU_ENTRY_POINT_RENAME(uprv_isInfinite)
@@ -1516,6 +1544,7 @@
 #define ures_openU U_ICU_ENTRY_POINT_RENAME(ures_openU)
 #define ures_resetIterator U_ICU_ENTRY_POINT_RENAME(ures_resetIterator)
 #define ures_swap U_ICU_ENTRY_POINT_RENAME(ures_swap)
+#define ures_visitItems U_ICU_ENTRY_POINT_RENAME(ures_visitItems)
 #define uscript_breaksBetweenLetters U_ICU_ENTRY_POINT_RENAME(uscript_breaksBetweenLetters)
 #define uscript_closeRun U_ICU_ENTRY_POINT_RENAME(uscript_closeRun)
 #define uscript_getCode U_ICU_ENTRY_POINT_RENAME(uscript_getCode)
@@ -1449,6 +1449,48 @@ u_strFromUTF8Lenient(UChar *dest,
                      int32_t srcLength,
                      UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Checks whether a string is well-formed UTF-8, and computes its UTF-16 length.
+ *
+ * This is much faster than pre-flighting u_strFromUTF8(),
+ * especially for text that is mostly ASCII.
+ * Well-formedness is defined as for U8_NEXT(): Surrogate code points,
+ * non-shortest forms and code points above U+10FFFF are ill-formed.
+ *
+ * @param s             The UTF-8 string.
+ * @param length        The length of the string in bytes, or -1 if it is NUL-terminated.
+ * @param pUTF16Length  If not NULL, receives the number of UChars of the string in UTF-16.
+ *                      If the string is ill-formed, then this is the number of UChars
+ *                      of the well-formed part before the returned offset.
+ * @param pErrorCode    Must be a valid pointer to an error code value,
+ *                      which must not indicate a failure before the function call.
+ * @return The byte offset of the first ill-formed sequence,
+ *         or -1 if the string is well-formed.
+ * @see u_countUTF8CodePoints
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+u_validateUTF8(const char *s, int32_t length,
+               int32_t *pUTF16Length,
+               UErrorCode *pErrorCode);
+
+/**
+ * Counts the code points in a UTF-8 string.
+ * Each maximal ill-formed subsequence counts as one code point,
+ * the same as the number of U+FFFD substitutions from u_strFromUTF8WithSub().
+ *
+ * @param s      The UTF-8 string. Can be NULL if length is 0.
+ * @param length The length of the string in bytes, or -1 if it is NUL-terminated.
+ * @return The number of code points, or 0 if s is NULL or length<-1.
+ * @see u_validateUTF8
+ * @see u_countChar32
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+u_countUTF8CodePoints(const char *s, int32_t length);
+#endif  // U_HIDE_DRAFT_API
+
 /**
  * Convert a UTF-16 string to UTF-32.
  * If the input string is not well-formed, then the U_INVALID_CHAR_FOUND error code is set.
@@ -14,6 +14,7 @@
 
 #include <algorithm>      // For std::max()
 
+#include "cmemory.h"
 #include "mutex.h"
 #include "uassert.h"
 #include "uhash.h"
@@ -21,13 +22,27 @@
 #include "umutex.h"
 
 static icu::UnifiedCache *gCache = NULL;
-static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
-static UConditionVar gInProgressValueAddedCond = U_CONDITION_INITIALIZER;
 static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
 
+// One mutex and one condition variable per stripe of the cache.
+// There must be exactly UnifiedCache::STRIPE_COUNT initializers.
+#define STRIPE_INITIALIZERS(init) \
+        init, init, init, init, init, init, init, init, \
+        init, init, init, init, init, init, init, init
+static UMutex gCacheMutex[icu::UnifiedCache::STRIPE_COUNT] = {
+        STRIPE_INITIALIZERS(U_MUTEX_INITIALIZER)
+};
+static UConditionVar gInProgressValueAddedCond[icu::UnifiedCache::STRIPE_COUNT] = {
+        STRIPE_INITIALIZERS(U_CONDITION_INITIALIZER)
+};
+
+// Serializes eviction and flushing. Always acquired before a stripe mutex.
+static UMutex gCacheEvictMutex = U_MUTEX_INITIALIZER;
+
 static const int32_t MAX_EVICT_ITERATIONS = 10;
 static const int32_t DEFAULT_MAX_UNUSED = 1000;
 static const int32_t DEFAULT_PERCENTAGE_OF_IN_USE = 100;
+static const int32_t DEFAULT_MAX_BYTES = 4 * 1024 * 1024;
 
 
 U_CDECL_BEGIN
@@ -92,14 +107,28 @@ UnifiedCache *UnifiedCache::getInstance(UErrorCode &status) {
 }
 
 UnifiedCache::UnifiedCache(UErrorCode &status) :
-        fHashtable(NULL),
-        fEvictPos(UHASH_FIRST),
+        fEvictStripe(0),
+        fNextShardToEvict(0),
+        fAccessTick(0),
+        fNumKeys(0),
         fNumValuesTotal(0),
         fNumValuesInUse(0),
         fMaxUnused(DEFAULT_MAX_UNUSED),
         fMaxPercentageOfInUse(DEFAULT_PERCENTAGE_OF_IN_USE),
-        fAutoEvictedCount(0),
+        fMaxBytes(DEFAULT_MAX_BYTES),
+        fEvictionAlgorithm(UCACHE_EVICT_ROUND_ROBIN),
+        fSharded(FALSE),
+        fCollectStatistics(FALSE),
         fNoValue(nullptr) {
+    for (int32_t i = 0; i < STRIPE_COUNT; ++i) {
+        fHashtables[i] = nullptr;
+        fStatistics[i] = nullptr;
+        fLruHead[i] = nullptr;
+        fLruTail[i] = nullptr;
+        fEvictPos[i] = UHASH_FIRST;
+        fAutoEvictedCount[i] = 0;
+        umtx_storeRelease(fFootprint[i], 0);
+    }
     if (U_FAILURE(status)) {
         return;
     }
@@ -108,19 +137,37 @@ UnifiedCache::UnifiedCache(UErrorCode &status) :
         status = U_MEMORY_ALLOCATION_ERROR;
         return;
     }
-    fNoValue->softRefCount = 1;  // Add fake references to prevent fNoValue from being deleted
+    umtx_storeRelease(fNoValue->softRefCount, 1);  // Add fake references to prevent fNoValue from being deleted
     fNoValue->hardRefCount = 1;  // when other references to it are removed.
     fNoValue->cachePtr = this;
 
-    fHashtable = uhash_open(
-            &ucache_hashKeys,
-            &ucache_compareKeys,
-            NULL,
-            &status);
-    if (U_FAILURE(status)) {
-        return;
+    for (int32_t i = 0; i < STRIPE_COUNT; ++i) {
+        fHashtables[i] = uhash_open(
+                &ucache_hashKeys,
+                &ucache_compareKeys,
+                NULL,
+                &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        uhash_setKeyDeleter(fHashtables[i], &ucache_deleteKey);
+        fStatistics[i] = uhash_open(
+                &uhash_hashChars,
+                &uhash_compareChars,
+                NULL,
+                &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        uhash_setValueDeleter(fStatistics[i], &uprv_free);
     }
-    uhash_setKeyDeleter(fHashtable, &ucache_deleteKey);
+}
+
+int32_t UnifiedCache::_stripeOf(const CacheKeyBase &key) {
+    // Multiplicative hashing, using the high bits, so that the stripe
+    // does not correlate with the bucket within the stripe's hash table.
+    uint32_t hash = (uint32_t)key.hashCode() * 0x9E3779B1u;
+    return (int32_t)((hash >> 16) & (STRIPE_COUNT - 1));
 }
 
 void UnifiedCache::setEvictionPolicy(
@@ -132,28 +179,115 @@ void UnifiedCache::setEvictionPolicy(
         status = U_ILLEGAL_ARGUMENT_ERROR;
         return;
     }
-    Mutex lock(&gCacheMutex);
-    fMaxUnused = count;
-    fMaxPercentageOfInUse = percentageOfInUseItems;
+    umtx_storeRelease(fMaxUnused, count);
+    umtx_storeRelease(fMaxPercentageOfInUse, percentageOfInUseItems);
+}
+
+void UnifiedCache::setMemoryLimit(int32_t maxBytes, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (maxBytes < 0) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    umtx_storeRelease(fMaxBytes, maxBytes);
+}
+
+int32_t UnifiedCache::memoryFootprint() const {
+    int32_t footprint = 0;
+    for (int32_t stripe = 0; stripe < STRIPE_COUNT; ++stripe) {
+        footprint += umtx_loadAcquire(fFootprint[stripe]);
+    }
+    return footprint;
 }
 
 int32_t UnifiedCache::unusedCount() const {
-    Mutex lock(&gCacheMutex);
-    return uhash_count(fHashtable) - fNumValuesInUse;
+    return umtx_loadAcquire(fNumKeys) - umtx_loadAcquire(fNumValuesInUse);
+}
+
+void UnifiedCache::setEvictionAlgorithm(
+        UCacheEvictionAlgorithm algorithm, UBool sharded, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (algorithm < 0 || algorithm >= UCACHE_EVICT_ALGORITHM_COUNT) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    umtx_storeRelease(fEvictionAlgorithm, algorithm);
+    umtx_storeRelease(fSharded, sharded ? TRUE : FALSE);
 }
 
 int64_t UnifiedCache::autoEvictedCount() const {
-    Mutex lock(&gCacheMutex);
-    return fAutoEvictedCount;
+    int64_t count = 0;
+    for (int32_t stripe = 0; stripe < STRIPE_COUNT; ++stripe) {
+        Mutex lock(&gCacheMutex[stripe]);
+        count += fAutoEvictedCount[stripe];
+    }
+    return count;
+}
+
+void UnifiedCache::setStatisticsEnabled(UBool enabled) {
+    umtx_storeRelease(fCollectStatistics, enabled ? TRUE : FALSE);
+}
+
+int32_t UnifiedCache::getStatistics(
+        UnifiedCacheStatistics *dest, int32_t capacity, UErrorCode &status) const {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (dest == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    // Merge the per-stripe tables. There are only a few dozen key types.
+    MaybeStackArray<UnifiedCacheStatistics, 32> merged;
+    int32_t count = 0;
+    for (int32_t stripe = 0; stripe < STRIPE_COUNT; ++stripe) {
+        Mutex lock(&gCacheMutex[stripe]);
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        while ((element = uhash_nextElement(fStatistics[stripe], &pos)) != nullptr) {
+            const UnifiedCacheStatistics *stats =
+                    (const UnifiedCacheStatistics *) element->value.pointer;
+            int32_t i = 0;
+            while (i < count && uprv_strcmp(merged[i].keyType, stats->keyType) != 0) {
+                ++i;
+            }
+            if (i == count) {
+                if (count == merged.getCapacity() &&
+                        merged.resize(2 * count, count) == NULL) {
+                    status = U_MEMORY_ALLOCATION_ERROR;
+                    return 0;
+                }
+                merged[count].keyType = stats->keyType;
+                merged[count].hits = 0;
+                merged[count].misses = 0;
+                merged[count].evictions = 0;
+                ++count;
+            }
+            merged[i].hits += stats->hits;
+            merged[i].misses += stats->misses;
+            merged[i].evictions += stats->evictions;
+        }
+    }
+    if (count > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+        return count;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        dest[i] = merged[i];
+    }
+    return count;
 }
 
 int32_t UnifiedCache::keyCount() const {
-    Mutex lock(&gCacheMutex);
-    return uhash_count(fHashtable);
+    return umtx_loadAcquire(fNumKeys);
 }
 
 void UnifiedCache::flush() const {
-    Mutex lock(&gCacheMutex);
+    Mutex lock(&gCacheEvictMutex);
 
     // Use a loop in case cache items that are flushed held hard references to
     // other cache items making those additional cache items eligible for
@@ -162,8 +296,18 @@ void UnifiedCache::flush() const {
 }
 
 void UnifiedCache::handleUnreferencedObject() const {
-    Mutex lock(&gCacheMutex);
-    --fNumValuesInUse;
+    umtx_atomic_dec(&fNumValuesInUse);
+    // Releasing a reference usually leaves nothing to evict. Check that
+    // before taking the eviction mutex so that releases after cache hits
+    // do not serialize on it.
+    if (_computeCountOfItemsToEvict() <= 0) {
+        return;
+    }
+    if (umtx_loadAcquire(fSharded)) {
+        _runShardEvictionSlice(umtx_atomic_inc(&fNextShardToEvict) & (STRIPE_COUNT - 1));
+        return;
+    }
+    Mutex lock(&gCacheEvictMutex);
     _runEvictionSlice();
 }
 
@@ -181,36 +325,39 @@ void UnifiedCache::dump() {
 }
 
 void UnifiedCache::dumpContents() const {
-    Mutex lock(&gCacheMutex);
+    Mutex lock(&gCacheEvictMutex);
     _dumpContents();
 }
 
 // Dumps content of cache.
-// On entry, gCacheMutex must be held.
+// On entry, gCacheEvictMutex must be held.
 // On exit, cache contents dumped to stderr.
 void UnifiedCache::_dumpContents() const {
-    int32_t pos = UHASH_FIRST;
-    const UHashElement *element = uhash_nextElement(fHashtable, &pos);
     char buffer[256];
     int32_t cnt = 0;
-    for (; element != NULL; element = uhash_nextElement(fHashtable, &pos)) {
-        const SharedObject *sharedObject =
-                (const SharedObject *) element->value.pointer;
-        const CacheKeyBase *key =
-                (const CacheKeyBase *) element->key.pointer;
-        if (sharedObject->hasHardReferences()) {
-            ++cnt;
-            fprintf(
-                    stderr,
-                    "Unified Cache: Key '%s', error %d, value %p, total refcount %d, soft refcount %d\n",
-                    key->writeDescription(buffer, 256),
-                    key->creationStatus,
-                    sharedObject == fNoValue ? NULL :sharedObject,
-                    sharedObject->getRefCount(),
-                    sharedObject->getSoftRefCount());
+    for (int32_t stripe = 0; stripe < STRIPE_COUNT; ++stripe) {
+        Mutex lock(&gCacheMutex[stripe]);
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element = uhash_nextElement(fHashtables[stripe], &pos);
+        for (; element != NULL; element = uhash_nextElement(fHashtables[stripe], &pos)) {
+            const SharedObject *sharedObject =
+                    (const SharedObject *) element->value.pointer;
+            const CacheKeyBase *key =
+                    (const CacheKeyBase *) element->key.pointer;
+            if (sharedObject->hasHardReferences()) {
+                ++cnt;
+                fprintf(
+                        stderr,
+                        "Unified Cache: Key '%s', error %d, value %p, total refcount %d, soft refcount %d\n",
+                        key->writeDescription(buffer, 256),
+                        key->creationStatus,
+                        sharedObject == fNoValue ? NULL :sharedObject,
+                        sharedObject->getRefCount(),
+                        sharedObject->getSoftRefCount());
+            }
         }
     }
-    fprintf(stderr, "Unified Cache: %d out of a total of %d still have hard references\n", cnt, uhash_count(fHashtable));
+    fprintf(stderr, "Unified Cache: %d out of a total of %d still have hard references\n", cnt, keyCount());
 }
 #endif
 
@@ -221,51 +368,50 @@ UnifiedCache::~UnifiedCache() {
         // Now all that should be left in the cache are entries that refer to
         // each other and entries with hard references from outside the cache.
         // Nothing we can do about these so proceed to wipe out the cache.
-        Mutex lock(&gCacheMutex);
+        Mutex lock(&gCacheEvictMutex);
         _flush(TRUE);
     }
-    uhash_close(fHashtable);
-    fHashtable = nullptr;
+    for (int32_t i = 0; i < STRIPE_COUNT; ++i) {
+        uhash_close(fHashtables[i]);
+        fHashtables[i] = nullptr;
+        uhash_close(fStatistics[i]);
+        fStatistics[i] = nullptr;
+    }
     delete fNoValue;
     fNoValue = nullptr;
 }
 
-const UHashElement *
-UnifiedCache::_nextElement() const {
-    const UHashElement *element = uhash_nextElement(fHashtable, &fEvictPos);
-    if (element == NULL) {
-        fEvictPos = UHASH_FIRST;
-        return uhash_nextElement(fHashtable, &fEvictPos);
-    }
-    return element;
-}
-
 UBool UnifiedCache::_flush(UBool all) const {
     UBool result = FALSE;
-    int32_t origSize = uhash_count(fHashtable);
-    for (int32_t i = 0; i < origSize; ++i) {
-        const UHashElement *element = _nextElement();
-        if (element == nullptr) {
-            break;
-        }
-        if (all || _isEvictable(element)) {
-            const SharedObject *sharedObject =
-                    (const SharedObject *) element->value.pointer;
-            U_ASSERT(sharedObject->cachePtr = this);
-            uhash_removeElement(fHashtable, element);
-            removeSoftRef(sharedObject);    // Deletes the sharedObject when softRefCount goes to zero.
-            result = TRUE;
+    for (int32_t stripe = 0; stripe < STRIPE_COUNT; ++stripe) {
+        Mutex lock(&gCacheMutex[stripe]);
+        UHashtable *hashtable = fHashtables[stripe];
+        int32_t pos = UHASH_FIRST;
+        const UHashElement *element;
+        while ((element = uhash_nextElement(hashtable, &pos)) != nullptr) {
+            if (all || _isEvictable(element)) {
+                _removeElement(stripe, element, FALSE);
+                result = TRUE;
+            }
         }
     }
     return result;
 }
 
 int32_t UnifiedCache::_computeCountOfItemsToEvict() const {
-    int32_t totalItems = uhash_count(fHashtable);
-    int32_t evictableItems = totalItems - fNumValuesInUse;
+    int32_t totalItems = umtx_loadAcquire(fNumKeys);
+    int32_t numValuesInUse = umtx_loadAcquire(fNumValuesInUse);
+    int32_t evictableItems = totalItems - numValuesInUse;
+    if (umtx_loadAcquire(fEvictionAlgorithm) == UCACHE_EVICT_SIZE_WEIGHTED) {
+        if (evictableItems <= 0) {
+            return 0;
+        }
+        return std::max(0, memoryFootprint() - umtx_loadAcquire(fMaxBytes));
+    }
 
-    int32_t unusedLimitByPercentage = fNumValuesInUse * fMaxPercentageOfInUse / 100;
-    int32_t unusedLimit = std::max(unusedLimitByPercentage, fMaxUnused);
+    int32_t unusedLimitByPercentage =
+            numValuesInUse * umtx_loadAcquire(fMaxPercentageOfInUse) / 100;
+    int32_t unusedLimit = std::max(unusedLimitByPercentage, umtx_loadAcquire(fMaxUnused));
     int32_t countOfItemsToEvict = std::max(0, evictableItems - unusedLimit);
     return countOfItemsToEvict;
 }
@@ -275,27 +421,253 @@ void UnifiedCache::_runEvictionSlice() const {
     if (maxItemsToEvict <= 0) {
         return;
     }
-    for (int32_t i = 0; i < MAX_EVICT_ITERATIONS; ++i) {
-        const UHashElement *element = _nextElement();
+    int32_t iterationsLeft = MAX_EVICT_ITERATIONS;
+    if (umtx_loadAcquire(fEvictionAlgorithm) == UCACHE_EVICT_LRU) {
+        _runLruEvictionSlice(iterationsLeft, maxItemsToEvict);
+        return;
+    }
+    // Visit each stripe at most once per slice, so that a slice over
+    // an empty cache terminates.
+    for (int32_t i = 0; i < STRIPE_COUNT; ++i) {
+        Mutex lock(&gCacheMutex[fEvictStripe]);
+        if (!_evictFromStripe(fEvictStripe, iterationsLeft, maxItemsToEvict)) {
+            return;
+        }
+        fEvictStripe = (fEvictStripe + 1) & (STRIPE_COUNT - 1);
+        if (iterationsLeft <= 0 || maxItemsToEvict <= 0) {
+            return;
+        }
+    }
+}
+
+void UnifiedCache::_runShardEvictionSlice(int32_t stripe) const {
+    int32_t maxItemsToEvict = _computeCountOfItemsToEvict();
+    if (maxItemsToEvict <= 0) {
+        return;
+    }
+    int32_t iterationsLeft = MAX_EVICT_ITERATIONS;
+    for (int32_t i = 0; i < STRIPE_COUNT; ++i) {
+        {
+            Mutex lock(&gCacheMutex[stripe]);
+            if (!_evictFromStripe(stripe, iterationsLeft, maxItemsToEvict)) {
+                return;
+            }
+        }
+        if (iterationsLeft <= 0 || maxItemsToEvict <= 0) {
+            return;
+        }
+        stripe = (stripe + 1) & (STRIPE_COUNT - 1);
+    }
+}
+
+void UnifiedCache::_runLruEvictionSlice(
+        int32_t &iterationsLeft, int32_t &itemsToEvict) const {
+    while (iterationsLeft > 0 && itemsToEvict > 0) {
+        // Find the stripe whose least recently used entry is the oldest.
+        // Ticks wrap around, so compare their difference.
+        int32_t oldest = -1;
+        uint32_t oldestTick = 0;
+        for (int32_t stripe = 0; stripe < STRIPE_COUNT; ++stripe) {
+            Mutex lock(&gCacheMutex[stripe]);
+            const CacheKeyBase *head = fLruHead[stripe];
+            if (head != nullptr &&
+                    (oldest < 0 || (int32_t)(head->fLastAccess - oldestTick) < 0)) {
+                oldest = stripe;
+                oldestTick = head->fLastAccess;
+            }
+        }
+        if (oldest < 0) {
+            return;
+        }
+        --iterationsLeft;
+        // The head may have changed since the scan; that only makes the
+        // choice slightly less exact.
+        Mutex lock(&gCacheMutex[oldest]);
+        const CacheKeyBase *key = fLruHead[oldest];
+        if (key == nullptr) {
+            continue;
+        }
+        const UHashElement *element = uhash_find(fHashtables[oldest], key);
+        U_ASSERT(element != nullptr);
+        if (_isEvictable(element)) {
+            _removeElement(oldest, element, TRUE);
+            --itemsToEvict;
+        } else {
+            // In use; treat it as recently used.
+            _touch(oldest, key);
+        }
+    }
+}
+
+UBool UnifiedCache::_evictFromStripe(
+        int32_t stripe, int32_t &iterationsLeft, int32_t &itemsToEvict) const {
+    UHashtable *hashtable = fHashtables[stripe];
+    UCacheEvictionAlgorithm algorithm =
+            (UCacheEvictionAlgorithm) umtx_loadAcquire(fEvictionAlgorithm);
+
+    if (algorithm == UCACHE_EVICT_LRU) {
+        // Walk the recency list from the least recently used end.
+        // Entries that cannot be evicted are in use, so they move to the
+        // most recently used end; stop on reaching the first one moved.
+        const CacheKeyBase *key = fLruHead[stripe];
+        const CacheKeyBase *firstMoved = nullptr;
+        while (key != nullptr && key != firstMoved && iterationsLeft > 0 && itemsToEvict > 0) {
+            --iterationsLeft;
+            const CacheKeyBase *next = key->fLruNext;
+            const UHashElement *element = uhash_find(hashtable, key);
+            U_ASSERT(element != nullptr);
+            if (_isEvictable(element)) {
+                _removeElement(stripe, element, TRUE);
+                --itemsToEvict;
+            } else if (next != nullptr) {
+                if (firstMoved == nullptr) {
+                    firstMoved = key;
+                }
+                _touch(stripe, key);
+            }
+            key = next;
+        }
+        return TRUE;
+    }
+
+    // Round robin sweep. UCACHE_EVICT_SIZE_WEIGHTED first collects all the
+    // evictable entries within the slice, then evicts the largest ones
+    // until it has freed itemsToEvict bytes.
+    UBool sizeWeighted = (algorithm == UCACHE_EVICT_SIZE_WEIGHTED);
+    const UHashElement *candidates[MAX_EVICT_ITERATIONS];
+    int32_t numCandidates = 0;
+    UBool wrapped = FALSE;
+    while (iterationsLeft > 0 && (sizeWeighted || itemsToEvict > 0)) {
+        const UHashElement *element = uhash_nextElement(hashtable, &fEvictPos[stripe]);
         if (element == nullptr) {
+            fEvictPos[stripe] = UHASH_FIRST;
+            wrapped = TRUE;
             break;
         }
-        if (_isEvictable(element)) {
-            const SharedObject *sharedObject =
-                    (const SharedObject *) element->value.pointer;
-            uhash_removeElement(fHashtable, element);
-            removeSoftRef(sharedObject);   // Deletes sharedObject when SoftRefCount goes to zero.
-            ++fAutoEvictedCount;
-            if (--maxItemsToEvict == 0) {
-                break;
+        --iterationsLeft;
+        const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+        if (algorithm == UCACHE_EVICT_CLOCK && theKey->fReferenced) {
+            theKey->fReferenced = FALSE;   // Second chance.
+            continue;
+        }
+        if (!_isEvictable(element)) {
+            continue;
+        }
+        if (sizeWeighted) {
+            U_ASSERT(numCandidates < MAX_EVICT_ITERATIONS);
+            candidates[numCandidates++] = element;
+        } else {
+            _removeElement(stripe, element, TRUE);
+            --itemsToEvict;
+        }
+    }
+    // Removing elements does not move the others, so the remaining
+    // candidate pointers stay valid. Selection sort, largest first.
+    for (int32_t i = 0; i < numCandidates && itemsToEvict > 0; ++i) {
+        int32_t largest = i;
+        for (int32_t j = i + 1; j < numCandidates; ++j) {
+            if (_footprintOf(candidates[j]) > _footprintOf(candidates[largest])) {
+                largest = j;
             }
         }
+        const UHashElement *element = candidates[largest];
+        candidates[largest] = candidates[i];
+        // Count at least one byte so that entries without a known
+        // footprint are evicted too.
+        itemsToEvict -= std::max(_footprintOf(element), 1);
+        _removeElement(stripe, element, TRUE);
+    }
+    return wrapped;
+}
+
+int32_t UnifiedCache::_footprintOf(const UHashElement *element) {
+    // Evicting a key that is not the master does not delete the value.
+    const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+    const SharedObject *value = (const SharedObject *) element->value.pointer;
+    return theKey->fIsMaster ? value->cacheFootprint : 0;
+}
+
+void UnifiedCache::_removeElement(
+        int32_t stripe, const UHashElement *element, UBool isAutoEviction) const {
+    const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+    const SharedObject *sharedObject =
+            (const SharedObject *) element->value.pointer;
+    if (isAutoEviction) {
+        ++fAutoEvictedCount[stripe];
+        _recordStatistic(stripe, *theKey, &UnifiedCacheStatistics::evictions);
     }
+    _unlink(stripe, theKey);
+    uhash_removeElement(fHashtables[stripe], element);   // Deletes theKey.
+    umtx_atomic_dec(&fNumKeys);
+    removeSoftRef(stripe, sharedObject);   // Deletes sharedObject when SoftRefCount goes to zero.
+}
+
+void UnifiedCache::_touch(int32_t stripe, const CacheKeyBase *key) const {
+    key->fReferenced = TRUE;
+    if (umtx_loadAcquire(fEvictionAlgorithm) == UCACHE_EVICT_LRU &&
+            !umtx_loadAcquire(fSharded)) {
+        key->fLastAccess = (uint32_t) umtx_atomic_inc(&fAccessTick);
+    }
+    if (fLruTail[stripe] == key) {
+        return;
+    }
+    _unlink(stripe, key);
+    key->fLruPrev = fLruTail[stripe];
+    if (fLruTail[stripe] != nullptr) {
+        fLruTail[stripe]->fLruNext = key;
+    } else {
+        fLruHead[stripe] = key;
+    }
+    fLruTail[stripe] = key;
+}
+
+void UnifiedCache::_unlink(int32_t stripe, const CacheKeyBase *key) const {
+    if (key->fLruPrev != nullptr) {
+        key->fLruPrev->fLruNext = key->fLruNext;
+    } else if (fLruHead[stripe] == key) {
+        fLruHead[stripe] = key->fLruNext;
+    }
+    if (key->fLruNext != nullptr) {
+        key->fLruNext->fLruPrev = key->fLruPrev;
+    } else if (fLruTail[stripe] == key) {
+        fLruTail[stripe] = key->fLruPrev;
+    }
+    key->fLruPrev = nullptr;
+    key->fLruNext = nullptr;
+}
+
+void UnifiedCache::_recordStatistic(
+        int32_t stripe, const CacheKeyBase &key,
+        int64_t UnifiedCacheStatistics::*counter) const {
+    if (!umtx_loadAcquire(fCollectStatistics)) {
+        return;
+    }
+    const char *keyType = typeid(key).name();
+    UnifiedCacheStatistics *stats =
+            (UnifiedCacheStatistics *) uhash_get(fStatistics[stripe], keyType);
+    if (stats == nullptr) {
+        stats = (UnifiedCacheStatistics *) uprv_malloc(sizeof(UnifiedCacheStatistics));
+        if (stats == nullptr) {
+            return;   // Statistics are best effort.
+        }
+        stats->keyType = keyType;
+        stats->hits = 0;
+        stats->misses = 0;
+        stats->evictions = 0;
+        UErrorCode status = U_ZERO_ERROR;
+        uhash_put(fStatistics[stripe], (void *) keyType, stats, &status);
+        if (U_FAILURE(status)) {
+            return;   // The table deleted stats.
+        }
+    }
+    ++(stats->*counter);
 }
 
 void UnifiedCache::_putNew(
+        int32_t stripe,
         const CacheKeyBase &key,
         const SharedObject *value,
+        int32_t footprint,
         const UErrorCode creationStatus,
         UErrorCode &status) const {
     if (U_FAILURE(status)) {
@@ -307,14 +679,16 @@ void UnifiedCache::_putNew(
         return;
     }
     keyToAdopt->fCreationStatus = creationStatus;
-    if (value->softRefCount == 0) {
-        _registerMaster(keyToAdopt, value);
+    if (umtx_loadAcquire(value->softRefCount) == 0) {
+        _registerMaster(stripe, keyToAdopt, value, footprint);
     }
-    void *oldValue = uhash_put(fHashtable, keyToAdopt, (void *) value, &status);
+    void *oldValue = uhash_put(fHashtables[stripe], keyToAdopt, (void *) value, &status);
     U_ASSERT(oldValue == nullptr);
     (void)oldValue;
     if (U_SUCCESS(status)) {
-        value->softRefCount++;
+        _touch(stripe, keyToAdopt);
+        umtx_atomic_inc(&fNumKeys);
+        umtx_atomic_inc(&value->softRefCount);
     }
 }
 
@@ -322,21 +696,35 @@ void UnifiedCache::_putIfAbsentAndGet(
         const CacheKeyBase &key,
         const SharedObject *&value,
         UErrorCode &status) const {
-    Mutex lock(&gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
-    if (element != NULL && !_inProgress(element)) {
-        _fetch(element, value, status);
-        return;
-    }
-    if (element == NULL) {
-        UErrorCode putError = U_ZERO_ERROR;
-        // best-effort basis only.
-        _putNew(key, value, status, putError);
-    } else {
-        _put(element, value, status);
+    int32_t stripe = _stripeOf(key);
+    // Ask for the footprint before taking the mutex: It is a virtual call into
+    // the cached type, and it is only needed if value becomes a new master.
+    int32_t footprint = value == fNoValue ? 0 : value->getMemoryFootprint();
+    {
+        Mutex lock(&gCacheMutex[stripe]);
+        const UHashElement *element = uhash_find(fHashtables[stripe], &key);
+        if (element != NULL && !_inProgress(element)) {
+            _touch(stripe, (const CacheKeyBase *) element->key.pointer);
+            _fetch(element, value, status);
+            return;
+        }
+        if (element == NULL) {
+            UErrorCode putError = U_ZERO_ERROR;
+            // best-effort basis only.
+            _putNew(stripe, key, value, footprint, status, putError);
+        } else {
+            _put(stripe, element, value, footprint, status);
+        }
     }
     // Run an eviction slice. This will run even if we added a master entry
     // which doesn't increase the unused count, but that is still o.k
+    // The stripe mutex must be released first; eviction takes the
+    // eviction mutex before any stripe mutex.
+    if (umtx_loadAcquire(fSharded)) {
+        _runShardEvictionSlice(stripe);
+        return;
+    }
+    Mutex lock(&gCacheEvictMutex);
     _runEvictionSlice();
 }
 
@@ -347,20 +735,23 @@ UBool UnifiedCache::_poll(
         UErrorCode &status) const {
     U_ASSERT(value == NULL);
     U_ASSERT(status == U_ZERO_ERROR);
-    Mutex lock(&gCacheMutex);
-    const UHashElement *element = uhash_find(fHashtable, &key);
+    int32_t stripe = _stripeOf(key);
+    Mutex lock(&gCacheMutex[stripe]);
+    const UHashElement *element = uhash_find(fHashtables[stripe], &key);
 
     // If the hash table contains an inProgress placeholder entry for this key,
     // this means that another thread is currently constructing the value object.
     // Loop, waiting for that construction to complete.
      while (element != NULL && _inProgress(element)) {
-        umtx_condWait(&gInProgressValueAddedCond, &gCacheMutex);
-        element = uhash_find(fHashtable, &key);
+        umtx_condWait(&gInProgressValueAddedCond[stripe], &gCacheMutex[stripe]);
+        element = uhash_find(fHashtables[stripe], &key);
     }
 
     // If the hash table contains an entry for the key,
     // fetch out the contents and return them.
     if (element != NULL) {
+        _touch(stripe, (const CacheKeyBase *) element->key.pointer);
+        _recordStatistic(stripe, key, &UnifiedCacheStatistics::hits);
          _fetch(element, value, status);
         return TRUE;
     }
@@ -368,7 +759,8 @@ UBool UnifiedCache::_poll(
     // The hash table contained nothing for this key.
     // Insert an inProgress place holder value.
     // Our caller will create the final value and update the hash table.
-    _putNew(key, fNoValue, U_ZERO_ERROR, status);
+    _recordStatistic(stripe, key, &UnifiedCacheStatistics::misses);
+    _putNew(stripe, key, fNoValue, 0, U_ZERO_ERROR, status);
     return FALSE;
 }
 
@@ -401,33 +793,39 @@ void UnifiedCache::_get(
 }
 
 void UnifiedCache::_registerMaster(
-            const CacheKeyBase *theKey, const SharedObject *value) const {
+            int32_t stripe, const CacheKeyBase *theKey, const SharedObject *value,
+            int32_t footprint) const {
     theKey->fIsMaster = true;
     value->cachePtr = this;
-    ++fNumValuesTotal;
-    ++fNumValuesInUse;
+    value->cacheFootprint = std::max(footprint, 0);
+    umtx_storeRelease(fFootprint[stripe],
+                      umtx_loadAcquire(fFootprint[stripe]) + value->cacheFootprint);
+    umtx_atomic_inc(&fNumValuesTotal);
+    umtx_atomic_inc(&fNumValuesInUse);
 }
 
 void UnifiedCache::_put(
+        int32_t stripe,
         const UHashElement *element,
         const SharedObject *value,
+        int32_t footprint,
         const UErrorCode status) const {
     U_ASSERT(_inProgress(element));
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     const SharedObject *oldValue = (const SharedObject *) element->value.pointer;
     theKey->fCreationStatus = status;
-    if (value->softRefCount == 0) {
-        _registerMaster(theKey, value);
+    if (umtx_loadAcquire(value->softRefCount) == 0) {
+        _registerMaster(stripe, theKey, value, footprint);
     }
-    value->softRefCount++;
+    umtx_atomic_inc(&value->softRefCount);
     UHashElement *ptr = const_cast<UHashElement *>(element);
     ptr->value.pointer = (void *) value;
     U_ASSERT(oldValue == fNoValue);
-    removeSoftRef(oldValue);
+    removeSoftRef(stripe, oldValue);
 
     // Tell waiting threads that we replace in-progress status with
     // an error.
-    umtx_condBroadcast(&gInProgressValueAddedCond);
+    umtx_condBroadcast(&gInProgressValueAddedCond[stripe]);
 }
 
 void UnifiedCache::_fetch(
@@ -437,7 +835,7 @@ void UnifiedCache::_fetch(
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     status = theKey->fCreationStatus;
 
-    // Since we have the cache lock, calling regular SharedObject add/removeRef
+    // Since we have a cache lock, calling regular SharedObject add/removeRef
     // could cause us to deadlock on ourselves since they may need to lock
     // the cache mutex.
     removeHardRef(value);
@@ -473,14 +871,19 @@ UBool UnifiedCache::_isEvictable(const UHashElement *element) const
 
     // We can evict entries that are either not a master or have just
     // one reference (The one reference being from the cache itself).
-    return (!theKey->fIsMaster || (theValue->softRefCount == 1 && theValue->noHardReferences()));
+    // The hard reference count must be checked first: another stripe can
+    // add a soft reference to this value only while holding a hard reference.
+    return (!theKey->fIsMaster ||
+            (theValue->noHardReferences() && umtx_loadAcquire(theValue->softRefCount) == 1));
 }
 
-void UnifiedCache::removeSoftRef(const SharedObject *value) const {
+void UnifiedCache::removeSoftRef(int32_t stripe, const SharedObject *value) const {
     U_ASSERT(value->cachePtr == this);
-    U_ASSERT(value->softRefCount > 0);
-    if (--value->softRefCount == 0) {
-        --fNumValuesTotal;
+    U_ASSERT(umtx_loadAcquire(value->softRefCount) > 0);
+    if (umtx_atomic_dec(&value->softRefCount) == 0) {
+        umtx_atomic_dec(&fNumValuesTotal);
+        umtx_storeRelease(fFootprint[stripe],
+                          umtx_loadAcquire(fFootprint[stripe]) - value->cacheFootprint);
         if (value->noHardReferences()) {
             delete value;
         } else {
@@ -498,7 +901,7 @@ int32_t UnifiedCache::removeHardRef(const SharedObject *value) const {
         refCount = umtx_atomic_dec(&value->hardRefCount);
         U_ASSERT(refCount >= 0);
         if (refCount == 0) {
-            --fNumValuesInUse;
+            umtx_atomic_dec(&fNumValuesInUse);
         }
     }
     return refCount;
@@ -510,10 +913,30 @@ int32_t UnifiedCache::addHardRef(const SharedObject *value) const {
         refCount = umtx_atomic_inc(&value->hardRefCount);
         U_ASSERT(refCount >= 1);
         if (refCount == 1) {
-            fNumValuesInUse++;
+            umtx_atomic_inc(&fNumValuesInUse);
         }
     }
     return refCount;
 }
 
 U_NAMESPACE_END
+
+U_NAMESPACE_USE
+
+U_CAPI void U_EXPORT2
+ucache_setStatisticsEnabled(UBool enabled, UErrorCode *status) {
+    UnifiedCache *cache = UnifiedCache::getInstance(*status);
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    cache->setStatisticsEnabled(enabled);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucache_getStatistics(UCacheStatistics *dest, int32_t capacity, UErrorCode *status) {
+    const UnifiedCache *cache = UnifiedCache::getInstance(*status);
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    return cache->getStatistics(dest, capacity, *status);
+}
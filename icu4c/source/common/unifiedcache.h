@@ -17,6 +17,7 @@
 
 #include "unicode/uobject.h"
 #include "unicode/locid.h"
+#include "unicode/ucache.h"
 #include "sharedobject.h"
 #include "unicode/unistr.h"
 #include "cstring.h"
@@ -34,13 +35,16 @@ class UnifiedCache;
  */
 class U_COMMON_API CacheKeyBase : public UObject {
  public:
-   CacheKeyBase() : fCreationStatus(U_ZERO_ERROR), fIsMaster(FALSE) {}
+   CacheKeyBase()
+           : fCreationStatus(U_ZERO_ERROR), fIsMaster(FALSE), fReferenced(FALSE),
+             fLastAccess(0), fLruPrev(NULL), fLruNext(NULL) {}
 
    /**
     * Copy constructor. Needed to support cloning.
     */
    CacheKeyBase(const CacheKeyBase &other) 
-           : UObject(other), fCreationStatus(other.fCreationStatus), fIsMaster(FALSE) { }
+           : UObject(other), fCreationStatus(other.fCreationStatus), fIsMaster(FALSE),
+             fReferenced(FALSE), fLastAccess(0), fLruPrev(NULL), fLruNext(NULL) { }
    virtual ~CacheKeyBase();
 
    /**
@@ -89,9 +93,58 @@ class U_COMMON_API CacheKeyBase : public UObject {
  private:
    mutable UErrorCode fCreationStatus;
    mutable UBool fIsMaster;
+   // Set when the entry is fetched; cleared by UCACHE_EVICT_CLOCK sweeps.
+   mutable UBool fReferenced;
+   // Access tick of the latest fetch, for non-sharded UCACHE_EVICT_LRU.
+   mutable uint32_t fLastAccess;
+   // Links in the recency list of the key's cache stripe, least recent first.
+   mutable const CacheKeyBase *fLruPrev;
+   mutable const CacheKeyBase *fLruNext;
    friend class UnifiedCache;
 };
 
+/**
+ * Algorithms that choose which unused cache entries to evict.
+ * See UnifiedCache::setEvictionAlgorithm().
+ */
+enum UCacheEvictionAlgorithm {
+    /**
+     * Sweep the entries round robin, evicting each unused entry found.
+     * This is the default.
+     */
+    UCACHE_EVICT_ROUND_ROBIN,
+    /**
+     * Sweep the entries round robin, but give each entry fetched since the
+     * previous sweep a second chance.
+     */
+    UCACHE_EVICT_CLOCK,
+    /**
+     * Evict the least recently fetched unused entries first.
+     * Unless the cache is sharded, this increments a cache-wide counter on
+     * every access. In a sharded cache, recency is tracked for each stripe
+     * separately, without a shared counter.
+     */
+    UCACHE_EVICT_LRU,
+    /**
+     * Sweep the entries round robin, and among the unused entries found,
+     * evict those with the largest SharedObject::getMemoryFootprint() first.
+     * The cache is limited by the memory footprint of its values, set with
+     * UnifiedCache::setMemoryLimit(), instead of by the number of entries.
+     */
+    UCACHE_EVICT_SIZE_WEIGHTED,
+    /**
+     * One more than the highest normal UCacheEvictionAlgorithm value.
+     */
+    UCACHE_EVICT_ALGORITHM_COUNT
+};
+
+/**
+ * Cache statistics for one type of cache key.
+ * See UnifiedCache::getStatistics().
+ * The key type name is the one returned by typeid().name().
+ */
+typedef UCacheStatistics UnifiedCacheStatistics;
+
 
 
 /**
@@ -179,6 +232,12 @@ class LocaleCacheKey : public CacheKey<T> {
  * The unified cache. A singleton type.
  * Design doc here:
  * https://docs.google.com/document/d/1RwGQJs4N4tawNbf809iYDRCvXoMKqDJihxzYt1ysmd8/edit?usp=sharing
+ *
+ * The key space is partitioned into STRIPE_COUNT stripes, each with its own
+ * hash table and mutex, so that concurrent lookups of different keys
+ * rarely contend. Cache-wide counters are atomic. Eviction and flushing
+ * are serialized by a separate eviction mutex which is always acquired
+ * before any stripe mutex.
  */
 class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
  public:
@@ -321,6 +380,9 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     * unused entries will remain only a small percentage of the total cache
     * size.
     *
+    * With UCACHE_EVICT_SIZE_WEIGHTED, the limit set with setMemoryLimit()
+    * is used instead.
+    *
     * If the parameters passed are negative, setEvctionPolicy sets status to
     * U_ILLEGAL_ARGUMENT_ERROR.
     */
@@ -328,6 +390,46 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
            int32_t count, int32_t percentageOfInUseItems, UErrorCode &status);
 
 
+   /**
+    * Selects how the cache chooses unused entries to evict.
+    *
+    * If sharded is FALSE, eviction slices walk all stripes of the cache in
+    * turn under a cache-wide eviction mutex. If sharded is TRUE, each
+    * eviction slice works on a single stripe while holding only that
+    * stripe's mutex: the stripe that was just added to, or the next stripe
+    * in turn when a value becomes unreferenced. The limits set with
+    * setEvictionPolicy() or setMemoryLimit() still apply to the cache as
+    * a whole.
+    *
+    * If this method is never called, the cache uses
+    * UCACHE_EVICT_ROUND_ROBIN and is not sharded.
+    *
+    * If algorithm is out of range, sets status to U_ILLEGAL_ARGUMENT_ERROR.
+    */
+   void setEvictionAlgorithm(
+           UCacheEvictionAlgorithm algorithm, UBool sharded, UErrorCode &status);
+
+   /**
+    * Configures the limit for UCACHE_EVICT_SIZE_WEIGHTED.
+    * With that algorithm, the cache evicts unused entries as long as the
+    * total SharedObject::getMemoryFootprint() of all of its values exceeds
+    * maxBytes, and the count given to setEvictionPolicy() does not apply.
+    * Values in use count towards the total but are never evicted. If they
+    * alone exceed maxBytes, then values are evicted as soon as they are no
+    * longer in use.
+    *
+    * If this method is never called, the limit is 4 MB.
+    *
+    * If maxBytes is negative, sets status to U_ILLEGAL_ARGUMENT_ERROR.
+    */
+   void setMemoryLimit(int32_t maxBytes, UErrorCode &status);
+
+   /**
+    * Returns the total SharedObject::getMemoryFootprint() of the values
+    * in this cache.
+    */
+   int32_t memoryFootprint() const;
+
    /**
     * Returns how many entries have been auto evicted during the lifetime
     * of this cache. This only includes auto evicted entries, not
@@ -335,6 +437,27 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     */
    int64_t autoEvictedCount() const;
 
+   /**
+    * Turns collection of per key type statistics on or off.
+    * Collection is off by default because it costs a hash lookup
+    * on every cache access.
+    */
+   void setStatisticsEnabled(UBool enabled);
+
+   /**
+    * Fetches the hit, miss and eviction counts of each key type seen since
+    * statistics collection was turned on.
+    *
+    * @param dest     receives one entry per key type, in no particular order.
+    *                 May be NULL if capacity is 0.
+    * @param capacity the number of entries dest can hold.
+    * @param status   set to U_BUFFER_OVERFLOW_ERROR if there are more than
+    *                 capacity key types.
+    * @return the number of key types.
+    */
+   int32_t getStatistics(
+           UnifiedCacheStatistics *dest, int32_t capacity, UErrorCode &status) const;
+
    /**
     * Returns the unused entry count in this cache. For testing only,
     * Regular clients will not need this.
@@ -343,25 +466,60 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
 
    virtual void handleUnreferencedObject() const;
    virtual ~UnifiedCache();
+
+   /**
+    * The number of independently locked partitions of the key space.
+    * Must be a power of two.
+    */
+   static const int32_t STRIPE_COUNT = 16;
    
  private:
-   UHashtable *fHashtable;
-   mutable int32_t fEvictPos;
-   mutable int32_t fNumValuesTotal;
-   mutable int32_t fNumValuesInUse;
-   int32_t fMaxUnused;
-   int32_t fMaxPercentageOfInUse;
-   mutable int64_t fAutoEvictedCount;
+   UHashtable *fHashtables[STRIPE_COUNT];
+   // Per key type statistics, keyed by type name. One table per stripe,
+   // protected by the stripe mutex.
+   UHashtable *fStatistics[STRIPE_COUNT];
+   // Recency lists of the stripes, protected by the stripe mutex.
+   mutable const CacheKeyBase *fLruHead[STRIPE_COUNT];
+   mutable const CacheKeyBase *fLruTail[STRIPE_COUNT];
+   // Round robin sweep positions of the stripes, protected by the stripe mutex.
+   mutable int32_t fEvictPos[STRIPE_COUNT];
+   // Auto evicted counts of the stripes, protected by the stripe mutex.
+   mutable int64_t fAutoEvictedCount[STRIPE_COUNT];
+   // Memory footprints of the values added and deleted while holding
+   // the stripe mutex. Written only with the stripe mutex held, read without it.
+   // A value can be added in one stripe and deleted in another, so only
+   // the sum over all stripes is meaningful.
+   mutable u_atomic_int32_t fFootprint[STRIPE_COUNT];
+   // Stripe swept next by non-sharded eviction, protected by gCacheEvictMutex.
+   mutable int32_t fEvictStripe;
+   // Stripe swept next by sharded eviction on release of a value.
+   mutable u_atomic_int32_t fNextShardToEvict;
+   // Counter for CacheKeyBase::fLastAccess.
+   mutable u_atomic_int32_t fAccessTick;
+   mutable u_atomic_int32_t fNumKeys;
+   mutable u_atomic_int32_t fNumValuesTotal;
+   mutable u_atomic_int32_t fNumValuesInUse;
+   mutable u_atomic_int32_t fMaxUnused;
+   mutable u_atomic_int32_t fMaxPercentageOfInUse;
+   mutable u_atomic_int32_t fMaxBytes;
+   mutable u_atomic_int32_t fEvictionAlgorithm;
+   mutable u_atomic_int32_t fSharded;
+   mutable u_atomic_int32_t fCollectStatistics;
    SharedObject *fNoValue;
    
    UnifiedCache(const UnifiedCache &other);
    UnifiedCache &operator=(const UnifiedCache &other);
+
+   /**
+    * Returns the index of the stripe that holds key.
+    */
+   static int32_t _stripeOf(const CacheKeyBase &key);
    
    /**
     * Flushes the contents of the cache. If cache values hold references to other
     * cache values then _flush should be called in a loop until it returns FALSE.
     * 
-    * On entry, gCacheMutex must be held.
+    * On entry, gCacheEvictMutex must be held and no stripe mutex may be held.
     * On exit, those values with are evictable are flushed.
     * 
     *  @param all if false flush evictable items only, which are those with no external
@@ -376,7 +534,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    
    /**
     * Gets value out of cache.
-    * On entry. gCacheMutex must not be held. value must be NULL. status
+    * On entry. No cache mutex may be held. value must be NULL. status
     * must be U_ZERO_ERROR.
     * On exit. value and status set to what is in cache at key or on cache
     * miss the key's createObject() is called and value and status are set to
@@ -393,7 +551,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
 
     /**
      * Attempts to fetch value and status for key from cache.
-     * On entry, gCacheMutex must not be held value must be NULL and status must
+     * On entry, no cache mutex may be held, value must be NULL and status must
      * be U_ZERO_ERROR.
      * On exit, either returns FALSE (In this
      * case caller should try to create the object) or returns TRUE with value
@@ -409,13 +567,17 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     
     /**
      * Places a new value and creationStatus in the cache for the given key.
-     * On entry, gCacheMutex must be held. key must not exist in the cache. 
+     * On entry, the mutex of stripe, the key's stripe, must be held. key must
+     * not exist in the cache. footprint is value's getMemoryFootprint(),
+     * computed by the caller before it took the mutex.
      * On exit, value and creation status placed under key. Soft reference added
      * to value on successful add. On error sets status.
      */
     void _putNew(
+        int32_t stripe,
         const CacheKeyBase &key,
         const SharedObject *value,
+        int32_t footprint,
         const UErrorCode creationStatus,
         UErrorCode &status) const;
            
@@ -424,7 +586,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
      * entry for key is in progress. Otherwise, it leaves the current value and
      * status there.
      * 
-     * On entry. gCacheMutex must not be held. Value must be
+     * On entry. No cache mutex may be held. Value must be
      * included in the reference count of the object to which it points.
      * 
      * On exit, value and status are changed to what was already in the cache if
@@ -437,30 +599,83 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
            const SharedObject *&value,
            UErrorCode &status) const;
 
-    /**
-     * Returns the next element in the cache round robin style.
-     * Returns nullptr if the cache is empty.
-     * On entry, gCacheMutex must be held.
-     */
-    const UHashElement *_nextElement() const;
-   
    /**
     * Return the number of cache items that would need to be evicted
     * to bring usage into conformance with eviction policy.
+    * For UCACHE_EVICT_SIZE_WEIGHTED, return the number of bytes instead.
     * 
     * An item corresponds to an entry in the hash table, a hash table element.
     * 
-    * On entry, gCacheMutex must be held.
+    * Reads only atomic counters; no mutex needs to be held. The result is
+    * exact only while gCacheEvictMutex is held and no other thread is
+    * adding or releasing references.
     */
    int32_t _computeCountOfItemsToEvict() const;
    
    /**
     * Run an eviction slice.
-    * On entry, gCacheMutex must be held.
+    * On entry, gCacheEvictMutex must be held and no stripe mutex may be held.
     * _runEvictionSlice runs a slice of the evict pipeline by examining the next
-    * 10 entries in the cache round robin style evicting them if they are eligible.
+    * 10 entries in the cache, chosen by the eviction algorithm, evicting them
+    * if they are eligible. The slice walks the stripes in order, locking one
+    * at a time.
     */
    void _runEvictionSlice() const;
+
+   /**
+    * Run an eviction slice for sharded eviction. Like _runEvictionSlice, but
+    * starts at the given stripe and does not take gCacheEvictMutex, so that
+    * concurrent slices work on different stripes.
+    * On entry, no cache mutex may be held.
+    */
+   void _runShardEvictionSlice(int32_t stripe) const;
+
+   /**
+    * Run an eviction slice for non-sharded UCACHE_EVICT_LRU. Repeatedly
+    * examines the least recently used entry of the whole cache.
+    * On entry, gCacheEvictMutex must be held and no stripe mutex may be held.
+    */
+   void _runLruEvictionSlice(int32_t &iterationsLeft, int32_t &itemsToEvict) const;
+
+   /**
+    * Examine up to iterationsLeft entries of one stripe, evicting at most
+    * itemsToEvict of them. Both are decremented accordingly.
+    * On entry, the mutex of stripe must be held.
+    * @return TRUE if the stripe has no more entries to examine in this round,
+    *         so that a cache-wide sweep should continue with the next stripe.
+    */
+   UBool _evictFromStripe(
+           int32_t stripe, int32_t &iterationsLeft, int32_t &itemsToEvict) const;
+
+   /**
+    * Remove an entry from the cache, dropping its soft reference to its value.
+    * On entry, the mutex of stripe must be held and element must belong to it.
+    * If isAutoEviction is TRUE, the eviction is counted.
+    */
+   void _removeElement(int32_t stripe, const UHashElement *element, UBool isAutoEviction) const;
+
+   /**
+    * Append key to the recency list of stripe, or move it to the end if it
+    * is already there. Also marks the key as referenced, and stamps it with
+    * the next access tick if the cache uses non-sharded LRU eviction.
+    * On entry, the mutex of stripe must be held.
+    */
+   void _touch(int32_t stripe, const CacheKeyBase *key) const;
+
+   /**
+    * Remove key from the recency list of stripe.
+    * On entry, the mutex of stripe must be held.
+    */
+   void _unlink(int32_t stripe, const CacheKeyBase *key) const;
+
+   /**
+    * Count a hit, miss or eviction for the type of key, if statistics
+    * collection is on.
+    * On entry, the mutex of stripe must be held.
+    */
+   void _recordStatistic(
+           int32_t stripe, const CacheKeyBase &key,
+           int64_t UnifiedCacheStatistics::*counter) const;
  
    /**
     * Register a master cache entry. A master key is the first key to create
@@ -468,36 +683,46 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
     * produce referneces to an already existing SharedObject are not masters -
     * they can be evicted and subsequently recreated.
     * 
-    * On entry, gCacheMutex must be held.
-    * On exit, items in use count incremented, entry is marked as a master
-    * entry, and value registered with cache so that subsequent calls to
-    * addRef() and removeRef() on it correctly interact with the cache.
-    */
-   void _registerMaster(const CacheKeyBase *theKey, const SharedObject *value) const;
+    * On entry, the mutex of stripe, the key's stripe, must be held.
+    * footprint is value's getMemoryFootprint(), computed without holding
+    * a cache mutex.
+    * On exit, items in use count incremented, footprint stored with value and
+    * added to the stripe's total, entry is marked as a master entry, and value
+    * registered with cache so that subsequent calls to addRef() and removeRef()
+    * on it correctly interact with the cache.
+    */
+   void _registerMaster(
+           int32_t stripe, const CacheKeyBase *theKey, const SharedObject *value,
+           int32_t footprint) const;
         
    /**
     * Store a value and creation error status in given hash entry.
-    * On entry, gCacheMutex must be held. Hash entry element must be in progress.
-    * value must be non NULL.
+    * On entry, the mutex of stripe must be held. Hash entry element must
+    * belong to that stripe and be in progress.
+    * value must be non NULL. footprint is value's getMemoryFootprint(),
+    * computed by the caller before it took the mutex.
     * On Exit, soft reference added to value. value and status stored in hash
     * entry. Soft reference removed from previous stored value. Waiting
     * threads notified.
     */
    void _put(
+           int32_t stripe,
            const UHashElement *element,
            const SharedObject *value,
+           int32_t footprint,
            const UErrorCode status) const;
     /**
      * Remove a soft reference, and delete the SharedObject if no references remain.
      * To be used from within the UnifiedCache implementation only.
-     * gCacheMutex must be held by caller.
+     * The mutex of the stripe that referenced value must be held by caller.
+     * @param stripe the stripe that referenced value.
      * @param value the SharedObject to be acted on.
      */
-   void removeSoftRef(const SharedObject *value) const;
+   void removeSoftRef(int32_t stripe, const SharedObject *value) const;
    
    /**
     * Increment the hard reference count of the given SharedObject.
-    * gCacheMutex must be held by the caller.
+    * A cache mutex must be held by the caller.
     * Update numValuesEvictable on transitions between zero and one reference.
     * 
     * @param value The SharedObject to be referenced.
@@ -507,7 +732,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    
   /**
     * Decrement the hard reference count of the given SharedObject.
-    * gCacheMutex must be held by the caller.
+    * A cache mutex must be held by the caller.
     * Update numValuesEvictable on transitions between one and zero reference.
     * 
     * @param value The SharedObject to be referenced.
@@ -522,7 +747,7 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
    
    /**
     *  Fetch value and error code from a particular hash entry.
-    *  On entry, gCacheMutex must be held. value must be either NULL or must be
+    *  On entry, the mutex of the element's stripe must be held. value must be either NULL or must be
     *  included in the ref count of the object to which it points.
     *  On exit, value and status set to what is in the hash entry. Caller must
     *  eventually call removeRef on value.
@@ -534,21 +759,29 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
                        
     /**
      * Determine if given hash entry is in progress.
-     * On entry, gCacheMutex must be held.
+     * On entry, the mutex of the element's stripe must be held.
      */
    UBool _inProgress(const UHashElement *element) const;
    
    /**
     * Determine if given hash entry is in progress.
-    * On entry, gCacheMutex must be held.
+    * On entry, the mutex of the stripe holding the entry must be held.
     */
    UBool _inProgress(const SharedObject *theValue, UErrorCode creationStatus) const;
    
    /**
     * Determine if given hash entry is eligible for eviction.
-    * On entry, gCacheMutex must be held.
+    * On entry, gCacheEvictMutex and the mutex of the element's stripe
+    * must be held.
     */
    UBool _isEvictable(const UHashElement *element) const;
+
+   /**
+    * Returns the number of bytes that evicting this entry would free:
+    * the memory footprint of the value if the entry is its master, else 0.
+    * On entry, the mutex of the element's stripe must be held.
+    */
+   static int32_t _footprintOf(const UHashElement *element);
 };
 
 U_NAMESPACE_END
@@ -50,6 +50,35 @@ static icu::UInitOnce gCacheInitOnce;
 
 static UMutex resbMutex = U_MUTEX_INITIALIZER;
 
+/*
+ * Direct-mapped cache of entryOpen() results, keyed by locale ID, path and open type.
+ * A slot is filled once under resbMutex and published with a release store,
+ * so that repeated opens of the same locale need neither the lock nor the
+ * fallback walk. Each filled slot holds one reference on every entry of its chain.
+ * Slots are only cleared by ures_flushCache().
+ */
+#define URES_OPEN_CACHE_SIZE 64
+
+typedef struct UResOpenCacheSlot {
+    u_atomic_int32_t isSet;
+    int32_t openType;
+    UErrorCode status;
+    UResourceDataEntry *entry;
+    char localeID[ULOC_FULLNAME_CAPACITY];
+} UResOpenCacheSlot;
+
+static UResOpenCacheSlot gOpenCache[URES_OPEN_CACHE_SIZE];
+
+static void entryCloseInt(UResourceDataEntry *resB);
+
+/*
+ * fCountExisting is modified atomically so that bundles can be
+ * opened from gOpenCache and closed without holding resbMutex.
+ */
+static inline u_atomic_int32_t *countExisting(UResourceDataEntry *entry) {
+    return (u_atomic_int32_t *)&entry->fCountExisting;
+}
+
 /* INTERNAL: hashes an entry  */
 static int32_t U_CALLCONV hashEntry(const UHashTok parm) {
     UResourceDataEntry *b = (UResourceDataEntry *)parm.pointer;
@@ -89,16 +118,16 @@ static UBool chopLocale(char *name) {
 }
 
 /**
- *  Internal function
+ *  Internal function.
+ *  Does not need resbMutex: The entry is already referenced,
+ *  and its parent chain was completed before the entry was handed out.
  */
 static void entryIncrease(UResourceDataEntry *entry) {
-    umtx_lock(&resbMutex);
-    entry->fCountExisting++;
+    umtx_atomic_inc(countExisting(entry));
     while(entry->fParent != NULL) {
       entry = entry->fParent;
-      entry->fCountExisting++;
+      umtx_atomic_inc(countExisting(entry));
     }
-    umtx_unlock(&resbMutex);
 }
 
 /**
@@ -156,14 +185,14 @@ free_entry(UResourceDataEntry *entry) {
         uprv_free(entry->fPath);
     }
     if(entry->fPool != NULL) {
-        --entry->fPool->fCountExisting;
+        umtx_atomic_dec(countExisting(entry->fPool));
     }
     alias = entry->fAlias;
     if(alias != NULL) {
         while(alias->fAlias != NULL) {
             alias = alias->fAlias;
         }
-        --alias->fCountExisting;
+        umtx_atomic_dec(countExisting(alias));
     }
     uprv_free(entry);
 }
@@ -186,6 +215,16 @@ static int32_t ures_flushCache()
         return 0;
     }
 
+    /* release the references held by the entryOpen() results cache */
+    for (int32_t i = 0; i < URES_OPEN_CACHE_SIZE; ++i) {
+        UResOpenCacheSlot *slot = gOpenCache + i;
+        if (umtx_loadAcquire(slot->isSet) != 0) {
+            umtx_storeRelease(slot->isSet, 0);
+            entryCloseInt(slot->entry);
+            slot->entry = NULL;
+        }
+    }
+
     do {
         deletedMore = FALSE;
         /*creates an enumeration to iterate through every element in the table */
@@ -202,7 +241,7 @@ static int32_t ures_flushCache()
             /* 04/05/2002 [weiv] fCountExisting should now be accurate. If it's not zero, that means that    */
             /* some resource bundles are still open somewhere. */
 
-            if (resB->fCountExisting == 0) {
+            if (umtx_loadAcquire(*countExisting(resB)) == 0) {
                 rbDeletedNum++;
                 deletedMore = TRUE;
                 uhash_removeElement(cache, e);
@@ -380,6 +419,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
                     if(r->fData.pRoot[1 + URES_INDEX_POOL_CHECKSUM] == poolIndexes[URES_INDEX_POOL_CHECKSUM]) {
                         r->fData.poolBundleKeys = (const char *)(poolIndexes + (poolIndexes[URES_INDEX_LENGTH] & 0xff));
                         r->fData.poolBundleStrings = r->fPool->fData.p16BitUnits;
+                        r->fData.poolBundleUTF8Strings = r->fPool->fData.utf8Strings;
                     } else {
                         r->fBogus = *status = U_INVALID_FORMAT_ERROR;
                     }
@@ -426,7 +466,7 @@ static UResourceDataEntry *init_entry(const char *localeID, const char *path, UE
         while(r->fAlias != NULL) {
             r = r->fAlias;
         }
-        r->fCountExisting++; /* we increase its reference count */
+        umtx_atomic_inc(countExisting(r)); /* we increase its reference count */
         /* if the resource has a warning */
         /* we don't want to overwrite a status with no error */
         if(r->fBogus != U_ZERO_ERROR && U_SUCCESS(*status)) {
@@ -471,7 +511,7 @@ findFirstExisting(const char* path, char* name,
             /* not to be used - as there might be parent   */
             /* lines in cache from previous openings that  */
             /* are not updated yet. */
-            r->fCountExisting--;
+            umtx_atomic_dec(countExisting(r));
             /*entryCloseInt(r);*/
             r = NULL;
             *status = U_USING_FALLBACK_WARNING;
@@ -546,7 +586,7 @@ loadParentsExceptRoot(UResourceDataEntry *&t1,
             t1->fParent = t2;
             if (usingUSRData) {
                 // The USR override data wasn't found, set it to be deleted.
-                u2->fCountExisting = 0;
+                umtx_storeRelease(*countExisting(u2), 0);
             }
         }
         t1 = t2;
@@ -601,6 +641,47 @@ enum UResOpenType {
 };
 typedef enum UResOpenType UResOpenType;
 
+/**
+ * INTERNAL: Returns the gOpenCache slot for these entryOpen() arguments,
+ * or NULL if the locale ID is too long to be cached.
+ */
+static UResOpenCacheSlot *
+getOpenCacheSlot(const char *path, const char *localeID, UResOpenType openType) {
+    int32_t length = (int32_t)uprv_strlen(localeID);
+    if (length >= ULOC_FULLNAME_CAPACITY) {
+        return NULL;
+    }
+    uint32_t hash = (uint32_t)ustr_hashCharsN(localeID, length);
+    if (path != NULL) {
+        hash += 37u * (uint32_t)ustr_hashCharsN(path, (int32_t)uprv_strlen(path));
+    }
+    hash += (uint32_t)openType;
+    return gOpenCache + (hash % URES_OPEN_CACHE_SIZE);
+}
+
+/**
+ * INTERNAL: Looks up a previous entryOpen() result without locking.
+ * On a hit, the chain's reference counts are increased as entryOpen() would have.
+ */
+static UResourceDataEntry *
+findOpenCacheEntry(UResOpenCacheSlot *slot, const char *path, const char *localeID,
+                   UResOpenType openType, UErrorCode *status) {
+    if (umtx_loadAcquire(slot->isSet) == 0 ||
+            slot->openType != openType ||
+            uprv_strcmp(slot->localeID, localeID) != 0) {
+        return NULL;
+    }
+    UResourceDataEntry *r = slot->entry;
+    if (path == NULL ? r->fPath != NULL : (r->fPath == NULL || uprv_strcmp(path, r->fPath) != 0)) {
+        return NULL;
+    }
+    entryIncrease(r);
+    if (slot->status != U_ZERO_ERROR) {
+        *status = slot->status;
+    }
+    return r;
+}
+
 static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
                                      UResOpenType openType, UErrorCode* status) {
     U_ASSERT(openType != URES_OPEN_DIRECT);
@@ -622,6 +703,17 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
         return NULL;
     }
 
+    UResOpenCacheSlot *slot = NULL;
+    if (!usingUSRData) {
+        slot = getOpenCacheSlot(path, localeID, openType);
+        if (slot != NULL) {
+            r = findOpenCacheEntry(slot, path, localeID, openType, status);
+            if (r != NULL) {
+                return r;
+            }
+        }
+    }
+
     uprv_strncpy(name, localeID, sizeof(name) - 1);
     name[sizeof(name) - 1] = 0;
 
@@ -654,7 +746,7 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
                    r = u1;
                  } else {
                    /* the USR override data wasn't found, set it to be deleted */
-                   u1->fCountExisting = 0;
+                   umtx_storeRelease(*countExisting(u1), 0);
                  }
                }
             }
@@ -710,9 +802,23 @@ static UResourceDataEntry *entryOpen(const char* path, const char* localeID,
 
         // TODO: Does this ever loop?
         while(r != NULL && !isRoot && t1->fParent != NULL) {
-            t1->fParent->fCountExisting++;
+            umtx_atomic_inc(countExisting(t1->fParent));
             t1 = t1->fParent;
         }
+
+        /*
+         * Remember the result unless it depends on the default locale,
+         * which can change between calls.
+         */
+        if (slot != NULL && umtx_loadAcquire(slot->isSet) == 0 &&
+                !(openType == URES_OPEN_LOCALE_DEFAULT_ROOT && intStatus == U_USING_DEFAULT_WARNING)) {
+            entryIncrease(r);  /* the cache's own reference */
+            slot->openType = openType;
+            slot->status = intStatus;
+            slot->entry = r;
+            uprv_strcpy(slot->localeID, localeID);
+            umtx_storeRelease(slot->isSet, 1);
+        }
     } /* umtx_lock */
 finishUnlock:
     umtx_unlock(&resbMutex);
@@ -745,7 +851,7 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
     UResourceDataEntry *r = init_entry(localeID, path, status);
     if(U_SUCCESS(*status)) {
         if(r->fBogus != U_ZERO_ERROR) {
-            r->fCountExisting--;
+            umtx_atomic_dec(countExisting(r));
             r = NULL;
         }
     } else {
@@ -774,7 +880,7 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
     if(r != NULL) {
         // TODO: Does this ever loop?
         while(t1->fParent != NULL) {
-            t1->fParent->fCountExisting++;
+            umtx_atomic_inc(countExisting(t1->fParent));
             t1 = t1->fParent;
         }
     }
@@ -784,7 +890,8 @@ entryOpenDirect(const char* path, const char* localeID, UErrorCode* status) {
 
 /**
  * Functions to create and destroy resource bundles.
- *     CAUTION:  resbMutex must be locked when calling this function.
+ *     The reference counts are modified atomically;
+ *     resbMutex need not be locked when calling this function.
  */
 /* INTERNAL: */
 static void entryCloseInt(UResourceDataEntry *resB) {
@@ -792,7 +899,7 @@ static void entryCloseInt(UResourceDataEntry *resB) {
 
     while(resB != NULL) {
         p = resB->fParent;
-        resB->fCountExisting--;
+        umtx_atomic_dec(countExisting(resB));
 
         /* Entries are left in the cache. TODO: add ures_flushCache() to force a flush
          of the cache. */
@@ -821,9 +928,7 @@ static void entryCloseInt(UResourceDataEntry *resB) {
  */
 
 static void entryClose(UResourceDataEntry *resB) {
-  umtx_lock(&resbMutex);
   entryCloseInt(resB);
-  umtx_unlock(&resbMutex);
 }
 
 /*
@@ -1323,6 +1428,53 @@ ures_toUTF8String(const UChar *s16, int32_t length16,
     }
 }
 
+/*
+ * Like ures_toUTF8String(), but first looks for a UTF-8 copy of s16
+ * in the bundles that it may have come from (see URES_ATT_HAS_UTF8_STRINGS)
+ * and returns that without conversion.
+ */
+static const char *
+ures_getUTF8Copy(const UResourceBundle *resB,
+                 const UChar *s16, int32_t length16,
+                 char *dest, int32_t *pLength,
+                 UBool forceCopy,
+                 UErrorCode *status) {
+    int32_t capacity, length8;
+    const char *s8;
+
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    s8 = res_getUTF8String(&resB->fResData, s16, &length8);
+    for (UResourceDataEntry *entry = resB->fData; s8 == NULL && entry != NULL; entry = entry->fParent) {
+        s8 = res_getUTF8String(&entry->fData, s16, &length8);
+    }
+    if (s8 == NULL) {
+        return ures_toUTF8String(s16, length16, dest, pLength, forceCopy, status);
+    }
+
+    if (pLength != NULL) {
+        capacity = *pLength;
+    } else {
+        capacity = 0;
+    }
+    if (capacity < 0 || (capacity > 0 && dest == NULL)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    if (pLength != NULL) {
+        *pLength = length8;
+    }
+    if (!forceCopy) {
+        return s8;
+    }
+    if (length8 <= capacity) {
+        uprv_memcpy(dest, s8, length8);
+    }
+    u_terminateChars(dest, capacity, length8, status);
+    return dest;
+}
+
 U_CAPI const char * U_EXPORT2
 ures_getUTF8String(const UResourceBundle *resB,
                    char *dest, int32_t *pLength,
@@ -1330,7 +1482,7 @@ ures_getUTF8String(const UResourceBundle *resB,
                    UErrorCode *status) {
     int32_t length16;
     const UChar *s16 = ures_getString(resB, &length16, status);
-    return ures_toUTF8String(s16, length16, dest, pLength, forceCopy, status);
+    return ures_getUTF8Copy(resB, s16, length16, dest, pLength, forceCopy, status);
 }
 
 U_CAPI const uint8_t* U_EXPORT2 ures_getBinary(const UResourceBundle* resB, int32_t* len, 
@@ -1653,7 +1805,7 @@ ures_getUTF8StringByIndex(const UResourceBundle *resB,
                           UErrorCode *status) {
     int32_t length16;
     const UChar *s16 = ures_getStringByIndex(resB, idx, &length16, status);
-    return ures_toUTF8String(s16, length16, dest, pLength, forceCopy, status);
+    return ures_getUTF8Copy(resB, s16, length16, dest, pLength, forceCopy, status);
 }
 
 /*U_CAPI const char *ures_getResPath(UResourceBundle *resB) {
@@ -1978,6 +2130,44 @@ ures_getAllItemsWithFallback(const UResourceBundle *bundle, const char *path,
     ures_close(&stackBundle);
 }
 
+U_CAPI UBool U_EXPORT2
+ures_visitItems(const UResourceBundle *bundle, const char *path,
+                icu::ResourceVisitor &visitor, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return FALSE; }
+    if (bundle == NULL || path == NULL) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return FALSE;
+    }
+    UResourceBundle stackBundle;
+    ures_initStackObject(&stackBundle);
+    const UResourceBundle *rb;
+    if (*path == 0) {
+        // empty path
+        rb = bundle;
+    } else {
+        rb = ures_getByKeyWithFallback(bundle, path, &stackBundle, &errorCode);
+    }
+    UBool complete = FALSE;
+    if (U_SUCCESS(errorCode)) {
+        ResourceDataValue value;
+        value.pResData = &rb->fResData;
+        value.setResource(rb->fRes);
+        switch (value.getType()) {
+        case URES_TABLE:
+            complete = value.getTable(errorCode).visit(value, visitor, errorCode);
+            break;
+        case URES_ARRAY:
+            complete = value.getArray(errorCode).visit(value, visitor, errorCode);
+            break;
+        default:
+            errorCode = U_RESOURCE_TYPE_MISMATCH;
+            break;
+        }
+    }
+    ures_close(&stackBundle);
+    return complete;
+}
+
 U_CAPI UResourceBundle* U_EXPORT2 ures_getByKey(const UResourceBundle *resB, const char* inKey, UResourceBundle *fillIn, UErrorCode *status) {
     Resource res = RES_BOGUS;
     UResourceDataEntry *realData = NULL;
@@ -2121,7 +2311,7 @@ ures_getUTF8StringByKey(const UResourceBundle *resB,
                         UErrorCode *status) {
     int32_t length16;
     const UChar *s16 = ures_getStringByKey(resB, key, &length16, status);
-    return ures_toUTF8String(s16, length16, dest, pLength, forceCopy, status);
+    return ures_getUTF8Copy(resB, s16, length16, dest, pLength, forceCopy, status);
 }
 
 /* TODO: clean from here down */
@@ -225,6 +225,24 @@ res_init(ResourceData *pResData,
             indexes[URES_INDEX_16BIT_TOP]>indexes[URES_INDEX_KEYS_TOP]
         ) {
             pResData->p16BitUnits=(const uint16_t *)(pResData->pRoot+indexes[URES_INDEX_KEYS_TOP]);
+            if(indexes[URES_INDEX_ATTRIBUTES]&URES_ATT_HAS_UTF8_STRINGS) {
+                /* optional; ignore a table that does not fit its bounds */
+                int32_t resTop=indexes[URES_INDEX_RESOURCES_TOP];
+                int32_t bundleTop=indexes[URES_INDEX_BUNDLE_TOP];
+                if(0<resTop && (resTop+URES_UTF8_STRINGS_HEADER_LENGTH)<=bundleTop) {
+                    const int32_t *utf8Strings=pResData->pRoot+resTop;
+                    int32_t count=utf8Strings[URES_UTF8_STRINGS_COUNT];
+                    int32_t utf8Length=utf8Strings[URES_UTF8_STRINGS_LENGTH];
+                    int32_t capacity=(bundleTop-resTop-URES_UTF8_STRINGS_HEADER_LENGTH)*4;
+                    if( 0<=count && count<=capacity/12 &&
+                        0<=utf8Length && utf8Length<=capacity-count*12 &&
+                        utf8Strings[URES_UTF8_STRINGS_NUM_16BIT_UNITS]<=
+                            (indexes[URES_INDEX_16BIT_TOP]-indexes[URES_INDEX_KEYS_TOP])*2
+                    ) {
+                        pResData->utf8Strings=utf8Strings;
+                    }
+                }
+            }
         }
     }
 
@@ -414,6 +432,50 @@ int32_t getStringArray(const ResourceData *pResData, const icu::ResourceArray &a
 
 }  // namespace
 
+/*
+ * Binary search of the UTF-8 strings table for the 16-bit-units index of s16.
+ * Pointers outside of the 16-bit units that the table was written for
+ * are not looked up, so that they cannot match by accident.
+ */
+static const char *
+findUTF8String(const int32_t *utf8Strings, const uint16_t *p16BitUnits,
+               const UChar *s16, int32_t *pLength) {
+    if(utf8Strings==NULL ||
+            s16<(const UChar *)p16BitUnits ||
+            (const UChar *)p16BitUnits+utf8Strings[URES_UTF8_STRINGS_NUM_16BIT_UNITS]<=s16) {
+        return NULL;
+    }
+    int32_t stringIndex=(int32_t)(s16-(const UChar *)p16BitUnits);
+    int32_t count=utf8Strings[URES_UTF8_STRINGS_COUNT];
+    const int32_t *stringIndexes=utf8Strings+URES_UTF8_STRINGS_HEADER_LENGTH;
+    int32_t start=0, limit=count;
+    while(start<limit) {
+        int32_t i=(start+limit)/2;
+        int32_t si=stringIndexes[i];
+        if(stringIndex<si) {
+            limit=i;
+        } else if(stringIndex>si) {
+            start=i+1;
+        } else {
+            const int32_t *utf8Offsets=stringIndexes+count;
+            const int32_t *utf8Lengths=utf8Offsets+count;
+            const char *utf8=(const char *)(utf8Lengths+count);
+            *pLength=utf8Lengths[i];
+            return utf8+utf8Offsets[i];
+        }
+    }
+    return NULL;
+}
+
+U_CFUNC const char *
+res_getUTF8String(const ResourceData *pResData, const UChar *s16, int32_t *pLength) {
+    const char *s8=findUTF8String(pResData->utf8Strings, pResData->p16BitUnits, s16, pLength);
+    if(s8==NULL) {
+        s8=findUTF8String(pResData->poolBundleUTF8Strings, pResData->poolBundleStrings, s16, pLength);
+    }
+    return s8;
+}
+
 U_CAPI const UChar * U_EXPORT2
 res_getAlias(const ResourceData *pResData, Resource res, int32_t *pLength) {
     const UChar *p;
@@ -835,6 +897,53 @@ UBool icu::ResourceTable::getKeyAndValue(int32_t i,
     return FALSE;
 }
 
+UBool icu::ResourceTable::findValue(const char *key, icu::ResourceValue &value) const {
+    icu::ResourceDataValue &rdValue = static_cast<icu::ResourceDataValue &>(value);
+    const char *realKey = NULL;
+    int32_t i;
+    if (keys16 != NULL) {
+        i = _res_findTableItem(rdValue.pResData, keys16, length, key, &realKey);
+    } else {
+        i = _res_findTable32Item(rdValue.pResData, keys32, length, key, &realKey);
+    }
+    if (i >= 0) {
+        Resource res;
+        if (items16 != NULL) {
+            res = makeResourceFrom16(rdValue.pResData, items16[i]);
+        } else {
+            res = items32[i];
+        }
+        rdValue.setResource(res);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+UBool icu::ResourceTable::visit(icu::ResourceValue &value, icu::ResourceVisitor &visitor,
+                                UErrorCode &errorCode) const {
+    icu::ResourceDataValue &rdValue = static_cast<icu::ResourceDataValue &>(value);
+    const ResourceData *pResData = rdValue.pResData;
+    for (int32_t i = 0; i < length; ++i) {
+        if (U_FAILURE(errorCode)) { return FALSE; }
+        const char *key;
+        if (keys16 != NULL) {
+            key = RES_GET_KEY16(pResData, keys16[i]);
+        } else {
+            key = RES_GET_KEY32(pResData, keys32[i]);
+        }
+        if (!visitor.acceptKey(key)) { continue; }
+        // The visitor may have traversed nested items with the same value object,
+        // but it cannot have changed the bundle data.
+        if (items16 != NULL) {
+            rdValue.setResource(makeResourceFrom16(pResData, items16[i]));
+        } else {
+            rdValue.setResource(items32[i]);
+        }
+        if (!visitor.visit(key, i, value, errorCode)) { return FALSE; }
+    }
+    return U_SUCCESS(errorCode);
+}
+
 U_CAPI Resource U_EXPORT2
 res_getArrayItem(const ResourceData *pResData, Resource array, int32_t indexR) {
     uint32_t offset=RES_GET_OFFSET(array);
@@ -881,6 +990,18 @@ UBool icu::ResourceArray::getValue(int32_t i, icu::ResourceValue &value) const {
     return FALSE;
 }
 
+UBool icu::ResourceArray::visit(icu::ResourceValue &value, icu::ResourceVisitor &visitor,
+                                UErrorCode &errorCode) const {
+    icu::ResourceDataValue &rdValue = static_cast<icu::ResourceDataValue &>(value);
+    const ResourceData *pResData = rdValue.pResData;
+    for (int32_t i = 0; i < length; ++i) {
+        if (U_FAILURE(errorCode)) { return FALSE; }
+        rdValue.setResource(internalGetResource(pResData, i));
+        if (!visitor.visit(NULL, i, value, errorCode)) { return FALSE; }
+    }
+    return U_SUCCESS(errorCode);
+}
+
 U_CFUNC Resource
 res_findResource(const ResourceData *pResData, Resource r, char** path, const char** key) {
   char *pathP = *path, *nextSepP = *path;
@@ -1441,6 +1562,27 @@ ures_swap(const UDataSwapper *ds,
             }
         }
 
+        /* swap the header and int32_t arrays of the optional UTF-8 strings; the bytes need no swapping */
+        if( indexLength>URES_INDEX_16BIT_TOP &&
+            (udata_readInt32(ds, inIndexes[URES_INDEX_ATTRIBUTES])&URES_ATT_HAS_UTF8_STRINGS)
+        ) {
+            int32_t resTop=udata_readInt32(ds, inIndexes[URES_INDEX_RESOURCES_TOP]);
+            int32_t count;
+            if(resTop<=0 || top<(resTop+URES_UTF8_STRINGS_HEADER_LENGTH) ||
+                    (count=udata_readInt32(ds, inBundle[resTop+URES_UTF8_STRINGS_COUNT]))<0 ||
+                    (top-resTop-URES_UTF8_STRINGS_HEADER_LENGTH)/3<count) {
+                udata_printError(ds, "ures_swap(): UTF-8 strings table does not fit between %d and %d\n",
+                                 resTop, top);
+                *pErrorCode=U_INVALID_FORMAT_ERROR;
+                if(tempTable.resFlags!=stackResFlags) {
+                    uprv_free(tempTable.resFlags);
+                }
+                return 0;
+            }
+            ds->swapArray32(ds, inBundle+resTop, (URES_UTF8_STRINGS_HEADER_LENGTH+3*count)*4,
+                            outBundle+resTop, pErrorCode);
+        }
+
         /* allocate the temporary table for sorting resource tables */
         tempTable.keyChars=(const char *)outBundle; /* sort by outCharset */
         if(tempTable.majorFormatVersion>1 || maxTableLength<=STACK_ROW_CAPACITY) {
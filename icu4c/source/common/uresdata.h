@@ -154,6 +154,37 @@ enum {
 #define URES_ATT_IS_POOL_BUNDLE 2
 #define URES_ATT_USES_POOL_BUNDLE 4
 
+/*
+ * UTF-8 strings attribute, attribute bit 3 in indexes[URES_INDEX_ATTRIBUTES].
+ * New in ICU 63, optional for formatVersion 2 and up; written by genrb --writeUTF8Strings.
+ *
+ * If set, then the bundle contains UTF-8 copies of its local string-v2 values
+ * so that ures_getUTF8String() can return them without conversion.
+ * They are stored after the resources, from indexes[URES_INDEX_RESOURCES_TOP]
+ * to indexes[URES_INDEX_BUNDLE_TOP]:
+ *
+ *   int32_t count;            -- number of strings
+ *   int32_t num16BitUnits;    -- length of the local 16-bit-units array
+ *   int32_t utf8Length;       -- number of UTF-8 bytes, including NULs
+ *   int32_t stringIndexes[count];  -- ascending 16-bit-units indexes of the first
+ *                                     UChar of each string (after its length units)
+ *   int32_t utf8Offsets[count];    -- offsets into utf8[]
+ *   int32_t utf8Lengths[count];    -- UTF-8 string lengths, not counting the NUL
+ *   char utf8[utf8Length];    -- NUL-terminated UTF-8 strings, padded to 4 bytes
+ *
+ * A string-v2 that is a suffix of another one may point into the other's UTF-8 bytes.
+ * Strings with unpaired surrogates are not included.
+ */
+#define URES_ATT_HAS_UTF8_STRINGS 8
+
+/* indexes into the UTF-8 strings header, see URES_ATT_HAS_UTF8_STRINGS */
+enum {
+    URES_UTF8_STRINGS_COUNT,
+    URES_UTF8_STRINGS_NUM_16BIT_UNITS,
+    URES_UTF8_STRINGS_LENGTH,
+    URES_UTF8_STRINGS_HEADER_LENGTH
+};
+
 /*
  * File format for .res resource bundle files
  *
@@ -389,6 +420,8 @@ typedef struct ResourceData {
     Resource rootRes;
     int32_t localKeyLimit;
     const uint16_t *poolBundleStrings;
+    const int32_t *utf8Strings;  /* see URES_ATT_HAS_UTF8_STRINGS, or NULL */
+    const int32_t *poolBundleUTF8Strings;
     int32_t poolStringIndexLimit;
     int32_t poolStringIndex16Limit;
     UBool noFallback; /* see URES_ATT_NO_FALLBACK */
@@ -431,6 +464,15 @@ res_getPublicType(Resource res);
 U_INTERNAL const UChar * U_EXPORT2
 res_getString(const ResourceData *pResData, Resource res, int32_t *pLength);
 
+/*
+ * Return a pointer to the zero-terminated UTF-8 copy of a string
+ * that res_getString() returned for this bundle or its pool bundle,
+ * and set its length in *pLength.
+ * Returns NULL if there is no such copy, see URES_ATT_HAS_UTF8_STRINGS.
+ */
+U_CFUNC const char *
+res_getUTF8String(const ResourceData *pResData, const UChar *s16, int32_t *pLength);
+
 U_INTERNAL const UChar * U_EXPORT2
 res_getAlias(const ResourceData *pResData, Resource res, int32_t *pLength);
 
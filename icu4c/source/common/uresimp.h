@@ -230,6 +230,24 @@ U_CAPI void U_EXPORT2
 ures_getAllItemsWithFallback(const UResourceBundle *bundle, const char *path,
                              icu::ResourceSink &sink, UErrorCode &errorCode);
 
+/**
+ * Calls the visitor for the items of the array or table resource at the path,
+ * without creating a UResourceBundle or copying the resource path per item.
+ * The path is looked up like in ures_getByKeyWithFallback(),
+ * but unlike ures_getAllItemsWithFallback() the items of parent bundles are not visited.
+ * Table items are visited in key order and can be filtered by key.
+ *
+ * @param bundle the bundle to start from
+ * @param path a path to an array or table resource, or "" for the bundle itself
+ * @param visitor called for each item; may stop the traversal
+ * @param errorCode set to U_RESOURCE_TYPE_MISMATCH if the resource is not an array or table
+ * @return TRUE if all items were visited,
+ *     FALSE if the visitor stopped early or errorCode indicates failure
+ */
+U_CAPI UBool U_EXPORT2
+ures_visitItems(const UResourceBundle *bundle, const char *path,
+                icu::ResourceVisitor &visitor, UErrorCode &errorCode);
+
 #endif  /* __cplusplus */
 
 /**
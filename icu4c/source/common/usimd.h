@@ -0,0 +1,60 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   file name:  usimd.h
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Compile-time detection of the SIMD instruction sets that ICU code may use.
+*   Only instruction sets that are part of the baseline of their architecture
+*   are used, so that no runtime CPU detection is needed:
+*   SSE2 on x86-64 (and on x86 when the compiler targets it),
+*   and Advanced SIMD (NEON) on little-endian AArch64.
+*
+*   Code using these must produce the same results as its portable fallback.
+*   Define U_SIMD_SSE2 or U_SIMD_NEON to 0 to build the fallback code instead.
+*/
+
+#ifndef __USIMD_H__
+#define __USIMD_H__
+
+#include "unicode/utypes.h"
+
+/**
+ * \def U_SIMD_SSE2
+ * 1 if SSE2 intrinsics from <emmintrin.h> are available.
+ * @internal
+ */
+#ifndef U_SIMD_SSE2
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define U_SIMD_SSE2 1
+#   else
+#       define U_SIMD_SSE2 0
+#   endif
+#endif
+
+/**
+ * \def U_SIMD_NEON
+ * 1 if AArch64 Advanced SIMD intrinsics from <arm_neon.h> are available.
+ * Big-endian targets are excluded because the code reinterprets
+ * vectors of bytes as vectors of 16-bit units.
+ * @internal
+ */
+#ifndef U_SIMD_NEON
+#   if !U_SIMD_SSE2 && (defined(__aarch64__) || defined(_M_ARM64)) && !U_IS_BIG_ENDIAN
+#       define U_SIMD_NEON 1
+#   else
+#       define U_SIMD_NEON 0
+#   endif
+#endif
+
+#if U_SIMD_SSE2
+#   include <emmintrin.h>
+#elif U_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "unicode/utypes.h"
 #include "unicode/utf8.h"
+#include "unicode/utext.h"
 
 /**
  * Internal option for unorm_cmpEquivFold() for strncmp style.
@@ -46,6 +47,20 @@ ustr_hashCharsN(const char *str, int32_t length);
 U_CAPI int32_t U_EXPORT2
 ustr_hashICharsN(const char *str, int32_t length);
 
+/**
+ * Returns the bytes of a UText that was opened with utext_openUTF8()
+ * (or cloned from one), so that performance-critical code can decode
+ * them directly rather than through the UText's UTF-16 chunks.
+ * Native indexes of such a UText are byte offsets into this string.
+ *
+ * @param ut The UText.
+ * @param pLength Receives the string length in bytes.
+ * @return The UTF-8 string, or NULL if ut is not a UTF-8 UText
+ *         or its length is not yet known (NUL-terminated and not yet scanned).
+ */
+U_CFUNC const char *
+uprv_getUTF8TextContents(const UText *ut, int32_t *pLength);
+
 /**
  * NUL-terminate a UChar * string if possible.
  * If length  < destCapacity then NUL-terminate.
@@ -35,6 +35,273 @@
 #include "cmemory.h"
 #include "ustr_imp.h"
 #include "uassert.h"
+#include "usimd.h"
+
+#if U_SIMD_SSE2 || U_SIMD_NEON
+
+/*
+ * Block converters for the fast loops in u_strFromUTF8WithSub() and
+ * u_strToUTF8WithSub().
+ *
+ * Each one converts whole blocks of ASCII characters (16 bytes of UTF-8 or
+ * 8 UChars), and stops at the first block that has anything else, or when the
+ * source or destination has no room for a whole block. Such blocks are
+ * well-formed, so the results are the same as with the scalar code, and there
+ * are no substitutions.
+ * Blocks that mix ASCII with longer characters would have to be compacted
+ * with a byte shuffle, which is not in the SSE2 baseline, so they are left
+ * to the scalar code.
+ * They write only as many code units as they convert.
+ */
+
+/*
+ * Number of characters that the fast loops convert one at a time
+ * after a block which the block converter did not handle,
+ * before they try the block converter again.
+ * The number doubles with each try that converts at most one block,
+ * up to the maximum, so that text with few such blocks is not slowed down much.
+ */
+#define MIN_SCALAR_RUN_LENGTH 16
+#define MAX_SCALAR_RUN_LENGTH 1024
+
+/**
+ * Converts UTF-8 blocks starting at src to UTF-16 at pDest and
+ * advances pDest.
+ * src must start with a lead byte.
+ * @return the number of bytes converted
+ */
+static int32_t
+_utf8BlocksToUTF16(const uint8_t *src, int32_t srcLength,
+                   UChar *&pDest, const UChar *pDestLimit) {
+    int32_t i = 0;
+    while((srcLength - i) >= 16 && (pDestLimit - pDest) >= 16) {
+#if U_SIMD_SSE2
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        if(_mm_movemask_epi8(v) != 0) {
+            break;
+        }
+        __m128i zero = _mm_setzero_si128();
+        _mm_storeu_si128((__m128i *)pDest, _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i *)(pDest + 8), _mm_unpackhi_epi8(v, zero));
+#else  /* U_SIMD_NEON */
+        uint8x16_t v = vld1q_u8(src + i);
+        if(vmaxvq_u8(v) > 0x7f) {
+            break;
+        }
+        vst1q_u16((uint16_t *)pDest, vmovl_u8(vget_low_u8(v)));
+        vst1q_u16((uint16_t *)(pDest + 8), vmovl_u8(vget_high_u8(v)));
+#endif
+        i += 16;
+        pDest += 16;
+    }
+    return i;
+}
+
+/**
+ * Converts UTF-16 blocks starting at src to UTF-8 at pDest and
+ * advances pDest.
+ * @return the number of UChars converted
+ */
+static int32_t
+_utf16BlocksToUTF8(const UChar *src, int32_t srcLength,
+                   uint8_t *&pDest, const uint8_t *pDestLimit) {
+    int32_t i = 0;
+    while((srcLength - i) >= 8 && (pDestLimit - pDest) >= 8) {
+#if U_SIMD_SSE2
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i isASCII = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((short)0xff80)),
+                                          _mm_setzero_si128());
+        if(_mm_movemask_epi8(isASCII) != 0xffff) {
+            break;
+        }
+        _mm_storel_epi64((__m128i *)pDest, _mm_packus_epi16(v, v));
+#else  /* U_SIMD_NEON */
+        uint16x8_t v = vld1q_u16((const uint16_t *)(src + i));
+        if(vmaxvq_u16(v) > 0x7f) {
+            break;
+        }
+        vst1_u8(pDest, vmovn_u16(v));
+#endif
+        i += 8;
+        pDest += 8;
+    }
+    return i;
+}
+
+static inline int32_t
+_countBits16(uint32_t x) {
+    x = x - ((x >> 1) & 0x5555);
+    x = (x & 0x3333) + ((x >> 2) & 0x3333);
+    x = (x + (x >> 4)) & 0x0f0f;
+    return (int32_t)((x + (x >> 8)) & 0x1f);
+}
+
+/**
+ * Checks one 16-byte block of UTF-8, for _validateUTF8Blocks().
+ * p[-3..-1] must be readable, and are the bytes before the block,
+ * which have already been checked.
+ * Checks each byte against its three predecessors:
+ * A byte must be a trail byte if and only if a preceding lead byte needs it,
+ * and the second byte of a sequence must be in the range allowed by its lead byte.
+ * @return FALSE if the block contains an ill-formed sequence, or ends in the middle
+ *         of a sequence that has an ill-formed trail byte
+ */
+static inline UBool
+_checkUTF8Block(const uint8_t *p, int32_t &numCodePoints, int32_t &utf16Length) {
+#if U_SIMD_SSE2
+    __m128i cur = _mm_loadu_si128((const __m128i *)p);
+    if(_mm_movemask_epi8(cur) == 0) {
+        /* All ASCII: Only check that no sequence from the previous block is incomplete. */
+        if(p[-1] >= 0xc0 || p[-2] >= 0xe0 || p[-3] >= 0xf0) {
+            return FALSE;
+        }
+        numCodePoints += 16;
+        utf16Length += 16;
+        return TRUE;
+    }
+    __m128i prev1 = _mm_loadu_si128((const __m128i *)(p - 1));
+    __m128i prev2 = _mm_loadu_si128((const __m128i *)(p - 2));
+    __m128i prev3 = _mm_loadu_si128((const __m128i *)(p - 3));
+    /* Unsigned x>=k is max(x, k)==x. As signed bytes, trail bytes 80..BF are the smallest values. */
+#define UTF8_GE(x, k) _mm_cmpeq_epi8(_mm_max_epu8((x), _mm_set1_epi8((char)(k))), (x))
+    __m128i isTrail = _mm_cmplt_epi8(cur, _mm_set1_epi8((char)0xc0));
+    __m128i needsTrail = _mm_or_si128(
+        _mm_or_si128(UTF8_GE(prev1, 0xc0), UTF8_GE(prev2, 0xe0)), UTF8_GE(prev3, 0xf0));
+    __m128i isFourByteLead = UTF8_GE(cur, 0xf0);
+    __m128i error = _mm_or_si128(
+        _mm_xor_si128(isTrail, needsTrail),
+        /* C0, C1 and F5..FF are never valid */
+        _mm_or_si128(_mm_cmpeq_epi8(_mm_and_si128(cur, _mm_set1_epi8((char)0xfe)),
+                                    _mm_set1_epi8((char)0xc0)),
+                     UTF8_GE(cur, 0xf5)));
+#undef UTF8_GE
+    /* E0 A0..BF, ED 80..9F, F0 90..BF, F4 80..8F */
+    error = _mm_or_si128(error, _mm_or_si128(
+        _mm_and_si128(_mm_cmpeq_epi8(prev1, _mm_set1_epi8((char)0xe0)),
+                      _mm_cmplt_epi8(cur, _mm_set1_epi8((char)0xa0))),
+        _mm_and_si128(_mm_cmpeq_epi8(prev1, _mm_set1_epi8((char)0xed)),
+                      _mm_cmpgt_epi8(cur, _mm_set1_epi8((char)0x9f)))));
+    error = _mm_or_si128(error, _mm_or_si128(
+        _mm_and_si128(_mm_cmpeq_epi8(prev1, _mm_set1_epi8((char)0xf0)),
+                      _mm_cmplt_epi8(cur, _mm_set1_epi8((char)0x90))),
+        _mm_and_si128(_mm_cmpeq_epi8(prev1, _mm_set1_epi8((char)0xf4)),
+                      _mm_cmpgt_epi8(cur, _mm_set1_epi8((char)0x8f)))));
+    if(_mm_movemask_epi8(error) != 0) {
+        return FALSE;
+    }
+    int32_t numLeads = 16 - _countBits16((uint32_t)_mm_movemask_epi8(isTrail));
+    numCodePoints += numLeads;
+    utf16Length += numLeads + _countBits16((uint32_t)_mm_movemask_epi8(isFourByteLead));
+    return TRUE;
+#else  /* U_SIMD_NEON */
+    uint8x16_t cur = vld1q_u8(p);
+    if(vmaxvq_u8(cur) <= 0x7f) {
+        /* All ASCII: Only check that no sequence from the previous block is incomplete. */
+        if(p[-1] >= 0xc0 || p[-2] >= 0xe0 || p[-3] >= 0xf0) {
+            return FALSE;
+        }
+        numCodePoints += 16;
+        utf16Length += 16;
+        return TRUE;
+    }
+    uint8x16_t prev1 = vld1q_u8(p - 1);
+    uint8x16_t prev2 = vld1q_u8(p - 2);
+    uint8x16_t prev3 = vld1q_u8(p - 3);
+    uint8x16_t isTrail = vceqq_u8(vandq_u8(cur, vdupq_n_u8(0xc0)), vdupq_n_u8(0x80));
+    uint8x16_t needsTrail = vorrq_u8(
+        vorrq_u8(vcgeq_u8(prev1, vdupq_n_u8(0xc0)), vcgeq_u8(prev2, vdupq_n_u8(0xe0))),
+        vcgeq_u8(prev3, vdupq_n_u8(0xf0)));
+    uint8x16_t isFourByteLead = vcgeq_u8(cur, vdupq_n_u8(0xf0));
+    uint8x16_t error = vorrq_u8(
+        veorq_u8(isTrail, needsTrail),
+        /* C0, C1 and F5..FF are never valid */
+        vorrq_u8(vceqq_u8(vandq_u8(cur, vdupq_n_u8(0xfe)), vdupq_n_u8(0xc0)),
+                 vcgeq_u8(cur, vdupq_n_u8(0xf5))));
+    /* E0 A0..BF, ED 80..9F, F0 90..BF, F4 80..8F */
+    error = vorrq_u8(error, vorrq_u8(
+        vandq_u8(vceqq_u8(prev1, vdupq_n_u8(0xe0)), vcltq_u8(cur, vdupq_n_u8(0xa0))),
+        vandq_u8(vceqq_u8(prev1, vdupq_n_u8(0xed)), vcgtq_u8(cur, vdupq_n_u8(0x9f)))));
+    error = vorrq_u8(error, vorrq_u8(
+        vandq_u8(vceqq_u8(prev1, vdupq_n_u8(0xf0)), vcltq_u8(cur, vdupq_n_u8(0x90))),
+        vandq_u8(vceqq_u8(prev1, vdupq_n_u8(0xf4)), vcgtq_u8(cur, vdupq_n_u8(0x8f)))));
+    if(vmaxvq_u8(error) != 0) {
+        return FALSE;
+    }
+    int32_t numLeads = 16 - vaddvq_u8(vandq_u8(isTrail, vdupq_n_u8(1)));
+    numCodePoints += numLeads;
+    utf16Length += numLeads + vaddvq_u8(vandq_u8(isFourByteLead, vdupq_n_u8(1)));
+    return TRUE;
+#endif
+}
+
+/**
+ * Checks whole 16-byte blocks of the UTF-8 string s[start..length[,
+ * and adds their numbers of code points and UTF-16 units.
+ * start must be at a character boundary.
+ * @return the index after the checked blocks, at a character boundary;
+ *         an ill-formed sequence, if any, is at or after this index
+ */
+static int32_t
+_validateUTF8Blocks(const uint8_t *s, int32_t start, int32_t length,
+                    int32_t &numCodePoints, int32_t &utf16Length) {
+    if((length - start) < 16) {
+        return start;
+    }
+    /* The first block must not see bytes before start. */
+    uint8_t firstBlock[3 + 16] = { 0, 0, 0 };
+    uprv_memcpy(firstBlock + 3, s + start, 16);
+    const uint8_t *p = firstBlock + 3;
+    int32_t i = start;
+    while((length - i) >= 16 && _checkUTF8Block(p, numCodePoints, utf16Length)) {
+        i += 16;
+        p = s + i;
+    }
+    if(i > start) {
+        /* Back out a sequence that continues after the checked blocks. */
+        int32_t lead = i - 1;
+        while(U8_IS_TRAIL(s[lead]) && lead > i - 4) {
+            --lead;
+        }
+        uint8_t c = s[lead];
+        int32_t seqLength = U8_COUNT_TRAIL_BYTES(c) + 1;
+        if(c >= 0xc0 && lead + seqLength > i) {
+            --numCodePoints;
+            utf16Length -= seqLength == 4 ? 2 : 1;
+            i = lead;
+        }
+    }
+    return i;
+}
+
+#endif  /* U_SIMD_SSE2 || U_SIMD_NEON */
+
+/**
+ * Checks the UTF-8 string s[start..length[ and adds its numbers of
+ * code points and UTF-16 units, up to the first ill-formed sequence.
+ * start must be at a character boundary.
+ * @return the index of the first ill-formed sequence at or after start,
+ *         or length if there is none
+ */
+static int32_t
+_validateUTF8(const uint8_t *s, int32_t start, int32_t length,
+              int32_t &numCodePoints, int32_t &utf16Length) {
+#if U_SIMD_SSE2 || U_SIMD_NEON
+    int32_t i = _validateUTF8Blocks(s, start, length, numCodePoints, utf16Length);
+#else
+    int32_t i = start;
+#endif
+    while(i < length) {
+        int32_t prev = i;
+        UChar32 c;
+        U8_NEXT(s, i, length, c);
+        if(c < 0) {
+            return prev;
+        }
+        ++numCodePoints;
+        utf16Length += U16_LENGTH(c);
+    }
+    return length;
+}
 
 U_CAPI UChar* U_EXPORT2 
 u_strFromUTF32WithSub(UChar *dest,
@@ -378,6 +645,9 @@ u_strFromUTF8WithSub(UChar *dest,
         /* Faster loop without ongoing checking for srcLength and pDestLimit. */
         int32_t i = 0;
         UChar32 c;
+#if U_SIMD_SSE2 || U_SIMD_NEON
+        int32_t scalarRunLength = MIN_SCALAR_RUN_LENGTH;
+#endif
         for(;;) {
             /*
              * Each iteration of the inner loop progresses by at most 3 UTF-8
@@ -397,6 +667,23 @@ u_strFromUTF8WithSub(UChar *dest,
                  */
                 break;
             }
+#if U_SIMD_SSE2 || U_SIMD_NEON
+            int32_t blockLength = _utf8BlocksToUTF16(
+                (const uint8_t *)src + i, srcLength - i, pDest, pDestLimit);
+            if(blockLength > 0) {
+                i += blockLength;
+                if(blockLength > 16) {
+                    scalarRunLength = MIN_SCALAR_RUN_LENGTH;
+                }
+                continue;  /* recompute count */
+            }
+            if(count > scalarRunLength) {
+                count = scalarRunLength;
+            }
+            if(scalarRunLength < MAX_SCALAR_RUN_LENGTH) {
+                scalarRunLength <<= 1;
+            }
+#endif
 
             do {
                 // modified copy of U8_NEXT()
@@ -487,6 +774,11 @@ u_strFromUTF8WithSub(UChar *dest,
         }
 
         /* Pre-flight the rest of the string. */
+        if(i < srcLength) {
+            /* Count the well-formed part quickly. */
+            int32_t numCodePoints = 0;
+            i = _validateUTF8((const uint8_t *)src, i, srcLength, numCodePoints, reqLength);
+        }
         while(i < srcLength) {
             // modified copy of U8_NEXT()
             c = (uint8_t)src[i++];
@@ -767,6 +1059,54 @@ u_strFromUTF8Lenient(UChar *dest,
     return dest;
 }
 
+U_CAPI int32_t U_EXPORT2
+u_validateUTF8(const char *s, int32_t length,
+               int32_t *pUTF16Length,
+               UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if((s==NULL && length!=0) || length < -1) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if(length < 0) {
+        length = (int32_t)uprv_strlen(s);
+    }
+    int32_t numCodePoints = 0;
+    int32_t utf16Length = 0;
+    int32_t errorIndex = _validateUTF8((const uint8_t *)s, 0, length, numCodePoints, utf16Length);
+    if(pUTF16Length != NULL) {
+        *pUTF16Length = utf16Length;
+    }
+    return errorIndex < length ? errorIndex : -1;
+}
+
+U_CAPI int32_t U_EXPORT2
+u_countUTF8CodePoints(const char *s, int32_t length) {
+    if(s==NULL || length < -1) {
+        return 0;
+    }
+    if(length < 0) {
+        length = (int32_t)uprv_strlen(s);
+    }
+    const uint8_t *s8 = (const uint8_t *)s;
+    int32_t numCodePoints = 0;
+    int32_t utf16Length = 0;
+    int32_t i = 0;
+    for(;;) {
+        i = _validateUTF8(s8, i, length, numCodePoints, utf16Length);
+        if(i == length) {
+            return numCodePoints;
+        }
+        /* Skip one maximal ill-formed subsequence. */
+        UChar32 c;
+        U8_NEXT(s8, i, length, c);
+        (void)c;
+        ++numCodePoints;
+    }
+}
+
 static inline uint8_t *
 _appendUTF8(uint8_t *pDest, UChar32 c) {
     /* it is 0<=c<=0x10ffff and not a surrogate if called by a validating function */
@@ -896,6 +1236,9 @@ u_strToUTF8WithSub(char *dest,
     } else {
         const UChar *pSrcLimit = (pSrc!=NULL)?(pSrc+srcLength):NULL;
         int32_t count;
+#if U_SIMD_SSE2 || U_SIMD_NEON
+        int32_t scalarRunLength = MIN_SCALAR_RUN_LENGTH;
+#endif
 
         /* Faster loop without ongoing checking for pSrcLimit and pDestLimit. */
         for(;;) {
@@ -917,6 +1260,22 @@ u_strToUTF8WithSub(char *dest,
                  */
                 break;
             }
+#if U_SIMD_SSE2 || U_SIMD_NEON
+            int32_t blockLength = _utf16BlocksToUTF8(pSrc, srcLength, pDest, pDestLimit);
+            if(blockLength > 0) {
+                pSrc += blockLength;
+                if(blockLength > 8) {
+                    scalarRunLength = MIN_SCALAR_RUN_LENGTH;
+                }
+                continue;  /* recompute count */
+            }
+            if(count > scalarRunLength) {
+                count = scalarRunLength;
+            }
+            if(scalarRunLength < MAX_SCALAR_RUN_LENGTH) {
+                scalarRunLength <<= 1;
+            }
+#endif
             do {
                 ch=*pSrc++;
                 if(ch <= 0x7f) {
@@ -1658,6 +1658,15 @@ utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status) {
 
 }
 
+U_CFUNC const char *
+uprv_getUTF8TextContents(const UText *ut, int32_t *pLength) {
+    if (ut == NULL || ut->pFuncs != &utf8Funcs || ut->b < 0) {
+        return NULL;
+    }
+    *pLength = ut->b;
+    return (const char *)ut->context;
+}
+
 
 
 
@@ -207,6 +207,12 @@ SharedCalendar::~SharedCalendar() {
     delete ptr;
 }
 
+int32_t SharedCalendar::getMemoryFootprint() const {
+    // Calendar subclasses add at most a few fields to those of Calendar,
+    // and the time zone is usually an OlsonTimeZone on resource bundle data.
+    return (int32_t)(sizeof(*this) + sizeof(GregorianCalendar) + sizeof(OlsonTimeZone));
+}
+
 template<> U_I18N_API
 const SharedCalendar *LocaleCacheKey<SharedCalendar>::createObject(
         const void * /*unusedCreationContext*/, UErrorCode &status) const {
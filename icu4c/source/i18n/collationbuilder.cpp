@@ -284,6 +284,8 @@ CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
         tailoring->data, ownedSettings,
         ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    ownedSettings.fastScriptsMask =
+        CollationFastLatin::getScriptsMask(tailoring->data, ownedSettings);
     tailoring->rules = ruleString;
     tailoring->rules.getTerminatedBuffer();  // ensure NUL-termination
     tailoring->setVersion(base->version, rulesVersion);
@@ -451,6 +451,7 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     settings->fastLatinOptions = CollationFastLatin::getOptions(
         tailoring.data, *settings,
         settings->fastLatinPrimaries, UPRV_LENGTHOF(settings->fastLatinPrimaries));
+    settings->fastScriptsMask = CollationFastLatin::getScriptsMask(tailoring.data, *settings);
 }
 
 UBool U_CALLCONV
@@ -16,6 +16,7 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/ucol.h"
+#include "unicode/uscript.h"
 #include "collationdata.h"
 #include "collationfastlatin.h"
 #include "collationsettings.h"
@@ -31,19 +32,8 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
     U_ASSERT(capacity == LATIN_LIMIT);
     if(capacity != LATIN_LIMIT) { return -1; }
 
-    uint32_t miniVarTop;
-    if((settings.options & CollationSettings::ALTERNATE_MASK) == 0) {
-        // No mini primaries are variable, set a variableTop just below the
-        // lowest long mini primary.
-        miniVarTop = MIN_LONG - 1;
-    } else {
-        int32_t headerLength = *table & 0xff;
-        int32_t i = 1 + settings.getMaxVariable();
-        if(i >= headerLength) {
-            return -1;  // variableTop >= digits, should not occur
-        }
-        miniVarTop = table[i];
-    }
+    int32_t miniVarTop = getMiniVarTop(table, settings);
+    if(miniVarTop < 0) { return -1; }
 
     UBool digitsAreReordered = FALSE;
     if(settings.hasReordering()) {
@@ -89,7 +79,7 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
         uint32_t p = table[c];
         if(p >= MIN_SHORT) {
             p &= SHORT_PRIMARY_MASK;
-        } else if(p > miniVarTop) {
+        } else if(p > (uint32_t)miniVarTop) {
             p &= LONG_PRIMARY_MASK;
         } else {
             p = 0;
@@ -102,13 +92,181 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
     }
 
     // Shift the miniVarTop above other options.
-    return ((int32_t)miniVarTop << 16) | settings.options;
+    return (miniVarTop << 16) | settings.options;
+}
+
+int32_t
+CollationFastLatin::getMiniVarTop(const uint16_t *table, const CollationSettings &settings) {
+    if((settings.options & CollationSettings::ALTERNATE_MASK) == 0) {
+        // No mini primaries are variable, set a variableTop just below the
+        // lowest long mini primary.
+        return MIN_LONG - 1;
+    } else {
+        int32_t headerLength = *table & 0xff;
+        int32_t i = 1 + settings.getMaxVariable();
+        if(i >= headerLength) {
+            return -1;  // variableTop >= digits, should not occur
+        }
+        return table[i];
+    }
+}
+
+int32_t
+CollationFastLatin::getScriptCode(int32_t scriptTable) {
+    return scriptTable == GREEK_TABLE ? USCRIPT_GREEK : USCRIPT_CYRILLIC;
+}
+
+int32_t
+CollationFastLatin::getScriptsMask(const CollationData *data, const CollationSettings &settings) {
+    if(!settings.hasReordering()) { return (1 << NUM_SCRIPT_TABLES) - 1; }
+    // A script table has only the special groups, digits and the script's letters.
+    // Typical tailorings like [reorder Cyrl] keep them in order.
+    // Unlike with the Latin table, we do not support reordered digits.
+    uint32_t prevStart = 0;
+    for(int32_t group = UCOL_REORDER_CODE_FIRST;
+            group < UCOL_REORDER_CODE_FIRST + CollationData::MAX_NUM_SPECIAL_REORDER_CODES;
+            ++group) {
+        uint32_t start = data->getFirstPrimaryForGroup(group);
+        if(start == 0) { continue; }
+        start = settings.reorder(start);
+        if(start < prevStart) { return 0; }
+        prevStart = start;
+    }
+    int32_t mask = 0;
+    for(int32_t i = 0; i < NUM_SCRIPT_TABLES; ++i) {
+        uint32_t scriptStart = data->getFirstPrimaryForGroup(getScriptCode(i));
+        if(scriptStart != 0 && settings.reorder(scriptStart) > prevStart) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+int32_t
+CollationFastLatin::getScriptOptions(const uint16_t *table, int32_t scriptTable,
+                                     const CollationSettings &settings) {
+    if(table == NULL) { return -1; }
+    if(settings.hasReordering() && (settings.fastScriptsMask & (1 << scriptTable)) == 0) {
+        return -1;
+    }
+    int32_t miniVarTop = getMiniVarTop(table, settings);
+    if(miniVarTop < 0) { return -1; }
+    return (miniVarTop << 16) | settings.options;
+}
+
+void
+CollationFastLatin::getScriptPrimaries(const uint16_t *table, uint16_t *primaries,
+                                       int32_t capacity) {
+    U_ASSERT(capacity == LATIN_LIMIT);
+    table += (table[0] & 0xff);  // skip the header
+    for(int32_t c = 0; c < capacity; ++c) {
+        uint32_t p = table[c];
+        if(p >= MIN_SHORT && !(0x30 <= c && c <= 0x39)) {
+            // Digits are looked up each time so that numeric collation bails out.
+            primaries[c] = (uint16_t)(p & SHORT_PRIMARY_MASK);
+        } else {
+            primaries[c] = 0;
+        }
+    }
 }
 
+namespace {
+
+/** Maps characters to fast Latin table slots: Nothing to do. */
+class LatinChars {
+public:
+    inline UChar32 map(UChar32 c) const { return c; }
+    inline UBool isLead(UChar32 b) const {
+        return 0xc2 <= b && b <= CollationFastLatin::LATIN_MAX_UTF8_LEAD;
+    }
+    /** The caller checked that b>0x7f and that the string is well-formed. */
+    inline UBool isLeadUnsafe(UChar32 b) const {
+        return b <= CollationFastLatin::LATIN_MAX_UTF8_LEAD;
+    }
+    inline UChar32 fromTwoBytes(UChar32 lead, uint8_t t) const {
+        return ((lead - 0xc2) << 6) + t;  // 0080..017F
+    }
+};
+
+/**
+ * Maps the characters of a script block to the script table slots,
+ * and other characters up to LATIN_MAX to a slot that bails out.
+ */
+class ScriptChars {
+public:
+    ScriptChars(int32_t scriptTable)
+            : start(CollationFastLatin::getScriptStart(scriptTable)),
+              length(CollationFastLatin::getScriptLimit(scriptTable) - start) {}
+
+    inline UChar32 map(UChar32 c) const {
+        if(c <= 0x7f) {
+            return c;
+        } else if((uint32_t)(c - start) < length) {
+            return c - start + CollationFastLatin::SCRIPT_SLOTS_START;
+        } else if(c <= CollationFastLatin::LATIN_MAX) {
+            return CollationFastLatin::SCRIPT_BAIL_OUT_SLOT;
+        } else {
+            return c;
+        }
+    }
+    inline UBool isLead(UChar32 b) const { return 0xc2 <= b && b <= 0xdf; }
+    inline UBool isLeadUnsafe(UChar32 b) const { return b <= 0xdf; }
+    inline UChar32 fromTwoBytes(UChar32 lead, uint8_t t) const {
+        UChar32 c = ((lead & 0x1f) << 6) | (t & 0x3f);
+        if((uint32_t)(c - start) < length) {
+            return c - start + CollationFastLatin::SCRIPT_SLOTS_START;
+        } else {
+            return CollationFastLatin::SCRIPT_BAIL_OUT_SLOT;
+        }
+    }
+
+private:
+    UChar32 start;
+    uint32_t length;
+};
+
+}  // namespace
+
 int32_t
 CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primaries, int32_t options,
                                  const UChar *left, int32_t leftLength,
                                  const UChar *right, int32_t rightLength) {
+    return doCompareUTF16(LatinChars(), table, primaries, options,
+                          left, leftLength, right, rightLength);
+}
+
+int32_t
+CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries, int32_t options,
+                                const uint8_t *left, int32_t leftLength,
+                                const uint8_t *right, int32_t rightLength) {
+    return doCompareUTF8(LatinChars(), table, primaries, options,
+                         left, leftLength, right, rightLength);
+}
+
+int32_t
+CollationFastLatin::compareScriptUTF16(const uint16_t *table, const uint16_t *primaries,
+                                       int32_t scriptTable, int32_t options,
+                                       const UChar *left, int32_t leftLength,
+                                       const UChar *right, int32_t rightLength) {
+    return doCompareUTF16(ScriptChars(scriptTable), table, primaries, options,
+                          left, leftLength, right, rightLength);
+}
+
+int32_t
+CollationFastLatin::compareScriptUTF8(const uint16_t *table, const uint16_t *primaries,
+                                      int32_t scriptTable, int32_t options,
+                                      const uint8_t *left, int32_t leftLength,
+                                      const uint8_t *right, int32_t rightLength) {
+    return doCompareUTF8(ScriptChars(scriptTable), table, primaries, options,
+                         left, leftLength, right, rightLength);
+}
+
+template<typename Chars>
+int32_t
+CollationFastLatin::doCompareUTF16(const Chars &chars, const uint16_t *table,
+                                   const uint16_t *primaries, int32_t options,
+                                   const UChar *left, int32_t leftLength,
+                                   const UChar *right, int32_t rightLength) {
     // This is a modified copy of CollationCompare::compareUpToQuaternary(),
     // optimized for common Latin text.
     // Keep them in sync!
@@ -134,7 +292,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair = EOS;
                 break;
             }
-            UChar32 c = left[leftIndex++];
+            UChar32 c = chars.map(left[leftIndex++]);
             if(c <= LATIN_MAX) {
                 leftPair = primaries[c];
                 if(leftPair != 0) { break; }
@@ -154,7 +312,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(chars, table, c, leftPair, left, NULL, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -165,7 +323,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair = EOS;
                 break;
             }
-            UChar32 c = right[rightIndex++];
+            UChar32 c = chars.map(right[rightIndex++]);
             if(c <= LATIN_MAX) {
                 rightPair = primaries[c];
                 if(rightPair != 0) { break; }
@@ -185,7 +343,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(chars, table, c, rightPair,
+                                     right, NULL, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -221,7 +380,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     leftPair = EOS;
                     break;
                 }
-                UChar32 c = left[leftIndex++];
+                UChar32 c = chars.map(left[leftIndex++]);
                 if(c <= LATIN_MAX) {
                     leftPair = table[c];
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
@@ -236,7 +395,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(chars, table, c, leftPair,
+                                        left, NULL, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -246,7 +406,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     rightPair = EOS;
                     break;
                 }
-                UChar32 c = right[rightIndex++];
+                UChar32 c = chars.map(right[rightIndex++]);
                 if(c <= LATIN_MAX) {
                     rightPair = table[c];
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
@@ -261,7 +421,8 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(chars, table, c, rightPair,
+                                         right, NULL, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -297,10 +458,11 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     leftPair = EOS;
                     break;
                 }
-                UChar32 c = left[leftIndex++];
+                UChar32 c = chars.map(left[leftIndex++]);
                 leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(chars, table, c, leftPair,
+                                        left, NULL, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -310,10 +472,11 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     rightPair = EOS;
                     break;
                 }
-                UChar32 c = right[rightIndex++];
+                UChar32 c = chars.map(right[rightIndex++]);
                 rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(chars, table, c, rightPair,
+                                         right, NULL, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -350,10 +513,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair = EOS;
                 break;
             }
-            UChar32 c = left[leftIndex++];
+            UChar32 c = chars.map(left[leftIndex++]);
             leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(chars, table, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -363,10 +526,11 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair = EOS;
                 break;
             }
-            UChar32 c = right[rightIndex++];
+            UChar32 c = chars.map(right[rightIndex++]);
             rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(chars, table, c, rightPair,
+                                     right, NULL, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -406,10 +570,10 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair = EOS;
                 break;
             }
-            UChar32 c = left[leftIndex++];
+            UChar32 c = chars.map(left[leftIndex++]);
             leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(chars, table, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -419,10 +583,11 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair = EOS;
                 break;
             }
-            UChar32 c = right[rightIndex++];
+            UChar32 c = chars.map(right[rightIndex++]);
             rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(chars, table, c, rightPair,
+                                     right, NULL, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -444,10 +609,12 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
     return UCOL_EQUAL;
 }
 
+template<typename Chars>
 int32_t
-CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries, int32_t options,
-                                 const uint8_t *left, int32_t leftLength,
-                                 const uint8_t *right, int32_t rightLength) {
+CollationFastLatin::doCompareUTF8(const Chars &chars, const uint16_t *table,
+                                  const uint16_t *primaries, int32_t options,
+                                  const uint8_t *left, int32_t leftLength,
+                                  const uint8_t *right, int32_t rightLength) {
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
     U_ASSERT((table[0] >> 8) == VERSION);
@@ -482,10 +649,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     return BAIL_OUT_RESULT;
                 }
                 leftPair = table[c];
-            } else if(c <= LATIN_MAX_UTF8_LEAD && 0xc2 <= c && leftIndex != leftLength &&
+            } else if(chars.isLead(c) && leftIndex != leftLength &&
                     0x80 <= (t = left[leftIndex]) && t <= 0xbf) {
                 ++leftIndex;
-                c = ((c - 0xc2) << 6) + t;
+                c = chars.fromTwoBytes(c, t);
                 leftPair = primaries[c];
                 if(leftPair != 0) { break; }
                 leftPair = table[c];
@@ -499,7 +666,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(chars, table, c, leftPair, NULL, left, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -519,10 +686,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     return BAIL_OUT_RESULT;
                 }
                 rightPair = table[c];
-            } else if(c <= LATIN_MAX_UTF8_LEAD && 0xc2 <= c && rightIndex != rightLength &&
+            } else if(chars.isLead(c) && rightIndex != rightLength &&
                     0x80 <= (t = right[rightIndex]) && t <= 0xbf) {
                 ++rightIndex;
-                c = ((c - 0xc2) << 6) + t;
+                c = chars.fromTwoBytes(c, t);
                 rightPair = primaries[c];
                 if(rightPair != 0) { break; }
                 rightPair = table[c];
@@ -536,7 +703,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(chars, table, c, rightPair,
+                                     NULL, right, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -575,10 +743,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 UChar32 c = left[leftIndex++];
                 if(c <= 0x7f) {
                     leftPair = table[c];
-                } else if(c <= LATIN_MAX_UTF8_LEAD) {
-                    leftPair = table[((c - 0xc2) << 6) + left[leftIndex++]];
+                } else if(chars.isLeadUnsafe(c)) {
+                    leftPair = table[chars.fromTwoBytes(c, left[leftIndex++])];
                 } else {
-                    leftPair = lookupUTF8Unsafe(table, c, left, leftIndex);
+                    leftPair = lookupUTF8Unsafe(chars, table, c, left, leftIndex);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -587,7 +755,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(chars, table, c, leftPair,
+                                        NULL, left, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -600,10 +769,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 UChar32 c = right[rightIndex++];
                 if(c <= 0x7f) {
                     rightPair = table[c];
-                } else if(c <= LATIN_MAX_UTF8_LEAD) {
-                    rightPair = table[((c - 0xc2) << 6) + right[rightIndex++]];
+                } else if(chars.isLeadUnsafe(c)) {
+                    rightPair = table[chars.fromTwoBytes(c, right[rightIndex++])];
                 } else {
-                    rightPair = lookupUTF8Unsafe(table, c, right, rightIndex);
+                    rightPair = lookupUTF8Unsafe(chars, table, c, right, rightIndex);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -612,7 +781,8 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(chars, table, c, rightPair,
+                                         NULL, right, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -649,9 +819,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+                leftPair = (c <= 0x7f) ? table[c] :
+                        lookupUTF8Unsafe(chars, table, c, left, leftIndex);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(chars, table, c, leftPair,
+                                        NULL, left, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -662,9 +834,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+                rightPair = (c <= 0x7f) ? table[c] :
+                        lookupUTF8Unsafe(chars, table, c, right, rightIndex);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(chars, table, c, rightPair,
+                                         NULL, right, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -702,9 +876,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(chars, table, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(chars, table, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -715,9 +889,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] :
+                    lookupUTF8Unsafe(chars, table, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(chars, table, c, rightPair,
+                                     NULL, right, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -758,9 +934,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(chars, table, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(chars, table, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -771,9 +947,11 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] :
+                    lookupUTF8Unsafe(chars, table, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(chars, table, c, rightPair,
+                                     NULL, right, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -832,14 +1010,15 @@ CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
     return BAIL_OUT;
 }
 
+template<typename Chars>
 uint32_t
-CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+CollationFastLatin::lookupUTF8Unsafe(const Chars &chars, const uint16_t *table, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex) {
     // The caller handled ASCII.
     // The string is well-formed and contains only supported characters.
     U_ASSERT(c > 0x7f);
-    if(c <= LATIN_MAX_UTF8_LEAD) {
-        return table[((c - 0xc2) << 6) + s8[sIndex++]];  // 0080..017F
+    if(chars.isLeadUnsafe(c)) {
+        return table[chars.fromTwoBytes(c, s8[sIndex++])];  // 0080..017F
     }
     uint8_t t2 = s8[sIndex + 1];
     sIndex += 2;
@@ -852,8 +1031,9 @@ CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
     }
 }
 
+template<typename Chars>
 uint32_t
-CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+CollationFastLatin::nextPair(const Chars &chars, const uint16_t *table, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength) {
     if(ce >= MIN_LONG || ce < CONTRACTION) {
         return ce;  // simple or special mini CE
@@ -873,7 +1053,7 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
             int32_t c2;
             int32_t nextIndex = sIndex;
             if(s16 != NULL) {
-                c2 = s16[nextIndex++];
+                c2 = chars.map(s16[nextIndex++]);
                 if(c2 > LATIN_MAX) {
                     if(PUNCT_START <= c2 && c2 < PUNCT_LIMIT) {
                         c2 = c2 - PUNCT_START + LATIN_LIMIT;  // 2000..203F -> 0180..01BF
@@ -887,9 +1067,9 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                 c2 = s8[nextIndex++];
                 if(c2 > 0x7f) {
                     uint8_t t;
-                    if(c2 <= 0xc5 && 0xc2 <= c2 && nextIndex != sLength &&
+                    if(chars.isLead(c2) && nextIndex != sLength &&
                             0x80 <= (t = s8[nextIndex]) && t <= 0xbf) {
-                        c2 = ((c2 - 0xc2) << 6) + t;  // 0080..017F
+                        c2 = chars.fromTwoBytes(c2, t);  // 0080..017F
                         ++nextIndex;
                     } else {
                         int32_t i2 = nextIndex + 1;
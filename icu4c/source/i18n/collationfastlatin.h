@@ -188,6 +188,30 @@ public:
      */
     static const int32_t BAIL_OUT_RESULT = -2;
 
+    /**
+     * Fast tables for some other scripts, built at runtime.
+     * They have the same format as the fast Latin table,
+     * except that the table slots for U+0080..U+017F hold the mini CEs
+     * for one block of the script. ASCII and the punctuation block are the same.
+     * Letters of other scripts, including Latin letters, bail out.
+     */
+    enum {
+        GREEK_TABLE,
+        CYRILLIC_TABLE,
+        NUM_SCRIPT_TABLES
+    };
+    static const UChar GREEK_START = 0x370;
+    static const UChar GREEK_LIMIT = 0x400;
+    static const UChar CYRILLIC_START = 0x400;
+    static const UChar CYRILLIC_LIMIT = 0x460;
+    /** Start of the table slots used for script characters. */
+    static const int32_t SCRIPT_SLOTS_START = 0x80;
+    /**
+     * Table slot for other characters up to LATIN_MAX when using a script table.
+     * No script block is long enough to reach it, so it always bails out.
+     */
+    static const int32_t SCRIPT_BAIL_OUT_SLOT = LATIN_MAX;
+
     static inline int32_t getCharIndex(UChar c) {
         if(c <= LATIN_MAX) {
             return c;
@@ -218,16 +242,93 @@ public:
                                const uint8_t *left, int32_t leftLength,
                                const uint8_t *right, int32_t rightLength);
 
+    static inline UChar getScriptStart(int32_t scriptTable) {
+        return scriptTable == GREEK_TABLE ? GREEK_START : CYRILLIC_START;
+    }
+    static inline UChar getScriptLimit(int32_t scriptTable) {
+        return scriptTable == GREEK_TABLE ? GREEK_LIMIT : CYRILLIC_LIMIT;
+    }
+
+    /**
+     * Returns the script table whose block contains c, or -1 if none.
+     */
+    static inline int32_t getScriptTable(UChar32 c) {
+        if(GREEK_START <= c && c < CYRILLIC_LIMIT) {
+            return c < GREEK_LIMIT ? GREEK_TABLE : CYRILLIC_TABLE;
+        } else {
+            return -1;
+        }
+    }
+
+    /** Returns the script code for the letters in the script table. */
+    static int32_t getScriptCode(int32_t scriptTable);
+
+    /**
+     * Returns a bit set of the script tables which can be used with the settings' reordering.
+     * The result is stored in CollationSettings::fastScriptsMask.
+     */
+    static int32_t getScriptsMask(const CollationData *data, const CollationSettings &settings);
+
+    /**
+     * Computes the options value for compareScriptUTF16() and compareScriptUTF8().
+     * Returns -1 if the table is NULL or if the settings are not supported.
+     */
+    static int32_t getScriptOptions(const uint16_t *table, int32_t scriptTable,
+                                    const CollationSettings &settings);
+
+    /**
+     * Writes the short primaries of the script table's characters.
+     * They do not depend on the settings.
+     * All other primaries are 0, including those of digits,
+     * and the compare functions then look them up in the table.
+     * The capacity must be LATIN_LIMIT.
+     */
+    static void getScriptPrimaries(const uint16_t *table, uint16_t *primaries, int32_t capacity);
+
+    /**
+     * Compares with a script table and its getScriptPrimaries().
+     * The compare functions map the characters of the script block to the table slots.
+     */
+    static int32_t compareScriptUTF16(const uint16_t *table, const uint16_t *primaries,
+                                      int32_t scriptTable, int32_t options,
+                                      const UChar *left, int32_t leftLength,
+                                      const UChar *right, int32_t rightLength);
+
+    static int32_t compareScriptUTF8(const uint16_t *table, const uint16_t *primaries,
+                                     int32_t scriptTable, int32_t options,
+                                     const uint8_t *left, int32_t leftLength,
+                                     const uint8_t *right, int32_t rightLength);
+
 private:
+    /** Returns the mini variableTop for the settings, or -1 if not supported. */
+    static int32_t getMiniVarTop(const uint16_t *table, const CollationSettings &settings);
+
     static uint32_t lookup(const uint16_t *table, UChar32 c);
     static uint32_t lookupUTF8(const uint16_t *table, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength);
-    static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+    template<typename Chars>
+    static uint32_t lookupUTF8Unsafe(const Chars &chars, const uint16_t *table, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex);
 
-    static uint32_t nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+    template<typename Chars>
+    static uint32_t nextPair(const Chars &chars, const uint16_t *table, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength);
 
+    /**
+     * Shared implementations of the compare functions.
+     * Chars maps characters to table slots, for the Latin table or for a script table.
+     */
+    template<typename Chars>
+    static int32_t doCompareUTF16(const Chars &chars, const uint16_t *table,
+                                  const uint16_t *primaries, int32_t options,
+                                  const UChar *left, int32_t leftLength,
+                                  const UChar *right, int32_t rightLength);
+    template<typename Chars>
+    static int32_t doCompareUTF8(const Chars &chars, const uint16_t *table,
+                                 const uint16_t *primaries, int32_t options,
+                                 const uint8_t *left, int32_t leftLength,
+                                 const uint8_t *right, int32_t rightLength);
+
     static inline uint32_t getPrimaries(uint32_t variableTop, uint32_t pair) {
         uint32_t ce = pair & 0xffff;
         if(ce >= MIN_SHORT) { return pair & TWO_SHORT_PRIMARIES_MASK; }
@@ -287,6 +388,10 @@ private:
  *   then the BAIL_OUT value is stored.
  *   For details see the comments for the class constants.
  *
+ *   In a script table, the U+0080..U+017F slots instead hold the mini CEs for
+ *   that script's block starting at getScriptStart(), see GREEK_TABLE.
+ *   Script tables are only built at runtime and are never stored in data files.
+ *
  * uint16_t expansions[variable length];
  *   Expansion mini CEs contain an offset relative to just after the miniCEs table.
  *   An expansions contains exactly 2 mini CEs.
@@ -91,6 +91,8 @@ CollationFastLatinBuilder::CollationFastLatinBuilder(UErrorCode &errorCode)
           contractionCEs(errorCode), uniqueCEs(errorCode),
           miniCEs(NULL),
           firstDigitPrimary(0), firstLatinPrimary(0), lastLatinPrimary(0),
+          letterScript(USCRIPT_LATIN), firstLetterPrimary(0), lastLetterPrimary(0),
+          scriptStart(0), scriptLimit(0),
           firstShortPrimary(0), shortPrimaryOverflow(FALSE),
           headerLength(0) {
 }
@@ -106,6 +108,26 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
         errorCode = U_INVALID_STATE_ERROR;
         return FALSE;
     }
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::forScript(const CollationData &data, int32_t scriptTable,
+                                     UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(!result.isEmpty() ||  // This builder is not reusable.
+            scriptTable < 0 || scriptTable >= CollationFastLatin::NUM_SCRIPT_TABLES) {
+        errorCode = U_INVALID_STATE_ERROR;
+        return FALSE;
+    }
+    letterScript = CollationFastLatin::getScriptCode(scriptTable);
+    scriptStart = CollationFastLatin::getScriptStart(scriptTable);
+    scriptLimit = CollationFastLatin::getScriptLimit(scriptTable);
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::build(const CollationData &data, UErrorCode &errorCode) {
     if(!loadGroups(data, errorCode)) { return FALSE; }
 
     // Fast handling of digits.
@@ -115,7 +137,7 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
     if(shortPrimaryOverflow) {
         // Give digits long mini primaries,
         // so that there are more short primaries for letters.
-        firstShortPrimary = firstLatinPrimary;
+        firstShortPrimary = firstLetterPrimary;
         resetCEs();
         getCEs(data, errorCode);
         if(!encodeUniqueCEs(errorCode)) { return FALSE; }
@@ -155,13 +177,30 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
     firstDigitPrimary = data.getFirstPrimaryForGroup(UCOL_REORDER_CODE_DIGIT);
     firstLatinPrimary = data.getFirstPrimaryForGroup(USCRIPT_LATIN);
     lastLatinPrimary = data.getLastPrimaryForGroup(USCRIPT_LATIN);
-    if(firstDigitPrimary == 0 || firstLatinPrimary == 0) {
+    firstLetterPrimary = data.getFirstPrimaryForGroup(letterScript);
+    lastLetterPrimary = data.getLastPrimaryForGroup(letterScript);
+    if(firstDigitPrimary == 0 || firstLatinPrimary == 0 || firstLetterPrimary == 0) {
         // missing data
         return FALSE;
     }
     return TRUE;
 }
 
+int32_t
+CollationFastLatinBuilder::getCharIndex(UChar c) const {
+    if(scriptStart == 0) {
+        return CollationFastLatin::getCharIndex(c);
+    } else if(c < CollationFastLatin::SCRIPT_SLOTS_START) {
+        return c;
+    } else if(scriptStart <= c && c < scriptLimit) {
+        return c - scriptStart + CollationFastLatin::SCRIPT_SLOTS_START;
+    } else if(CollationFastLatin::PUNCT_START <= c && c < CollationFastLatin::PUNCT_LIMIT) {
+        return CollationFastLatin::getCharIndex(c);
+    } else {
+        return -1;
+    }
+}
+
 UBool
 CollationFastLatinBuilder::inSameGroup(uint32_t p, uint32_t q) const {
     // Both or neither need to be encoded as short primaries,
@@ -211,15 +250,26 @@ CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCo
         } else if(c == CollationFastLatin::PUNCT_LIMIT) {
             break;
         }
+        UChar sc = c;  // the character for this slot
+        if(scriptStart != 0 && c >= CollationFastLatin::SCRIPT_SLOTS_START &&
+                c < CollationFastLatin::LATIN_LIMIT) {
+            sc = (UChar)(scriptStart + (c - CollationFastLatin::SCRIPT_SLOTS_START));
+            if(sc >= scriptLimit) {
+                // unused slot
+                charCEs[i][0] = Collation::NO_CE;
+                charCEs[i][1] = 0;
+                continue;
+            }
+        }
         const CollationData *d;
-        uint32_t ce32 = data.getCE32(c);
+        uint32_t ce32 = data.getCE32(sc);
         if(ce32 == Collation::FALLBACK_CE32) {
             d = data.base;
-            ce32 = d->getCE32(c);
+            ce32 = d->getCE32(sc);
         } else {
             d = &data;
         }
-        if(getCEsFromCE32(*d, c, ce32, errorCode)) {
+        if(getCEsFromCE32(*d, sc, ce32, errorCode)) {
             charCEs[i][0] = ce0;
             charCEs[i][1] = ce1;
             addUniqueCE(ce0, errorCode);
@@ -303,8 +353,9 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
     // We do not support an ignorable ce0 unless it is completely ignorable.
     uint32_t p0 = (uint32_t)(ce0 >> 32);
     if(p0 == 0) { return FALSE; }
-    // We only support primaries up to the Latin script.
-    if(p0 > lastLatinPrimary) { return FALSE; }
+    // We only support primaries up to the Latin script,
+    // or the special groups, digits and the letters of a script table.
+    if(!isSupportedPrimary(p0)) { return FALSE; }
     // We support non-common secondary and case weights only together with short primaries.
     uint32_t lower32_0 = (uint32_t)ce0;
     if(p0 < firstShortPrimary) {
@@ -321,6 +372,7 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
         // and determine for both whether they are variable.
         uint32_t p1 = (uint32_t)(ce1 >> 32);
         if(p1 == 0 ? p0 < firstShortPrimary : !inSameGroup(p0, p1)) { return FALSE; }
+        if(scriptStart != 0 && p1 != 0 && !isSupportedPrimary(p1)) { return FALSE; }
         uint32_t lower32_1 = (uint32_t)ce1;
         // No tertiary CEs.
         if((lower32_1 >> 16) == 0) { return FALSE; }
@@ -361,7 +413,7 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
     UCharsTrie::Iterator suffixes(p + 2, 0, errorCode);
     while(suffixes.next(errorCode)) {
         const UnicodeString &suffix = suffixes.getString();
-        int32_t x = CollationFastLatin::getCharIndex(suffix.charAt(0));
+        int32_t x = getCharIndex(suffix.charAt(0));
         if(x < 0) { continue; }  // ignore anything but fast Latin text
         if(x == prevX) {
             if(addContraction) {
@@ -36,6 +36,13 @@ public:
 
     UBool forData(const CollationData &data, UErrorCode &errorCode);
 
+    /**
+     * Builds a fast table for one of the CollationFastLatin script tables.
+     * Its U+0080..U+017F slots are used for that script's block,
+     * and the mini primaries are used for its letters rather than for Latin ones.
+     */
+    UBool forScript(const CollationData &data, int32_t scriptTable, UErrorCode &errorCode);
+
     const uint16_t *getTable() const {
         return reinterpret_cast<const uint16_t *>(result.getBuffer());
     }
@@ -45,8 +52,13 @@ private:
     // space, punct, symbol, currency (not digit)
     enum { NUM_SPECIAL_GROUPS = UCOL_REORDER_CODE_CURRENCY - UCOL_REORDER_CODE_FIRST + 1 };
 
+    UBool build(const CollationData &data, UErrorCode &errorCode);
     UBool loadGroups(const CollationData &data, UErrorCode &errorCode);
     UBool inSameGroup(uint32_t p, uint32_t q) const;
+    UBool isSupportedPrimary(uint32_t p) const {
+        return p <= lastLetterPrimary && (p < firstLatinPrimary || firstLetterPrimary <= p);
+    }
+    int32_t getCharIndex(UChar c) const;
 
     void resetCEs();
     void getCEs(const CollationData &data, UErrorCode &errorCode);
@@ -84,6 +96,14 @@ private:
     uint32_t firstDigitPrimary;
     uint32_t firstLatinPrimary;
     uint32_t lastLatinPrimary;
+    // The letters with mini CEs: Latin, or the script of a script table.
+    // A script table bails out for Latin letters.
+    int32_t letterScript;
+    uint32_t firstLetterPrimary;
+    uint32_t lastLetterPrimary;
+    // The block of a script table in the U+0080..U+017F slots, or 0 for the Latin table.
+    UChar scriptStart;
+    UChar scriptLimit;
     // This determines the first normal primary weight which is mapped to
     // a short mini primary. It must be >=firstDigitPrimary.
     uint32_t firstShortPrimary;
@@ -110,7 +110,7 @@ struct U_I18N_API CollationSettings : public SharedObject {
               minHighNoReorder(0),
               reorderRanges(NULL), reorderRangesLength(0),
               reorderCodes(NULL), reorderCodesLength(0), reorderCodesCapacity(0),
-              fastLatinOptions(-1) {}
+              fastLatinOptions(-1), fastScriptsMask(0) {}
 
     CollationSettings(const CollationSettings &other);
     virtual ~CollationSettings();
@@ -260,6 +260,8 @@ struct U_I18N_API CollationSettings : public SharedObject {
     /** Options for CollationFastLatin. Negative if disabled. */
     int32_t fastLatinOptions;
     uint16_t fastLatinPrimaries[0x180];
+    /** Bit set of the CollationFastLatin script tables usable with these settings. */
+    int32_t fastScriptsMask;
 
 private:
     void setReorderArrays(const int32_t *codes, int32_t codesLength,
@@ -22,6 +22,7 @@
 #include "unicode/uvernum.h"
 #include "cmemory.h"
 #include "collationdata.h"
+#include "collationroot.h"
 #include "collationsettings.h"
 #include "collationtailoring.h"
 #include "normalizer2impl.h"
@@ -52,6 +53,7 @@ CollationTailoring::CollationTailoring(const CollationSettings *baseSettings)
     rules.getTerminatedBuffer();  // ensure NUL-termination
     version[0] = version[1] = version[2] = version[3] = 0;
     maxExpansionsInitOnce.reset();
+    fastScriptTablesInitOnce.reset();
 }
 
 CollationTailoring::~CollationTailoring() {
@@ -64,6 +66,7 @@ CollationTailoring::~CollationTailoring() {
     delete unsafeBackwardSet;
     uhash_close(maxExpansions);
     maxExpansionsInitOnce.reset();
+    fastScriptTablesInitOnce.reset();
 }
 
 UBool
@@ -108,6 +111,25 @@ CollationCacheEntry::~CollationCacheEntry() {
     SharedObject::clearPtr(tailoring);
 }
 
+int32_t CollationCacheEntry::getMemoryFootprint() const {
+    int32_t footprint = (int32_t)sizeof(*this);
+    // Locales without a tailoring share the root collator, which is not cached.
+    UErrorCode errorCode = U_ZERO_ERROR;
+    if (tailoring == NULL || tailoring == CollationRoot::getRoot(errorCode)) {
+        return footprint;
+    }
+    // The data trie and arrays are in the memory-mapped resource bundle
+    // unless the tailoring was built from rules.
+    footprint += (int32_t)sizeof(CollationTailoring) + tailoring->rules.length() * U_SIZEOF_UCHAR;
+    if (tailoring->ownedData != NULL) {
+        footprint += (int32_t)sizeof(CollationData);
+    }
+    if (tailoring->unsafeBackwardSet != NULL) {
+        footprint += (int32_t)sizeof(UnicodeSet);
+    }
+    return footprint;
+}
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
@@ -21,6 +21,7 @@
 #include "unicode/locid.h"
 #include "unicode/unistr.h"
 #include "unicode/uversion.h"
+#include "collationfastlatin.h"
 #include "collationsettings.h"
 #include "uhash.h"
 #include "umutex.h"
@@ -83,6 +84,11 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     UnicodeSet *unsafeBackwardSet;
     mutable UHashtable *maxExpansions;
     mutable UInitOnce maxExpansionsInitOnce;
+    // CollationFastLatin script tables and their primaries, built on first use.
+    // An empty string means that the table could not be built.
+    mutable UnicodeString fastScriptTables[CollationFastLatin::NUM_SCRIPT_TABLES];
+    mutable uint16_t fastScriptPrimaries[CollationFastLatin::NUM_SCRIPT_TABLES][0x180];
+    mutable UInitOnce fastScriptTablesInitOnce;
 
 private:
     /**
@@ -100,6 +106,7 @@ struct CollationCacheEntry : public SharedObject {
         }
     }
     ~CollationCacheEntry();
+    virtual int32_t getMemoryFootprint() const;
 
     Locale validLocale;
     const CollationTailoring *tailoring;
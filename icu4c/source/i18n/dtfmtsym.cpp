@@ -169,6 +169,52 @@ U_NAMESPACE_BEGIN
 SharedDateFormatSymbols::~SharedDateFormatSymbols() {
 }
 
+// Counts the contents of each string as if it were on the heap.
+static int32_t getStringsFootprint(const UnicodeString *strings, int32_t count) {
+    int32_t footprint = count * (int32_t)sizeof(UnicodeString);
+    for (int32_t i = 0; i < count; ++i) {
+        footprint += strings[i].length() * U_SIZEOF_UCHAR;
+    }
+    return footprint;
+}
+
+int32_t SharedDateFormatSymbols::getMemoryFootprint() const {
+    int32_t footprint = (int32_t)sizeof(*this);
+    int32_t count;
+    const UnicodeString *strings = dfs.getEras(count);
+    footprint += getStringsFootprint(strings, count);
+    strings = dfs.getEraNames(count);
+    footprint += getStringsFootprint(strings, count);
+    strings = dfs.getNarrowEras(count);
+    footprint += getStringsFootprint(strings, count);
+    strings = dfs.getAmPmStrings(count);
+    footprint += getStringsFootprint(strings, count);
+    strings = dfs.getLeapMonthPatterns(count);
+    footprint += getStringsFootprint(strings, count);
+    strings = dfs.getYearNames(count, DateFormatSymbols::FORMAT, DateFormatSymbols::ABBREVIATED);
+    footprint += getStringsFootprint(strings, count);
+    strings = dfs.getZodiacNames(count, DateFormatSymbols::FORMAT, DateFormatSymbols::ABBREVIATED);
+    footprint += getStringsFootprint(strings, count);
+    for (int32_t context = 0; context < DateFormatSymbols::DT_CONTEXT_COUNT; ++context) {
+        DateFormatSymbols::DtContextType c = (DateFormatSymbols::DtContextType) context;
+        // There are no SHORT months or quarters; those return the ABBREVIATED ones.
+        for (int32_t width = 0; width < DateFormatSymbols::DT_WIDTH_COUNT; ++width) {
+            DateFormatSymbols::DtWidthType w = (DateFormatSymbols::DtWidthType) width;
+            strings = dfs.getWeekdays(count, c, w);
+            footprint += getStringsFootprint(strings, count);
+            if (w != DateFormatSymbols::SHORT) {
+                strings = dfs.getMonths(count, c, w);
+                footprint += getStringsFootprint(strings, count);
+            }
+            if (w == DateFormatSymbols::ABBREVIATED || w == DateFormatSymbols::WIDE) {
+                strings = dfs.getQuarters(count, c, w);
+                footprint += getStringsFootprint(strings, count);
+            }
+        }
+    }
+    return footprint;
+}
+
 template<> U_I18N_API
 const SharedDateFormatSymbols *
         LocaleCacheKey<SharedDateFormatSymbols>::createObject(
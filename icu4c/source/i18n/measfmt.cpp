@@ -35,6 +35,8 @@
 #include "charstr.h"
 #include "unicode/putil.h"
 #include "unicode/smpdtfmt.h"
+#include "unicode/dtfmtsym.h"
+#include "unicode/gregocal.h"
 #include "uassert.h"
 
 #include "sharednumberformat.h"
@@ -117,6 +119,7 @@ public:
 
     MeasureFormatCacheData();
     virtual ~MeasureFormatCacheData();
+    virtual int32_t getMemoryFootprint() const;
 
     UBool hasPerFormatter(int32_t width) const {
         // TODO: Create a more obvious way to test if the per-formatter has been set?
@@ -184,6 +187,35 @@ MeasureFormatCacheData::~MeasureFormatCacheData() {
     delete numericDateFormatters;
 }
 
+int32_t MeasureFormatCacheData::getMemoryFootprint() const {
+    int32_t footprint = (int32_t)sizeof(*this);
+    for (int32_t i = 0; i < MEAS_UNIT_COUNT; ++i) {
+        for (int32_t j = 0; j < WIDTH_INDEX_COUNT; ++j) {
+            for (int32_t k = 0; k < PATTERN_COUNT; ++k) {
+                if (patterns[i][j][k] != nullptr) {
+                    footprint += (int32_t)sizeof(SimpleFormatter);
+                }
+            }
+        }
+    }
+    for (int32_t i = 0; i < UPRV_LENGTHOF(currencyFormats); ++i) {
+        footprint += SharedNumberFormat::getNumberFormatFootprint(currencyFormats[i]);
+    }
+    footprint += SharedNumberFormat::getNumberFormatFootprint(integerFormat);
+    if (numericDateFormatters != nullptr) {
+        // Each SimpleDateFormat owns its symbols, calendar and number format.
+        footprint += (int32_t)sizeof(NumericDateFormatters) +
+            3 * (int32_t)(sizeof(DateFormatSymbols) + sizeof(GregorianCalendar)) +
+            SharedNumberFormat::getNumberFormatFootprint(
+                numericDateFormatters->hourMinute.getNumberFormat()) +
+            SharedNumberFormat::getNumberFormatFootprint(
+                numericDateFormatters->minuteSecond.getNumberFormat()) +
+            SharedNumberFormat::getNumberFormatFootprint(
+                numericDateFormatters->hourMinuteSecond.getNumberFormat());
+    }
+    return footprint;
+}
+
 static UBool isCurrency(const MeasureUnit &unit) {
     return (uprv_strcmp(unit.getType(), "currency") == 0);
 }
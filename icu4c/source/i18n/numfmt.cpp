@@ -55,6 +55,7 @@
 #include "sharednumberformat.h"
 #include "unifiedcache.h"
 #include "number_decimalquantity.h"
+#include "number_mapper.h"
 #include "number_utils.h"
 
 //#define FMT_DEBUG
@@ -252,6 +253,25 @@ SharedNumberFormat::~SharedNumberFormat() {
     delete ptr;
 }
 
+int32_t SharedNumberFormat::getMemoryFootprint() const {
+    return (int32_t)sizeof(*this) + getNumberFormatFootprint(ptr);
+}
+
+int32_t SharedNumberFormat::getNumberFormatFootprint(const NumberFormat *nf) {
+    if (nf == NULL) {
+        return 0;
+    }
+    if (dynamic_cast<const DecimalFormat *>(nf) == NULL) {
+        return (int32_t)sizeof(RuleBasedNumberFormat);
+    }
+    // The fields own the properties, exported properties, symbols and formatter.
+    return (int32_t)(sizeof(DecimalFormat) +
+                     sizeof(number::impl::DecimalFormatFields) +
+                     2 * sizeof(number::impl::DecimalFormatProperties) +
+                     sizeof(DecimalFormatSymbols) +
+                     sizeof(number::LocalizedNumberFormatter));
+}
+
 // -------------------------------------
 // copy constructor
 
@@ -84,6 +84,18 @@ SharedPluralRules::~SharedPluralRules() {
     delete ptr;
 }
 
+int32_t SharedPluralRules::getMemoryFootprint() const {
+    // One rule chain with at least one constraint per keyword.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<StringEnumeration> keywords(ptr->getKeywords(status));
+    int32_t count = U_SUCCESS(status) ? keywords->count(status) : 0;
+    if (U_FAILURE(status)) {
+        count = 0;
+    }
+    return (int32_t)(sizeof(*this) + sizeof(PluralRules) +
+                     count * (sizeof(RuleChain) + sizeof(OrConstraint) + sizeof(AndConstraint)));
+}
+
 PluralRules*
 PluralRules::clone() const {
     return new PluralRules(*this);
@@ -66,6 +66,7 @@ public:
         }
     }
     virtual ~RelativeDateTimeCacheData();
+    virtual int32_t getMemoryFootprint() const;
 
     // no numbers: e.g Next Tuesday; Yesterday; etc.
     UnicodeString absoluteUnits[UDAT_STYLE_COUNT][UDAT_ABSOLUTE_UNIT_COUNT][UDAT_DIRECTION_COUNT];
@@ -117,6 +118,27 @@ RelativeDateTimeCacheData::~RelativeDateTimeCacheData() {
     delete combinedDateAndTime;
 }
 
+int32_t RelativeDateTimeCacheData::getMemoryFootprint() const {
+    // The absolute unit strings are usually aliases of resource bundle strings.
+    int32_t footprint = (int32_t)sizeof(*this);
+    for (int32_t style = 0; style < UDAT_STYLE_COUNT; ++style) {
+        for (int32_t relUnit = 0; relUnit < UDAT_RELATIVE_UNIT_COUNT; ++relUnit) {
+            for (int32_t pl = 0; pl < StandardPlural::COUNT; ++pl) {
+                if (relativeUnitsFormatters[style][relUnit][0][pl] != NULL) {
+                    footprint += (int32_t)sizeof(SimpleFormatter);
+                }
+                if (relativeUnitsFormatters[style][relUnit][1][pl] != NULL) {
+                    footprint += (int32_t)sizeof(SimpleFormatter);
+                }
+            }
+        }
+    }
+    if (combinedDateAndTime != NULL) {
+        footprint += (int32_t)sizeof(SimpleFormatter);
+    }
+    return footprint;
+}
+
 
 // Use fallback cache for absolute units.
 const UnicodeString& RelativeDateTimeCacheData::getAbsoluteUnitString(
@@ -29,6 +29,7 @@
 #include "unicode/uniset.h"
 #include "unicode/unistr.h"
 #include "unicode/usetiter.h"
+#include "unicode/ustring.h"
 #include "unicode/utf8.h"
 #include "unicode/uversion.h"
 #include "bocsu.h"
@@ -39,6 +40,7 @@
 #include "collationdata.h"
 #include "collationdatareader.h"
 #include "collationfastlatin.h"
+#include "collationfastlatinbuilder.h"
 #include "collationiterator.h"
 #include "collationkeys.h"
 #include "collationroot.h"
@@ -694,6 +696,7 @@ RuleBasedCollator::setFastLatinOptions(CollationSettings &ownedSettings) const {
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
             data, ownedSettings,
             ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    ownedSettings.fastScriptsMask = CollationFastLatin::getScriptsMask(data, ownedSettings);
 }
 
 UCollationResult
@@ -962,6 +965,69 @@ UCollationResult compareNFDIter(const Normalizer2Impl &nfcImpl,
     return UCOL_EQUAL;
 }
 
+void U_CALLCONV
+computeFastScriptTables(const CollationTailoring *t, UErrorCode &errorCode) {
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        CollationFastLatinBuilder builder(errorCode);
+        if(builder.forScript(*t->data, i, errorCode)) {
+            t->fastScriptTables[i].setTo(
+                reinterpret_cast<const UChar *>(builder.getTable()), builder.lengthOfTable());
+            CollationFastLatin::getScriptPrimaries(
+                builder.getTable(),
+                t->fastScriptPrimaries[i], UPRV_LENGTHOF(t->fastScriptPrimaries[i]));
+        }
+        if(U_FAILURE(errorCode)) { return; }
+    }
+}
+
+/**
+ * Returns the script table, or NULL if it could not be built.
+ * The script tables are built on first use from the tailoring data.
+ */
+const uint16_t *getFastScriptTable(const CollationTailoring *t, int32_t scriptTable) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    umtx_initOnce(t->fastScriptTablesInitOnce, computeFastScriptTables, t, errorCode);
+    if(U_FAILURE(errorCode)) { return NULL; }
+    const UnicodeString &table = t->fastScriptTables[scriptTable];
+    return table.isEmpty() ? NULL : reinterpret_cast<const uint16_t *>(table.getBuffer());
+}
+
+/**
+ * Returns the options for CollationFastLatin::compareScriptUTF16() & compareScriptUTF8()
+ * with the tailoring's script table, or -1 if it is not available or not supported.
+ */
+int32_t getFastScriptOptions(const CollationTailoring *t, const CollationSettings &settings,
+                             int32_t scriptTable, const uint16_t *&table) {
+    table = getFastScriptTable(t, scriptTable);
+    return CollationFastLatin::getScriptOptions(table, scriptTable, settings);
+}
+
+/**
+ * Returns the script table for the first non-ASCII character in s[i..length[,
+ * or -1 if none.
+ */
+int32_t getScriptTable(const UChar *s, int32_t i, int32_t length) {
+    UChar c;
+    while(i != length && (c = s[i]) <= 0x7f) {
+        if(c == 0 && length < 0) { return -1; }
+        ++i;
+    }
+    return i != length ? CollationFastLatin::getScriptTable(s[i]) : -1;
+}
+
+int32_t getScriptTable(const uint8_t *s, int32_t i, int32_t length) {
+    uint8_t lead;
+    while(i != length && (lead = s[i]) <= 0x7f) {
+        if(lead == 0 && length < 0) { return -1; }
+        ++i;
+    }
+    // U+0370..U+045F have lead bytes CD..D1.
+    if(i != length && 0xcd <= lead && lead <= 0xd1 && (i + 1) != length && U8_IS_TRAIL(s[i + 1])) {
+        return CollationFastLatin::getScriptTable(((lead & 0x1f) << 6) | (s[i + 1] & 0x3f));
+    }
+    return -1;
+}
+
 }  // namespace
 
 UCollationResult
@@ -1044,6 +1110,22 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
     } else {
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
+    if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // Try a fast table for the script of the first differing non-ASCII character.
+        int32_t scriptTable = getScriptTable(left, equalPrefixLength, leftLength);
+        if(scriptTable < 0) {
+            scriptTable = getScriptTable(right, equalPrefixLength, rightLength);
+        }
+        const uint16_t *table;
+        int32_t options;
+        if(scriptTable >= 0 &&
+                (options = getFastScriptOptions(tailoring, *settings, scriptTable, table)) >= 0) {
+            result = CollationFastLatin::compareScriptUTF16(
+                table, tailoring->fastScriptPrimaries[scriptTable], scriptTable, options,
+                left + equalPrefixLength, leftLength >= 0 ? leftLength - equalPrefixLength : -1,
+                right + equalPrefixLength, rightLength >= 0 ? rightLength - equalPrefixLength : -1);
+        }
+    }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
@@ -1173,6 +1255,22 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
     } else {
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
+    if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // Try a fast table for the script of the first differing non-ASCII character.
+        int32_t scriptTable = getScriptTable(left, equalPrefixLength, leftLength);
+        if(scriptTable < 0) {
+            scriptTable = getScriptTable(right, equalPrefixLength, rightLength);
+        }
+        const uint16_t *table;
+        int32_t options;
+        if(scriptTable >= 0 &&
+                (options = getFastScriptOptions(tailoring, *settings, scriptTable, table)) >= 0) {
+            result = CollationFastLatin::compareScriptUTF8(
+                table, tailoring->fastScriptPrimaries[scriptTable], scriptTable, options,
+                left + equalPrefixLength, leftLength >= 0 ? leftLength - equalPrefixLength : -1,
+                right + equalPrefixLength, rightLength >= 0 ? rightLength - equalPrefixLength : -1);
+        }
+    }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
@@ -1328,6 +1426,265 @@ RuleBasedCollator::getSortKey(const UChar *s, int32_t length,
     return U_SUCCESS(errorCode) ? sink.NumberOfBytesAppended() : 0;
 }
 
+namespace {
+
+UBool
+areValidSortKeysArgs(const void *sources, int32_t count,
+                     const uint8_t *dest, int32_t capacity, const int32_t *offsets) {
+    return count >= 0 && (sources != NULL || count == 0) && offsets != NULL &&
+        capacity >= 0 && (dest != NULL || capacity == 0);
+}
+
+/**
+ * Stops writing sort key levels after noOfLevels levels, like ucol_getBound().
+ * The primary level is always written. noOfLevels=0 writes all levels.
+ */
+class BoundLevelCallback : public CollationKeys::LevelCallback {
+public:
+    BoundLevelCallback(uint32_t noOfLevels)
+            : maxLevels(noOfLevels != 0 ? noOfLevels : 0xffffffff), levels(1) {}
+    virtual ~BoundLevelCallback() {}
+    virtual UBool needToWrite(Collation::Level /*level*/) {
+        if(levels < maxLevels) {
+            ++levels;
+            return TRUE;
+        } else {
+            return FALSE;
+        }
+    }
+    void reset() { levels = 1; }
+    /** @return TRUE if the key has fewer levels than requested */
+    UBool isTooShort() const { return levels < maxLevels && maxLevels != 0xffffffff; }
+
+private:
+    uint32_t maxLevels;
+    uint32_t levels;
+};
+
+/** Appends the bytes for the bound type and the terminator, like ucol_getBound(). */
+void
+appendBound(SortKeyByteSink &sink, UColBoundMode boundType) {
+    if(boundType == UCOL_BOUND_UPPER) {
+        sink.Append(2);
+    } else if(boundType == UCOL_BOUND_UPPER_LONG) {
+        sink.Append(0xff);
+        sink.Append(0xff);
+    }
+    sink.Append(Collation::TERMINATOR_BYTE);
+}
+
+/**
+ * Sets the prefix for the key at start..limit if it is complete.
+ * Sort key bytes after the terminator are 0.
+ */
+inline void
+setPrefix(const uint8_t *dest, int32_t capacity, int32_t start, int32_t limit,
+          uint64_t *prefix) {
+    uint64_t p = 0;
+    if(limit <= capacity) {
+        const uint8_t *key = dest + start;
+        int32_t length = limit - start;
+        for(int32_t i = 0; i < 8; ++i) {
+            p <<= 8;
+            if(i < length) {
+                p |= key[i];
+            }
+        }
+    }
+    *prefix = p;
+}
+
+}  // namespace
+
+int32_t
+RuleBasedCollator::getSortKeys(const UChar *const sources[], const int32_t sourceLengths[],
+                               int32_t count, uint8_t *dest, int32_t capacity,
+                               int32_t offsets[], UErrorCode &errorCode) const {
+    return writeSortKeys(sources, sourceLengths, count, 0, UCOL_BOUND_LOWER,
+                         dest, capacity, offsets, NULL, errorCode);
+}
+
+int32_t
+RuleBasedCollator::getSortKeysUTF8(const char *const sources[], const int32_t sourceLengths[],
+                                   int32_t count, uint8_t *dest, int32_t capacity,
+                                   int32_t offsets[], UErrorCode &errorCode) const {
+    return writeSortKeysUTF8(sources, sourceLengths, count, 0, UCOL_BOUND_LOWER,
+                             dest, capacity, offsets, NULL, errorCode);
+}
+
+int32_t
+RuleBasedCollator::getSortKeysWithPrefixes(const UChar *const sources[],
+                                           const int32_t sourceLengths[], int32_t count,
+                                           uint32_t noOfLevels, UColBoundMode boundType,
+                                           uint8_t *dest, int32_t capacity,
+                                           int32_t offsets[], uint64_t prefixes[],
+                                           UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(prefixes == NULL) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    return writeSortKeys(sources, sourceLengths, count, noOfLevels, boundType,
+                         dest, capacity, offsets, prefixes, errorCode);
+}
+
+int32_t
+RuleBasedCollator::getSortKeysWithPrefixesUTF8(const char *const sources[],
+                                               const int32_t sourceLengths[], int32_t count,
+                                               uint32_t noOfLevels, UColBoundMode boundType,
+                                               uint8_t *dest, int32_t capacity,
+                                               int32_t offsets[], uint64_t prefixes[],
+                                               UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(prefixes == NULL) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    return writeSortKeysUTF8(sources, sourceLengths, count, noOfLevels, boundType,
+                             dest, capacity, offsets, prefixes, errorCode);
+}
+
+int32_t
+RuleBasedCollator::writeSortKeys(const UChar *const sources[], const int32_t sourceLengths[],
+                                 int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                                 uint8_t *dest, int32_t capacity,
+                                 int32_t offsets[], uint64_t prefixes[],
+                                 UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(!areValidSortKeysArgs(sources, count, dest, capacity, offsets) ||
+            boundType < UCOL_BOUND_LOWER || UCOL_BOUND_UPPER_LONG < boundType) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) {
+        dest = noDest;
+    }
+    // One sink writes all keys into dest,
+    // and one iterator keeps its CE buffer across all strings.
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
+    UBool checkFCD = !settings->dontCheckFCD();
+    UBool numeric = settings->isNumeric();
+    UTF16CollationIterator iter(data, numeric, NULL, NULL, NULL);
+    FCDUTF16CollationIterator fcdIter(data, numeric, NULL, NULL, NULL);
+    CollationIterator &ci = checkFCD ? static_cast<CollationIterator &>(fcdIter) : iter;
+    BoundLevelCallback callback(noOfLevels);
+    UBool tooShort = FALSE;
+    for(int32_t i = 0; i < count; ++i) {
+        offsets[i] = sink.NumberOfBytesAppended();
+        const UChar *s = sources[i];
+        int32_t length = (sourceLengths != NULL) ? sourceLengths[i] : -1;
+        if((s == NULL && length != 0) || length < -1) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        const UChar *limit = (length >= 0) ? s + length : NULL;
+        if(checkFCD) {
+            fcdIter.setText(s, limit);
+        } else {
+            iter.setText(s, limit);
+        }
+        callback.reset();
+        CollationKeys::writeSortKeyUpToQuaternary(ci, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, TRUE, errorCode);
+        if(settings->getStrength() == UCOL_IDENTICAL &&
+                callback.needToWrite(Collation::IDENTICAL_LEVEL)) {
+            writeIdenticalLevel(s, limit, sink, errorCode);
+        }
+        tooShort |= callback.isTooShort();
+        appendBound(sink, boundType);
+        if(U_FAILURE(errorCode)) { return 0; }
+        if(prefixes != NULL) {
+            setPrefix(dest, capacity, offsets[i], sink.NumberOfBytesAppended(), prefixes + i);
+        }
+    }
+    int32_t totalLength = offsets[count] = sink.NumberOfBytesAppended();
+    if(totalLength > capacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    } else if(tooShort) {
+        errorCode = U_SORT_KEY_TOO_SHORT_WARNING;
+    }
+    return totalLength;
+}
+
+int32_t
+RuleBasedCollator::writeSortKeysUTF8(const char *const sources[], const int32_t sourceLengths[],
+                                     int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                                     uint8_t *dest, int32_t capacity,
+                                     int32_t offsets[], uint64_t prefixes[],
+                                     UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(!areValidSortKeysArgs(sources, count, dest, capacity, offsets) ||
+            boundType < UCOL_BOUND_LOWER || UCOL_BOUND_UPPER_LONG < boundType) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) {
+        dest = noDest;
+    }
+    FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest), capacity);
+    UBool checkFCD = !settings->dontCheckFCD();
+    UBool numeric = settings->isNumeric();
+    UTF8CollationIterator iter(data, numeric, NULL, 0, 0);
+    FCDUTF8CollationIterator fcdIter(data, numeric, NULL, 0, 0);
+    CollationIterator &ci = checkFCD ? static_cast<CollationIterator &>(fcdIter) : iter;
+    BoundLevelCallback callback(noOfLevels);
+    UBool tooShort = FALSE;
+    UnicodeString s16;  // The identical level is written from UTF-16.
+    for(int32_t i = 0; i < count; ++i) {
+        offsets[i] = sink.NumberOfBytesAppended();
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(sources[i]);
+        int32_t length = (sourceLengths != NULL) ? sourceLengths[i] : -1;
+        if((s == NULL && length != 0) || length < -1) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        if(checkFCD) {
+            fcdIter.setText(s, length);
+        } else {
+            iter.setText(s, length);
+        }
+        callback.reset();
+        CollationKeys::writeSortKeyUpToQuaternary(ci, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, TRUE, errorCode);
+        if(settings->getStrength() == UCOL_IDENTICAL &&
+                callback.needToWrite(Collation::IDENTICAL_LEVEL)) {
+            if(length < 0) {
+                length = (int32_t)uprv_strlen(sources[i]);
+            }
+            // The UTF-16 length is at most the UTF-8 length.
+            // Leave room for the NUL terminator so that u_strFromUTF8WithSub()
+            // does not set U_STRING_NOT_TERMINATED_WARNING in the caller's errorCode.
+            UChar *s16Array = s16.getBuffer(length + 1);
+            if(s16Array == NULL) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+                return 0;
+            }
+            int32_t length16;
+            u_strFromUTF8WithSub(s16Array, s16.getCapacity(), &length16,
+                                 sources[i], length, 0xfffd, NULL, &errorCode);
+            writeIdenticalLevel(s16Array, s16Array + length16, sink, errorCode);
+            s16.releaseBuffer(0);
+        }
+        tooShort |= callback.isTooShort();
+        appendBound(sink, boundType);
+        if(U_FAILURE(errorCode)) { return 0; }
+        if(prefixes != NULL) {
+            setPrefix(dest, capacity, offsets[i], sink.NumberOfBytesAppended(), prefixes + i);
+        }
+    }
+    int32_t totalLength = offsets[count] = sink.NumberOfBytesAppended();
+    if(totalLength > capacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    } else if(tooShort) {
+        errorCode = U_SORT_KEY_TOO_SHORT_WARNING;
+    }
+    return totalLength;
+}
+
 void
 RuleBasedCollator::writeSortKey(const UChar *s, int32_t length,
                                 SortKeyByteSink &sink, UErrorCode &errorCode) const {
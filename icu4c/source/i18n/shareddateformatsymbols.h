@@ -24,6 +24,7 @@ public:
             const Locale &loc, const char *type, UErrorCode &status)
             : dfs(loc, type, status) { }
     virtual ~SharedDateFormatSymbols();
+    virtual int32_t getMemoryFootprint() const;
     const DateFormatSymbols &get() const { return dfs; }
 private:
     DateFormatSymbols dfs;
@@ -22,6 +22,14 @@ class U_I18N_API SharedNumberFormat : public SharedObject {
 public:
     SharedNumberFormat(NumberFormat *nfToAdopt) : ptr(nfToAdopt) { }
     virtual ~SharedNumberFormat();
+    virtual int32_t getMemoryFootprint() const;
+
+    /**
+     * Returns an estimate of the memory held by nf, for getMemoryFootprint().
+     * Returns 0 if nf is NULL.
+     */
+    static int32_t getNumberFormatFootprint(const NumberFormat *nf);
+
     const NumberFormat *get() const { return ptr; }
     const NumberFormat *operator->() const { return ptr; }
     const NumberFormat &operator*() const { return *ptr; }
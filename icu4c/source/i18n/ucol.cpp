@@ -209,6 +209,74 @@ ucol_getSortKey(const    UCollator    *coll,
     return keySize;
 }
 
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const sources[], const int32_t sourceLengths[], int32_t count,
+                 uint8_t *dest, int32_t destCapacity,
+                 int32_t offsets[], UErrorCode *status) {
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getSortKeys(sources, sourceLengths, count, dest, destCapacity, offsets, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const sources[], const int32_t sourceLengths[], int32_t count,
+                     uint8_t *dest, int32_t destCapacity,
+                     int32_t offsets[], UErrorCode *status) {
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getSortKeysUTF8(sources, sourceLengths, count, dest, destCapacity, offsets, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeysWithPrefixes(const UCollator *coll,
+                             const UChar *const sources[], const int32_t sourceLengths[],
+                             int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                             uint8_t *dest, int32_t destCapacity,
+                             int32_t offsets[], uint64_t prefixes[], UErrorCode *status) {
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getSortKeysWithPrefixes(sources, sourceLengths, count, noOfLevels, boundType,
+                                        dest, destCapacity, offsets, prefixes, *status);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeysWithPrefixesUTF8(const UCollator *coll,
+                                 const char *const sources[], const int32_t sourceLengths[],
+                                 int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                                 uint8_t *dest, int32_t destCapacity,
+                                 int32_t offsets[], uint64_t prefixes[], UErrorCode *status) {
+    if(U_FAILURE(*status)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc == NULL && coll != NULL) {
+        *status = U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return rbc->getSortKeysWithPrefixesUTF8(sources, sourceLengths, count, noOfLevels, boundType,
+                                            dest, destCapacity, offsets, prefixes, *status);
+}
+
 U_CAPI int32_t U_EXPORT2
 ucol_nextSortKeyPart(const UCollator *coll,
                      UCharIterator *iter,
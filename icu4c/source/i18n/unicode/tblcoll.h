@@ -649,6 +649,142 @@ public:
     virtual int32_t getSortKey(const char16_t *source, int32_t sourceLength,
                                uint8_t *result, int32_t resultLength) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Writes the sort keys for an array of strings into one buffer.
+     * This is much faster than calling getSortKey() for each string
+     * because the setup for sort key generation is done only once.
+     *
+     * Each sort key is the same as from getSortKey(), including its terminating zero byte.
+     * The keys are written one after the other, and offsets[i] is the start of the key
+     * for sources[i] in dest. offsets[count] is the total length of all keys,
+     * so the length of the key for sources[i] is offsets[i+1]-offsets[i].
+     *
+     * If the keys do not all fit, then U_BUFFER_OVERFLOW_ERROR is set
+     * and the offsets are still set as if dest were large enough.
+     * Each key that ends at or before capacity is complete.
+     * The collator is not modified, so several threads can write the keys
+     * for different parts of one array at the same time, into different buffers.
+     *
+     * @param sources array of count strings
+     * @param sourceLengths array of count string lengths, or NULL if all strings
+     *        are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+     * @param count number of strings; can be 0
+     * @param dest buffer for the sort keys; can be NULL if capacity is 0 (preflighting)
+     * @param capacity number of bytes available at dest
+     * @param offsets array of count+1 sort key offsets, filled in by this function
+     * @param errorCode ICU error code in/out parameter.
+     *                  Must fulfill U_SUCCESS before the function call.
+     * @return the total length of all sort keys, offsets[count]
+     * @see getSortKey
+     * @see ucol_getSortKeys
+     * @draft ICU 63
+     */
+    int32_t getSortKeys(const char16_t *const sources[], const int32_t sourceLengths[],
+                        int32_t count, uint8_t *dest, int32_t capacity,
+                        int32_t offsets[], UErrorCode &errorCode) const;
+
+    /**
+     * Writes the sort keys for an array of UTF-8 strings into one buffer.
+     * The keys are the same as for the UTF-16 versions of the strings,
+     * where ill-formed UTF-8 sequences are treated like U+FFFD.
+     * Otherwise the same as getSortKeys() for UTF-16 strings.
+     *
+     * @param sources array of count UTF-8 strings
+     * @param sourceLengths array of count string lengths, or NULL if all strings
+     *        are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+     * @param count number of strings; can be 0
+     * @param dest buffer for the sort keys; can be NULL if capacity is 0 (preflighting)
+     * @param capacity number of bytes available at dest
+     * @param offsets array of count+1 sort key offsets, filled in by this function
+     * @param errorCode ICU error code in/out parameter.
+     *                  Must fulfill U_SUCCESS before the function call.
+     * @return the total length of all sort keys, offsets[count]
+     * @see getSortKeys
+     * @see ucol_getSortKeysUTF8
+     * @draft ICU 63
+     */
+    int32_t getSortKeysUTF8(const char *const sources[], const int32_t sourceLengths[],
+                            int32_t count, uint8_t *dest, int32_t capacity,
+                            int32_t offsets[], UErrorCode &errorCode) const;
+
+    /**
+     * Writes the sort keys or bounds for an array of strings into one buffer,
+     * and sets a fixed-width prefix for each key.
+     * For external sorting, the prefixes can be compared as integers,
+     * and only equal prefixes need a comparison of the full keys.
+     *
+     * prefixes[i] is the first 8 bytes of the key for sources[i] as a big-endian integer,
+     * padded with 0 bytes if the key is shorter.
+     * If prefixes[i]<prefixes[j] then the key for sources[i] is less than that for sources[j].
+     * If the prefixes are equal and their low byte is not 0, then the keys need to be
+     * compared from their 8th byte (index 8) on.
+     * The prefix is 0 for a key that does not end at or before capacity.
+     *
+     * If noOfLevels is 0, then the keys are the same as from getSortKeys() with
+     * boundType=UCOL_BOUND_LOWER.
+     * Otherwise each key is truncated and terminated like with ucol_getBound()
+     * for the same noOfLevels and boundType, all in the same pass.
+     * If some keys have fewer levels than requested, then U_SORT_KEY_TOO_SHORT_WARNING is set.
+     * Otherwise the same as getSortKeys().
+     *
+     * @param sources array of count strings
+     * @param sourceLengths array of count string lengths, or NULL if all strings
+     *        are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+     * @param count number of strings; can be 0
+     * @param noOfLevels number of sort key levels to write, or 0 for all levels
+     * @param boundType the type of bound, appended to each key
+     * @param dest buffer for the sort keys; can be NULL if capacity is 0 (preflighting)
+     * @param capacity number of bytes available at dest
+     * @param offsets array of count+1 sort key offsets, filled in by this function
+     * @param prefixes array of count sort key prefixes, filled in by this function
+     * @param errorCode ICU error code in/out parameter.
+     *                  Must fulfill U_SUCCESS before the function call.
+     * @return the total length of all sort keys, offsets[count]
+     * @see getSortKeys
+     * @see ucol_getBound
+     * @see ucol_getSortKeysWithPrefixes
+     * @draft ICU 63
+     */
+    int32_t getSortKeysWithPrefixes(const char16_t *const sources[],
+                                    const int32_t sourceLengths[], int32_t count,
+                                    uint32_t noOfLevels, UColBoundMode boundType,
+                                    uint8_t *dest, int32_t capacity,
+                                    int32_t offsets[], uint64_t prefixes[],
+                                    UErrorCode &errorCode) const;
+
+    /**
+     * Writes the sort keys or bounds for an array of UTF-8 strings into one buffer,
+     * and sets a fixed-width prefix for each key.
+     * The keys are the same as for the UTF-16 versions of the strings,
+     * where ill-formed UTF-8 sequences are treated like U+FFFD.
+     * Otherwise the same as getSortKeysWithPrefixes() for UTF-16 strings.
+     *
+     * @param sources array of count UTF-8 strings
+     * @param sourceLengths array of count string lengths, or NULL if all strings
+     *        are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+     * @param count number of strings; can be 0
+     * @param noOfLevels number of sort key levels to write, or 0 for all levels
+     * @param boundType the type of bound, appended to each key
+     * @param dest buffer for the sort keys; can be NULL if capacity is 0 (preflighting)
+     * @param capacity number of bytes available at dest
+     * @param offsets array of count+1 sort key offsets, filled in by this function
+     * @param prefixes array of count sort key prefixes, filled in by this function
+     * @param errorCode ICU error code in/out parameter.
+     *                  Must fulfill U_SUCCESS before the function call.
+     * @return the total length of all sort keys, offsets[count]
+     * @see getSortKeysWithPrefixes
+     * @see ucol_getSortKeysWithPrefixesUTF8
+     * @draft ICU 63
+     */
+    int32_t getSortKeysWithPrefixesUTF8(const char *const sources[],
+                                        const int32_t sourceLengths[], int32_t count,
+                                        uint32_t noOfLevels, UColBoundMode boundType,
+                                        uint8_t *dest, int32_t capacity,
+                                        int32_t offsets[], uint64_t prefixes[],
+                                        UErrorCode &errorCode) const;
+#endif  // U_HIDE_DRAFT_API
+
     /**
      * Retrieves the reordering codes for this collator.
      * @param dest The array to fill with the script ordering.
@@ -834,6 +970,19 @@ private:
     void writeIdenticalLevel(const char16_t *s, const char16_t *limit,
                              SortKeyByteSink &sink, UErrorCode &errorCode) const;
 
+    // Implement getSortKeys() and getSortKeysWithPrefixes() etc.
+    // prefixes can be NULL.
+    int32_t writeSortKeys(const char16_t *const sources[], const int32_t sourceLengths[],
+                          int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                          uint8_t *dest, int32_t capacity,
+                          int32_t offsets[], uint64_t prefixes[],
+                          UErrorCode &errorCode) const;
+    int32_t writeSortKeysUTF8(const char *const sources[], const int32_t sourceLengths[],
+                              int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                              uint8_t *dest, int32_t capacity,
+                              int32_t offsets[], uint64_t prefixes[],
+                              UErrorCode &errorCode) const;
+
     const CollationSettings &getDefaultSettings() const;
 
     void setAttributeDefault(int32_t attribute) {
@@ -1019,6 +1019,69 @@ ucol_getSortKey(const    UCollator    *coll,
         uint8_t        *result,
         int32_t        resultLength);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Writes the sort keys for an array of strings into one buffer.
+ * This is much faster than calling ucol_getSortKey() for each string
+ * because the setup for sort key generation is done only once.
+ *
+ * Each sort key is the same as from ucol_getSortKey(), including its terminating zero byte.
+ * The keys are written one after the other, and offsets[i] is the start of the key
+ * for sources[i] in dest. offsets[count] is the total length of all keys,
+ * so the length of the key for sources[i] is offsets[i+1]-offsets[i].
+ *
+ * If the keys do not all fit, then U_BUFFER_OVERFLOW_ERROR is set
+ * and the offsets are still set as if dest were large enough.
+ * Each key that ends at or before destCapacity is complete.
+ * Several threads can write the keys for different parts of one array
+ * at the same time with the same collator, into different buffers.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param sources Array of count strings.
+ * @param sourceLengths Array of count string lengths, or NULL if all strings
+ *                      are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+ * @param count The number of strings; can be 0.
+ * @param dest Buffer for the sort keys; can be NULL if destCapacity is 0 (preflighting).
+ * @param destCapacity The number of bytes available at dest.
+ * @param offsets Array of count+1 sort key offsets, filled in by this function.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The total length of all sort keys, offsets[count].
+ * @see ucol_getSortKey
+ * @see ucol_getSortKeysUTF8
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const sources[], const int32_t sourceLengths[], int32_t count,
+                 uint8_t *dest, int32_t destCapacity,
+                 int32_t offsets[], UErrorCode *status);
+
+/**
+ * Writes the sort keys for an array of UTF-8 strings into one buffer.
+ * The keys are the same as for the UTF-16 versions of the strings,
+ * where ill-formed UTF-8 sequences are treated like U+FFFD.
+ * Otherwise the same as ucol_getSortKeys().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param sources Array of count UTF-8 strings.
+ * @param sourceLengths Array of count string lengths, or NULL if all strings
+ *                      are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+ * @param count The number of strings; can be 0.
+ * @param dest Buffer for the sort keys; can be NULL if destCapacity is 0 (preflighting).
+ * @param destCapacity The number of bytes available at dest.
+ * @param offsets Array of count+1 sort key offsets, filled in by this function.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The total length of all sort keys, offsets[count].
+ * @see ucol_getSortKeys
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const sources[], const int32_t sourceLengths[], int32_t count,
+                     uint8_t *dest, int32_t destCapacity,
+                     int32_t offsets[], UErrorCode *status);
+#endif  // U_HIDE_DRAFT_API
+
 
 /** Gets the next count bytes of a sort key. Caller needs
  *  to preserve state array between calls and to provide
@@ -1115,6 +1178,82 @@ ucol_getBound(const uint8_t       *source,
         uint8_t             *result,
         int32_t             resultLength,
         UErrorCode          *status);
+
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Writes the sort keys or bounds for an array of strings into one buffer,
+ * and sets a fixed-width prefix for each key.
+ * For external sorting, the prefixes can be compared as integers,
+ * and only equal prefixes need a comparison of the full keys.
+ *
+ * prefixes[i] is the first 8 bytes of the key for sources[i] as a big-endian integer,
+ * padded with 0 bytes if the key is shorter.
+ * If prefixes[i]<prefixes[j] then the key for sources[i] is less than that for sources[j].
+ * If the prefixes are equal and their low byte is not 0, then the keys need to be
+ * compared from their 8th byte (index 8) on.
+ * The prefix is 0 for a key that does not end at or before destCapacity.
+ *
+ * If noOfLevels is 0, then the keys are the same as from ucol_getSortKeys() with
+ * boundType=UCOL_BOUND_LOWER.
+ * Otherwise each key is truncated and terminated like with ucol_getBound()
+ * for the same noOfLevels and boundType, all in the same pass.
+ * If some keys have fewer levels than requested, then U_SORT_KEY_TOO_SHORT_WARNING is set.
+ * Otherwise the same as ucol_getSortKeys().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param sources Array of count strings.
+ * @param sourceLengths Array of count string lengths, or NULL if all strings
+ *                      are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+ * @param count The number of strings; can be 0.
+ * @param noOfLevels The number of sort key levels to write, or 0 for all levels.
+ * @param boundType The type of bound, appended to each key.
+ * @param dest Buffer for the sort keys; can be NULL if destCapacity is 0 (preflighting).
+ * @param destCapacity The number of bytes available at dest.
+ * @param offsets Array of count+1 sort key offsets, filled in by this function.
+ * @param prefixes Array of count sort key prefixes, filled in by this function.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The total length of all sort keys, offsets[count].
+ * @see ucol_getSortKeys
+ * @see ucol_getBound
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeysWithPrefixes(const UCollator *coll,
+                             const UChar *const sources[], const int32_t sourceLengths[],
+                             int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                             uint8_t *dest, int32_t destCapacity,
+                             int32_t offsets[], uint64_t prefixes[], UErrorCode *status);
+
+/**
+ * Writes the sort keys or bounds for an array of UTF-8 strings into one buffer,
+ * and sets a fixed-width prefix for each key.
+ * The keys are the same as for the UTF-16 versions of the strings,
+ * where ill-formed UTF-8 sequences are treated like U+FFFD.
+ * Otherwise the same as ucol_getSortKeysWithPrefixes().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param sources Array of count UTF-8 strings.
+ * @param sourceLengths Array of count string lengths, or NULL if all strings
+ *                      are NUL-terminated. A length of -1 means that the string is NUL-terminated.
+ * @param count The number of strings; can be 0.
+ * @param noOfLevels The number of sort key levels to write, or 0 for all levels.
+ * @param boundType The type of bound, appended to each key.
+ * @param dest Buffer for the sort keys; can be NULL if destCapacity is 0 (preflighting).
+ * @param destCapacity The number of bytes available at dest.
+ * @param offsets Array of count+1 sort key offsets, filled in by this function.
+ * @param prefixes Array of count sort key prefixes, filled in by this function.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The total length of all sort keys, offsets[count].
+ * @see ucol_getSortKeysWithPrefixes
+ * @draft ICU 63
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeysWithPrefixesUTF8(const UCollator *coll,
+                                 const char *const sources[], const int32_t sourceLengths[],
+                                 int32_t count, uint32_t noOfLevels, UColBoundMode boundType,
+                                 uint8_t *dest, int32_t destCapacity,
+                                 int32_t offsets[], uint64_t prefixes[], UErrorCode *status);
+#endif  // U_HIDE_DRAFT_API
         
 /**
  * Gets the version information for a Collator. Version is currently
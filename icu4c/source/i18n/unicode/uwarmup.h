@@ -0,0 +1,134 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   file name:  uwarmup.h
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*/
+
+#ifndef UWARMUP_H
+#define UWARMUP_H
+
+#include "unicode/utypes.h"
+
+/**
+ * \file
+ * \brief C API: Preload locale data and services before their first use.
+ *
+ * The first formatter, collator etc. for a locale is much more expensive than
+ * later ones because it loads and parses resource bundle data.
+ * Most of the resulting objects are shared through an internal cache,
+ * and the resource bundles through the resource bundle cache.
+ * A server that handles requests for many locales can call u_warmup()
+ * at startup so that the first requests do not pay this cost.
+ *
+ * Warming up only populates caches; it does not change the behavior of any API.
+ * Cached objects that are not in use can still be evicted later
+ * when many other objects are created.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Bit flags for selecting the services that u_warmup() preloads.
+ * @draft ICU 63
+ */
+typedef enum UWarmupService {
+    /**
+     * NumberFormat and NumberFormatter: number patterns, symbols and numbering systems.
+     * @draft ICU 63
+     */
+    UWARMUP_NUMBER_FORMAT = 1,
+    /**
+     * Cardinal and ordinal PluralRules.
+     * @draft ICU 63
+     */
+    UWARMUP_PLURAL_RULES = 2,
+    /**
+     * DateFormat: calendar, date format symbols and patterns.
+     * @draft ICU 63
+     */
+    UWARMUP_DATE_FORMAT = 4,
+    /**
+     * Collator tailorings.
+     * @draft ICU 63
+     */
+    UWARMUP_COLLATOR = 8,
+    /**
+     * MeasureFormat unit patterns.
+     * @draft ICU 63
+     */
+    UWARMUP_MEASURE_FORMAT = 0x10,
+    /**
+     * RelativeDateTimeFormatter patterns.
+     * @draft ICU 63
+     */
+    UWARMUP_RELATIVE_DATE_TIME_FORMAT = 0x20,
+    /**
+     * All of the above.
+     * @draft ICU 63
+     */
+    UWARMUP_ALL = 0x3f
+} UWarmupService;
+
+/**
+ * Task function for UWarmupRunner.
+ * @param context the taskContext passed into the runner
+ * @param index the index of the task
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UWarmupTask(void *context, int32_t index);
+
+/**
+ * Function type for running independent warmup tasks,
+ * for example on a thread pool.
+ * It must call task(taskContext, i) exactly once for each i from 0 to count-1,
+ * in any order and possibly concurrently, and return only after all calls have returned.
+ *
+ * @param context the runnerContext passed into u_warmup()
+ * @param task the task function
+ * @param taskContext the context for the task function
+ * @param count the number of tasks
+ * @see u_warmup
+ * @draft ICU 63
+ */
+typedef void U_CALLCONV UWarmupRunner(const void *context,
+                                      UWarmupTask *task, void *taskContext,
+                                      int32_t count);
+
+/**
+ * Preloads the data and cacheable objects of the selected services
+ * for each of the locales, so that their first use in the process is fast.
+ * This function returns when all locales are done.
+ *
+ * ICU does not start threads itself. To warm up several locales concurrently,
+ * the caller passes a UWarmupRunner, for example one that runs the tasks
+ * on a thread pool. The locales are distributed over up to maxTasks tasks.
+ * With a NULL runner, all locales are processed on the calling thread.
+ *
+ * Services that are excluded from this build of ICU (see uconfig.h) are skipped.
+ * Missing locale data is not an error: the services fall back as usual.
+ *
+ * @param locales array of locale IDs
+ * @param count number of locale IDs
+ * @param services bit set of UWarmupService values
+ * @param maxTasks maximum number of tasks to pass to the runner,
+ *                 for example the number of threads in its pool
+ * @param runner runs the warmup tasks; if NULL, then the locales are
+ *               processed one after the other on this thread
+ * @param runnerContext the context pointer for the runner
+ * @param status ICU error code; set to the first failure from any of the services
+ *               (for example U_MEMORY_ALLOCATION_ERROR), after all locales were processed
+ * @draft ICU 63
+ */
+U_DRAFT void U_EXPORT2
+u_warmup(const char * const *locales, int32_t count, uint32_t services,
+         int32_t maxTasks, UWarmupRunner *runner, const void *runnerContext,
+         UErrorCode *status);
+
+#endif  /* U_HIDE_DRAFT_API */
+
+#endif
@@ -101,6 +101,14 @@ public:
 
     virtual int32_t getOffset() const;
 
+    void setText(const UChar *s, const UChar *lim) {
+        UTF16CollationIterator::setText(s, lim);
+        rawStart = segmentStart = s;
+        segmentLimit = NULL;
+        rawLimit = lim;
+        checkDir = 1;
+    }
+
     virtual UChar32 nextCodePoint(UErrorCode &errorCode);
 
     virtual UChar32 previousCodePoint(UErrorCode &errorCode);
@@ -0,0 +1,168 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   file name:  uwarmup.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*/
+
+#include "unicode/utypes.h"
+#include "unicode/uwarmup.h"
+#include "unicode/coll.h"
+#include "unicode/datefmt.h"
+#include "unicode/locid.h"
+#include "unicode/measfmt.h"
+#include "unicode/numberformatter.h"
+#include "unicode/numfmt.h"
+#include "unicode/plurrule.h"
+#include "unicode/reldatefmt.h"
+#include "cmemory.h"
+#include "sharednumberformat.h"
+#include "sharedpluralrules.h"
+#include "umutex.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+// Keeps the first failure; warnings are ignored.
+void setFirstFailure(UErrorCode status, UErrorCode &errorCode) {
+    if (U_FAILURE(status) && U_SUCCESS(errorCode)) {
+        errorCode = status;
+    }
+}
+
+// Creates and discards one object per service.
+// What stays behind are the UnifiedCache entries and the cached resource bundles.
+void warmupLocale(const char *localeID, uint32_t services, UErrorCode &errorCode) {
+    Locale locale(localeID);
+    if (locale.isBogus()) {
+        setFirstFailure(U_ILLEGAL_ARGUMENT_ERROR, errorCode);
+        return;
+    }
+#if !UCONFIG_NO_FORMATTING
+    if (services & UWARMUP_NUMBER_FORMAT) {
+        UErrorCode status = U_ZERO_ERROR;
+        const SharedNumberFormat *shared =
+            NumberFormat::createSharedInstance(locale, UNUM_DECIMAL, status);
+        if (shared != NULL) {
+            shared->removeRef();
+        }
+        // NumberFormatter loads its data when it formats.
+        number::NumberFormatter::withLocale(locale).formatDouble(1234.5, status);
+        setFirstFailure(status, errorCode);
+    }
+    if (services & UWARMUP_PLURAL_RULES) {
+        UErrorCode status = U_ZERO_ERROR;
+        const SharedPluralRules *shared =
+            PluralRules::createSharedInstance(locale, UPLURAL_TYPE_CARDINAL, status);
+        if (shared != NULL) {
+            shared->removeRef();
+        }
+        // Ordinal rules are not cached, but their data is loaded with the cardinal rules.
+        delete PluralRules::forLocale(locale, UPLURAL_TYPE_ORDINAL, status);
+        setFirstFailure(status, errorCode);
+    }
+    if (services & UWARMUP_DATE_FORMAT) {
+        UErrorCode status = U_ZERO_ERROR;
+        LocalPointer<DateFormat> df(
+            DateFormat::createDateTimeInstance(DateFormat::kDefault, DateFormat::kDefault, locale));
+        if (df.isNull()) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+        } else {
+            UnicodeString s;
+            df->format((UDate)0, s);
+        }
+        setFirstFailure(status, errorCode);
+    }
+    if (services & UWARMUP_MEASURE_FORMAT) {
+        UErrorCode status = U_ZERO_ERROR;
+        MeasureFormat mf(locale, UMEASFMT_WIDTH_WIDE, status);
+        setFirstFailure(status, errorCode);
+    }
+#if !UCONFIG_NO_BREAK_ITERATION
+    if (services & UWARMUP_RELATIVE_DATE_TIME_FORMAT) {
+        UErrorCode status = U_ZERO_ERROR;
+        RelativeDateTimeFormatter rdtf(locale, status);
+        setFirstFailure(status, errorCode);
+    }
+#endif
+#endif
+#if !UCONFIG_NO_COLLATION
+    if (services & UWARMUP_COLLATOR) {
+        UErrorCode status = U_ZERO_ERROR;
+        delete Collator::createInstance(locale, status);
+        setFirstFailure(status, errorCode);
+    }
+#endif
+    (void)services;
+}
+
+struct WarmupContext {
+    const char * const *locales;
+    int32_t count;
+    uint32_t services;
+    u_atomic_int32_t next;  // number of locales taken by any task
+    UErrorCode *errorCodes;  // one per task
+};
+
+// Each task takes the next locale until all are done.
+void U_CALLCONV warmupLocales(void *context, int32_t index) {
+    WarmupContext *warmup = static_cast<WarmupContext *>(context);
+    int32_t i;
+    while ((i = umtx_atomic_inc(&warmup->next) - 1) < warmup->count) {
+        warmupLocale(warmup->locales[i], warmup->services, warmup->errorCodes[index]);
+    }
+}
+
+}  // namespace
+
+U_CAPI void U_EXPORT2
+u_warmup(const char * const *locales, int32_t count, uint32_t services,
+         int32_t maxTasks, UWarmupRunner *runner, const void *runnerContext,
+         UErrorCode *status) {
+    if (status == NULL || U_FAILURE(*status)) {
+        return;
+    }
+    if (count < 0 || (locales == NULL && count > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if (count == 0 || (services & UWARMUP_ALL) == 0) {
+        return;
+    }
+    int32_t numTasks = runner != NULL ? maxTasks : 1;
+    if (numTasks > count) {
+        numTasks = count;
+    }
+    if (numTasks < 1) {
+        numTasks = 1;
+    }
+
+    // One error code per task.
+    MaybeStackArray<UErrorCode, 8> errorCodes;
+    if (errorCodes.resize(numTasks) == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < numTasks; ++i) {
+        errorCodes[i] = U_ZERO_ERROR;
+    }
+    WarmupContext context;
+    context.locales = locales;
+    context.count = count;
+    context.services = services;
+    context.next = 0;
+    context.errorCodes = errorCodes.getAlias();
+    if (numTasks > 1) {
+        runner(runnerContext, warmupLocales, &context, numTasks);
+    } else {
+        warmupLocales(&context, 0);
+    }
+    for (int32_t i = 0; i < numTasks; ++i) {
+        setFirstFailure(errorCodes[i], *status);
+    }
+}
@@ -52,6 +52,8 @@ static void TestBreakIteratorTailoring(void);
 static void TestBreakIteratorRefresh(void);
 static void TestBug11665(void);
 static void TestBreakIteratorSuppressions(void);
+static void TestBreakIteratorGetAllBoundaries(void);
+static void TestBreakIteratorAcquire(void);
 
 void addBrkIterAPITest(TestNode** root);
 
@@ -61,6 +63,8 @@ void addBrkIterAPITest(TestNode** root)
     addTest(root, &TestBreakIteratorCAPI, "tstxtbd/cbiapts/TestBreakIteratorCAPI");
     addTest(root, &TestBreakIteratorSafeClone, "tstxtbd/cbiapts/TestBreakIteratorSafeClone");
     addTest(root, &TestBreakIteratorUText, "tstxtbd/cbiapts/TestBreakIteratorUText");
+    addTest(root, &TestBreakIteratorGetAllBoundaries, "tstxtbd/cbiapts/TestBreakIteratorGetAllBoundaries");
+    addTest(root, &TestBreakIteratorAcquire, "tstxtbd/cbiapts/TestBreakIteratorAcquire");
 #endif
     addTest(root, &TestBreakIteratorRules, "tstxtbd/cbiapts/TestBreakIteratorRules");
     addTest(root, &TestBreakIteratorRuleError, "tstxtbd/cbiapts/TestBreakIteratorRuleError");
@@ -710,6 +714,143 @@ static void TestBreakIteratorStatusVec() {
 }
 
 
+/*
+ *  TestBreakIteratorGetAllBoundaries()   Test ubrk_getAllBoundaries() against
+ *                                        iteration with ubrk_next().
+ */
+static void TestBreakIteratorGetAllBoundaries(void) {
+    UChar           testString[40];
+    int32_t         expected[40];
+    int32_t         expectedStatus[40];
+    int32_t         boundaries[40];
+    int32_t         statuses[40];
+    int32_t         numExpected = 0;
+    int32_t         count, i, pos;
+    UErrorCode      status = U_ZERO_ERROR;
+    UBreakIterator *bi;
+
+    u_uastrncpy(testString, "Hello, world! It's 12.5 degrees.", UPRV_LENGTHOF(testString));
+    bi = ubrk_open(UBRK_WORD, "en", testString, -1, &status);
+    if (U_FAILURE(status)) {
+        log_data_err("ubrk_open(UBRK_WORD) failed - %s (Are you missing data?)\n", u_errorName(status));
+        return;
+    }
+
+    for (pos = ubrk_first(bi); pos != UBRK_DONE; pos = ubrk_next(bi)) {
+        expected[numExpected] = pos;
+        expectedStatus[numExpected] = ubrk_getRuleStatus(bi);
+        ++numExpected;
+    }
+    ubrk_following(bi, 5);
+
+    memset(boundaries, -1, sizeof(boundaries));
+    memset(statuses, -1, sizeof(statuses));
+    count = ubrk_getAllBoundaries(bi, boundaries, statuses, UPRV_LENGTHOF(boundaries), &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(count == numExpected);
+    for (i = 0; i < numExpected; ++i) {
+        TEST_ASSERT(boundaries[i] == expected[i]);
+        TEST_ASSERT(statuses[i] == expectedStatus[i]);
+    }
+    TEST_ASSERT(boundaries[numExpected] == -1);
+    TEST_ASSERT(ubrk_current(bi) == 0);
+
+    /* Without rule status values. */
+    count = ubrk_getAllBoundaries(bi, boundaries, NULL, UPRV_LENGTHOF(boundaries), &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(count == numExpected);
+
+    /* Preflighting, and a buffer that is too small. */
+    count = ubrk_getAllBoundaries(bi, NULL, NULL, 0, &status);
+    TEST_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+    TEST_ASSERT(count == numExpected);
+    status = U_ZERO_ERROR;
+    memset(boundaries, -1, sizeof(boundaries));
+    count = ubrk_getAllBoundaries(bi, boundaries, statuses, 3, &status);
+    TEST_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
+    TEST_ASSERT(count == numExpected);
+    TEST_ASSERT(boundaries[2] == expected[2]);
+    TEST_ASSERT(boundaries[3] == -1);
+
+    status = U_ZERO_ERROR;
+    ubrk_getAllBoundaries(bi, NULL, NULL, 5, &status);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+
+    /* A text this short is segmented on the calling thread. */
+    status = U_ZERO_ERROR;
+    memset(boundaries, -1, sizeof(boundaries));
+    memset(statuses, -1, sizeof(statuses));
+    count = ubrk_getAllBoundariesParallel(bi, boundaries, statuses, UPRV_LENGTHOF(boundaries), 4,
+                                          NULL, NULL, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(count == numExpected);
+    for (i = 0; i < numExpected; ++i) {
+        TEST_ASSERT(boundaries[i] == expected[i]);
+        TEST_ASSERT(statuses[i] == expectedStatus[i]);
+    }
+    ubrk_getAllBoundariesParallel(NULL, boundaries, NULL, UPRV_LENGTHOF(boundaries), 4, NULL, NULL, &status);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+
+    ubrk_close(bi);
+}
+
+/*
+ *  static void TestBreakIteratorAcquire(void);
+ *
+ *         Test that ubrk_acquire() reuses break iterators returned with ubrk_release().
+ */
+static void TestBreakIteratorAcquire(void) {
+    UChar           testString[40];
+    int32_t         expected[40];
+    int32_t         numExpected = 0;
+    int32_t         i, pos;
+    UErrorCode      status = U_ZERO_ERROR;
+    UBreakIterator *bi, *bi2, *fresh;
+
+    u_uastrncpy(testString, "Hello, world! It's 12.5 degrees.", UPRV_LENGTHOF(testString));
+    fresh = ubrk_open(UBRK_WORD, "en", testString, -1, &status);
+    if (U_FAILURE(status)) {
+        log_data_err("ubrk_open(UBRK_WORD) failed - %s (Are you missing data?)\n", u_errorName(status));
+        return;
+    }
+    for (pos = ubrk_first(fresh); pos != UBRK_DONE; pos = ubrk_next(fresh)) {
+        expected[numExpected++] = pos;
+    }
+    ubrk_close(fresh);
+
+    bi = ubrk_acquire(UBRK_WORD, "en", testString, -1, &status);
+    TEST_ASSERT_SUCCESS(status);
+    if (bi == NULL) {
+        return;
+    }
+    ubrk_following(bi, 10);
+    ubrk_release(bi);
+
+    /* The released iterator is reused, starting from the beginning of the new text. */
+    bi2 = ubrk_acquire(UBRK_WORD, "en", testString, -1, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(bi2 == bi);
+    if (bi2 == NULL) {
+        return;
+    }
+    TEST_ASSERT(ubrk_current(bi2) == 0);
+    for (i = 0; i < numExpected; ++i) {
+        TEST_ASSERT((i == 0 ? ubrk_first(bi2) : ubrk_next(bi2)) == expected[i]);
+    }
+    TEST_ASSERT(ubrk_next(bi2) == UBRK_DONE);
+    ubrk_release(bi2);
+
+    /* Without text, and with an error already set. */
+    bi = ubrk_acquire(UBRK_LINE, "en", NULL, 0, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(bi != NULL && ubrk_first(bi) == 0 && ubrk_next(bi) == UBRK_DONE);
+    ubrk_close(bi);
+    status = U_ILLEGAL_ARGUMENT_ERROR;
+    TEST_ASSERT(ubrk_acquire(UBRK_WORD, "en", testString, -1, &status) == NULL);
+    ubrk_release(NULL);
+}
+
+
 /*
  *  static void TestBreakIteratorUText(void);
  *
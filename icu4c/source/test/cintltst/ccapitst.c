@@ -69,6 +69,7 @@ static void TestEBCDICSwapLFNL(void);
 static void TestConvertEx(void);
 static void TestConvertExFromUTF8(void);
 static void TestConvertExFromUTF8_C5F0(void);
+static void TestConvertExMBCSUTF8(void);
 static void TestConvertAlgorithmic(void);
        void TestDefaultConverterError(void);    /* defined in cctest.c */
        void TestDefaultConverterSet(void);    /* defined in cctest.c */
@@ -80,6 +81,8 @@ static void TestSubstString(void);
 static void InvalidArguments(void);
 static void TestGetName(void);
 static void TestUTFBOM(void);
+static void TestToUCharsInChunks(void);
+static void TestAcquireRelease(void);
 
 void addTestConvert(TestNode** root);
 
@@ -104,6 +107,7 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestConvertEx,               "tsconv/ccapitst/TestConvertEx");
     addTest(root, &TestConvertExFromUTF8,       "tsconv/ccapitst/TestConvertExFromUTF8");
     addTest(root, &TestConvertExFromUTF8_C5F0,  "tsconv/ccapitst/TestConvertExFromUTF8_C5F0");
+    addTest(root, &TestConvertExMBCSUTF8,       "tsconv/ccapitst/TestConvertExMBCSUTF8");
     addTest(root, &TestConvertAlgorithmic,      "tsconv/ccapitst/TestConvertAlgorithmic");
     addTest(root, &TestDefaultConverterError,   "tsconv/ccapitst/TestDefaultConverterError");
     addTest(root, &TestDefaultConverterSet,     "tsconv/ccapitst/TestDefaultConverterSet");
@@ -117,6 +121,8 @@ void addTestConvert(TestNode** root)
     addTest(root, &InvalidArguments,            "tsconv/ccapitst/InvalidArguments");
     addTest(root, &TestGetName,                 "tsconv/ccapitst/TestGetName");
     addTest(root, &TestUTFBOM,                  "tsconv/ccapitst/TestUTFBOM");
+    addTest(root, &TestToUCharsInChunks,        "tsconv/ccapitst/TestToUCharsInChunks");
+    addTest(root, &TestAcquireRelease,          "tsconv/ccapitst/TestAcquireRelease");
 }
 
 static void ListNames(void) {
@@ -1169,6 +1175,9 @@ static void TestAlias() {
         { "UTF-32",   "ucs-4" }
     };
     int32_t CONVERTERS_NAMES_LENGTH = UPRV_LENGTHOF(CONVERTERS_NAMES);
+    const char *NOT_ALIASES[] =
+        { "UTF-88", "utf", "ibm-99999", "x", "-", "shift_jis7", "no such converter" };
+    int32_t NOT_ALIASES_LENGTH = UPRV_LENGTHOF(NOT_ALIASES);
 
     /* When there are bugs in gencnval or in ucnv_io, converters can
        appear to have no aliases. */
@@ -1305,6 +1314,15 @@ static void TestAlias() {
         }
     }
 
+    /* Names that are not aliases must not be found, whether by hash or by binary search. */
+    for (i = 0; i < NOT_ALIASES_LENGTH; ++i) {
+        const char* mapBack;
+        status = U_ZERO_ERROR;
+        mapBack = ucnv_getAlias(NOT_ALIASES[i], 0, &status);
+        if (mapBack != NULL) {
+            log_err("FAIL: \"%s\" -> \"%s\", expect NULL\n", NOT_ALIASES[i], mapBack);
+        }
+    }
 }
 
 static void TestDuplicateAlias(void) {
@@ -2636,6 +2654,8 @@ static void TestConvertExFromUTF8() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
         "windows-1252",
         "shift-jis",
+        "euc-jp",
+        "gb18030",
 #endif
         "us-ascii",
         "iso-8859-1",
@@ -2759,6 +2779,91 @@ static void TestConvertExFromUTF8_C5F0() {
     ucnv_close(utf8Cnv);
 }
 
+/*
+ * Direct conversion between UTF-8 and multi-byte charsets must yield
+ * the same results as converting through UTF-16.
+ */
+static void TestConvertExMBCSUTF8() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const char *const converterNames[]={
+        "shift-jis",
+        "euc-jp",
+        "gb18030",
+        "big5",
+        "ibm-930"
+    };
+    /* ASCII, Kana, Han (also JIS X 0212), Cyrillic, Thai, halfwidth Katakana, supplementary, PUA */
+    static const UChar text[]={
+        0x61, 0x62, 0x3042, 0x4e00, 0x20, 0x451, 0x452, 0x4e02, 0xe01, 0xff61,
+        0xd840, 0xdc0b, 0x31, 0xe000, 0x6f22, 0x5b57, 0xa, 0x10a0, 0xd800, 0xdf00, 0x7a
+    };
+    /* lead bytes without trail bytes and other bytes that are illegal in some of the charsets */
+    static const char badBytes[]={ (char)0x81, 0x20, (char)0xff, 0x41, (char)0x8e, (char)0xa1, 0x0e, (char)0x80 };
+
+    char utf8[200], bytes[200], expected[300];
+    UChar utf16[200];
+    int32_t utf8Length, bytesLength, expectedLength, utf16Length;
+
+    UConverter *utf8Cnv, *cnv;
+    UErrorCode errorCode;
+    int32_t i, fallback;
+
+    errorCode=U_ZERO_ERROR;
+    utf8Cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to open UTF-8 converter - %s\n", u_errorName(errorCode));
+        return;
+    }
+    u_strToUTF8(utf8, UPRV_LENGTHOF(utf8), &utf8Length, text, UPRV_LENGTHOF(text), &errorCode);
+
+    for(i=0; i<UPRV_LENGTHOF(converterNames); ++i) {
+        errorCode=U_ZERO_ERROR;
+        cnv=ucnv_open(converterNames[i], &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s converter - %s\n", converterNames[i], u_errorName(errorCode));
+            continue;
+        }
+        for(fallback=0; fallback<=1; ++fallback) {
+            ucnv_setFallback(cnv, (UBool)fallback);
+
+            /* UTF-8 -> charset */
+            bytesLength=ucnv_fromUChars(cnv, bytes, UPRV_LENGTHOF(bytes), text, UPRV_LENGTHOF(text), &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("ucnv_fromUChars(%s) failed - %s\n", converterNames[i], u_errorName(errorCode));
+                break;
+            }
+            convertExMultiStreaming(utf8Cnv, cnv,
+                                    utf8, utf8Length, bytes, bytesLength,
+                                    converterNames[i], U_ZERO_ERROR);
+            convertExStreaming(utf8Cnv, cnv,
+                               utf8, utf8Length, bytes, bytesLength,
+                               CHUNK_SIZE, converterNames[i], U_ZERO_ERROR);
+
+            /* charset -> UTF-8, with some bad bytes in the middle and at the end */
+            uprv_memcpy(bytes+bytesLength, badBytes, sizeof(badBytes));
+            uprv_memcpy(bytes+bytesLength+sizeof(badBytes), bytes, bytesLength);
+            bytesLength=2*bytesLength+(int32_t)sizeof(badBytes);
+            uprv_memcpy(bytes+bytesLength, badBytes, sizeof(badBytes));
+            bytesLength+=(int32_t)sizeof(badBytes)-1;
+            utf16Length=ucnv_toUChars(cnv, utf16, UPRV_LENGTHOF(utf16), bytes, bytesLength, &errorCode);
+            u_strToUTF8(expected, UPRV_LENGTHOF(expected), &expectedLength, utf16, utf16Length, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("ucnv_toUChars(%s) failed - %s\n", converterNames[i], u_errorName(errorCode));
+                break;
+            }
+            convertExMultiStreaming(cnv, utf8Cnv,
+                                    bytes, bytesLength, expected, expectedLength,
+                                    converterNames[i], U_ZERO_ERROR);
+            convertExStreaming(cnv, utf8Cnv,
+                               bytes, bytesLength, expected, expectedLength,
+                               CHUNK_SIZE, converterNames[i], U_ZERO_ERROR);
+        }
+        ucnv_close(cnv);
+    }
+    ucnv_close(utf8Cnv);
+#endif
+}
+
 static void
 TestConvertAlgorithmic() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
@@ -3738,3 +3843,291 @@ static void TestUTFBOM() {
         ucnv_close(cnv);
     }
 }
+
+/* runs the tasks backward, to make sure that they do not depend on each other */
+static void U_CALLCONV
+runChunksBackward(const void *context, UConverterChunkTask *task, void *taskContext,
+                  int32_t count) {
+    int32_t *pCount = (int32_t *)context;
+    while(count > 0) {
+        task(taskContext, --count);
+        ++*pCount;
+    }
+}
+
+static void TestToUCharsInChunks() {
+    static const char *const names[] = {
+        "UTF-8", "UTF-16BE", "UTF-16LE", "UTF-32BE", "UTF-32LE", "ISO-8859-1", "US-ASCII",
+#if !UCONFIG_NO_LEGACY_CONVERSION
+        "windows-1252", "Shift_JIS", "GB18030", "EUC-JP", "Big5", "ISO-2022-JP"
+#endif
+    };
+    static const UChar pieces[][8] = {
+        { 0x53, 0x6f, 0x6d, 0x65, 0x20, 0x74, 0x65, 0x78 },  /* Some tex */
+        { 0x74, 0x2c, 0x20, 0 },
+        { 0x65e5, 0x672c, 0x8a9e, 0x30c6, 0x30ad, 0x30b9, 0x30c8, 0 },
+        { 0x0a, 0 },
+        { 0x4e2d, 0x6587, 0x3002, 0 },
+        { 0xd842, 0xdf9f, 0x20, 0xe9, 0x3b, 0 },
+        { 0x31, 0x32, 0x33, 0x0d, 0x0a, 0 }
+    };
+    static const int32_t maxChunks[] = { 1, 2, 3, 7, 16, 40 };
+    /* large enough for ucnv_toUCharsInChunks() to convert directly into actual[] */
+    static UChar text[6000], expected[30000], actual[30000];
+    static int32_t expectedOffsets[30000], actualOffsets[30000];
+    static char bytes[20000];
+    int32_t limits[40];
+    int32_t textLength = 0, i, j, k;
+
+    /* a long text with characters from a few scripts */
+    for(i = 0; textLength < 5000; ++i) {
+        const UChar *piece = pieces[(i * 5 + i / 7) % UPRV_LENGTHOF(pieces)];
+        for(j = 0; j < 8 && piece[j] != 0; ++j) {
+            text[textLength++] = piece[j];
+        }
+    }
+
+    for(i = 0; i < UPRV_LENGTHOF(names); ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UConverter *cnv = ucnv_open(names[i], &errorCode);
+        int32_t length, variant;
+        if(U_FAILURE(errorCode)) {
+            log_data_err("ucnv_open(%s) failed - %s\n", names[i], u_errorName(errorCode));
+            continue;
+        }
+        length = ucnv_fromUChars(cnv, bytes, (int32_t)sizeof(bytes), text, textLength, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("ucnv_fromUChars(%s) failed - %s\n", names[i], u_errorName(errorCode));
+            ucnv_close(cnv);
+            continue;
+        }
+        /*
+         * variant 1: with some illegal bytes
+         * variant 2: with many illegal bytes, escaped into longer output
+         */
+        for(variant = 0; variant <= 2; ++variant) {
+            const char *src = bytes;
+            UChar *target = expected;
+            int32_t expectedLength;
+            if(variant == 2 && strncmp(names[i], "UTF-32", 6) == 0) {
+                break;  /* escapes would not fit into expected[] */
+            }
+            if(variant >= 1) {
+                for(j = 13; j < length; j += variant == 1 ? 97 : 5) {
+                    bytes[j] = (char)0x81;
+                }
+            }
+            if(variant == 2) {
+                ucnv_setToUCallBack(cnv, UCNV_TO_U_CALLBACK_ESCAPE, NULL, NULL, NULL, &errorCode);
+            }
+            ucnv_resetToUnicode(cnv);
+            ucnv_toUnicode(cnv, &target, expected + UPRV_LENGTHOF(expected), &src, bytes + length,
+                           expectedOffsets, TRUE, &errorCode);
+            expectedLength = (int32_t)(target - expected);
+            if(U_FAILURE(errorCode)) {
+                log_err("ucnv_toUnicode(%s) failed - %s\n", names[i], u_errorName(errorCode));
+                break;
+            }
+            for(j = 0; j < UPRV_LENGTHOF(maxChunks); ++j) {
+                int32_t count, runs = 0, actualLength;
+                count = ucnv_getToUChunkLimits(cnv, bytes, length, maxChunks[j], limits, &errorCode);
+                if(U_FAILURE(errorCode) || count < 1 || count > maxChunks[j] ||
+                        limits[count - 1] != length) {
+                    log_err("ucnv_getToUChunkLimits(%s, %d) failed - %s\n",
+                            names[i], (int)maxChunks[j], u_errorName(errorCode));
+                    errorCode = U_ZERO_ERROR;
+                    continue;
+                }
+                if(maxChunks[j] >= 7 && strcmp(names[i], "ISO-2022-JP") != 0 && count < 3) {
+                    log_err("ucnv_getToUChunkLimits(%s, %d) returned only %d chunks\n",
+                            names[i], (int)maxChunks[j], (int)count);
+                }
+                if(strcmp(names[i], "ISO-2022-JP") == 0 && count != 1) {
+                    log_err("ucnv_getToUChunkLimits(ISO-2022-JP) split a stateful encoding\n");
+                }
+                actualLength = ucnv_toUCharsInChunks(cnv, actual, UPRV_LENGTHOF(actual), actualOffsets,
+                                                     bytes, length, maxChunks[j],
+                                                     runChunksBackward, &runs, &errorCode);
+                if(U_FAILURE(errorCode) || actualLength != expectedLength ||
+                        0 != memcmp(actual, expected, expectedLength * U_SIZEOF_UCHAR)) {
+                    log_err("ucnv_toUCharsInChunks(%s, variant %d, %d chunks) differs from ucnv_toUnicode() - %s\n",
+                            names[i], (int)variant, (int)count, u_errorName(errorCode));
+                    errorCode = U_ZERO_ERROR;
+                    continue;
+                }
+                for(k = 0; k < actualLength; ++k) {
+                    if(actualOffsets[k] != expectedOffsets[k]) {
+                        log_err("ucnv_toUCharsInChunks(%s, variant %d, %d chunks) offsets[%d]=%d != %d\n",
+                                names[i], (int)variant, (int)count,
+                                (int)k, (int)actualOffsets[k], (int)expectedOffsets[k]);
+                        break;
+                    }
+                }
+                if(runs != (count > 1 ? count : 0)) {
+                    log_err("ucnv_toUCharsInChunks(%s) ran %d tasks for %d chunks\n",
+                            names[i], (int)runs, (int)count);
+                }
+            }
+        }
+
+        /* preflighting and no runner */
+        errorCode = U_ZERO_ERROR;
+        length = ucnv_toUCharsInChunks(cnv, NULL, 0, NULL, bytes, length, 5, NULL, NULL, &errorCode);
+        if(errorCode != U_BUFFER_OVERFLOW_ERROR || length <= 0) {
+            log_err("ucnv_toUCharsInChunks(%s) preflighting failed - %s\n",
+                    names[i], u_errorName(errorCode));
+        }
+        ucnv_close(cnv);
+    }
+
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    /* a single-byte charset with two-byte extension mappings: do not split after ESC */
+    {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        UConverter *cnv = ucnv_open("gsm-03.38-2009", &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("ucnv_open(gsm-03.38-2009) failed - %s\n", u_errorName(errorCode));
+            return;
+        }
+        for(i = 0; i < 3000; i += 3) {
+            bytes[i] = 0x61;
+            bytes[i + 1] = 0x1b;  /* ESC */
+            bytes[i + 2] = 0x3c;  /* ESC < = [ */
+        }
+        for(j = 0; j < UPRV_LENGTHOF(maxChunks); ++j) {
+            int32_t count = ucnv_getToUChunkLimits(cnv, bytes, 3000, maxChunks[j], limits, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                log_err("ucnv_getToUChunkLimits(gsm-03.38-2009, %d) failed - %s\n",
+                        (int)maxChunks[j], u_errorName(errorCode));
+                break;
+            }
+            if(maxChunks[j] >= 7 && count < 3) {
+                log_err("ucnv_getToUChunkLimits(gsm-03.38-2009, %d) returned only %d chunks\n",
+                        (int)maxChunks[j], (int)count);
+            }
+            for(k = 0; k < count; ++k) {
+                if(bytes[limits[k] - 1] == 0x1b) {
+                    log_err("ucnv_getToUChunkLimits(gsm-03.38-2009, %d) split after ESC at %d\n",
+                            (int)maxChunks[j], (int)limits[k]);
+                    break;
+                }
+            }
+        }
+        ucnv_close(cnv);
+    }
+#endif
+}
+
+static void TestAcquireRelease() {
+    static const char partial[] = { (char)0xe2, (char)0x82 };
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UConverter *cnv, *cnv2;
+    UChar buffer[8];
+    UChar *target;
+    const char *source;
+
+    /* a released converter is reset and reused for an equivalent name */
+    cnv = ucnv_acquire("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("ucnv_acquire(UTF-8) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    target = buffer;
+    source = partial;
+    ucnv_toUnicode(cnv, &target, buffer + UPRV_LENGTHOF(buffer), &source, partial + 2, NULL, FALSE, &errorCode);
+    if(U_FAILURE(errorCode) || ucnv_toUCountPending(cnv, &errorCode) != 2) {
+        log_err("ucnv_toUnicode(UTF-8, partial) did not leave 2 bytes pending - %s\n", u_errorName(errorCode));
+    }
+    ucnv_release(cnv);
+    cnv2 = ucnv_acquire("utf8", &errorCode);
+    if(U_FAILURE(errorCode) || cnv2 != cnv) {
+        log_err("ucnv_acquire(utf8) did not reuse the released UTF-8 converter - %s\n", u_errorName(errorCode));
+    } else if(ucnv_toUCountPending(cnv2, &errorCode) != 0) {
+        log_err("ucnv_acquire(utf8) returned a converter that was not reset\n");
+    }
+    ucnv_release(cnv2);
+    ucnv_release(NULL);
+
+    /* acquiring does not start with a failure code */
+    errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+    if(ucnv_acquire("UTF-8", &errorCode) != NULL || errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucnv_acquire() ignores an incoming failure code\n");
+    }
+    errorCode = U_ZERO_ERROR;
+    if(ucnv_acquire("no-such-converter", &errorCode) != NULL || errorCode != U_FILE_ACCESS_ERROR) {
+        log_err("ucnv_acquire(no-such-converter) did not fail like ucnv_open() - %s\n", u_errorName(errorCode));
+    }
+
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    /* options are part of the pool key */
+    errorCode = U_ZERO_ERROR;
+    cnv = ucnv_acquire("ibm-1047,swaplfnl", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("ucnv_acquire(ibm-1047,swaplfnl) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    ucnv_release(cnv);
+    cnv2 = ucnv_acquire("ibm-1047", &errorCode);
+    if(U_FAILURE(errorCode) || cnv2 == cnv || strstr(ucnv_getName(cnv2, &errorCode), "swaplfnl") != NULL) {
+        log_err("ucnv_acquire(ibm-1047) returned the swaplfnl converter - %s\n", u_errorName(errorCode));
+    }
+    ucnv_release(cnv2);
+    cnv2 = ucnv_acquire("IBM-1047,swaplfnl", &errorCode);
+    if(U_FAILURE(errorCode) || cnv2 != cnv) {
+        log_err("ucnv_acquire(IBM-1047,swaplfnl) did not reuse the released converter - %s\n", u_errorName(errorCode));
+    }
+    ucnv_close(cnv2);
+
+    /* LMBCS omits the locale option from its name; it must still be part of the pool key */
+    cnv = ucnv_acquire("LMBCS-1,locale=ko", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("ucnv_acquire(LMBCS-1,locale=ko) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    ucnv_release(cnv);
+    cnv2 = ucnv_acquire("LMBCS-1", &errorCode);
+    if(U_SUCCESS(errorCode)) {
+        static const UChar kanji[] = { 0x4e00 };
+        char bytes[8], expected[8];
+        int32_t length, expectedLength;
+        UConverter *plain = ucnv_open("LMBCS-1", &errorCode);
+        length = ucnv_fromUChars(cnv2, bytes, UPRV_LENGTHOF(bytes), kanji, 1, &errorCode);
+        expectedLength = ucnv_fromUChars(plain, expected, UPRV_LENGTHOF(expected), kanji, 1, &errorCode);
+        if(U_FAILURE(errorCode) || cnv2 == cnv ||
+                length != expectedLength || memcmp(bytes, expected, length) != 0) {
+            log_err("ucnv_acquire(LMBCS-1) returned the LMBCS-1,locale=ko converter - %s\n", u_errorName(errorCode));
+        }
+        ucnv_close(plain);
+    }
+    ucnv_release(cnv2);
+    cnv2 = ucnv_acquire("LMBCS-1,locale=ko", &errorCode);
+    if(U_FAILURE(errorCode) || cnv2 != cnv) {
+        log_err("ucnv_acquire(LMBCS-1,locale=ko) did not reuse the released converter - %s\n", u_errorName(errorCode));
+    }
+    ucnv_release(cnv2);
+
+    /* a converter with a modified substitution character is closed, not pooled */
+    cnv = ucnv_acquire("Shift-JIS", &errorCode);
+    ucnv_setSubstChars(cnv, "?", 1, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("ucnv_acquire(Shift-JIS) or ucnv_setSubstChars() failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    ucnv_release(cnv);
+    cnv = ucnv_acquire("Shift-JIS", &errorCode);
+    if(U_SUCCESS(errorCode)) {
+        char subChars[4];
+        int8_t length = (int8_t)sizeof(subChars);
+        ucnv_getSubstChars(cnv, subChars, &length, &errorCode);
+        if(U_FAILURE(errorCode) || length != 2) {
+            log_err("ucnv_acquire(Shift-JIS) returned a converter with a modified substitution character\n");
+        }
+    }
+    ucnv_release(cnv);
+
+    /* ucnv_flushCache() closes the pooled converters and then unloads their data */
+    if(ucnv_flushCache() <= 0) {
+        log_err("ucnv_flushCache() did not unload the data of pooled converters\n");
+    }
+#endif
+}
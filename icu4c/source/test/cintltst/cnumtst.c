@@ -31,6 +31,7 @@
 #include "unicode/unumsys.h"
 #include "unicode/ustring.h"
 #include "unicode/udisplaycontext.h"
+#include "unicode/ucache.h"
 
 #include "cintltst.h"
 #include "cnumtst.h"
@@ -66,6 +67,7 @@ static void TestParseCurrPatternWithDecStyle(void);
 static void TestFormatForFields(void);
 static void TestRBNFRounding(void);
 static void Test12052_NullPointer(void);
+static void TestCacheStatistics(void);
 
 #define TESTCASE(x) addTest(root, &x, "tsformat/cnumtst/" #x)
 
@@ -99,6 +101,7 @@ void addNumForTest(TestNode** root)
     TESTCASE(TestParseCurrPatternWithDecStyle);
     TESTCASE(TestFormatForFields);
     TESTCASE(Test12052_NullPointer);
+    TESTCASE(TestCacheStatistics);
 }
 
 /* test Parse int 64 */
@@ -3079,4 +3082,44 @@ static void Test12052_NullPointer() {
     unum_close(theFormatter);
 }
 
+static void TestCacheStatistics() {
+    UErrorCode status = U_ZERO_ERROR;
+    UCacheStatistics stats[50];
+    int32_t i, count;
+    int64_t hits = 0, misses = 0;
+    UNumberFormat *nf;
+
+    ucache_setStatisticsEnabled(TRUE, &status);
+    if (!assertSuccess("ucache_setStatisticsEnabled()", &status)) { return; }
+    /* Decimal formats share their data through the cache. */
+    for (i = 0; i < 2; ++i) {
+        nf = unum_open(UNUM_DECIMAL, NULL, 0, "de_CH", NULL, &status);
+        unum_close(nf);
+    }
+    if (!assertSuccessCheck("unum_open()", &status, TRUE)) {
+        ucache_setStatisticsEnabled(FALSE, &status);
+        return;
+    }
+
+    count = ucache_getStatistics(NULL, 0, &status);
+    assertIntEquals("ucache_getStatistics(preflight) status", U_BUFFER_OVERFLOW_ERROR, status);
+    assertTrue("ucache_getStatistics(preflight) > 0", count > 0);
+    status = U_ZERO_ERROR;
+    count = ucache_getStatistics(stats, UPRV_LENGTHOF(stats), &status);
+    if (!assertSuccess("ucache_getStatistics()", &status)) { return; }
+    for (i = 0; i < count; ++i) {
+        assertTrue("keyType != NULL", stats[i].keyType != NULL);
+        hits += stats[i].hits;
+        misses += stats[i].misses;
+    }
+    assertTrue("cache hits", hits > 0);
+    assertTrue("cache lookups", hits + misses >= 2);
+
+    ucache_getStatistics(NULL, -1, &status);
+    assertIntEquals("ucache_getStatistics(capacity<0)", U_ILLEGAL_ARGUMENT_ERROR, status);
+    status = U_ZERO_ERROR;
+    ucache_setStatisticsEnabled(FALSE, &status);
+    assertSuccess("ucache_setStatisticsEnabled(FALSE)", &status);
+}
+
 #endif /* #if !UCONFIG_NO_FORMATTING */
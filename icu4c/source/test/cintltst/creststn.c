@@ -223,6 +223,7 @@ void addNEWResourceBundleTest(TestNode** root)
     addTest(root, &TestGetFunctionalEquivalent,"tsutil/creststn/TestGetFunctionalEquivalent");
     addTest(root, &TestJB3763,                "tsutil/creststn/TestJB3763");
     addTest(root, &TestStackReuse,            "tsutil/creststn/TestStackReuse");
+    addTest(root, &TestRepeatedOpen,          "tsutil/creststn/TestRepeatedOpen");
 }
 
 
@@ -2860,6 +2861,57 @@ static void TestStackReuse(void) {
     ures_close(&table);
 }
 
+/*
+ * Repeated opens of the same locale are answered from a cache;
+ * they must give the same bundle and status as the first open,
+ * except that a fallback to the default locale must follow uloc_setDefault().
+ */
+static void TestRepeatedOpen(void) {
+    static const struct {
+        const char *locale;
+        const char *defaultLocale;
+        const char *expectedLocale;
+        UErrorCode expectedStatus;
+    } testCases[] = {
+        { "de_CH", "en_US", "de_CH", U_ZERO_ERROR },
+        { "de_CH", "fr", "de_CH", U_ZERO_ERROR },
+        { "de_CH_XX", "en_US", "de_CH", U_USING_FALLBACK_WARNING },
+        { "de_CH_XX", "fr", "de_CH", U_USING_FALLBACK_WARNING },
+        { "xx_YY", "de", "de", U_USING_DEFAULT_WARNING },
+        { "xx_YY", "fr", "fr", U_USING_DEFAULT_WARNING },
+        { "xx_YY", "de", "de", U_USING_DEFAULT_WARNING }
+    };
+    char originalDefault[ULOC_FULLNAME_CAPACITY];
+    int32_t i, j;
+
+    uprv_strcpy(originalDefault, uloc_getDefault());
+    for (i = 0; i < UPRV_LENGTHOF(testCases); ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        uloc_setDefault(testCases[i].defaultLocale, &status);
+        for (j = 0; j < 3 && U_SUCCESS(status); ++j) {
+            UResourceBundle *rb = ures_open(NULL, testCases[i].locale, &status);
+            const char *actual = ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &status);
+            if (U_FAILURE(status)) {
+                log_data_err("ures_open(%s) failed - %s\n", testCases[i].locale, u_errorName(status));
+            } else if (status != testCases[i].expectedStatus ||
+                    uprv_strcmp(actual, testCases[i].expectedLocale) != 0) {
+                log_err("ures_open(%s) with default locale %s, attempt %d: got %s/%s, expected %s/%s\n",
+                        testCases[i].locale, testCases[i].defaultLocale, (int)j,
+                        actual, u_errorName(status),
+                        testCases[i].expectedLocale, u_errorName(testCases[i].expectedStatus));
+            }
+            ures_close(rb);
+            if (U_SUCCESS(status)) {
+                status = U_ZERO_ERROR;
+            }
+        }
+    }
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        uloc_setDefault(originalDefault, &status);
+    }
+}
+
 /* Test ures_getUTF8StringXYZ() --------------------------------------------- */
 
 /*
@@ -3025,6 +3077,26 @@ TestGetUTF8String() {
         log_err("ures_getUTF8StringByKey(dest=NULL capacity>0) malfunctioned - %s\n", u_errorName(status));
     }
 
+    /*
+     * The test data is built with genrb --writeUTF8Strings,
+     * so a read-only pointer to the stored UTF-8 string is returned even without a buffer.
+     */
+    status = U_ZERO_ERROR;
+    length8 = 0;
+    s8 = ures_getUTF8StringByKey(res, "string_only_in_Root", NULL, &length8, FALSE, &status);
+    if(status != U_ZERO_ERROR || s8 == NULL || length8 != 4 ||
+            uprv_strcmp(s8, "ROOT") != 0) {
+        log_err("ures_getUTF8StringByKey(stored UTF-8, no buffer) malfunctioned - %s\n", u_errorName(status));
+    }
+
+    /* forceCopy=TRUE still needs a buffer that fits */
+    status = U_ZERO_ERROR;
+    length8 = 2;
+    s8 = ures_getUTF8StringByKey(res, "string_only_in_Root", buffer8, &length8, TRUE, &status);
+    if(status != U_BUFFER_OVERFLOW_ERROR || length8 != 4) {
+        log_err("ures_getUTF8StringByKey(stored UTF-8, forceCopy, overflow) malfunctioned - %s\n", u_errorName(status));
+    }
+
     ures_close(res);
 }
 
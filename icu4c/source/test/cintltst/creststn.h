@@ -83,6 +83,8 @@ static void TestXPath(void);
 
 static void TestStackReuse(void);
 
+static void TestRepeatedOpen(void);
+
 /**
 * extensive subtests called by TestResourceBundles
 **/
@@ -38,6 +38,8 @@ static void Test_strFromUTF32_surrogates(void);
 static void Test_UChar_UTF8_API(void);
 static void Test_FromUTF8(void);
 static void Test_FromUTF8Lenient(void);
+static void Test_UTFRuns(void);
+static void Test_validateUTF8(void);
 static void Test_UChar_WCHART_API(void);
 static void Test_widestrs(void);
 static void Test_WCHART_LongString(void);
@@ -55,6 +57,8 @@ addUCharTransformTest(TestNode** root)
    addTest(root, &Test_UChar_UTF8_API, "custrtrn/Test_UChar_UTF8_API");
    addTest(root, &Test_FromUTF8, "custrtrn/Test_FromUTF8");
    addTest(root, &Test_FromUTF8Lenient, "custrtrn/Test_FromUTF8Lenient");
+   addTest(root, &Test_UTFRuns, "custrtrn/Test_UTFRuns");
+   addTest(root, &Test_validateUTF8, "custrtrn/Test_validateUTF8");
    addTest(root, &Test_UChar_WCHART_API,  "custrtrn/Test_UChar_WCHART_API");
    addTest(root, &Test_widestrs,  "custrtrn/Test_widestrs");
 #if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
@@ -1133,6 +1137,222 @@ Test_FromUTF8Lenient(void) {
     }
 }
 
+/*
+ * Pieces for Test_UTFRuns(): runs of ASCII, 2-byte, 3-byte and 4-byte characters,
+ * with occasional ill-formed sequences, so that the fast conversion loops
+ * see whole blocks of each kind as well as blocks that mix them.
+ */
+static const char *const utf8RunPieces[]={
+    "a", "a", "a", "\xc3\xa9", "\xd0\x96", "\xd0\x96", "\xe4\xb8\xad", "\xf0\x9f\x98\x80",
+    "\x80", "\xc0\xaf", "\xe4\xb8", "\xed\xa0\x80"
+};
+
+static const UChar utf16RunPieces[][2]={
+    { 0x61, 0 }, { 0x61, 0 }, { 0x61, 0 }, { 0xe9, 0 }, { 0x416, 0 }, { 0x7ff, 0 },
+    { 0x4e2d, 0 }, { 0xd83d, 0xde00 }, { 0xd800, 0 }, { 0xdc00, 0 }
+};
+
+/* Simple pseudo-random numbers, for reproducible test strings. */
+static uint32_t
+nextRandom(uint32_t *pSeed) {
+    *pSeed=*pSeed*1103515245+12345;
+    return (*pSeed>>16)&0x7fff;
+}
+
+/* test that the block conversion in u_strFromUTF8WithSub() and u_strToUTF8WithSub() matches U8_NEXT()/U16_NEXT() */
+static void
+Test_UTFRuns(void) {
+    char s8[600], expected8[1200], dest8[1200];
+    UChar s16[300], expected16[600], dest16[600];
+    uint32_t seed=1;
+    int32_t n;
+
+    for(n=0; n<400; ++n) {
+        int32_t length8=0, length16=0, expectedLength, expectedSubs, i;
+        int32_t destLength, numSubs, capacity;
+        UErrorCode errorCode;
+        UChar32 c;
+
+        /* Build strings from runs of 1..40 copies of a piece. */
+        while(length8<(int32_t)sizeof(s8)-200 && length16<UPRV_LENGTHOF(s16)-100) {
+            int32_t piece8=nextRandom(&seed)%UPRV_LENGTHOF(utf8RunPieces);
+            int32_t piece16=nextRandom(&seed)%UPRV_LENGTHOF(utf16RunPieces);
+            int32_t count=1+nextRandom(&seed)%40;
+            if(piece8>=8 && count>2) {
+                count=1;  /* ill-formed sequences are rare */
+            }
+            if(piece16>=8 && count>2) {
+                count=1;
+            }
+            while(count-->0) {
+                const char *p=utf8RunPieces[piece8];
+                while(*p!=0) {
+                    s8[length8++]=*p++;
+                }
+                s16[length16++]=utf16RunPieces[piece16][0];
+                if(utf16RunPieces[piece16][1]!=0) {
+                    s16[length16++]=utf16RunPieces[piece16][1];
+                }
+            }
+            if(nextRandom(&seed)%4==0) {
+                break;
+            }
+        }
+
+        /* UTF-8 to UTF-16 */
+        expectedLength=expectedSubs=0;
+        for(i=0; i<length8;) {
+            U8_NEXT(s8, i, length8, c);
+            if(c<0) {
+                c=0xfffd;
+                ++expectedSubs;
+            }
+            U16_APPEND_UNSAFE(expected16, expectedLength, c);
+        }
+        for(capacity=expectedLength; capacity>=expectedLength-1 && capacity>=0; --capacity) {
+            errorCode=U_ZERO_ERROR;
+            u_strFromUTF8WithSub(dest16, capacity, &destLength, s8, length8,
+                                 0xfffd, &numSubs, &errorCode);
+            if(destLength!=expectedLength || numSubs!=expectedSubs ||
+                    (capacity==expectedLength ?
+                        errorCode!=U_STRING_NOT_TERMINATED_WARNING ||
+                        0!=memcmp(dest16, expected16, expectedLength*U_SIZEOF_UCHAR) :
+                        errorCode!=U_BUFFER_OVERFLOW_ERROR)) {
+                log_err("u_strFromUTF8WithSub(string %ld, capacity %ld) differs from U8_NEXT(): "
+                        "length %ld (expected %ld), substitutions %ld (expected %ld) - %s\n",
+                        (long)n, (long)capacity, (long)destLength, (long)expectedLength,
+                        (long)numSubs, (long)expectedSubs, u_errorName(errorCode));
+            }
+        }
+
+        /* UTF-16 to UTF-8 */
+        expectedLength=expectedSubs=0;
+        for(i=0; i<length16;) {
+            U16_NEXT(s16, i, length16, c);
+            if(U_IS_SURROGATE(c)) {
+                c=0xfffd;
+                ++expectedSubs;
+            }
+            U8_APPEND_UNSAFE(expected8, expectedLength, c);
+        }
+        for(capacity=expectedLength; capacity>=expectedLength-1 && capacity>=0; --capacity) {
+            errorCode=U_ZERO_ERROR;
+            u_strToUTF8WithSub(dest8, capacity, &destLength, s16, length16,
+                               0xfffd, &numSubs, &errorCode);
+            if(destLength!=expectedLength || numSubs!=expectedSubs ||
+                    (capacity==expectedLength ?
+                        errorCode!=U_STRING_NOT_TERMINATED_WARNING ||
+                        0!=memcmp(dest8, expected8, expectedLength) :
+                        errorCode!=U_BUFFER_OVERFLOW_ERROR)) {
+                log_err("u_strToUTF8WithSub(string %ld, capacity %ld) differs from U16_NEXT(): "
+                        "length %ld (expected %ld), substitutions %ld (expected %ld) - %s\n",
+                        (long)n, (long)capacity, (long)destLength, (long)expectedLength,
+                        (long)numSubs, (long)expectedSubs, u_errorName(errorCode));
+            }
+        }
+    }
+}
+
+/* test u_validateUTF8() and u_countUTF8CodePoints() against U8_NEXT() */
+static void
+Test_validateUTF8(void) {
+    static const struct {
+        const char *s;
+        int32_t errorIndex, utf16Length, numCodePoints;
+    } cases[]={
+        { "", -1, 0, 0 },
+        { "abc\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80", -1, 7, 6 },
+        { "abcdefghijklmnopqrstuvwxyz0123456789", -1, 36, 36 },
+        { "abcdefghijklmnopqrstuvwxyz\xc0\xaf", 26, 26, 28 },
+        { "abcdefghijklmnopqrstuvwxyz\xe0\x9f\x80", 26, 26, 29 },
+        { "abcdefghijklmnopqrstuvwxyz\xed\xa0\x80", 26, 26, 29 },
+        { "abcdefghijklmnopqrstuvwxyz\xf4\x90\x80\x80", 26, 26, 30 },
+        { "abcdefghijklm\xe4\xb8\xad", -1, 14, 14 },
+        { "abcdefghijklmn\xe4\xb8\xadxyz", -1, 18, 18 },
+        { "abcdefghijklmn\xe4\xb8xyz", 14, 14, 18 },
+        { "abcdefghijklm\xf0\x9f\x98\x80", -1, 15, 14 },
+        { "abcdefghijklmnopqrstuvwxyz\x80", 26, 26, 27 }
+    };
+    char s8[600];
+    uint32_t seed=7;
+    int32_t i, n;
+
+    for(i=0; i<UPRV_LENGTHOF(cases); ++i) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        int32_t utf16Length=-99;
+        int32_t errorIndex=u_validateUTF8(cases[i].s, -1, &utf16Length, &errorCode);
+        int32_t numCodePoints=u_countUTF8CodePoints(cases[i].s, (int32_t)strlen(cases[i].s));
+        if(U_FAILURE(errorCode) || errorIndex!=cases[i].errorIndex ||
+                utf16Length!=cases[i].utf16Length || numCodePoints!=cases[i].numCodePoints) {
+            log_err("u_validateUTF8(cases[%ld]) = %ld, UTF-16 length %ld, %ld code points - %s\n",
+                    (long)i, (long)errorIndex, (long)utf16Length, (long)numCodePoints,
+                    u_errorName(errorCode));
+        }
+    }
+
+    for(n=0; n<400; ++n) {
+        int32_t length=0, expectedErrorIndex=-1, expectedUTF16Length=0, expectedCount=0;
+        int32_t errorIndex, utf16Length, numCodePoints;
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UChar32 c;
+
+        /* Mostly well-formed strings, so that errors are found in all positions. */
+        while(length<(int32_t)sizeof(s8)-200) {
+            int32_t piece=nextRandom(&seed)%UPRV_LENGTHOF(utf8RunPieces);
+            int32_t count=1+nextRandom(&seed)%40;
+            if(piece>=8 && nextRandom(&seed)%8!=0) {
+                continue;
+            } else if(piece>=8) {
+                count=1;
+            }
+            while(count-->0) {
+                const char *p=utf8RunPieces[piece];
+                while(*p!=0) {
+                    s8[length++]=*p++;
+                }
+            }
+            if(nextRandom(&seed)%4==0) {
+                break;
+            }
+        }
+
+        for(i=0; i<length;) {
+            int32_t start=i;
+            U8_NEXT(s8, i, length, c);
+            ++expectedCount;
+            if(c<0) {
+                if(expectedErrorIndex<0) {
+                    expectedErrorIndex=start;
+                }
+            } else if(expectedErrorIndex<0) {
+                expectedUTF16Length+=U16_LENGTH(c);
+            }
+        }
+
+        errorIndex=u_validateUTF8(s8, length, &utf16Length, &errorCode);
+        numCodePoints=u_countUTF8CodePoints(s8, length);
+        if(U_FAILURE(errorCode) || errorIndex!=expectedErrorIndex ||
+                utf16Length!=expectedUTF16Length || numCodePoints!=expectedCount) {
+            log_err("u_validateUTF8(string %ld) = %ld (expected %ld), UTF-16 length %ld (expected %ld), "
+                    "%ld code points (expected %ld) - %s\n",
+                    (long)n, (long)errorIndex, (long)expectedErrorIndex,
+                    (long)utf16Length, (long)expectedUTF16Length,
+                    (long)numCodePoints, (long)expectedCount, u_errorName(errorCode));
+        }
+    }
+
+    {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        u_validateUTF8(NULL, 3, NULL, &errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("u_validateUTF8(NULL, 3) did not fail - %s\n", u_errorName(errorCode));
+        }
+        if(u_countUTF8CodePoints(NULL, 0)!=0) {
+            log_err("u_countUTF8CodePoints(NULL, 0)!=0\n");
+        }
+    }
+}
+
 static const uint16_t src16j[] = {
     0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 0x0048, 0x0049, 0x004A, 0x000D, 0x000A,
     0x004B, 0x004C, 0x004D, 0x004E, 0x004F, 0x0050, 0x0051, 0x0052, 0x000D, 0x000A,
@@ -54,6 +54,7 @@ static void TestLATIN1(void);
 
 #if !UCONFIG_NO_LEGACY_CONVERSION
 static void TestSBCS(void);
+static void TestSBCSASCIIRuns(void);
 static void TestDBCS(void);
 static void TestMBCS(void);
 #if !UCONFIG_NO_LEGACY_CONVERSION && !UCONFIG_NO_FILE_IO
@@ -277,6 +278,7 @@ void addTestNewConvert(TestNode** root)
 
 #if !UCONFIG_NO_LEGACY_CONVERSION
    addTest(root, &TestSBCS, "tsconv/nucnvtst/TestSBCS");
+   addTest(root, &TestSBCSASCIIRuns, "tsconv/nucnvtst/TestSBCSASCIIRuns");
 #if !UCONFIG_NO_FILE_IO
    addTest(root, &TestDBCS, "tsconv/nucnvtst/TestDBCS");
    addTest(root, &TestICCRunout, "tsconv/nucnvtst/TestICCRunout");
@@ -2563,6 +2565,94 @@ TestSBCS() {
     ucnv_close(cnv);
 }
 
+/*
+ * Long runs of ASCII are converted in blocks where the platform supports SIMD.
+ * Put other characters at all positions relative to such blocks and
+ * compare with converting one character at a time.
+ */
+static void
+TestSBCSASCIIRuns() {
+    /* é, €, unassigned, LF, ¤ */
+    static const uint8_t specials[]={ 0xe9, 0x80, 0x81, 0x0a, 0xa4 };
+    uint8_t bytes[1200], bytes2[1200];
+    UChar text[1200], expected[1200];
+    int32_t offsets[1200];
+    int32_t length=0, textLength, i, r, n;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    UConverter *cnv=ucnv_open("windows-1252", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("Unable to open a SBCS(windows-1252) converter: %s\n", u_errorName(errorCode));
+        return;
+    }
+    for(r=0; r<=40; ++r) {
+        for(i=0; i<r; ++i, ++length) {
+            bytes[length]=(uint8_t)(0x20+(length*7)%0x5f);
+        }
+        bytes[length++]=specials[r%UPRV_LENGTHOF(specials)];
+    }
+    for(i=0; i<length; ++i) {
+        n=ucnv_toUChars(cnv, expected+i, 1, (const char *)bytes+i, 1, &errorCode);
+        if(n!=1) {
+            log_err("windows-1252 byte %02x does not convert to one UChar\n", bytes[i]);
+            errorCode=U_ZERO_ERROR;
+        }
+    }
+    errorCode=U_ZERO_ERROR;
+
+    /* toUnicode */
+    {
+        const char *source=(const char *)bytes;
+        UChar *target=text;
+        ucnv_resetToUnicode(cnv);
+        ucnv_toUnicode(cnv, &target, text+UPRV_LENGTHOF(text), &source, (const char *)bytes+length,
+                       offsets, TRUE, &errorCode);
+        textLength=(int32_t)(target-text);
+        if(U_FAILURE(errorCode) || textLength!=length) {
+            log_err("windows-1252 toUnicode() failed: %s, length %d!=%d\n",
+                    u_errorName(errorCode), (int)textLength, (int)length);
+            ucnv_close(cnv);
+            return;
+        }
+        for(i=0; i<length; ++i) {
+            if(text[i]!=expected[i] || offsets[i]!=i) {
+                log_err("windows-1252 toUnicode() text[%d]=U+%04x offset %d != U+%04x\n",
+                        (int)i, text[i], (int)offsets[i], expected[i]);
+                break;
+            }
+        }
+    }
+
+    /* fromUnicode, with an unmappable character instead of the unassigned byte */
+    for(i=0; i<length; ++i) {
+        if(bytes[i]==0x81) {
+            text[i]=0x4e00;
+            bytes[i]=0x1a;
+        }
+    }
+    {
+        const UChar *source=text;
+        char *target=(char *)bytes2;
+        ucnv_resetFromUnicode(cnv);
+        ucnv_fromUnicode(cnv, &target, (char *)bytes2+sizeof(bytes2), &source, text+length,
+                         offsets, TRUE, &errorCode);
+        n=(int32_t)(target-(char *)bytes2);
+        if(U_FAILURE(errorCode) || n!=length) {
+            log_err("windows-1252 fromUnicode() failed: %s, length %d!=%d\n",
+                    u_errorName(errorCode), (int)n, (int)length);
+            ucnv_close(cnv);
+            return;
+        }
+        for(i=0; i<length; ++i) {
+            if(bytes2[i]!=bytes[i] || offsets[i]!=i) {
+                log_err("windows-1252 fromUnicode() bytes[%d]=%02x offset %d != %02x\n",
+                        (int)i, bytes2[i], (int)offsets[i], bytes[i]);
+                break;
+            }
+        }
+    }
+    ucnv_close(cnv);
+}
+
 static void
 TestDBCS() {
     /* test input */
@@ -67,12 +67,14 @@ static void TestUDataGetMemory(void);
 static void TestErrorConditions(void);
 static void TestAppData(void);
 static void TestSwapData(void);
+static void TestTOCHash(void);
 #endif
 static void TestUDataSetAppData(void);
 static void TestICUDataName(void);
 static void PointerTableOfContents(void);
 static void SetBadCommonData(void);
 static void TestUDataFileAccess(void);
+static void TestUDataMappingHints(void);
 #if !UCONFIG_NO_FORMATTING && !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
 static void TestTZDataDir(void); 
 #endif
@@ -91,12 +93,14 @@ addUDataTest(TestNode** root)
     addTest(root, &TestErrorConditions, "udatatst/TestErrorConditions");
     addTest(root, &TestAppData, "udatatst/TestAppData" );
     addTest(root, &TestSwapData, "udatatst/TestSwapData" );
+    addTest(root, &TestTOCHash, "udatatst/TestTOCHash" );
 #endif
     addTest(root, &TestUDataSetAppData, "udatatst/TestUDataSetAppData" );
     addTest(root, &TestICUDataName, "udatatst/TestICUDataName" );
     addTest(root, &PointerTableOfContents, "udatatst/PointerTableOfContents" );
     addTest(root, &SetBadCommonData, "udatatst/SetBadCommonData" );
     addTest(root, &TestUDataFileAccess, "udatatst/TestUDataFileAccess" );
+    addTest(root, &TestUDataMappingHints, "udatatst/TestUDataMappingHints" );
 #if !UCONFIG_NO_FORMATTING && !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
     addTest(root, &TestTZDataDir, "udatatst/TestTZDataDir" );
 #endif
@@ -553,6 +557,78 @@ static void TestUDataFileAccess(){
     ctest_resetICU();
 }
 
+static void TestUDataMappingHints(){
+    UErrorCode status=U_ZERO_ERROR;
+    UDataMemory *result;
+    char items[1000];
+    const char *p;
+    int32_t length;
+    char *icuDataDir=safeGetICUDataDirectory();
+
+    u_cleanup();
+    /* only items from packages are recorded */
+    udata_setFileAccess(UDATA_ONLY_PACKAGES, &status);
+    udata_setMappingHints(UDATA_MAP_WILL_NEED|UDATA_MAP_HUGE_PAGES|UDATA_MAP_RECORD_ITEMS, &status);
+    u_setDataDirectory(icuDataDir);
+
+    length=udata_getRecordedItems(items, UPRV_LENGTHOF(items), &status);
+    if(U_FAILURE(status) || length!=0 || items[0]!=0) {
+        log_err("udata_getRecordedItems() before loading data = %d %s\n", (int)length, u_errorName(status));
+    }
+
+    /* open one item twice and another one once */
+    result=udata_open(NULL, "icu", "cnvalias", &status);
+    udata_close(result);
+    result=udata_open(NULL, "icu", "unames", &status);
+    udata_close(result);
+    result=udata_open(NULL, "icu", "cnvalias", &status);
+    udata_close(result);
+    if(U_FAILURE(status)) {
+        log_data_err("udata_open(cnvalias/unames) from packages failed - %s\n", u_errorName(status));
+    } else {
+        length=udata_getRecordedItems(NULL, 0, &status);
+        if(status!=U_BUFFER_OVERFLOW_ERROR || length<=0) {
+            log_err("udata_getRecordedItems(preflighting) = %d %s\n", (int)length, u_errorName(status));
+        }
+        status=U_ZERO_ERROR;
+        if(udata_getRecordedItems(items, UPRV_LENGTHOF(items), &status)!=length ||
+                U_FAILURE(status) || (int32_t)strlen(items)!=length) {
+            log_err("udata_getRecordedItems() = \"%s\" %s\n", items, u_errorName(status));
+        } else if((p=strstr(items, "cnvalias.icu"))==NULL || strstr(p+1, "cnvalias.icu")!=NULL ||
+                strstr(p, "unames.icu")==NULL) {
+            log_err("udata_getRecordedItems() = \"%s\" does not list cnvalias.icu then unames.icu once\n", items);
+        } else if(items[0]=='\n' || items[length-1]=='\n') {
+            log_err("udata_getRecordedItems() = \"%s\" has leading or trailing separators\n", items);
+        }
+
+        /* prefetching ignores unknown names */
+        udata_prefetchItems(items, length, &status);
+        udata_prefetchItems("no/such.item\n\nxyz", -1, &status);
+        udata_prefetchItems(NULL, 0, &status);
+        if(U_FAILURE(status)) {
+            log_err("udata_prefetchItems() failed - %s\n", u_errorName(status));
+        }
+    }
+
+    status=U_ZERO_ERROR;
+    udata_prefetchItems(NULL, -1, &status);
+    if(status!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("udata_prefetchItems(NULL, -1) = %s instead of U_ILLEGAL_ARGUMENT_ERROR\n", u_errorName(status));
+    }
+
+    status=U_ZERO_ERROR;
+    u_cleanup();
+    udata_setMappingHints(UDATA_MAP_NO_HINTS, &status);
+    udata_setFileAccess(UDATA_DEFAULT_ACCESS, &status);
+    u_setDataDirectory(icuDataDir);
+    u_init(&status);
+    if(U_FAILURE(status)){
+        log_err_status(status, "%s\n", u_errorName(status));
+    }
+    free(icuDataDir);
+    ctest_resetICU();
+}
+
 
 static UBool U_CALLCONV
 isAcceptable1(void *context,
@@ -1391,7 +1467,7 @@ static const struct {
 };
 
 /* Large enough for the largest swappable data item. */
-#define SWAP_BUFFER_SIZE 1800000
+#define SWAP_BUFFER_SIZE 2000000
 
 static void U_CALLCONV
 printError(void *context, const char *fmt, va_list args) {
@@ -1741,6 +1817,111 @@ TestSwapData() {
 }
 #endif
 
+#if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
+/* Check that item lookups with and without the TOC hash table of a package agree. */
+static void CheckTOCLookups(UDataMemory *pData, const char *when) {
+    const UDataOffsetTOC *toc=(const UDataOffsetTOC *)pData->toc;
+    const char *base=(const char *)toc;
+    const DataHeader *pHeader;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    int32_t i, length;
+
+    for(i=0; i<(int32_t)toc->count; ++i) {
+        const char *name=base+toc->entry[i].nameOffset;
+        pHeader=pData->vFuncs->Lookup(pData, name, &length, &errorCode);
+        if(pHeader!=(const DataHeader *)(base+toc->entry[i].dataOffset) || U_FAILURE(errorCode)) {
+            log_err("%s: Lookup(%s) did not find TOC entry %d - %s\n", when, name, (int)i, u_errorName(errorCode));
+        }
+    }
+    pHeader=pData->vFuncs->Lookup(pData, "testdata/no_such_item.res", &length, &errorCode);
+    if(pHeader!=NULL) {
+        log_err("%s: Lookup(testdata/no_such_item.res) found an item\n", when);
+    }
+}
+
+static void TestTOCHash() {
+    UErrorCode errorCode=U_ZERO_ERROR;
+    const char *testDataPath=loadTestData(&errorCode);
+    char *path;
+    FILE *file;
+    char *buffer;
+    long fileLength;
+    UDataMemory mem;
+
+    if(U_FAILURE(errorCode)) {
+        log_data_err("Could not load testdata.dat, status = %s\n", u_errorName(errorCode));
+        return;
+    }
+    path=(char *)malloc(strlen(testDataPath)+5);
+    strcat(strcpy(path, testDataPath), ".dat");
+    file=fopen(path, "rb");
+    free(path);
+    if(file==NULL) {
+        log_data_err("Could not open testdata.dat\n");
+        return;
+    }
+    fseek(file, 0, SEEK_END);
+    fileLength=ftell(file);
+    fseek(file, 0, SEEK_SET);
+    buffer=(char *)malloc(fileLength);
+    if(buffer==NULL || (long)fread(buffer, 1, fileLength, file)!=fileLength) {
+        log_err("Could not read testdata.dat\n");
+        fclose(file);
+        free(buffer);
+        return;
+    }
+    fclose(file);
+
+    /* pkgdata/icupkg write a TOC hash table */
+    UDataMemory_init(&mem);
+    UDataMemory_setData(&mem, buffer);
+    udata_checkCommonData(&mem, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("udata_checkCommonData(testdata.dat) failed - %s\n", u_errorName(errorCode));
+    } else if(mem.tocHash==NULL) {
+        log_err("testdata.dat does not have a valid TOC hash table\n");
+    } else {
+        CheckTOCLookups(&mem, "hash");
+
+        UDataTOCHash *hash=(UDataTOCHash *)mem.tocHash;
+        uint32_t i;
+
+        /* A table with an out-of-range slot value is ignored. */
+        for(i=0; hash->slots[i]==UDATA_TOC_HASH_EMPTY; ++i) {}
+        hash->slots[i]=(uint16_t)hash->itemCount;
+        UDataMemory_init(&mem);
+        UDataMemory_setData(&mem, buffer);
+        udata_checkCommonData(&mem, &errorCode);
+        if(U_FAILURE(errorCode) || mem.tocHash!=NULL) {
+            log_err("testdata.dat with a bad TOC hash slot: hash table not ignored - %s\n", u_errorName(errorCode));
+        }
+
+        /* A table without empty slots is ignored. */
+        for(i=0; i<hash->slotCount; ++i) {
+            hash->slots[i]=0;
+        }
+        UDataMemory_init(&mem);
+        UDataMemory_setData(&mem, buffer);
+        udata_checkCommonData(&mem, &errorCode);
+        if(U_FAILURE(errorCode) || mem.tocHash!=NULL) {
+            log_err("testdata.dat with a full TOC hash table: hash table not ignored - %s\n", u_errorName(errorCode));
+        }
+
+        /* A table that does not match the TOC is ignored. */
+        hash->checksum^=1;
+        UDataMemory_init(&mem);
+        UDataMemory_setData(&mem, buffer);
+        udata_checkCommonData(&mem, &errorCode);
+        if(U_FAILURE(errorCode) || mem.tocHash!=NULL) {
+            log_err("testdata.dat with a bad TOC hash checksum: hash table not ignored - %s\n", u_errorName(errorCode));
+        } else {
+            CheckTOCLookups(&mem, "binary search");
+        }
+    }
+    free(buffer);
+}
+#endif
+
 static void PointerTableOfContents() {
     UDataMemory      *dataItem;
     UErrorCode        status=U_ZERO_ERROR;
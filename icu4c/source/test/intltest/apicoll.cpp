@@ -48,6 +48,7 @@
 #include "sfwdchit.h"
 #include "cmemory.h"
 #include <stdlib.h>
+#include <string>
 
 void
 CollationAPITest::doAssert(UBool condition, const char *message)
@@ -2517,6 +2518,247 @@ void CollationAPITest::TestGapTooSmall() {
     }
 }
 
+void CollationAPITest::TestGetSortKeys() {
+    IcuTestErrorCode errorCode(*this, "TestGetSortKeys");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getGerman(), errorCode));
+    if(errorCode.errDataIfFailureAndReset("Collator::createInstance(de) failed")) {
+        return;
+    }
+    RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+    if(rbc == NULL) {
+        errln("the de collator is not a RuleBasedCollator");
+        return;
+    }
+    static const char16_t *const strings16[] = {
+        u"Stra\u00DFe", u"", u"strasse", u"a\u0323\u0308b\u0301", u"A\u0308\u0323",
+        u"item 12", u"item 9", u"\u0645\u0631\u062D\u0628\u0627", u"\U0001D15E\u4E00\uFFFD"
+    };
+    const int32_t count = UPRV_LENGTHOF(strings16);
+    const char *strings8[count];
+    int32_t lengths16[count], lengths8[count];
+    std::string buffers8[count];
+    for(int32_t i = 0; i < count; ++i) {
+        UnicodeString(strings16[i]).toUTF8String(buffers8[i]);
+        strings8[i] = buffers8[i].c_str();
+        lengths16[i] = u_strlen(strings16[i]);
+        lengths8[i] = (int32_t)buffers8[i].length();
+    }
+    // Each setting changes which iterator or levels the keys use.
+    static const UColAttribute attributes[] = {
+        UCOL_NORMALIZATION_MODE, UCOL_NUMERIC_COLLATION, UCOL_STRENGTH, UCOL_STRENGTH
+    };
+    static const UColAttributeValue values[] = {
+        UCOL_ON, UCOL_ON, UCOL_IDENTICAL, UCOL_PRIMARY
+    };
+    uint8_t keys[2000];
+    int32_t offsets[count + 1];
+    for(int32_t setting = -1; setting < UPRV_LENGTHOF(attributes); ++setting) {
+        if(setting >= 0) {
+            coll->setAttribute(attributes[setting], values[setting], errorCode);
+        }
+        for(int32_t utf8 = 0; utf8 <= 1; ++utf8) {
+            for(int32_t withLengths = 0; withLengths <= 1; ++withLengths) {
+                UnicodeString name = UnicodeString("setting ") + setting +
+                    (utf8 ? " UTF-8" : " UTF-16") + (withLengths ? " with lengths" : " NUL-terminated");
+                int32_t totalLength;
+                if(utf8) {
+                    totalLength = rbc->getSortKeysUTF8(strings8, withLengths ? lengths8 : NULL, count,
+                                                       keys, UPRV_LENGTHOF(keys), offsets, errorCode);
+                } else {
+                    totalLength = rbc->getSortKeys(strings16, withLengths ? lengths16 : NULL, count,
+                                                   keys, UPRV_LENGTHOF(keys), offsets, errorCode);
+                }
+                if(errorCode.isFailure()) {
+                    errln(name + " failed: " + u_errorName(errorCode.reset()));
+                    continue;
+                }
+                assertEquals(name + " no warning", U_ZERO_ERROR, errorCode.reset());
+                assertEquals(name + " offsets[0]", 0, offsets[0]);
+                assertEquals(name + " total length", offsets[count], totalLength);
+                for(int32_t i = 0; i < count; ++i) {
+                    uint8_t expected[200];
+                    int32_t expectedLength = coll->getSortKey(strings16[i], -1, expected, UPRV_LENGTHOF(expected));
+                    if(expectedLength != offsets[i + 1] - offsets[i] ||
+                            uprv_memcmp(expected, keys + offsets[i], expectedLength) != 0) {
+                        errln(name + " key " + i + " differs from getSortKey()");
+                    }
+                }
+            }
+        }
+    }
+
+    // The identical level of a UTF-8 string is written from UTF-16.
+    // Strings whose UTF-16 form exactly fills the conversion buffer
+    // (the UnicodeString stack buffer with 64-bit and 32-bit pointers)
+    // must not leave a warning in the error code.
+    static const char *const asciiStrings8[] = {
+        "abcdefghijklmnopqrstuvwxyz0", "abcdefghijklmnopqrstuvwxyz012"
+    };
+    coll->setAttribute(UCOL_STRENGTH, UCOL_IDENTICAL, errorCode);
+    for(int32_t i = 0; i < UPRV_LENGTHOF(asciiStrings8); ++i) {
+        rbc->getSortKeysUTF8(asciiStrings8 + i, NULL, 1, keys, UPRV_LENGTHOF(keys), offsets, errorCode);
+        assertEquals(UnicodeString("identical level UTF-8 no warning ") + i, U_ZERO_ERROR, errorCode.reset());
+    }
+    coll->setAttribute(UCOL_STRENGTH, UCOL_PRIMARY, errorCode);
+
+    // Preflighting and overflow.
+    int32_t totalLength = rbc->getSortKeys(strings16, lengths16, count, NULL, 0, offsets, errorCode);
+    assertEquals("preflighting error", U_BUFFER_OVERFLOW_ERROR, errorCode.reset());
+    assertEquals("preflighting total length", offsets[count], totalLength);
+    int32_t capacity = offsets[count - 1];  // all but the last key fit
+    uprv_memset(keys, 0x55, UPRV_LENGTHOF(keys));
+    assertEquals("overflow total length", totalLength,
+                 rbc->getSortKeys(strings16, lengths16, count, keys, capacity, offsets, errorCode));
+    assertEquals("overflow error", U_BUFFER_OVERFLOW_ERROR, errorCode.reset());
+    assertEquals("overflow does not write beyond capacity", 0x55, keys[capacity]);
+    uint8_t expected[200];
+    int32_t expectedLength = coll->getSortKey(strings16[count - 2], -1, expected, UPRV_LENGTHOF(expected));
+    assertTrue("overflow key before capacity is complete",
+               expectedLength == capacity - offsets[count - 2] &&
+               uprv_memcmp(expected, keys + offsets[count - 2], expectedLength) == 0);
+
+    // Empty array, illegal arguments, and the C API.
+    assertEquals("no strings", 0, rbc->getSortKeys(NULL, NULL, 0, NULL, 0, offsets, errorCode));
+    errorCode.errIfFailureAndReset("no strings");
+    assertEquals("no strings offsets[0]", 0, offsets[0]);
+    rbc->getSortKeys(strings16, lengths16, count, keys, UPRV_LENGTHOF(keys), NULL, errorCode);
+    assertEquals("NULL offsets", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    const char *nullString[1] = { NULL };
+    rbc->getSortKeysUTF8(nullString, NULL, 1, keys, UPRV_LENGTHOF(keys), offsets, errorCode);
+    assertEquals("NULL string", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    totalLength = ucol_getSortKeysUTF8(rbc->toUCollator(), strings8, lengths8, count,
+                                       keys, UPRV_LENGTHOF(keys), offsets, errorCode);
+    errorCode.errIfFailureAndReset("ucol_getSortKeysUTF8");
+    assertEquals("ucol_getSortKeysUTF8 total length", offsets[count], totalLength);
+}
+
+void CollationAPITest::TestGetSortKeysWithPrefixes() {
+    IcuTestErrorCode errorCode(*this, "TestGetSortKeysWithPrefixes");
+    LocalPointer<Collator> coll(Collator::createInstance(Locale::getGerman(), errorCode));
+    if(errorCode.errDataIfFailureAndReset("Collator::createInstance(de) failed")) {
+        return;
+    }
+    RuleBasedCollator *rbc = dynamic_cast<RuleBasedCollator *>(coll.getAlias());
+    if(rbc == NULL) {
+        errln("the de collator is not a RuleBasedCollator");
+        return;
+    }
+    // No empty string: ucol_getBound() does not look for a level separator at index 0.
+    static const char16_t *const strings16[] = {
+        u"Stra\u00DFe", u"strasse", u"Strasse", u"a\u0323\u0308b\u0301", u"A\u0308\u0323",
+        u"item 12", u"item 9", u"\u0645\u0631\u062D\u0628\u0627", u"\U0001D15E\u4E00\uFFFD",
+        u"a", u"ab", u"abcdefghijklmnopq", u"abcdefghijklmnopr"
+    };
+    const int32_t count = UPRV_LENGTHOF(strings16);
+    const char *strings8[count];
+    std::string buffers8[count];
+    for(int32_t i = 0; i < count; ++i) {
+        UnicodeString(strings16[i]).toUTF8String(buffers8[i]);
+        strings8[i] = buffers8[i].c_str();
+    }
+    uint8_t keys[2000];
+    int32_t offsets[count + 1];
+    uint64_t prefixes[count];
+    for(int32_t strength = UCOL_TERTIARY; strength <= UCOL_IDENTICAL;
+            strength += UCOL_IDENTICAL - UCOL_TERTIARY) {
+        coll->setAttribute(UCOL_STRENGTH, (UColAttributeValue)strength, errorCode);
+        int32_t keyLevels = strength == UCOL_IDENTICAL ? 5 : 3;  // with the quaternary level
+        for(uint32_t levels = 0; levels <= 6; ++levels) {
+            for(int32_t bound = UCOL_BOUND_LOWER; bound <= UCOL_BOUND_UPPER_LONG; ++bound) {
+                for(int32_t utf8 = 0; utf8 <= 1; ++utf8) {
+                    UnicodeString name = UnicodeString("strength ") + strength + " levels " +
+                        (int32_t)levels + " bound " + bound + (utf8 ? " UTF-8" : " UTF-16");
+                    UColBoundMode boundType = (UColBoundMode)bound;
+                    int32_t totalLength;
+                    if(utf8) {
+                        totalLength = rbc->getSortKeysWithPrefixesUTF8(
+                            strings8, NULL, count, levels, boundType,
+                            keys, UPRV_LENGTHOF(keys), offsets, prefixes, errorCode);
+                    } else {
+                        totalLength = rbc->getSortKeysWithPrefixes(
+                            strings16, NULL, count, levels, boundType,
+                            keys, UPRV_LENGTHOF(keys), offsets, prefixes, errorCode);
+                    }
+                    UErrorCode expectedError = (int32_t)levels > keyLevels ?
+                        U_SORT_KEY_TOO_SHORT_WARNING : U_ZERO_ERROR;
+                    if(!assertEquals(name + " error", expectedError, errorCode.reset())) {
+                        continue;
+                    }
+                    assertEquals(name + " total length", offsets[count], totalLength);
+                    for(int32_t i = 0; i < count; ++i) {
+                        uint8_t key[200], expected[200];
+                        int32_t expectedLength =
+                            coll->getSortKey(strings16[i], -1, key, UPRV_LENGTHOF(key));
+                        if(levels == 0 && boundType == UCOL_BOUND_LOWER) {
+                            uprv_memcpy(expected, key, expectedLength);
+                        } else {
+                            // Without the terminator, so that ucol_getBound() stops there.
+                            expectedLength = ucol_getBound(key, expectedLength - 1, boundType,
+                                                           levels != 0 ? levels : 99,
+                                                           expected, UPRV_LENGTHOF(expected),
+                                                           errorCode);
+                            errorCode.reset();
+                        }
+                        const uint8_t *actual = keys + offsets[i];
+                        if(expectedLength != offsets[i + 1] - offsets[i] ||
+                                uprv_memcmp(expected, actual, expectedLength) != 0) {
+                            errln(name + " key " + i + " differs from ucol_getBound()");
+                        }
+                        uint64_t expectedPrefix = 0;
+                        for(int32_t j = 0; j < 8; ++j) {
+                            expectedPrefix = (expectedPrefix << 8) |
+                                (j < expectedLength ? actual[j] : 0);
+                        }
+                        if(prefixes[i] != expectedPrefix) {
+                            errln(name + " prefix " + i + " is wrong");
+                        }
+                    }
+                    // Comparing prefixes and then the rest of the keys
+                    // gives the same order as comparing the keys.
+                    for(int32_t i = 0; i + 1 < count; ++i) {
+                        const char *left = reinterpret_cast<const char *>(keys + offsets[i]);
+                        const char *right = reinterpret_cast<const char *>(keys + offsets[i + 1]);
+                        int32_t expectedOrder = strcmp(left, right);
+                        int32_t order;
+                        if(prefixes[i] != prefixes[i + 1]) {
+                            order = prefixes[i] < prefixes[i + 1] ? -1 : 1;
+                        } else if((prefixes[i] & 0xff) == 0) {
+                            order = 0;
+                        } else {
+                            order = strcmp(left + 8, right + 8);
+                        }
+                        if((order < 0) != (expectedOrder < 0) || (order > 0) != (expectedOrder > 0)) {
+                            errln(name + " prefix order differs from key order at " + i);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Overflow and the C API.
+    coll->setAttribute(UCOL_STRENGTH, UCOL_TERTIARY, errorCode);
+    int32_t totalLength = ucol_getSortKeysWithPrefixes(rbc->toUCollator(), strings16, NULL, count,
+                                                       1, UCOL_BOUND_UPPER, NULL, 0,
+                                                       offsets, prefixes, errorCode);
+    assertEquals("preflighting error", U_BUFFER_OVERFLOW_ERROR, errorCode.reset());
+    assertEquals("preflighting total length", offsets[count], totalLength);
+    assertTrue("preflighting prefix 0", prefixes[0] == 0);
+    int32_t capacity = offsets[1];  // only the first key fits
+    ucol_getSortKeysWithPrefixesUTF8(rbc->toUCollator(), strings8, NULL, count,
+                                     1, UCOL_BOUND_UPPER, keys, capacity,
+                                     offsets, prefixes, errorCode);
+    assertEquals("overflow error", U_BUFFER_OVERFLOW_ERROR, errorCode.reset());
+    assertTrue("overflow prefix 0 is set", prefixes[0] != 0);
+    assertTrue("overflow prefix 1 is 0", prefixes[1] == 0);
+    rbc->getSortKeysWithPrefixes(strings16, NULL, count, 0, UCOL_BOUND_LOWER,
+                                 keys, UPRV_LENGTHOF(keys), offsets, NULL, errorCode);
+    assertEquals("NULL prefixes", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    rbc->getSortKeysWithPrefixes(strings16, NULL, count, 0, (UColBoundMode)3,
+                                 keys, UPRV_LENGTHOF(keys), offsets, prefixes, errorCode);
+    assertEquals("bad bound type", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+}
+
  void CollationAPITest::dump(UnicodeString msg, RuleBasedCollator* c, UErrorCode& status) {
     const char* bigone = "One";
     const char* littleone = "one";
@@ -2560,6 +2802,8 @@ void CollationAPITest::runIndexedTest( int32_t index, UBool exec, const char* &n
     TESTCASE_AUTO(TestIterNumeric);
     TESTCASE_AUTO(TestBadKeywords);
     TESTCASE_AUTO(TestGapTooSmall);
+    TESTCASE_AUTO(TestGetSortKeys);
+    TESTCASE_AUTO(TestGetSortKeysWithPrefixes);
     TESTCASE_AUTO_END;
 }
 
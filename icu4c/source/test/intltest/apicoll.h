@@ -174,6 +174,8 @@ public:
     void TestIterNumeric();
     void TestBadKeywords();
     void TestGapTooSmall();
+    void TestGetSortKeys();
+    void TestGetSortKeysWithPrefixes();
 
 private:
     // If this is too small for the test data, just increase it.
@@ -32,6 +32,8 @@
 #include "cmemory.h"
 #include "collation.h"
 #include "collationdata.h"
+#include "collationfastlatin.h"
+#include "collationfastlatinbuilder.h"
 #include "collationfcd.h"
 #include "collationiterator.h"
 #include "collationroot.h"
@@ -71,6 +73,7 @@ public:
     void TestImplicits();
     void TestNulTerminated();
     void TestIllegalUTF8();
+    void TestFastScriptTables();
     void TestShortFCDData();
     void TestFCD();
     void TestCollationWeights();
@@ -141,6 +144,7 @@ void CollationTest::runIndexedTest(int32_t index, UBool exec, const char *&name,
     TESTCASE_AUTO(TestImplicits);
     TESTCASE_AUTO(TestNulTerminated);
     TESTCASE_AUTO(TestIllegalUTF8);
+    TESTCASE_AUTO(TestFastScriptTables);
     TESTCASE_AUTO(TestShortFCDData);
     TESTCASE_AUTO(TestFCD);
     TESTCASE_AUTO(TestCollationWeights);
@@ -329,6 +333,86 @@ void addLeadSurrogatesForSupplementary(const UnicodeSet &src, UnicodeSet &dest)
 
 }  // namespace
 
+void CollationTest::TestFastScriptTables() {
+    IcuTestErrorCode errorCode(*this, "TestFastScriptTables");
+    const CollationData *data = CollationRoot::getData(errorCode);
+    if(errorCode.errDataIfFailureAndReset("CollationRoot::getData()")) {
+        return;
+    }
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_TABLES; ++i) {
+        CollationFastLatinBuilder builder(errorCode);
+        if(!builder.forScript(*data, i, errorCode) || builder.lengthOfTable() == 0) {
+            errln("CollationFastLatinBuilder.forScript(root, %d) failed - %s",
+                  (int)i, errorCode.errorName());
+            errorCode.reset();
+        }
+    }
+
+    // The script tables must yield the same results as the sort keys
+    // which are always computed without the fast tables.
+    static const char *const strings[] = {
+        "\u0391\u03B8\u03AE\u03BD\u03B1", "\u03B1\u03B8\u03AE\u03BD\u03B1",
+        "\u03B1\u03B8\u03B7\u03BD\u03B1", "\u03B1\u03B8\u03B7\u03BD\u03B1 2",
+        "\u03B1\u03B8\u03B7\u03BD\u03B1 10", "\u03AC\u03BB\u03C6\u03B1",
+        "\u03AC-\u03BB\u03C6\u03B1", "\u03AC\u03BB\u03C6\u03B1!",
+        "\u03C3\u03BF\u03C6\u03CC\u03C2", "\u03A3\u039F\u03A6\u039F\u03A3",
+        "\u03CA\u03C3\u03BF\u03C2", "\u0390", "\u03B9", "\u03B1b",
+        "\u041C\u043E\u0441\u043A\u0432\u0430", "\u043C\u043E\u0441\u043A\u0432\u0430",
+        "\u043C\u043E\u0441\u043A\u0432\u0430 1", "\u041C\u043E\u0441\u043A\u0432\u0430\u2026",
+        "\u0451\u043B\u043A\u0430", "\u0435\u043B\u043A\u0430", "\u0415\u043B\u043A\u0430",
+        "\u0439\u043E\u0433\u0430", "\u0438\u043E\u0433\u0430", "\u0438\u0306\u043E\u0433\u0430",
+        "\u0457\u0436\u0430\u043A", "\u0456\u0436\u0430\u043A", "\u0491\u0430\u043D\u043E\u043A",
+        "\u0452\u0430\u043A", "\u045F\u0435\u043F", "\u0434\u0435\u0440\u0435\u0432\u043E",
+        "\u0434\u0435-\u0440\u0435\u0432\u043E", "\u0434\u0435 \u0440\u0435\u0432\u043E",
+        "\u0434\u0435\uFFFE\u0440", "\u0434\uFFFF", "\u0434a", "\u0434\u00E9", "\u0434\u03B1", "\u0434", ""
+    };
+    static const char *const locales[] = { "root", "ru", "el", "uk", "sr" };
+    for(int32_t li = 0; li < UPRV_LENGTHOF(locales); ++li) {
+        for(int32_t variant = 0; variant < 7; ++variant) {
+            LocalPointer<Collator> coll(Collator::createInstance(locales[li], errorCode));
+            if(errorCode.errDataIfFailureAndReset("Collator::createInstance(%s)", locales[li])) {
+                continue;
+            }
+            switch(variant) {
+            case 1: coll->setAttribute(UCOL_STRENGTH, UCOL_PRIMARY, errorCode); break;
+            case 2: coll->setAttribute(UCOL_STRENGTH, UCOL_SECONDARY, errorCode); break;
+            case 3: coll->setAttribute(UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, errorCode); break;
+            case 4: coll->setAttribute(UCOL_CASE_FIRST, UCOL_UPPER_FIRST, errorCode); break;
+            case 5: coll->setAttribute(UCOL_CASE_LEVEL, UCOL_ON, errorCode); break;
+            case 6: coll->setAttribute(UCOL_NUMERIC_COLLATION, UCOL_ON, errorCode); break;
+            default: break;
+            }
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                UnicodeString left = UnicodeString(strings[i], -1, US_INV).unescape();
+                std::string left8;
+                left.toUTF8String(left8);
+                CollationKey leftKey;
+                coll->getCollationKey(left, leftKey, errorCode);
+                for(int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                    UnicodeString right = UnicodeString(strings[j], -1, US_INV).unescape();
+                    std::string right8;
+                    right.toUTF8String(right8);
+                    CollationKey rightKey;
+                    coll->getCollationKey(right, rightKey, errorCode);
+                    UCollationResult expected = leftKey.compareTo(rightKey, errorCode);
+                    UCollationResult order = coll->compare(left, right, errorCode);
+                    UCollationResult orderNul = coll->compare(
+                        left.getTerminatedBuffer(), -1, right.getTerminatedBuffer(), -1, errorCode);
+                    UCollationResult order8 = coll->compareUTF8(left8, right8, errorCode);
+                    if(errorCode.errIfFailureAndReset("%s variant %d compare()", locales[li], (int)variant)) {
+                        continue;
+                    }
+                    if(order != expected || orderNul != expected || order8 != expected) {
+                        errln("%s variant %d: compare(%s, %s) = %d/%d/%d (UTF-16/NUL/UTF-8) but sort keys %d",
+                              locales[li], (int)variant, strings[i], strings[j],
+                              (int)order, (int)orderNul, (int)order8, (int)expected);
+                    }
+                }
+            }
+        }
+    }
+}
+
 void CollationTest::TestShortFCDData() {
     // See CollationFCD class comments.
     IcuTestErrorCode errorCode(*this, "TestShortFCDData");
@@ -1160,6 +1160,88 @@ void RBBIAPITest::TestRefreshInputText() {
 
 }
 
+void RBBIAPITest::TestAcquireRelease() {
+    /*
+     *  acquireInstance() hands out iterators from a pool; releaseInstance() returns them.
+     *  A released iterator must come back with its text reset, and its results must
+     *  match those of a freshly created iterator.
+     */
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString text("Hello, world. This is a test of the break iterator pool.");
+    UnicodeString other("Another sentence, with different words.");
+
+    LocalPointer<BreakIterator> fresh(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d Error creating word break iterator: %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    fresh->setText(text);
+
+    BreakIterator *bi = BreakIterator::acquireInstance(UBRK_WORD, Locale::getEnglish(), status);
+    TEST_ASSERT_SUCCESS(status);
+    if (bi == NULL) {
+        return;
+    }
+    bi->setText(text);
+    TEST_ASSERT(bi->first() == fresh->first());
+    for (int32_t b = fresh->next(); b != BreakIterator::DONE; b = fresh->next()) {
+        TEST_ASSERT(bi->next() == b);
+    }
+    TEST_ASSERT(bi->next() == BreakIterator::DONE);
+
+    /* Part way through a different text, a clone must carry on from the same place. */
+    bi->setText(other);
+    bi->first();
+    bi->next();
+    bi->next();
+    LocalPointer<BreakIterator> clone(bi->clone());
+    TEST_ASSERT(clone.isValid());
+    if (clone.isValid()) {
+        TEST_ASSERT(clone->current() == bi->current());
+        for (int32_t b = bi->next(); b != BreakIterator::DONE; b = bi->next()) {
+            TEST_ASSERT(clone->next() == b);
+        }
+        TEST_ASSERT(clone->next() == BreakIterator::DONE);
+    }
+    BreakIterator::releaseInstance(bi);
+
+    /* The same key gets the pooled iterator back, with empty text. */
+    BreakIterator *bi2 = BreakIterator::acquireInstance(UBRK_WORD, Locale::getEnglish(), status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(bi2 == bi);
+    if (bi2 == NULL) {
+        return;
+    }
+    TEST_ASSERT(bi2->first() == 0);
+    TEST_ASSERT(bi2->next() == BreakIterator::DONE);
+
+    /* While that one is out, the same key gets a different iterator, as does another type. */
+    BreakIterator *bi3 = BreakIterator::acquireInstance(UBRK_WORD, Locale::getEnglish(), status);
+    BreakIterator *line = BreakIterator::acquireInstance(UBRK_LINE, Locale::getEnglish(), status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(bi3 != NULL && bi3 != bi2);
+    TEST_ASSERT(line != NULL && line != bi2 && line != bi3);
+
+    /* A reused iterator gives the same results as a fresh one. */
+    bi2->setText(text);
+    fresh->first();
+    TEST_ASSERT(bi2->first() == 0);
+    for (int32_t b = fresh->next(); b != BreakIterator::DONE; b = fresh->next()) {
+        TEST_ASSERT(bi2->next() == b);
+    }
+    TEST_ASSERT(bi2->following(5) == fresh->following(5));
+    TEST_ASSERT(bi2->preceding(20) == fresh->preceding(20));
+    TEST_ASSERT(bi2->isBoundary(13) == fresh->isBoundary(13));
+
+    BreakIterator::releaseInstance(line);
+    BreakIterator::releaseInstance(bi3);
+    BreakIterator::releaseInstance(bi2);
+
+    /* Iterators that did not come from the pool are simply deleted. */
+    BreakIterator::releaseInstance(fresh.orphan());
+    BreakIterator::releaseInstance(NULL);
+}
+
 #if !UCONFIG_NO_BREAK_ITERATION && !UCONFIG_NO_FILTERED_BREAK_ITERATION
 static void prtbrks(BreakIterator* brk, const UnicodeString &ustr, IntlTest &it) {
   static const UChar PILCROW=0x00B6, CHSTR=0x3010, CHEND=0x3011; // lenticular brackets
@@ -1429,6 +1511,9 @@ void RBBIAPITest::runIndexedTest( int32_t index, UBool exec, const char* &name,
     TESTCASE_AUTO(TestGetBinaryRules);
 #endif
     TESTCASE_AUTO(TestRefreshInputText);
+#if !UCONFIG_NO_FILE_IO
+    TESTCASE_AUTO(TestAcquireRelease);
+#endif
 #if !UCONFIG_NO_BREAK_ITERATION
     TESTCASE_AUTO(TestFilteredBreakIteratorBuilder);
 #endif
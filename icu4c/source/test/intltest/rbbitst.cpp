@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -42,6 +43,9 @@
 #include "intltest.h"
 #include "rbbitst.h"
 #include "rbbidata.h"
+#include "simplethread.h"
+#include "dictionarydata.h"
+#include "ubrkimpl.h"
 #include "utypeinfo.h"  // for 'typeid' to work
 #include "uvector.h"
 #include "uvectr32.h"
@@ -114,6 +118,10 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
     TESTCASE_AUTO(TestBug13447);
     TESTCASE_AUTO(TestReverse);
     TESTCASE_AUTO(TestBug13692);
+    TESTCASE_AUTO(TestTextAccessPaths);
+    TESTCASE_AUTO(TestGetAllBoundaries);
+    TESTCASE_AUTO(TestGetAllBoundariesParallel);
+    TESTCASE_AUTO(TestCjkDictionary);
     TESTCASE_AUTO_END;
 }
 
@@ -4590,4 +4598,400 @@ void RBBITest::TestProperties() {
     }
 }
 
+//
+//  TestTextAccessPaths   RuleBasedBreakIterator decodes UTF-8 UTexts directly,
+//                        and reads any other text through the UText API.
+//                        Both must find the same boundaries as for the same
+//                        text in other forms.
+//
+static std::vector<int32_t> getAllBoundaries(BreakIterator *bi, int32_t length) {
+    std::vector<int32_t> boundaries;
+    for (int32_t b = bi->first(); b != BreakIterator::DONE; b = bi->next()) {
+        boundaries.push_back(b);
+    }
+    // following() from every offset, including ones inside of a character.
+    for (int32_t i = 0; i < length; ++i) {
+        boundaries.push_back(bi->following(i));
+    }
+    return boundaries;
+}
+
+void RBBITest::TestTextAccessPaths() {
+    static const char utf8[] =
+        "Hello, world! 123.45 \xC3\xA9t\xC3\xA9 \xE0\xB8\x81\xE0\xB8\xB2\xE0\xB8\xA3\xE0\xB8\x9A\xE0\xB9\x89\xE0\xB8\xB2\xE0\xB8\x99 "
+        "\xF0\x9F\x98\x80\xF0\x9F\x87\xBA\xF0\x9F\x87\xB8 a\xCC\x81 \xE4\xB8\xAD\xE6\x96\x87\xE3\x80\x82 "
+        // Ill-formed UTF-8.
+        "bad\x80\xC0\xAFz\xE0\x80 \xED\xA0\x80x\xF4\x90\x80\x80 \xF0\x9F\x98 end.\r\nNext line? Yes.";
+    const int32_t utf8Length = (int32_t)strlen(utf8);
+    UnicodeString utf16 = UnicodeString::fromUTF8(StringPiece(utf8, utf8Length));
+    utf16.append((UChar)0xd800).append(u"x.").append((UChar)0xdc00).append(u" 42");
+
+    for (int32_t type = UBRK_CHARACTER; type <= UBRK_SENTENCE; ++type) {
+        UErrorCode status = U_ZERO_ERROR;
+        Locale locale("en");
+        LocalPointer<BreakIterator> bi;
+        switch (type) {
+        case UBRK_CHARACTER: bi.adoptInstead(BreakIterator::createCharacterInstance(locale, status)); break;
+        case UBRK_WORD: bi.adoptInstead(BreakIterator::createWordInstance(locale, status)); break;
+        case UBRK_LINE: bi.adoptInstead(BreakIterator::createLineInstance(locale, status)); break;
+        default: bi.adoptInstead(BreakIterator::createSentenceInstance(locale, status)); break;
+        }
+        if (!assertSuccess(WHERE, status, true)) {
+            return;
+        }
+
+        // UTF-16: a UnicodeString vs. a CharacterIterator.
+        bi->setText(utf16);
+        std::vector<int32_t> direct16 = getAllBoundaries(bi.getAlias(), utf16.length());
+        bi->adoptText(new StringCharacterIterator(utf16));
+        std::vector<int32_t> generic16 = getAllBoundaries(bi.getAlias(), utf16.length());
+        assertTrue(WHERE, direct16 == generic16);
+
+        // UTF-8: the bytes vs. the same UText with a copy of its functions,
+        // which hides that it is a UTF-8 UText.
+        UText ut = UTEXT_INITIALIZER;
+        utext_openUTF8(&ut, utf8, utf8Length, &status);
+        bi->setText(&ut, status);
+        std::vector<int32_t> direct8 = getAllBoundaries(bi.getAlias(), utf8Length);
+        UTextFuncs funcs = *ut.pFuncs;
+        ut.pFuncs = &funcs;
+        bi->setText(&ut, status);
+        std::vector<int32_t> generic8 = getAllBoundaries(bi.getAlias(), utf8Length);
+        assertSuccess(WHERE, status);
+        assertTrue(WHERE, direct8 == generic8);
+        bi.adoptInstead(NULL);
+        utext_close(&ut);
+    }
+}
+
+//
+//  TestGetAllBoundaries   getAllBoundaries() must find the same boundaries and
+//                         rule status values as iteration with first() and next(),
+//                         including in dictionary-based text, and must leave the
+//                         iterator usable.
+//
+void RBBITest::TestGetAllBoundaries() {
+    UnicodeString text(u"Hello, world! It's 12.5\u00B0C in Mr. Smith's \u0E01\u0E32\u0E23\u0E17\u0E14\u0E25\u0E2D\u0E07 "
+                       u"\u65E5\u672C\u8A9E\u306E\u6587\u7AE0\u3002 "
+                       u"\U0001F600\U0001F1FA\U0001F1F8 a\u0301b. The end?");
+    text = text.unescape();
+    static const char *const locales[] = { "en", "th", "ja", "en@ss=standard" };
+    for (int32_t li = 0; li < UPRV_LENGTHOF(locales); ++li) {
+        for (int32_t type = UBRK_CHARACTER; type <= UBRK_SENTENCE; ++type) {
+            UErrorCode status = U_ZERO_ERROR;
+            Locale locale(locales[li]);
+            LocalPointer<BreakIterator> bi;
+            switch (type) {
+            case UBRK_CHARACTER: bi.adoptInstead(BreakIterator::createCharacterInstance(locale, status)); break;
+            case UBRK_WORD: bi.adoptInstead(BreakIterator::createWordInstance(locale, status)); break;
+            case UBRK_LINE: bi.adoptInstead(BreakIterator::createLineInstance(locale, status)); break;
+            default: bi.adoptInstead(BreakIterator::createSentenceInstance(locale, status)); break;
+            }
+            if (!assertSuccess(WHERE, status, true)) {
+                return;
+            }
+            bi->setText(text);
+
+            std::vector<int32_t> expected, expectedStatus;
+            for (int32_t b = bi->first(); b != BreakIterator::DONE; b = bi->next()) {
+                expected.push_back(b);
+                expectedStatus.push_back(bi->getRuleStatus());
+            }
+
+            // A fresh iterator has nothing cached yet.
+            bi->setText(text);
+            int32_t count = bi->getAllBoundaries(NULL, NULL, 0, status);
+            assertEquals(WHERE, U_BUFFER_OVERFLOW_ERROR, status);
+            assertEquals(WHERE, (int32_t)expected.size(), count);
+            status = U_ZERO_ERROR;
+
+            std::vector<int32_t> boundaries(count + 1, -1), statuses(count + 1, -1);
+            count = bi->getAllBoundaries(boundaries.data(), statuses.data(), count + 1, status);
+            assertSuccess(WHERE, status);
+            boundaries.resize(count);
+            statuses.resize(count);
+            if (!assertTrue(WHERE, boundaries == expected && statuses == expectedStatus)) {
+                errln("    locale %s, break type %d", locales[li], (int)type);
+            }
+
+            // The iterator is back at the start, and still iterates correctly.
+            assertEquals(WHERE, 0, bi->current());
+            std::vector<int32_t> again;
+            for (int32_t b = bi->current(); b != BreakIterator::DONE; b = bi->next()) {
+                again.push_back(b);
+            }
+            assertTrue(WHERE, again == expected);
+        }
+    }
+}
+
+namespace {
+
+// Runs one getAllBoundariesParallel() task.
+class BreakIteratorTaskThread : public SimpleThread {
+public:
+    BreakIteratorTaskThread(UBreakIteratorTask *task, void *taskContext, int32_t index) :
+            fTask(task), fTaskContext(taskContext), fIndex(index) {}
+    virtual void run() { fTask(fTaskContext, fIndex); }
+private:
+    UBreakIteratorTask *fTask;
+    void *fTaskContext;
+    int32_t fIndex;
+};
+
+// Runs the tasks on threads, task 0 on the calling thread,
+// and records the number of tasks in *context.
+void U_CALLCONV runTasksOnThreads(const void *context, UBreakIteratorTask *task, void *taskContext,
+                                  int32_t count) {
+    *(int32_t *)context = count;
+    std::vector<BreakIteratorTaskThread *> threads;
+    for (int32_t i = 1; i < count; ++i) {
+        BreakIteratorTaskThread *thread = new BreakIteratorTaskThread(task, taskContext, i);
+        if (thread->start() == 0) {
+            threads.push_back(thread);
+        } else {
+            // Could not start a thread: run the task here.
+            thread->run();
+            delete thread;
+        }
+    }
+    task(taskContext, 0);
+    for (BreakIteratorTaskThread *thread : threads) {
+        thread->join();
+        delete thread;
+    }
+}
+
+// Runs the tasks backward on the calling thread,
+// to make sure that they do not depend on each other.
+void U_CALLCONV runTasksBackward(const void *context, UBreakIteratorTask *task, void *taskContext,
+                                 int32_t count) {
+    *(int32_t *)context = count;
+    while (count > 0) {
+        task(taskContext, --count);
+    }
+}
+
+}  // namespace
+
+//
+//  TestGetAllBoundariesParallel   getAllBoundariesParallel() must find the same
+//                         boundaries and rule status values as getAllBoundaries(),
+//                         whatever the chunk boundaries happen to fall on,
+//                         including inside of long dictionary-based runs.
+//
+void RBBITest::TestGetAllBoundariesParallel() {
+    static const char16_t *const fragments[] = {
+        u"Hello, world! ",
+        u"It's 12.5\u00B0C in Mr. Smith's garden. ",
+        u"\u0E01\u0E32\u0E23\u0E17\u0E14\u0E25\u0E2D\u0E07\u0E20\u0E32\u0E29\u0E32\u0E44\u0E17\u0E22 ",
+        u"\u65E5\u672C\u8A9E\u306E\u6587\u7AE0\u3067\u3059\u3002",
+        u"\U0001F600\U0001F1FA\U0001F1F8 a\u0301b.\n",
+        u"(see http://example.com/a-b_c?d=1) \"quoted,\" she said\u2014twice.\r\n",
+        u"   ",
+    };
+    // A pseudo-random sequence of fragments, so that the chunks start in many different contexts,
+    // followed by a Thai run without spaces that is longer than a chunk.
+    UnicodeString text;
+    uint32_t seed = 1;
+    while (text.length() < 300000) {
+        seed = seed * 1103515245 + 12345;
+        text.append(fragments[(seed >> 16) % UPRV_LENGTHOF(fragments)]);
+    }
+    while (text.length() < 400000) {
+        text.append(u"\u0E01\u0E32\u0E23\u0E17\u0E14\u0E25\u0E2D\u0E07\u0E20\u0E32\u0E29\u0E32\u0E44\u0E17\u0E22");
+    }
+    text.append(u" The end?");
+
+    static const char *const locales[] = { "en", "th", "ja" };
+    for (int32_t li = 0; li < UPRV_LENGTHOF(locales); ++li) {
+        for (int32_t type = UBRK_WORD; type <= UBRK_LINE; ++type) {
+            UErrorCode status = U_ZERO_ERROR;
+            Locale locale(locales[li]);
+            LocalPointer<RuleBasedBreakIterator> bi(dynamic_cast<RuleBasedBreakIterator *>(
+                type == UBRK_WORD ? BreakIterator::createWordInstance(locale, status) :
+                                    BreakIterator::createLineInstance(locale, status)));
+            if (!assertSuccess(WHERE, status, true) || !assertTrue(WHERE, bi.isValid())) {
+                return;
+            }
+            bi->setText(text);
+            int32_t count = bi->getAllBoundaries(NULL, NULL, 0, status);
+            status = U_ZERO_ERROR;
+            std::vector<int32_t> expected(count), expectedStatus(count);
+            bi->getAllBoundaries(expected.data(), expectedStatus.data(), count, status);
+            assertSuccess(WHERE, status);
+
+            static const int32_t taskCounts[] = { 2, 3, 8 };
+            for (int32_t ti = 0; ti <= UPRV_LENGTHOF(taskCounts); ++ti) {
+                // The last round runs the tasks backward on this thread.
+                UBool backward = ti == UPRV_LENGTHOF(taskCounts);
+                int32_t maxTasks = backward ? 5 : taskCounts[ti];
+                int32_t numTasks = 0;
+                std::vector<int32_t> boundaries(count + 1, -1), statuses(count + 1, -1);
+                int32_t parallelCount = bi->getAllBoundariesParallel(
+                    boundaries.data(), statuses.data(), count + 1, maxTasks,
+                    backward ? runTasksBackward : runTasksOnThreads, &numTasks, status);
+                assertSuccess(WHERE, status);
+                assertTrue(WHERE, 1 < numTasks && numTasks <= maxTasks);
+                boundaries.resize(parallelCount);
+                statuses.resize(parallelCount);
+                if (!assertTrue(WHERE, boundaries == expected && statuses == expectedStatus)) {
+                    errln("    locale %s, break type %d, %d tasks%s",
+                          locales[li], (int)type, (int)maxTasks, backward ? " backward" : "");
+                }
+                assertEquals(WHERE, 0, bi->current());
+            }
+
+            // Without a runner, the text is segmented like getAllBoundaries() does.
+            std::vector<int32_t> boundaries(count, -1);
+            assertEquals(WHERE, count, bi->getAllBoundariesParallel(
+                boundaries.data(), NULL, count, 4, NULL, NULL, status));
+            assertSuccess(WHERE, status);
+            assertTrue(WHERE, boundaries == expected);
+
+            // Preflighting, and the same text in UTF-8.
+            int32_t numTasks = 0;
+            int32_t parallelCount = bi->getAllBoundariesParallel(NULL, NULL, 0, 4,
+                                                                 runTasksOnThreads, &numTasks, status);
+            assertEquals(WHERE, U_BUFFER_OVERFLOW_ERROR, status);
+            assertEquals(WHERE, count, parallelCount);
+            status = U_ZERO_ERROR;
+            std::string text8;
+            text.toUTF8String(text8);
+            UText ut = UTEXT_INITIALIZER;
+            utext_openUTF8(&ut, text8.data(), (int64_t)text8.length(), &status);
+            bi->setText(&ut, status);
+            count = bi->getAllBoundaries(NULL, NULL, 0, status);
+            status = U_ZERO_ERROR;
+            std::vector<int32_t> expected8(count), boundaries8(count);
+            bi->getAllBoundaries(expected8.data(), NULL, count, status);
+            bi->getAllBoundariesParallel(boundaries8.data(), NULL, count, 4,
+                                         runTasksOnThreads, &numTasks, status);
+            assertSuccess(WHERE, status);
+            if (!assertTrue(WHERE, boundaries8 == expected8)) {
+                errln("    UTF-8, locale %s, break type %d", locales[li], (int)type);
+            }
+            bi.adoptInstead(NULL);
+            utext_close(&ut);
+        }
+    }
+
+    // A short text is segmented on this thread, without calling the runner.
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<RuleBasedBreakIterator> bi(dynamic_cast<RuleBasedBreakIterator *>(
+        BreakIterator::createWordInstance(Locale::getEnglish(), status)));
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    bi->setText(UnicodeString(u"Hello, world!"));
+    int32_t boundaries[8];
+    int32_t numTasks = 0;
+    assertEquals(WHERE, 6, bi->getAllBoundariesParallel(boundaries, NULL, UPRV_LENGTHOF(boundaries), 4,
+                                                        runTasksOnThreads, &numTasks, status));
+    assertSuccess(WHERE, status);
+    assertEquals(WHERE, 7, boundaries[3]);
+    assertEquals(WHERE, 0, numTasks);
+    bi->getAllBoundariesParallel(NULL, NULL, 1, 4, runTasksOnThreads, &numTasks, status);
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
+
+static DictionaryMatcher *openCjkDictionary(UBool indexed, UErrorCode &status) {
+    UDataMemory *file = udata_open(U_ICUDATA_BRKITR, "dict", "cjdict", &status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    const uint8_t *data = (const uint8_t *)udata_getMemory(file);
+    const int32_t *indexes = (const int32_t *)data;
+    const UChar *characters = (const UChar *)(data + indexes[DictionaryData::IX_STRING_TRIE_OFFSET]);
+    if (indexed) {
+        return new IndexedUCharsDictionaryMatcher(characters, file);
+    } else {
+        return new UCharsDictionaryMatcher(characters, file);
+    }
+}
+
+//
+//  TestCjkDictionary   The dictionary matcher variants must find the same words
+//                      in Chinese/Japanese text, and word breaking must give the same
+//                      boundaries whether or not the text needs to be NFKC normalized.
+//
+void RBBITest::TestCjkDictionary() {
+    UErrorCode status = U_ZERO_ERROR;
+    LocalPointer<DictionaryMatcher> plain(openCjkDictionary(FALSE, status));
+    LocalPointer<DictionaryMatcher> indexed(openCjkDictionary(TRUE, status));
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d unable to open the CJK dictionary - %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+
+    UnicodeString text(u"\u79C1\u9054\u306B\u4E00\u3007\u3007\u3007\u306E\u30B3\u30F3\u30D4\u30E5\u30FC\u30BF"
+                       u"\u304C\u3042\u308B\u3002\u5948\u3005\u306F\u30EF\u30FC\u30C9\u3067\u3042\u308B\u3002"
+                       u"\u4E2D\u6587\u5206\u8BCD\u6D4B\u8BD5\U0002000B\uFF76\uFF80\u3002");
+    UText ut = UTEXT_INITIALIZER;
+    utext_openUnicodeString(&ut, &text, &status);
+    const UChar *buffer = text.getBuffer();
+    for (int32_t i = 0; i < text.length(); i = text.moveIndex32(i, 1)) {
+        int32_t lengths[4][20], cpLengths[4][20], values[4][20], prefix[4], count[4];
+        utext_setNativeIndex(&ut, i);
+        count[0] = plain->matches(&ut, 20, 20, lengths[0], cpLengths[0], values[0], &prefix[0]);
+        utext_setNativeIndex(&ut, i);
+        count[1] = indexed->matches(&ut, 20, 20, lengths[1], cpLengths[1], values[1], &prefix[1]);
+        count[2] = indexed->matchesUChars(buffer + i, text.length() - i, 20, 20,
+                                          lengths[2], cpLengths[2], values[2], &prefix[2]);
+        count[3] = plain->DictionaryMatcher::matchesUChars(buffer + i, text.length() - i, 20, 20,
+                                                           lengths[3], cpLengths[3], values[3], &prefix[3]);
+        for (int32_t m = 1; m < 4; ++m) {
+            if (count[m] != count[0] || prefix[m] != prefix[0]) {
+                errln("%s:%d matcher %d at %d: %d words, prefix %d; expected %d words, prefix %d",
+                      __FILE__, __LINE__, m, i, count[m], prefix[m], count[0], prefix[0]);
+                continue;
+            }
+            for (int32_t w = 0; w < count[0]; ++w) {
+                if (lengths[m][w] != lengths[0][w] || cpLengths[m][w] != cpLengths[0][w] ||
+                        values[m][w] != values[0][w]) {
+                    errln("%s:%d matcher %d at %d: word %d differs", __FILE__, __LINE__, m, i, w);
+                }
+            }
+        }
+    }
+    utext_close(&ut);
+
+    // Halfwidth katakana and a compatibility ideograph normalize one-to-one,
+    // after a prefix that is already normalized.
+    UnicodeString normalized(u"\u4ECA\u65E5\u306F\u30E1\u30E2\u30EA\u306E\u30C6\u30B9\u30C8\u3067\u3059\u3002"
+                             u"\u30AB\u30BF\u30AB\u30CA\u3067\u66F8\u304D\u307E\u3059\u3002"
+                             u"\u8C48\U0002000B\u3067\u3059\u306D\u3002");
+    UnicodeString unnormalized(u"\u4ECA\u65E5\u306F\uFF92\uFF93\uFF98\u306E\uFF83\uFF7D\uFF84\u3067\u3059\u3002"
+                               u"\uFF76\uFF80\uFF76\uFF85\u3067\u66F8\u304D\u307E\u3059\u3002"
+                               u"\uF900\U0002000B\u3067\u3059\u306D\u3002");
+    LocalPointer<BreakIterator> bi(BreakIterator::createWordInstance("ja", status));
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    bi->setText(normalized);
+    std::vector<int32_t> expected16 = getAllBoundaries(bi.getAlias(), normalized.length());
+    assertTrue(WHERE, expected16.size() > 10);
+    bi->setText(unnormalized);
+    assertTrue(WHERE, expected16 == getAllBoundaries(bi.getAlias(), unnormalized.length()));
+
+    // The same in UTF-8, where the dictionary code works on a copy of the text.
+    // Each of these characters has a three-byte UTF-8 form.
+    std::string normalized8, unnormalized8;
+    normalized.toUTF8String(normalized8);
+    unnormalized.toUTF8String(unnormalized8);
+    assertEquals(WHERE, (int32_t)normalized8.length(), (int32_t)unnormalized8.length());
+    utext_openUTF8(&ut, normalized8.data(), (int64_t)normalized8.length(), &status);
+    bi->setText(&ut, status);
+    std::vector<int32_t> expected8 = getAllBoundaries(bi.getAlias(), (int32_t)normalized8.length());
+    assertEquals(WHERE, (int32_t)expected16.size() - normalized.length(),
+                 (int32_t)expected8.size() - (int32_t)normalized8.length());
+    utext_openUTF8(&ut, unnormalized8.data(), (int64_t)unnormalized8.length(), &status);
+    bi->setText(&ut, status);
+    assertTrue(WHERE, expected8 == getAllBoundaries(bi.getAlias(), (int32_t)unnormalized8.length()));
+    assertSuccess(WHERE, status);
+    bi.adoptInstead(NULL);
+    utext_close(&ut);
+}
+
 #endif // #if !UCONFIG_NO_BREAK_ITERATION
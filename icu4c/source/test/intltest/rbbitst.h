@@ -82,6 +82,10 @@ public:
     void TestReverse();
     void TestReverse(std::unique_ptr<RuleBasedBreakIterator>bi);
     void TestBug13692();
+    void TestTextAccessPaths();
+    void TestGetAllBoundaries();
+    void TestGetAllBoundariesParallel();
+    void TestCjkDictionary();
 
     void TestDebug();
     void TestProperties();
@@ -11,6 +11,9 @@
 #include "cstring.h"
 #include "unicode/unistr.h"
 #include "unicode/resbund.h"
+#include "unicode/localpointer.h"
+#include "resource.h"
+#include "uresimp.h"
 #include "restsnew.h"
 
 #include <stdlib.h>
@@ -195,6 +198,7 @@ void NewResourceBundleTest::runIndexedTest( int32_t index, UBool exec, const cha
 #endif
 
     case 5: name = "TestGetByFallback";  if(exec) TestGetByFallback(); break;
+    case 6: name = "TestVisitItems";  if(exec) TestVisitItems(); break;
         default: name = ""; break; //needed to end loop
     }
 }
@@ -1198,5 +1202,109 @@ NewResourceBundleTest::TestGetByFallback() {
     status = U_ZERO_ERROR;
 
 }
+
+namespace {
+
+// Appends "key=value;" or "value;" for string items, and "[...]" around nested arrays.
+// Accepts only keys of keyLength, if it is not negative,
+// and stops after maxItems top-level items.
+class TestVisitor : public ResourceVisitor {
+public:
+    TestVisitor(int32_t keyLen, int32_t maxItemCount) :
+            keyLength(keyLen), maxItems(maxItemCount), count(0), depth(0) {}
+    virtual ~TestVisitor();
+
+    virtual UBool acceptKey(const char *key) {
+        return keyLength < 0 || (int32_t)uprv_strlen(key) == keyLength;
+    }
+
+    virtual UBool visit(const char *key, int32_t /*index*/, ResourceValue &value,
+                        UErrorCode &errorCode) {
+        if (key != NULL) {
+            result.append(UnicodeString(key, -1, US_INV)).append((UChar)0x3d);
+        }
+        if (value.getType() == URES_ARRAY) {
+            result.append((UChar)0x5b);
+            ++depth;
+            value.getArray(errorCode).visit(value, *this, errorCode);
+            --depth;
+            result.append((UChar)0x5d);
+        } else {
+            result.append(value.getUnicodeString(errorCode)).append((UChar)0x3b);
+        }
+        return depth > 0 || ++count < maxItems;
+    }
+
+    int32_t keyLength;
+    int32_t maxItems;
+    int32_t count;
+    int32_t depth;
+    UnicodeString result;
+};
+
+TestVisitor::~TestVisitor() {}
+
+}  // namespace
+
+void
+NewResourceBundleTest::TestVisitItems() {
+    IcuTestErrorCode errorCode(*this, "TestVisitItems");
+    const char *testdatapath = loadTestData(errorCode);
+    if (errorCode.errDataIfFailureAndReset("Could not load testdata.dat")) {
+        return;
+    }
+    LocalUResourceBundlePointer te_IN(ures_open(testdatapath, "te_IN", errorCode));
+    if (errorCode.errIfFailureAndReset("ures_open(testdata, te_IN)")) {
+        return;
+    }
+
+    // The path is looked up with fallback to root.
+    TestVisitor all(-1, INT32_MAX);
+    assertTrue("array complete",
+               ures_visitItems(te_IN.getAlias(), "array_only_in_Root", all, errorCode));
+    assertEquals("array items", u"ROOT0;ROOT1;ROOT2;ROOT3;", all.result);
+
+    TestVisitor nested(-1, INT32_MAX);
+    assertTrue("2d array complete",
+               ures_visitItems(te_IN.getAlias(), "array_2d_only_in_Root", nested, errorCode));
+    assertEquals("2d array items", u"[ROOT00;ROOT01;][ROOT10;ROOT11;]", nested.result);
+
+    // Table items are visited in key order; the key filter skips items.
+    TestVisitor filtered(5, INT32_MAX);
+    assertTrue("filtered table complete",
+               ures_visitItems(te_IN.getAlias(), "tagged_array_only_in_Root", filtered, errorCode));
+    assertEquals("filtered table items", u"tag12=ROOT12;tag14=ROOT14;", filtered.result);
+
+    // Early termination.
+    TestVisitor firstTwo(-1, 2);
+    assertFalse("stopped table",
+                ures_visitItems(te_IN.getAlias(), "tagged_array_only_in_Root", firstTwo, errorCode));
+    assertEquals("stopped table items", u"tag1=ROOT1;tag12=ROOT12;", firstTwo.result);
+    errorCode.errIfFailureAndReset("ures_visitItems()");
+
+    TestVisitor none(-1, INT32_MAX);
+    assertFalse("not a container",
+                ures_visitItems(te_IN.getAlias(), "string_only_in_Root", none, errorCode));
+    assertEquals("not a container error", U_RESOURCE_TYPE_MISMATCH, errorCode.reset());
+    assertFalse("missing resource",
+                ures_visitItems(te_IN.getAlias(), "nonexistent", none, errorCode));
+    assertEquals("missing resource error", U_MISSING_RESOURCE_ERROR, errorCode.reset());
+
+    // Direct lookup in a table without iterating.
+    LocalUResourceBundlePointer root(ures_open(testdatapath, "root", errorCode));
+    LocalUResourceBundlePointer tagged(
+        ures_getByKey(root.getAlias(), "tagged_array_only_in_Root", NULL, errorCode));
+    if (errorCode.errIfFailureAndReset("ures_getByKey(tagged_array_only_in_Root)")) {
+        return;
+    }
+    ResourceDataValue value;
+    value.setData(&tagged->fResData);
+    value.setResource(tagged->fRes);
+    ResourceTable table = value.getTable(errorCode);
+    assertTrue("findValue(tag7)", table.findValue("tag7", value));
+    assertEquals("tag7 value", u"ROOT7", value.getUnicodeString(errorCode));
+    assertFalse("findValue(tag8)", table.findValue("tag8", value));
+    errorCode.errIfFailureAndReset("findValue()");
+}
 //eof
 
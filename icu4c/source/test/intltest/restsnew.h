@@ -38,6 +38,8 @@ public:
 
     void TestGetByFallback(void);
 
+    void TestVisitItems(void);
+
 private:
     /**
      * The assignment operator has no real implementation.
@@ -23,7 +23,11 @@
 #include "intltest.h"
 #include "tsmthred.h"
 #include "unicode/ushape.h"
+#include "unicode/ucnv.h"
+#include "unicode/ures.h"
 #include "unicode/translit.h"
+#include "unicode/uwarmup.h"
+#include "unicode/brkiter.h"
 #include "sharedobject.h"
 #include "unifiedcache.h"
 #include "uassert.h"
@@ -46,6 +50,7 @@ MultithreadTest::~MultithreadTest()
 #include <string.h>
 #include <ctype.h>    // tolower, toupper
 #include <memory>
+#include <vector>
 
 #include "unicode/putil.h"
 
@@ -82,6 +87,14 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
     TESTCASE_AUTO(TestBreakTranslit);
     TESTCASE_AUTO(TestIncDec);
 #endif /* #if !UCONFIG_NO_TRANSLITERATION */
+    TESTCASE_AUTO(TestConverterCache);
+    TESTCASE_AUTO(TestResourceBundleCache);
+#if !UCONFIG_NO_FORMATTING
+    TESTCASE_AUTO(TestWarmup);
+#endif
+#if !UCONFIG_NO_BREAK_ITERATION
+    TESTCASE_AUTO(TestBreakIteratorPool);
+#endif
     TESTCASE_AUTO_END
 }
 
@@ -1550,3 +1563,300 @@ void MultithreadTest::TestIncDec()
 
 
 #endif /* !UCONFIG_NO_TRANSLITERATION */
+
+
+//
+// Converters: Open and close, and acquire and release, converters
+//   while another thread flushes the converter cache.
+//
+
+static const char *gConverterCacheNames[] = {
+    "UTF-8",
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    "Shift-JIS", "ibm-1047", "windows-1252", "ibm-1047,swaplfnl",
+#endif
+};
+
+class ConverterCacheThread : public SimpleThread {
+public:
+    ConverterCacheThread(int32_t id) : fId(id) {}
+    virtual void run();
+private:
+    int32_t fId;
+};
+
+void ConverterCacheThread::run() {
+    static const UChar input[] = { 0x61, 0x62, 0x63, 0x20, 0x31, 0x32, 0x33, 0x0a };
+    UChar output[UPRV_LENGTHOF(input)];
+    char bytes[4 * UPRV_LENGTHOF(input)];
+    for (int32_t i = 0; i < 2000; ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        const char *name = gConverterCacheNames[(fId + i) % UPRV_LENGTHOF(gConverterCacheNames)];
+        UBool pooled = (i & 1) != 0;
+        UConverter *cnv = pooled ? ucnv_acquire(name, &status) : ucnv_open(name, &status);
+        if (U_FAILURE(status)) {
+            IntlTest::gTest->dataerrln("%s:%d opening converter %s failed - %s",
+                                       __FILE__, __LINE__, name, u_errorName(status));
+            return;
+        }
+        int32_t length = ucnv_fromUChars(cnv, bytes, UPRV_LENGTHOF(bytes),
+                                         input, UPRV_LENGTHOF(input), &status);
+        length = ucnv_toUChars(cnv, output, UPRV_LENGTHOF(output), bytes, length, &status);
+        if (U_FAILURE(status) || length != UPRV_LENGTHOF(input) ||
+                0 != uprv_memcmp(output, input, sizeof(input))) {
+            IntlTest::gTest->errln("%s:%d round trip with converter %s failed - %s",
+                                   __FILE__, __LINE__, name, u_errorName(status));
+        }
+        if (pooled) {
+            ucnv_release(cnv);
+        } else {
+            ucnv_close(cnv);
+        }
+        if (fId == 0 && (i % 16) == 0) {
+            ucnv_flushCache();
+        }
+    }
+}
+
+void MultithreadTest::TestConverterCache() {
+    ConverterCacheThread *threads[4];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(threads); ++i) {
+        threads[i] = new ConverterCacheThread(i);
+        threads[i]->start();
+    }
+    for (int32_t i = 0; i < UPRV_LENGTHOF(threads); ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+    ucnv_flushCache();
+}
+
+
+//
+// Resource bundles: Open and close the same locales' bundles from several threads,
+//   and check that cached opens give the same bundle and status as the first open.
+//
+
+static const char *gBundleCacheLocales[] = {
+    "de_CH", "de_CH_XX", "sr_Latn_RS", "en", "root", "zh_Hant_TW", "fr_CA"
+};
+
+static char gBundleCacheActual[UPRV_LENGTHOF(gBundleCacheLocales)][ULOC_FULLNAME_CAPACITY];
+static UErrorCode gBundleCacheStatus[UPRV_LENGTHOF(gBundleCacheLocales)];
+
+class BundleCacheThread : public SimpleThread {
+public:
+    BundleCacheThread(int32_t id) : fId(id) {}
+    virtual void run();
+private:
+    int32_t fId;
+};
+
+void BundleCacheThread::run() {
+    for (int32_t i = 0; i < 2000; ++i) {
+        int32_t index = (fId + i) % UPRV_LENGTHOF(gBundleCacheLocales);
+        UErrorCode status = U_ZERO_ERROR;
+        UResourceBundle *rb = ures_open(NULL, gBundleCacheLocales[index], &status);
+        const char *actual = ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &status);
+        if (status != gBundleCacheStatus[index] || actual == NULL ||
+                uprv_strcmp(actual, gBundleCacheActual[index]) != 0) {
+            IntlTest::gTest->errln("%s:%d ures_open(%s) gave %s/%s, expected %s/%s",
+                                   __FILE__, __LINE__, gBundleCacheLocales[index],
+                                   actual == NULL ? "(null)" : actual, u_errorName(status),
+                                   gBundleCacheActual[index], u_errorName(gBundleCacheStatus[index]));
+        }
+        ures_close(rb);
+    }
+}
+
+void MultithreadTest::TestResourceBundleCache() {
+    for (int32_t i = 0; i < UPRV_LENGTHOF(gBundleCacheLocales); ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        UResourceBundle *rb = ures_open(NULL, gBundleCacheLocales[i], &status);
+        const char *actual = ures_getLocaleByType(rb, ULOC_ACTUAL_LOCALE, &status);
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d ures_open(%s) failed - %s",
+                      __FILE__, __LINE__, gBundleCacheLocales[i], u_errorName(status));
+            ures_close(rb);
+            return;
+        }
+        uprv_strcpy(gBundleCacheActual[i], actual);
+        gBundleCacheStatus[i] = status;
+        ures_close(rb);
+    }
+    BundleCacheThread *threads[4];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(threads); ++i) {
+        threads[i] = new BundleCacheThread(i);
+        threads[i]->start();
+    }
+    for (int32_t i = 0; i < UPRV_LENGTHOF(threads); ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+#if !UCONFIG_NO_FORMATTING
+
+namespace {
+
+// Runs one u_warmup() task.
+class WarmupTaskThread : public SimpleThread {
+  public:
+    WarmupTaskThread(UWarmupTask *task, void *taskContext, int32_t index) :
+            fTask(task), fTaskContext(taskContext), fIndex(index) {}
+    virtual void run() { fTask(fTaskContext, fIndex); }
+  private:
+    UWarmupTask *fTask;
+    void *fTaskContext;
+    int32_t fIndex;
+};
+
+// Runs each task on its own thread, and records the number of tasks in *context.
+void U_CALLCONV runWarmupTasks(const void *context, UWarmupTask *task, void *taskContext,
+                               int32_t count) {
+    *(int32_t *)context = count;
+    std::vector<WarmupTaskThread *> threads;
+    for (int32_t i = 0; i < count; ++i) {
+        threads.push_back(new WarmupTaskThread(task, taskContext, i));
+        threads.back()->start();
+    }
+    for (WarmupTaskThread *thread : threads) {
+        thread->join();
+        delete thread;
+    }
+}
+
+}  // namespace
+
+void MultithreadTest::TestWarmup() {
+    // Locales that other tests in this suite do not use,
+    // so that their objects are not cached yet.
+    static const char *const locales[] = { "sw", "is", "mk", "kk", "lo", "ka", "hy" };
+    UErrorCode status = U_ZERO_ERROR;
+    const UnifiedCache *cache = UnifiedCache::getInstance(status);
+    if (U_FAILURE(status)) {
+        errln("%s:%d UnifiedCache::getInstance() failed - %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    int32_t keyCount = cache->keyCount();
+    int32_t numTasks = 0;
+    u_warmup(locales, UPRV_LENGTHOF(locales), UWARMUP_ALL, 4, runWarmupTasks, &numTasks, &status);
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d u_warmup() failed - %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    if (numTasks != 4) {
+        errln("%s:%d u_warmup() ran %d tasks, expected 4", __FILE__, __LINE__, (int)numTasks);
+    }
+    // At least the number format, plural rules, calendar and date format symbols per locale.
+    if (cache->keyCount() < keyCount + 4 * UPRV_LENGTHOF(locales)) {
+        errln("%s:%d u_warmup() cached only %d objects for %d locales",
+              __FILE__, __LINE__, (int)(cache->keyCount() - keyCount), (int)UPRV_LENGTHOF(locales));
+    }
+
+    // Warming up again, on this thread, only hits the caches.
+    keyCount = cache->keyCount();
+    u_warmup(locales, UPRV_LENGTHOF(locales), UWARMUP_NUMBER_FORMAT | UWARMUP_PLURAL_RULES,
+             4, NULL, NULL, &status);
+    if (U_FAILURE(status) || cache->keyCount() != keyCount) {
+        errln("%s:%d u_warmup() again: %s, cached %d more objects",
+              __FILE__, __LINE__, u_errorName(status), (int)(cache->keyCount() - keyCount));
+    }
+
+    status = U_ZERO_ERROR;
+    u_warmup(NULL, 0, UWARMUP_ALL, 4, runWarmupTasks, &numTasks, &status);
+    if (U_FAILURE(status)) {
+        errln("%s:%d u_warmup(no locales) failed - %s", __FILE__, __LINE__, u_errorName(status));
+    }
+    u_warmup(locales, -1, UWARMUP_ALL, 4, runWarmupTasks, &numTasks, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        errln("%s:%d u_warmup(count<0) did not fail - %s", __FILE__, __LINE__, u_errorName(status));
+    }
+}
+
+#endif
+
+
+#if !UCONFIG_NO_BREAK_ITERATION
+//
+// Break iterators: Acquire and release pooled break iterators from several threads,
+//   and check that each one still finds the same boundaries as a fresh iterator.
+//
+
+static const UBreakIteratorType gBreakIteratorPoolTypes[] = { UBRK_WORD, UBRK_LINE };
+static const char *gBreakIteratorPoolLocales[] = { "en", "th" };
+static const char *gBreakIteratorPoolText =
+    "The quick (\"brown\") fox can't jump 32.3 feet, right? "
+    "\\u0e01\\u0e32\\u0e23\\u0e17\\u0e14\\u0e25\\u0e2d\\u0e07\\u0e20\\u0e32\\u0e29\\u0e32\\u0e44\\u0e17\\u0e22";
+static UnicodeString *gBreakIteratorPoolString = NULL;
+static std::vector<int32_t> gBreakIteratorPoolExpected[UPRV_LENGTHOF(gBreakIteratorPoolTypes)]
+                                                      [UPRV_LENGTHOF(gBreakIteratorPoolLocales)];
+
+class BreakIteratorPoolThread : public SimpleThread {
+public:
+    BreakIteratorPoolThread(int32_t id) : fId(id) {}
+    virtual void run();
+private:
+    int32_t fId;
+};
+
+void BreakIteratorPoolThread::run() {
+    for (int32_t i = 0; i < 500; ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        int32_t t = (fId + i) % UPRV_LENGTHOF(gBreakIteratorPoolTypes);
+        int32_t l = ((fId + i) / 2) % UPRV_LENGTHOF(gBreakIteratorPoolLocales);
+        BreakIterator *bi = BreakIterator::acquireInstance(
+            gBreakIteratorPoolTypes[t], Locale(gBreakIteratorPoolLocales[l]), status);
+        if (U_FAILURE(status)) {
+            IntlTest::gTest->dataerrln("%s:%d acquiring break iterator failed - %s",
+                                       __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+        bi->setText(*gBreakIteratorPoolString);
+        const std::vector<int32_t> &expected = gBreakIteratorPoolExpected[t][l];
+        size_t n = 0;
+        for (int32_t b = bi->first(); b != BreakIterator::DONE; b = bi->next(), ++n) {
+            if (n >= expected.size() || expected[n] != b) {
+                IntlTest::gTest->errln("%s:%d type %d locale %s: unexpected boundary %d",
+                                       __FILE__, __LINE__, (int)t, gBreakIteratorPoolLocales[l], (int)b);
+                break;
+            }
+        }
+        BreakIterator::releaseInstance(bi);
+    }
+}
+
+void MultithreadTest::TestBreakIteratorPool() {
+    UnicodeString text = UnicodeString(gBreakIteratorPoolText, -1, US_INV).unescape();
+    gBreakIteratorPoolString = &text;
+    for (int32_t t = 0; t < UPRV_LENGTHOF(gBreakIteratorPoolTypes); ++t) {
+        for (int32_t l = 0; l < UPRV_LENGTHOF(gBreakIteratorPoolLocales); ++l) {
+            UErrorCode status = U_ZERO_ERROR;
+            LocalPointer<BreakIterator> bi(
+                t == 0 ? BreakIterator::createWordInstance(gBreakIteratorPoolLocales[l], status) :
+                         BreakIterator::createLineInstance(gBreakIteratorPoolLocales[l], status));
+            if (U_FAILURE(status)) {
+                dataerrln("%s:%d creating break iterator failed - %s", __FILE__, __LINE__, u_errorName(status));
+                return;
+            }
+            bi->setText(text);
+            gBreakIteratorPoolExpected[t][l].clear();
+            for (int32_t b = bi->first(); b != BreakIterator::DONE; b = bi->next()) {
+                gBreakIteratorPoolExpected[t][l].push_back(b);
+            }
+        }
+    }
+
+    BreakIteratorPoolThread *threads[4];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(threads); ++i) {
+        threads[i] = new BreakIteratorPoolThread(i);
+        threads[i]->start();
+    }
+    for (int32_t i = 0; i < UPRV_LENGTHOF(threads); ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+    gBreakIteratorPoolString = NULL;
+}
+
+#endif /* !UCONFIG_NO_BREAK_ITERATION */
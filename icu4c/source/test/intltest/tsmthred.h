@@ -53,6 +53,10 @@ public:
     void TestUnifiedCache();
     void TestBreakTranslit();
     void TestIncDec();
+    void TestConverterCache();
+    void TestResourceBundleCache();
+    void TestWarmup();
+    void TestBreakIteratorPool();
 };
 
 #endif
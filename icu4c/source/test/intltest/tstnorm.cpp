@@ -60,6 +60,9 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
     TESTCASE_AUTO(TestNormalizeIllFormedText);
     TESTCASE_AUTO(TestComposeJamoTBase);
     TESTCASE_AUTO(TestComposeBoundaryAfter);
+    TESTCASE_AUTO(TestDecomposeUTF8WithEdits);
+    TESTCASE_AUTO(TestNormalizeUTF8MatchesUTF16);
+    TESTCASE_AUTO(TestQuickCheckLongRuns);
     TESTCASE_AUTO_END;
 }
 
@@ -1772,4 +1775,209 @@ BasicNormalizerTest::TestComposeBoundaryAfter() {
     assertFalse("U+FB2C boundary-after", nfkc->hasBoundaryAfter(0xFB2C));
 }
 
+void
+BasicNormalizerTest::TestDecomposeUTF8WithEdits() {
+    IcuTestErrorCode errorCode(*this, "TestDecomposeUTF8WithEdits");
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getNFDInstance() call failed")) {
+        return;
+    }
+    static const char *const src =
+        u8"  AÄA\u0308A\u0308\u00AD\u0323Ä\u0323,\u00AD\u1100\u1161가\u11A8가\u3133  ";
+    std::string expected =
+        u8"  AA\u0308A\u0308A\u0308\u00AD\u0323A\u0323\u0308,\u00AD"
+        u8"\u1100\u1161\u1100\u1161\u11A8\u1100\u1161\u3133  ";
+    std::string result;
+    StringByteSink<std::string> sink(&result, expected.length());
+    Edits edits;
+    nfd->normalizeUTF8(0, src, sink, &edits, errorCode);
+    assertSuccess("decomposeUTF8 with Edits", errorCode.get());
+    assertEquals("decomposeUTF8 with Edits", expected.c_str(), result.c_str());
+    static const EditChange expectedChanges[] = {
+        { FALSE, 3, 3 },  // 2 spaces + A
+        { TRUE, 2, 3 },  // Ä→A\u0308
+        { FALSE, 10, 10 },  // A\u0308A\u0308\u00AD\u0323
+        { TRUE, 4, 5 },  // Ä\u0323→A\u0323\u0308
+        { FALSE, 9, 9 },  // comma, soft hyphen, \u1100\u1161
+        { TRUE, 3, 6 },  // 가→\u1100\u1161
+        { FALSE, 3, 3 },  // \u11A8
+        { TRUE, 3, 6 },  // 가→\u1100\u1161
+        { FALSE, 5, 5 }  // \u3133 + 2 spaces
+    };
+    assertTrue("decomposeUTF8 with Edits hasChanges", edits.hasChanges());
+    assertEquals("decomposeUTF8 with Edits numberOfChanges", 4, edits.numberOfChanges());
+    TestUtility::checkEditsIter(*this, u"decomposeUTF8 with Edits",
+            edits.getFineIterator(), edits.getFineIterator(),
+            expectedChanges, UPRV_LENGTHOF(expectedChanges),
+            TRUE, errorCode);
+
+    assertFalse("NFD isNormalizedUTF8(source)", nfd->isNormalizedUTF8(src, errorCode));
+    assertTrue("NFD isNormalizedUTF8(normalized)", nfd->isNormalizedUTF8(result, errorCode));
+    assertFalse("NFD isNormalizedUTF8(out of order)",
+                nfd->isNormalizedUTF8(u8"a\u0308\u0323", errorCode));
+
+    // Omit unchanged text.
+    expected = u8"A\u0308A\u0323\u0308\u1100\u1161\u1100\u1161";
+    result.clear();
+    edits.reset();
+    nfd->normalizeUTF8(U_OMIT_UNCHANGED_TEXT, src, sink, &edits, errorCode);
+    assertSuccess("decomposeUTF8 omit unchanged", errorCode.get());
+    assertEquals("decomposeUTF8 omit unchanged", expected.c_str(), result.c_str());
+    TestUtility::checkEditsIter(*this, u"decomposeUTF8 omit unchanged",
+            edits.getFineIterator(), edits.getFineIterator(),
+            expectedChanges, UPRV_LENGTHOF(expectedChanges),
+            TRUE, errorCode);
+
+    // Compatibility mappings, a mapping to empty, and reordering across it.
+    const Normalizer2 *nfkc_cf_d = Normalizer2::getInstance(
+        nullptr, "nfkc_cf", UNORM2_DECOMPOSE, errorCode);
+    if (errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    expected = u8"fia\u0301 a\u0323\u0308";
+    result.clear();
+    nfkc_cf_d->normalizeUTF8(0, u8"ﬁＡ\u0301 \u00ADÄ\u00AD\u0323", sink, &edits, errorCode);
+    assertSuccess("nfkc_cf decomposeUTF8", errorCode.get());
+    assertEquals("nfkc_cf decomposeUTF8", expected.c_str(), result.c_str());
+    static const EditChange compatChanges[] = {
+        { TRUE, 3, 2 },  // ﬁ→fi
+        { TRUE, 3, 1 },  // Ａ→a
+        { FALSE, 3, 3 },  // \u0301 + space
+        { TRUE, 2, 0 },  // U+00AD soft hyphen maps to empty
+        { TRUE, 6, 5 }  // Ä\u00AD\u0323→a\u0323\u0308 removes the soft hyphen
+    };
+    TestUtility::checkEditsIter(*this, u"nfkc_cf decomposeUTF8",
+            edits.getFineIterator(), edits.getFineIterator(),
+            compatChanges, UPRV_LENGTHOF(compatChanges),
+            TRUE, errorCode);
+}
+
+void
+BasicNormalizerTest::TestNormalizeUTF8MatchesUTF16() {
+    IcuTestErrorCode errorCode(*this, "TestNormalizeUTF8MatchesUTF16");
+    const Normalizer2 *n2s[] = {
+        Normalizer2::getNFCInstance(errorCode),
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCInstance(errorCode),
+        Normalizer2::getNFKDInstance(errorCode),
+        Normalizer2::getInstance(nullptr, "nfkc_cf", UNORM2_DECOMPOSE, errorCode)
+    };
+    static const char *const names[] = { "NFC", "NFD", "NFKC", "NFKD", "NFKC_CF decompose" };
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    static const char *const strings[] = {
+        "",
+        "plain ASCII text",
+        u8"  AÄA\u0308A\u0308\u00AD\u0323Ä\u0323,\u00AD\u1100\u1161가\u11A8가\u3133  ",
+        u8"\u0301\u0323a\u0308\u0323\u0301\u0316ǖ\u0327ḋ\u0323Ç\u0301",
+        u8"Ｆｕｌｌｗｉｄｔｈ ﬁ ① ½ ㌀ ẛ\u0323 \u0344",
+        u8"Ελληνικά ῇ ΐ Кириллица й ё Tiếng Việt क़\u093C \u0F73\u0F75",
+        u8"\U0001D15E\U0001D165\U0001D16D \U0001109A ΩÅ 가힣",
+        // ill-formed sequences are copied unchanged
+        "A\x80\xC3\x84\xC0\x80\xCC\x88\xED\xA0\x80\xCC\xA3\xF4\x90\x80\x80\xC3\x84\xF0"
+    };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(n2s); ++i) {
+        for (int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+            std::string src8(strings[j]);
+            UnicodeString expected16 = n2s[i]->normalize(UnicodeString::fromUTF8(src8), errorCode);
+            std::string expected8;
+            expected16.toUTF8String(expected8);
+            std::string result8;
+            StringByteSink<std::string> sink(&result8);
+            Edits edits;
+            n2s[i]->normalizeUTF8(0, src8, sink, &edits, errorCode);
+            if (errorCode.errIfFailureAndReset("%s normalizeUTF8(strings[%d])", names[i], (int)j)) {
+                continue;
+            }
+            if (src8.find('\x80') == std::string::npos) {
+                // Only well-formed strings round-trip through UTF-16.
+                assertEquals(UnicodeString(names[i]) + " normalizeUTF8 vs. normalize " + (int)j,
+                             expected8.c_str(), result8.c_str());
+                assertEquals(UnicodeString(names[i]) + " isNormalizedUTF8 vs. isNormalized " + (int)j,
+                             n2s[i]->isNormalized(UnicodeString::fromUTF8(src8), errorCode),
+                             n2s[i]->isNormalizedUTF8(src8, errorCode));
+            }
+            // The Edits must map the source to the result.
+            assertEquals(UnicodeString(names[i]) + " Edits lengthDelta " + (int)j,
+                         (int32_t)(result8.length() - src8.length()), edits.lengthDelta());
+            Edits::Iterator ei = edits.getCoarseIterator();
+            while (ei.next(errorCode)) {
+                if (!ei.hasChange() &&
+                        src8.compare(ei.sourceIndex(), ei.oldLength(),
+                                     result8, ei.destinationIndex(), ei.newLength()) != 0) {
+                    errln("%s Edits unchanged span at source index %d differs in strings[%d]",
+                          names[i], (int)ei.sourceIndex(), (int)j);
+                }
+            }
+            assertTrue(UnicodeString(names[i]) + " isNormalizedUTF8(result) " + (int)j,
+                       n2s[i]->isNormalizedUTF8(result8, errorCode));
+        }
+    }
+}
+
+void
+BasicNormalizerTest::TestQuickCheckLongRuns() {
+    // Runs of code units below the quick check thresholds are skipped
+    // several at a time. Put a character that is not normalized at every
+    // position of runs of various lengths, so that it lands everywhere
+    // in and around those blocks.
+    IcuTestErrorCode errorCode(*this, "TestQuickCheckLongRuns");
+    const Normalizer2 *n2s[] = {
+        Normalizer2::getNFCInstance(errorCode),
+        Normalizer2::getNFDInstance(errorCode),
+        Normalizer2::getNFKCInstance(errorCode),
+        Normalizer2::getNFKDInstance(errorCode)
+    };
+    static const char *const names[] = { "NFC", "NFD", "NFKC", "NFKD" };
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getInstance() call failed")) {
+        return;
+    }
+    // Only the NFC/NFKC filler contains Latin-1 letters
+    // because those are below the composition threshold but not below the decomposition one.
+    static const UChar nfcFiller[] = u"Latin text with caf\u00e9 and na\u00efve words. ";
+    static const UChar nfdFiller[] = u"Latin text without accents, just ASCII! ";
+    // U+212B Angstrom sign is not normalized in any form.
+    // A combining mark after a base letter is "maybe" for NFC/NFKC,
+    // and only tested with those.
+    static const UChar *const nonNormalized[] = { u"\u212B", u"e\u0301" };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(n2s); ++i) {
+        UBool isCompose = (i & 1) == 0;
+        const UChar *filler = isCompose ? nfcFiller : nfdFiller;
+        int32_t fillerLength = u_strlen(filler);
+        for (int32_t length = 0; length <= 40; ++length) {
+            UnicodeString run;
+            for (int32_t j = 0; j < length; ++j) {
+                run.append(filler[j % fillerLength]);
+            }
+            std::string run8;
+            run.toUTF8String(run8);
+            assertTrue(UnicodeString(names[i]) + " isNormalized(run) " + length,
+                       n2s[i]->isNormalized(run, errorCode));
+            assertEquals(UnicodeString(names[i]) + " spanQuickCheckYes(run) " + length,
+                         length, n2s[i]->spanQuickCheckYes(run, errorCode));
+            assertTrue(UnicodeString(names[i]) + " isNormalizedUTF8(run) " + length,
+                       n2s[i]->isNormalizedUTF8(run8, errorCode));
+            for (int32_t k = 0; k < (isCompose ? 2 : 1); ++k) {
+                for (int32_t pos = 0; pos <= length; ++pos) {
+                    UnicodeString s(run);
+                    s.insert(pos, nonNormalized[k]);
+                    std::string s8;
+                    s.toUTF8String(s8);
+                    UnicodeString message = UnicodeString(names[i]) + " length " + length +
+                        " insert " + k + " at " + pos;
+                    assertFalse(message + " isNormalized", n2s[i]->isNormalized(s, errorCode));
+                    int32_t spanLength = n2s[i]->spanQuickCheckYes(s, errorCode);
+                    if (spanLength > pos) {
+                        errln(message + " spanQuickCheckYes()=" + spanLength + " too long");
+                    }
+                    assertTrue(message + " span is normalized",
+                               n2s[i]->isNormalized(s.tempSubString(0, spanLength), errorCode));
+                    assertFalse(message + " isNormalizedUTF8", n2s[i]->isNormalizedUTF8(s8, errorCode));
+                }
+            }
+        }
+    }
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
@@ -53,6 +53,9 @@ public:
     void TestNormalizeIllFormedText();
     void TestComposeJamoTBase();
     void TestComposeBoundaryAfter();
+    void TestDecomposeUTF8WithEdits();
+    void TestNormalizeUTF8MatchesUTF16();
+    void TestQuickCheckLongRuns();
 
 private:
     UnicodeString canonTests[24][3];
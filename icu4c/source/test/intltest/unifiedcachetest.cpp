@@ -10,10 +10,18 @@
 *
 ********************************************************************************
 */
+#include <stdlib.h>
+
 #include "cstring.h"
 #include "intltest.h"
 #include "unifiedcache.h"
 #include "unicode/datefmt.h"
+#include "unicode/dcfmtsym.h"
+#include "unicode/numfmt.h"
+#include "unicode/plurrule.h"
+#include "shareddateformatsymbols.h"
+#include "sharednumberformat.h"
+#include "sharedpluralrules.h"
 
 class UCTItem : public SharedObject {
   public:
@@ -24,11 +32,24 @@ class UCTItem : public SharedObject {
     virtual ~UCTItem() {
         uprv_free(value);
     }
+    virtual int32_t getMemoryFootprint() const {
+        return 100;
+    }
 };
 
 class UCTItem2 : public SharedObject {
 };
 
+// An item whose memory footprint is 100 bytes times the number in its locale name.
+class UCTSizedItem : public SharedObject {
+  public:
+    int32_t footprint;
+    UCTSizedItem(int32_t x) : footprint(x) { }
+    virtual int32_t getMemoryFootprint() const {
+        return footprint;
+    }
+};
+
 U_NAMESPACE_BEGIN
 
 template<> U_EXPORT
@@ -62,6 +83,18 @@ const UCTItem2 *LocaleCacheKey<UCTItem2>::createObject(
     return NULL;
 }
 
+template<> U_EXPORT
+const UCTSizedItem *LocaleCacheKey<UCTSizedItem>::createObject(
+        const void * /*unused*/, UErrorCode &status) const {
+    UCTSizedItem *result = new UCTSizedItem(100 * atoi(fLoc.getName()));
+    if (result == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    result->addRef();
+    return result;
+}
+
 U_NAMESPACE_END
 
 
@@ -77,6 +110,10 @@ private:
     void TestError();
     void TestHashEquals();
     void TestEvictionUnderStress();
+    void TestLruEviction();
+    void TestShardedEviction();
+    void TestSizeWeightedEviction();
+    void TestMemoryFootprint();
 };
 
 void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
@@ -87,6 +124,10 @@ void UnifiedCacheTest::runIndexedTest(int32_t index, UBool exec, const char* &na
   TESTCASE_AUTO(TestError);
   TESTCASE_AUTO(TestHashEquals);
   TESTCASE_AUTO(TestEvictionUnderStress);
+  TESTCASE_AUTO(TestLruEviction);
+  TESTCASE_AUTO(TestShardedEviction);
+  TESTCASE_AUTO(TestSizeWeightedEviction);
+  TESTCASE_AUTO(TestMemoryFootprint);
   TESTCASE_AUTO_END;
 }
 
@@ -396,6 +437,151 @@ void UnifiedCacheTest::TestHashEquals() {
     assertTrue("", diffKey1 != diffKey2);
 }
 
+void UnifiedCacheTest::TestLruEviction() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("", status);
+    cache.setEvictionPolicy(3, 0, status);
+    cache.setEvictionAlgorithm(UCACHE_EVICT_LRU, FALSE, status);
+    cache.setStatisticsEnabled(TRUE);
+
+    static const char *locales[] = {
+            "1", "2", "3", "4", "5", "6", "7", "8", "9", "10",
+            "11", "12", "13", "14", "15", "16", "17", "18", "19", "20"};
+
+    // Fetch "1" after each new entry. It is always among the most recently
+    // used entries, so it must never be evicted.
+    const UCTItem *hot = NULL;
+    cache.get(LocaleCacheKey<UCTItem>(locales[0]), &cache, hot, status);
+    SharedObject::clearPtr(hot);
+    for (int32_t i = 1; i < UPRV_LENGTHOF(locales); ++i) {
+        const UCTItem *item = NULL;
+        cache.get(LocaleCacheKey<UCTItem>(locales[i]), &cache, item, status);
+        SharedObject::clearPtr(item);
+        cache.get(LocaleCacheKey<UCTItem>(locales[0]), &cache, hot, status);
+        SharedObject::clearPtr(hot);
+    }
+    assertSuccess("T1", status);
+    assertEquals("T2", 3, cache.unusedCount());
+
+    UnifiedCacheStatistics stats[2];
+    int32_t count = cache.getStatistics(stats, UPRV_LENGTHOF(stats), status);
+    assertSuccess("T3", status);
+    if (!assertEquals("T4", 1, count)) {
+        return;
+    }
+    assertEquals("T5", typeid(LocaleCacheKey<UCTItem>).name(), stats[0].keyType);
+    assertEquals("T6", (int64_t) UPRV_LENGTHOF(locales) - 1, stats[0].hits);
+    assertEquals("T7", (int64_t) UPRV_LENGTHOF(locales), stats[0].misses);
+    assertEquals("T8", cache.autoEvictedCount(), stats[0].evictions);
+
+    // Preflighting.
+    count = cache.getStatistics(NULL, 0, status);
+    assertEquals("T9", U_BUFFER_OVERFLOW_ERROR, status);
+    assertEquals("T10", 1, count);
+    status = U_ZERO_ERROR;
+    cache.setEvictionAlgorithm(UCACHE_EVICT_ALGORITHM_COUNT, FALSE, status);
+    assertEquals("T11", U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
+void UnifiedCacheTest::TestShardedEviction() {
+    static const char *locales[] = {
+            "1", "2", "3", "4", "5", "6", "7", "8", "9", "10",
+            "11", "12", "13", "14", "15", "16", "17", "18", "19", "20"};
+
+    for (int32_t algorithm = 0; algorithm < UCACHE_EVICT_ALGORITHM_COUNT; ++algorithm) {
+        UErrorCode status = U_ZERO_ERROR;
+        UnifiedCache::getInstance(status);
+        UnifiedCache cache(status);
+        assertSuccess("", status);
+        cache.setEvictionPolicy(3, 0, status);
+        // UCTItem weighs 100 bytes: Room for the item in use and 3 more.
+        cache.setMemoryLimit(400, status);
+        cache.setEvictionAlgorithm((UCacheEvictionAlgorithm) algorithm, TRUE, status);
+        const UCTItem *inUse = NULL;
+        cache.get(LocaleCacheKey<UCTItem>(locales[0]), &cache, inUse, status);
+        for (int32_t i = 1; i < UPRV_LENGTHOF(locales); ++i) {
+            const UCTItem *item = NULL;
+            cache.get(LocaleCacheKey<UCTItem>(locales[i]), &cache, item, status);
+            SharedObject::clearPtr(item);
+        }
+        assertSuccess("T1", status);
+        assertEquals("T2", 3, cache.unusedCount());
+        assertEquals("T3", 4, cache.keyCount());
+        assertEquals("T4", (int64_t) UPRV_LENGTHOF(locales) - 4, cache.autoEvictedCount());
+        SharedObject::clearPtr(inUse);
+    }
+}
+
+void UnifiedCacheTest::TestSizeWeightedEviction() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCache::getInstance(status);
+    UnifiedCache cache(status);
+    assertSuccess("", status);
+    cache.setEvictionPolicy(1, 0, status);   // Does not apply.
+    cache.setEvictionAlgorithm(UCACHE_EVICT_SIZE_WEIGHTED, FALSE, status);
+    cache.setMemoryLimit(1000, status);
+
+    // 100 + 200 + 300 + 400 bytes fit.
+    static const char *locales[] = {"1", "2", "3", "4"};
+    for (int32_t i = 0; i < UPRV_LENGTHOF(locales); ++i) {
+        const UCTSizedItem *item = NULL;
+        cache.get(LocaleCacheKey<UCTSizedItem>(locales[i]), item, status);
+        SharedObject::clearPtr(item);
+    }
+    assertSuccess("T1", status);
+    assertEquals("T2", 4, cache.keyCount());
+    assertEquals("T3", 1000, cache.memoryFootprint());
+
+    // 900 more bytes in use: At least that much of the unused items must go.
+    const UCTSizedItem *inUse = NULL;
+    cache.get(LocaleCacheKey<UCTSizedItem>("9"), inUse, status);
+    assertSuccess("T4", status);
+    int32_t footprint = cache.memoryFootprint();
+    assertTrue("T5", 900 <= footprint && footprint <= 1000);
+    assertTrue("T6", cache.autoEvictedCount() > 0);
+
+    // Values in use stay even when they alone exceed the limit.
+    cache.setMemoryLimit(0, status);
+    const UCTSizedItem *item = NULL;
+    cache.get(LocaleCacheKey<UCTSizedItem>("1"), item, status);
+    SharedObject::clearPtr(item);
+    assertSuccess("T7", status);
+    assertEquals("T8", 1, cache.keyCount());
+    assertEquals("T9", 900, cache.memoryFootprint());
+    SharedObject::clearPtr(inUse);
+    assertEquals("T10", 0, cache.keyCount());
+    assertEquals("T11", 0, cache.memoryFootprint());
+
+    cache.setMemoryLimit(-1, status);
+    assertEquals("T12", U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
+void UnifiedCacheTest::TestMemoryFootprint() {
+#if !UCONFIG_NO_FORMATTING
+    UErrorCode status = U_ZERO_ERROR;
+    const SharedNumberFormat *nf =
+            NumberFormat::createSharedInstance("de", UNUM_DECIMAL, status);
+    const SharedPluralRules *pr =
+            PluralRules::createSharedInstance("de", UPLURAL_TYPE_CARDINAL, status);
+    const SharedDateFormatSymbols *dfs = NULL;
+    UnifiedCache::getByLocale("de", dfs, status);
+    if (assertSuccess("", status, TRUE)) {
+        // Each value counts more than just its own object.
+        assertTrue("SharedNumberFormat",
+                   nf->getMemoryFootprint() > (int32_t) sizeof(DecimalFormatSymbols));
+        assertTrue("SharedPluralRules",
+                   pr->getMemoryFootprint() > (int32_t) (sizeof(SharedPluralRules) + sizeof(PluralRules)));
+        assertTrue("SharedDateFormatSymbols",
+                   dfs->getMemoryFootprint() > (int32_t) sizeof(SharedDateFormatSymbols));
+    }
+    SharedObject::clearPtr(nf);
+    SharedObject::clearPtr(pr);
+    SharedObject::clearPtr(dfs);
+#endif
+}
+
 extern IntlTest *createUnifiedCacheTest() {
     return new UnifiedCacheTest();
 }
@@ -37,6 +37,8 @@ const char gUsageString[] =
     "-unix                      Run test using Unix strxfrm, strcoll services.\n"
     "-uselen                    Use API with string lengths.  Default is null-terminated strings\n"
     "-usekeys                   Run tests using sortkeys rather than strcoll\n"
+    "-prefixkeys                Run tests using sortkey prefixes from ucol_getSortKeysWithPrefixes\n"
+    "                               rather than strcoll.  ICU only.\n"
     "-strcmp                    Run tests using u_strcmp rather than strcoll\n"
     "-strcmpCPO                 Run tests using u_strcmpCodePointOrder rather than strcoll\n"
     "-loop nnnn                 Loopcount for test.  Adjust for reasonable total running time.\n"
@@ -121,6 +123,7 @@ UBool  opt_win        = FALSE;      // Run with Windows native functions.
 UBool  opt_unix       = FALSE;      // Run with UNIX strcoll, strxfrm functions.
 UBool  opt_uselen     = FALSE;
 UBool  opt_usekeys    = FALSE;
+UBool  opt_prefixkeys = FALSE;
 UBool  opt_strcmp     = FALSE;
 UBool  opt_strcmpCPO  = FALSE;
 UBool  opt_norm       = FALSE;
@@ -159,6 +162,7 @@ OptSpec opts[] = {
     {"-unix",        OptSpec::FLAG,   &opt_unix},
     {"-uselen",      OptSpec::FLAG,   &opt_uselen},
     {"-usekeys",     OptSpec::FLAG,   &opt_usekeys},
+    {"-prefixkeys",  OptSpec::FLAG,   &opt_prefixkeys},
     {"-strcmp",      OptSpec::FLAG,   &opt_strcmp},
     {"-strcmpCPO",   OptSpec::FLAG,   &opt_strcmpCPO},
     {"-norm",        OptSpec::FLAG,   &opt_norm},
@@ -198,6 +202,8 @@ struct  Line {
     int        len;
     char      *winSortKey;
     char      *icuSortKey;
+    uint64_t   icuKeyPrefix;     // First 8 bytes of the key in gIcuKeyArena, big-endian.
+    char      *icuArenaKey;      // The key in gIcuKeyArena.
     char      *unixSortKey;
     char      *unixName;
 };
@@ -209,6 +215,11 @@ int            gNumFileLines;
 UCollator     *gCol;
 DWORD          gWinLCID;
 
+uint8_t       *gIcuKeyArena;         // All ICU sort keys, from ucol_getSortKeysWithPrefixes().
+int32_t       *gIcuKeyOffsets;
+uint64_t      *gIcuKeyPrefixes;
+const UChar  **gIcuNames;
+
 Line          **gSortedLines;
 Line          **gRandomLines;
 int            gCount;
@@ -284,6 +295,21 @@ int ICUstrcmpK(const void *a, const void *b) {
 }
 
 
+//  Compare the integer key prefixes, and the rest of the keys only if the prefixes are equal.
+int ICUstrcmpP(const void *a, const void *b) {
+    gCount++;
+    const Line *al = *(Line **)a;
+    const Line *bl = *(Line **)b;
+    if (al->icuKeyPrefix != bl->icuKeyPrefix) {
+        return al->icuKeyPrefix < bl->icuKeyPrefix ? -1 : 1;
+    }
+    if ((al->icuKeyPrefix & 0xff) == 0) {
+        return 0;   // The prefix contains the whole key.
+    }
+    return strcmp(al->icuArenaKey + 8, bl->icuArenaKey + 8);
+}
+
+
 int ICUstrcmpL(const void *a, const void *b) {
     gCount++;
     UCollationResult t;
@@ -399,6 +425,16 @@ void doKeyGen()
             }
         }
     }
+    else if (opt_icu && opt_prefixkeys)
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        for (loops=0; loops<adj_loopCount; loops++) {
+            for (iLoop=0; iLoop < opt_iLoopCount; iLoop++) {
+                t = ucol_getSortKeysWithPrefixes(gCol, gIcuNames, NULL, gNumFileLines, 0, UCOL_BOUND_LOWER,
+                    gIcuKeyArena, gIcuKeyOffsets[gNumFileLines], gIcuKeyOffsets, gIcuKeyPrefixes, &status);
+            }
+        }
+    }
     else if (opt_icu)
     {
         for (loops=0; loops<adj_loopCount; loops++) {
@@ -704,7 +740,7 @@ void doQSort() {
 
     // Adjust loop count to compensate for file size.   QSort should be n log(n)
     double dLoopCount = double(opt_loopCount) * 3000. / (log10((double)gNumFileLines) * double(gNumFileLines));
-    if (opt_usekeys) dLoopCount *= 5;
+    if (opt_usekeys || opt_prefixkeys) dLoopCount *= 5;
     int adj_loopCount = int(dLoopCount);
     if (adj_loopCount < 1) adj_loopCount = 1;
 
@@ -733,6 +769,13 @@ void doQSort() {
         }
     }
 
+    else if (opt_icu && opt_prefixkeys) {
+        for (i=0; i<adj_loopCount; i++) {
+            memcpy(sortBuf, gRandomLines, gNumFileLines * sizeof(Line *));
+            qsort(sortBuf, gNumFileLines, sizeof(Line *), ICUstrcmpP);
+        }
+    }
+
     else if (opt_icu && opt_usekeys) {
         for (i=0; i<adj_loopCount; i++) {
             memcpy(sortBuf, gRandomLines, gNumFileLines * sizeof(Line *));
@@ -1628,6 +1671,32 @@ int main(int argc, const char** argv) {
          }
     }
 
+    //
+    //  Pre-compute the ICU sort key arena and prefixes for the lines of the file.
+    //
+    if (opt_prefixkeys) {
+        UErrorCode status = U_ZERO_ERROR;
+        gIcuNames = new const UChar *[gNumFileLines];
+        gIcuKeyOffsets = new int32_t[gNumFileLines + 1];
+        gIcuKeyPrefixes = new uint64_t[gNumFileLines];
+        for (line=0; line<gNumFileLines; line++) {
+            gIcuNames[line] = gFileLines[line].name;
+        }
+        t = ucol_getSortKeysWithPrefixes(gCol, gIcuNames, NULL, gNumFileLines, 0, UCOL_BOUND_LOWER,
+            NULL, 0, gIcuKeyOffsets, gIcuKeyPrefixes, &status);
+        status = U_ZERO_ERROR;
+        gIcuKeyArena = new uint8_t[t];
+        ucol_getSortKeysWithPrefixes(gCol, gIcuNames, NULL, gNumFileLines, 0, UCOL_BOUND_LOWER,
+            gIcuKeyArena, t, gIcuKeyOffsets, gIcuKeyPrefixes, &status);
+        if (U_FAILURE(status)) {
+            fprintf(stderr, "ucol_getSortKeysWithPrefixes() failed: %s\n", u_errorName(status));
+            exit(-1);
+        }
+        for (line=0; line<gNumFileLines; line++) {
+            gFileLines[line].icuKeyPrefix = gIcuKeyPrefixes[line];
+            gFileLines[line].icuArenaKey = (char *)gIcuKeyArena + gIcuKeyOffsets[line];
+        }
+    }
 
 
     //
@@ -328,6 +328,87 @@ long GetSortKey::getOperationsPerIteration()
     return source->count;
 }
 
+//
+// Test case taking a single test data array, calling ucol_getSortKeys or ucol_getSortKeysUTF8
+// for all of the strings at once
+//
+class GetSortKeys : public UPerfFunction
+{
+public:
+    GetSortKeys(const UCollator* coll, const CA_uchar* source16, const CA_char* source8);
+    ~GetSortKeys();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration();
+
+private:
+    const UCollator *coll;
+    int32_t count;
+    const UChar **strings16;
+    const char **strings8;
+    int32_t *lengths;
+    int32_t *offsets;
+    uint8_t *keys;
+    int32_t capacity;
+};
+
+GetSortKeys::GetSortKeys(const UCollator* coll, const CA_uchar* source16, const CA_char* source8)
+    :   coll(coll),
+        count(source16 != NULL ? source16->count : source8->count),
+        strings16(NULL),
+        strings8(NULL),
+        lengths((int32_t *)malloc(sizeof(int32_t) * count)),
+        offsets((int32_t *)malloc(sizeof(int32_t) * (count + 1))),
+        keys(NULL),
+        capacity(0)
+{
+    if (source16 != NULL) {
+        strings16 = (const UChar **)malloc(sizeof(UChar *) * count);
+        for (int32_t i = 0; i < count; i++) {
+            strings16[i] = source16->dataOf(i);
+            lengths[i] = source16->lengthOf(i);
+        }
+    } else {
+        strings8 = (const char **)malloc(sizeof(char *) * count);
+        for (int32_t i = 0; i < count; i++) {
+            strings8[i] = source8->dataOf(i);
+            lengths[i] = source8->lengthOf(i);
+        }
+    }
+    // Preflight once so that each call writes all keys.
+    UErrorCode status = U_ZERO_ERROR;
+    if (strings16 != NULL) {
+        capacity = ucol_getSortKeys(coll, strings16, lengths, count, NULL, 0, offsets, &status);
+    } else {
+        capacity = ucol_getSortKeysUTF8(coll, strings8, lengths, count, NULL, 0, offsets, &status);
+    }
+    keys = (uint8_t *)malloc(capacity);
+}
+
+GetSortKeys::~GetSortKeys()
+{
+    free(strings16);
+    free(strings8);
+    free(lengths);
+    free(offsets);
+    free(keys);
+}
+
+void GetSortKeys::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    if (strings16 != NULL) {
+        ucol_getSortKeys(coll, strings16, lengths, count, keys, capacity, offsets, status);
+    } else {
+        ucol_getSortKeysUTF8(coll, strings8, lengths, count, keys, capacity, offsets, status);
+    }
+}
+
+long GetSortKeys::getOperationsPerIteration()
+{
+    return count;
+}
+
 //
 // Test case taking a single test data array in UTF-16, calling ucol_nextSortKeyPart for each for the
 // given buffer size
@@ -1093,6 +1174,8 @@ private:
 
     UPerfFunction* TestGetSortKey();
     UPerfFunction* TestGetSortKeyNull();
+    UPerfFunction* TestGetSortKeys();
+    UPerfFunction* TestGetSortKeysUTF8();
 
     UPerfFunction* TestNextSortKeyPart_4All();
     UPerfFunction* TestNextSortKeyPart_4x2();
@@ -1402,6 +1485,8 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
 
     TESTCASE_AUTO(TestGetSortKey);
     TESTCASE_AUTO(TestGetSortKeyNull);
+    TESTCASE_AUTO(TestGetSortKeys);
+    TESTCASE_AUTO(TestGetSortKeysUTF8);
 
     TESTCASE_AUTO(TestNextSortKeyPart_4All);
     TESTCASE_AUTO(TestNextSortKeyPart_4x4);
@@ -1528,6 +1613,26 @@ UPerfFunction* CollPerf2Test::TestGetSortKeyNull()
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestGetSortKeys()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *source = getData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new GetSortKeys(coll, source, NULL);
+}
+
+UPerfFunction* CollPerf2Test::TestGetSortKeysUTF8()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_char *source = getData8(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new GetSortKeys(coll, NULL, source);
+}
+
 UPerfFunction* CollPerf2Test::TestNextSortKeyPart_4All()
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -116,6 +116,11 @@ UPerfFunction* ConverterPerformanceTest::runIndexedTest(int32_t index, UBool exe
         TESTCASE(52,TestWinANSI_ISO2022JP_ToUnicode);
         TESTCASE(53,TestWinANSI_ISO2022JP_FromUnicode);
 
+        TESTCASE(54,TestICU_Latin2_ToUnicode);
+        TESTCASE(55,TestICU_Latin2_FromUnicode);
+        TESTCASE(56,TestICU_Win1252_ToUnicode);
+        TESTCASE(57,TestICU_Win1252_FromUnicode);
+
         default: 
             name = ""; 
             return NULL;
@@ -657,3 +662,42 @@ UPerfFunction*  ConverterPerformanceTest::TestWinANSI_ISO2022JP_ToUnicode(){
     }
     return pf;
 }
+
+//##################
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Latin2_FromUnicode(){
+    UErrorCode status = U_ZERO_ERROR;
+    ICUFromUnicodePerfFunction* pf = new ICUFromUnicodePerfFunction("iso-8859-2",latin2_uniSource, UPRV_LENGTHOF(latin2_uniSource), status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction*  ConverterPerformanceTest::TestICU_Latin2_ToUnicode(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUToUnicodePerfFunction("iso-8859-2",(char*)latin2_encSource, UPRV_LENGTHOF(latin2_encSource), status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+// windows-1252 is a table-based single-byte converter, unlike the algorithmic iso-8859-1 one.
+UPerfFunction* ConverterPerformanceTest::TestICU_Win1252_FromUnicode(){
+    UErrorCode status = U_ZERO_ERROR;
+    ICUFromUnicodePerfFunction* pf = new ICUFromUnicodePerfFunction("windows-1252",latin1_uniSource, UPRV_LENGTHOF(latin1_uniSource), status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction*  ConverterPerformanceTest::TestICU_Win1252_ToUnicode(){
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction* pf = new ICUToUnicodePerfFunction("windows-1252",(char*)latin1_encSource, UPRV_LENGTHOF(latin1_encSource), status);
+    if(U_FAILURE(status)){
+        return NULL;
+    }
+    return pf;
+}
@@ -529,6 +529,11 @@ public:
     UPerfFunction* TestWinIML2_Latin8_ToUnicode();
     UPerfFunction* TestWinIML2_Latin8_FromUnicode();
 
+    UPerfFunction* TestICU_Latin2_ToUnicode();
+    UPerfFunction* TestICU_Latin2_FromUnicode();
+    UPerfFunction* TestICU_Win1252_ToUnicode();
+    UPerfFunction* TestICU_Win1252_FromUnicode();
+
     
     UPerfFunction* TestICU_SJIS_ToUnicode();
     UPerfFunction* TestICU_SJIS_FromUnicode();
@@ -24,10 +24,15 @@
  *  ./dicttrieperf --sourcedir <ICU build tree>/data/out/tmp --passes 3 --iterations 1000
  * or
  *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/thaidict.txt --passes 3 --iterations 250
+ * or, for Chinese/Japanese word breaking with the cjdict.dict from the ICU data,
+ * on text made of the dictionary's words,
+ *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/dictionaries/cjdict.txt --passes 3 --iterations 10 \
+ *      cjkwordbreak ucharsdictmatches indexeddictmatches
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "unicode/brkiter.h"
 #include "unicode/bytestrie.h"
 #include "unicode/bytestriebuilder.h"
 #include "unicode/localpointer.h"
@@ -36,8 +41,10 @@
 #include "unicode/uperf.h"
 #include "unicode/utext.h"
 #include "charstr.h"
+#include "dictionarydata.h"
 #include "package.h"
 #include "toolutil.h"
+#include "ubrkimpl.h"
 #include "ucbuf.h"  // struct ULine
 #include "uoptions.h"
 #include "uvectr32.h"
@@ -642,6 +649,107 @@ public:
     }
 };
 
+// Performance test function object.
+// Runs Chinese/Japanese dictionary segmentation over a text made of the words
+// from the dictionary text file, with an ideographic full stop after every tenth word.
+// For example, <ICU source dir>/source/data/brkitr/dictionaries/cjdict.txt.
+class CjkDictText : public DictLookup {
+public:
+    CjkDictText(const DictionaryTriePerfTest &perfTest) : DictLookup(perfTest) {
+        const ULine *lines=perf.getCachedLines();
+        int32_t numLines=perf.getNumLines();
+        int32_t numWords=0;
+        for(int32_t i=0; i<numLines; ++i) {
+            // Skip comment lines (start with a character below 'A').
+            if(lines[i].name[0]<0x41) {
+                continue;
+            }
+            // Each line has a word, optionally followed by a tab and its value.
+            int32_t len=0;
+            while(len<lines[i].len && lines[i].name[len]!=9 && lines[i].name[len]!=0x20) {
+                ++len;
+            }
+            text.append(lines[i].name, len);
+            if(++numWords%10==0) {
+                text.append((UChar)0x3002);
+            }
+        }
+    }
+
+    virtual long getOperationsPerIteration() {
+        return text.length();
+    }
+
+protected:
+    UnicodeString text;
+};
+
+class CjkWordBreak : public CjkDictText {
+public:
+    CjkWordBreak(const DictionaryTriePerfTest &perfTest) : CjkDictText(perfTest) {
+        IcuToolErrorCode errorCode("CjkWordBreak()");
+        bi.adoptInstead(BreakIterator::createWordInstance("ja", errorCode));
+    }
+
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        if(bi.isNull()) {
+            return;
+        }
+        // Start with a fresh dictionary cache in each iteration.
+        bi->setText(text);
+        int32_t count=0;
+        for(int32_t b=bi->first(); b!=BreakIterator::DONE; b=bi->next()) {
+            ++count;
+        }
+        if(count<2) {
+            fprintf(stderr, "no words found\n");
+        }
+    }
+
+protected:
+    LocalPointer<BreakIterator> bi;
+};
+
+// Calls a cjdict.dict matcher at every position of the text, as the CjkBreakEngine does.
+class CjkDictMatches : public CjkDictText {
+public:
+    CjkDictMatches(const DictionaryTriePerfTest &perfTest, UBool indexed) : CjkDictText(perfTest) {
+        IcuToolErrorCode errorCode("CjkDictMatches()");
+        UDataMemory *file=udata_open(U_ICUDATA_BRKITR, "dict", "cjdict", errorCode);
+        if(errorCode.isSuccess()) {
+            const uint8_t *data=(const uint8_t *)udata_getMemory(file);
+            const int32_t *indexes=(const int32_t *)data;
+            const UChar *characters=
+                (const UChar *)(data+indexes[DictionaryData::IX_STRING_TRIE_OFFSET]);
+            if(indexed) {
+                matcher.adoptInstead(new IndexedUCharsDictionaryMatcher(characters, file));
+            } else {
+                matcher.adoptInstead(new UCharsDictionaryMatcher(characters, file));
+            }
+        }
+    }
+
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        if(matcher.isNull()) {
+            return;
+        }
+        const UChar *s=text.getBuffer();
+        int32_t length=text.length();
+        int32_t lengths[20], values[20];
+        long count=0;
+        for(int32_t i=0; i<length; ++i) {
+            count+=matcher->matchesUChars(s+i, length-i, 20, UPRV_LENGTHOF(lengths),
+                                          NULL, lengths, values, NULL);
+        }
+        if(count<length/4) {
+            fprintf(stderr, "too few words found\n");
+        }
+    }
+
+protected:
+    LocalPointer<DictionaryMatcher> matcher;
+};
+
 UPerfFunction *DictionaryTriePerfTest::runIndexedTest(int32_t index, UBool exec,
                                                       const char *&name, char * /*par*/) {
     if(hasFile()) {
@@ -670,6 +778,24 @@ UPerfFunction *DictionaryTriePerfTest::runIndexedTest(int32_t index, UBool exec,
                 return new BytesTrieDictContains(*this);
             }
             break;
+        case 4:
+            name="cjkwordbreak";
+            if(exec) {
+                return new CjkWordBreak(*this);
+            }
+            break;
+        case 5:
+            name="ucharsdictmatches";
+            if(exec) {
+                return new CjkDictMatches(*this, FALSE);
+            }
+            break;
+        case 6:
+            name="indexeddictmatches";
+            if(exec) {
+                return new CjkDictMatches(*this, TRUE);
+            }
+            break;
         default:
             name="";
             break;
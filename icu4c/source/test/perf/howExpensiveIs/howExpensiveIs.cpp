@@ -9,6 +9,7 @@
  ***********************************************************************
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "cmemory.h"
@@ -18,13 +19,14 @@
 #include "unicode/ustring.h"
 #include "unicode/decimfmt.h"
 #include "unicode/udat.h"
+#include "unicode/udata.h"
 U_NAMESPACE_USE
 
 #if U_PLATFORM_IMPLEMENTS_POSIX
 #include <unistd.h>
 
 static void usage(const char *prog) {
-  fprintf(stderr, "Usage: %s [ -f outfile.xml ] [ -t 'TestName' ]\n", prog);
+  fprintf(stderr, "Usage: %s [ -f outfile.xml ] [ -t 'TestName' ] [ -m mappingHints ]\n", prog);
 }
 #endif
 
@@ -46,6 +48,7 @@ const char *testName = NULL;
 const char *progname = NULL;
 int errflg = 0;
 int testhit = 0;
+int32_t mappingHints = UDATA_MAP_NO_HINTS;
 
 int testMatch(const char *aName) {
   if(testName==NULL) return 1;
@@ -73,7 +76,7 @@ int main(int argc, char * const * argv){
   int c;
   //extern int optind;
   extern char *optarg;
-  while((c=getopt(argc,argv,"lf:t:")) != EOF) {
+  while((c=getopt(argc,argv,"lf:t:m:")) != EOF) {
     switch(c) {
     case 'f':
       outName = optarg;
@@ -84,6 +87,9 @@ int main(int argc, char * const * argv){
     case 't':
       testName = optarg;
       break;
+    case 'm':
+      mappingHints = (int32_t)strtol(optarg, NULL, 0);
+      break;
     case '?':
       errflg++;
     }
@@ -130,6 +136,12 @@ int main(int argc, char * const * argv){
   }
 
 
+  if(mappingHints != UDATA_MAP_NO_HINTS) {
+    // must be set before any data is loaded
+    udata_setMappingHints(mappingHints, &setupStatus);
+    fprintf(stderr, "# data mapping hints: 0x%x\n", (int)mappingHints);
+  }
+
   runTests();
 
 
@@ -740,6 +752,8 @@ OpenCloseTest(gb18030,ucnv,open,{},("gb18030",&setupStatus),{})
 #endif
 #include "unicode/ures.h"
 OpenCloseTest(root,ures,open,{},(NULL,"root",&setupStatus),{})
+OpenCloseTest(de_CH,ures,open,{},(NULL,"de_CH",&setupStatus),{})
+OpenCloseTest(cnvalias,udata,open,{},(NULL,"icu","cnvalias",&setupStatus),{})
 
 void runTests() {
   {
@@ -864,6 +878,14 @@ void runTests() {
     Test_ures_openroot t;
     runTestOn(t);
   }
+  {
+    Test_ures_opende_CH t;
+    runTestOn(t);
+  }
+  {
+    Test_udata_opencnvalias t;
+    runTestOn(t);
+  }
 
   if(testhit==0) {
     fprintf(stderr, "ERROR: no tests matched.\n");
@@ -66,6 +66,32 @@ UPerfFunction* NormalizerPerformanceTest::runIndexedTest(int32_t index, UBool ex
         TESTCASE(31,TestIsNormalized_FCD_NFC_Text);
         TESTCASE(32,TestIsNormalized_FCD_Orig_Text);
 
+        TESTCASE(33,TestICU_NFC_UTF8_NFD_Text);
+        TESTCASE(34,TestICU_NFC_UTF8_NFC_Text);
+        TESTCASE(35,TestICU_NFC_UTF8_Orig_Text);
+
+        TESTCASE(36,TestICU_NFD_UTF8_NFD_Text);
+        TESTCASE(37,TestICU_NFD_UTF8_NFC_Text);
+        TESTCASE(38,TestICU_NFD_UTF8_Orig_Text);
+
+        TESTCASE(39,TestICU_NFKC_UTF8_NFD_Text);
+        TESTCASE(40,TestICU_NFKC_UTF8_NFC_Text);
+        TESTCASE(41,TestICU_NFKC_UTF8_Orig_Text);
+
+        TESTCASE(42,TestICU_NFKD_UTF8_NFD_Text);
+        TESTCASE(43,TestICU_NFKD_UTF8_NFC_Text);
+        TESTCASE(44,TestICU_NFKD_UTF8_Orig_Text);
+
+        TESTCASE(45,TestICU_NFC_UTF8RoundTrip_Orig_Text);
+        TESTCASE(46,TestICU_NFD_UTF8RoundTrip_Orig_Text);
+        TESTCASE(47,TestICU_NFKC_UTF8RoundTrip_Orig_Text);
+        TESTCASE(48,TestICU_NFKD_UTF8RoundTrip_Orig_Text);
+
+        TESTCASE(49,TestIsNormalizedUTF8_NFC_NFC_Text);
+        TESTCASE(50,TestIsNormalizedUTF8_NFC_Orig_Text);
+        TESTCASE(51,TestIsNormalizedUTF8_NFD_NFD_Text);
+        TESTCASE(52,TestIsNormalizedUTF8_NFD_Orig_Text);
+
         default: 
             name = ""; 
             return NULL;
@@ -124,6 +150,7 @@ NormalizerPerformanceTest::NormalizerPerformanceTest(int32_t argc, const char* a
     NFCBufferLen = 0;
     NFDFileLines = NULL;
     NFCFileLines = NULL;
+    nfc = nfd = nfkc = nfkd = NULL;
 
     if(status== U_ILLEGAL_ARGUMENT_ERROR){
        fprintf(stderr,gUsageString, "normperf");
@@ -135,6 +162,15 @@ NormalizerPerformanceTest::NormalizerPerformanceTest(int32_t argc, const char* a
         return;
     }
 
+    nfc = Normalizer2::getNFCInstance(status);
+    nfd = Normalizer2::getNFDInstance(status);
+    nfkc = Normalizer2::getNFKCInstance(status);
+    nfkd = Normalizer2::getNFKDInstance(status);
+    if(U_FAILURE(status)){
+        fprintf(stderr, "FAILED to get Normalizer2 instances. Error: %s\n", u_errorName(status));
+        return;
+    }
+
     _remainingArgc = u_parseArgs(_remainingArgc, (char **)argv, UPRV_LENGTHOF(cmdLineOptions), cmdLineOptions);
     if(cmdLineOptions[0].doesOccur && cmdLineOptions[0].value!=NULL) {
         options=(int32_t)strtol(cmdLineOptions[0].value, NULL, 16);
@@ -494,6 +530,83 @@ UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_FCD_Orig_Text(){
     }
 }
 
+// Test UTF-8 Performance
+UPerfFunction* NormalizerPerformanceTest::newUTF8Function(const Normalizer2* n2, NormUTF8Mode mode,
+                                                          ULine* fileLines, const UChar* buf, int32_t bufLen){
+    if(line_mode){
+        return new NormUTF8PerfFunction(n2, mode, fileLines, numLines);
+    }else{
+        return new NormUTF8PerfFunction(n2, mode, buf, bufLen);
+    }
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFC_UTF8_NFD_Text(){
+    return newUTF8Function(nfc, UTF8_NORMALIZE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFC_UTF8_NFC_Text(){
+    return newUTF8Function(nfc, UTF8_NORMALIZE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFC_UTF8_Orig_Text(){
+    return newUTF8Function(nfc, UTF8_NORMALIZE, lines, buffer, bufferLen);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFD_UTF8_NFD_Text(){
+    return newUTF8Function(nfd, UTF8_NORMALIZE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFD_UTF8_NFC_Text(){
+    return newUTF8Function(nfd, UTF8_NORMALIZE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFD_UTF8_Orig_Text(){
+    return newUTF8Function(nfd, UTF8_NORMALIZE, lines, buffer, bufferLen);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKC_UTF8_NFD_Text(){
+    return newUTF8Function(nfkc, UTF8_NORMALIZE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKC_UTF8_NFC_Text(){
+    return newUTF8Function(nfkc, UTF8_NORMALIZE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKC_UTF8_Orig_Text(){
+    return newUTF8Function(nfkc, UTF8_NORMALIZE, lines, buffer, bufferLen);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKD_UTF8_NFD_Text(){
+    return newUTF8Function(nfkd, UTF8_NORMALIZE, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKD_UTF8_NFC_Text(){
+    return newUTF8Function(nfkd, UTF8_NORMALIZE, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKD_UTF8_Orig_Text(){
+    return newUTF8Function(nfkd, UTF8_NORMALIZE, lines, buffer, bufferLen);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFC_UTF8RoundTrip_Orig_Text(){
+    return newUTF8Function(nfc, UTF8_ROUND_TRIP, lines, buffer, bufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFD_UTF8RoundTrip_Orig_Text(){
+    return newUTF8Function(nfd, UTF8_ROUND_TRIP, lines, buffer, bufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKC_UTF8RoundTrip_Orig_Text(){
+    return newUTF8Function(nfkc, UTF8_ROUND_TRIP, lines, buffer, bufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestICU_NFKD_UTF8RoundTrip_Orig_Text(){
+    return newUTF8Function(nfkd, UTF8_ROUND_TRIP, lines, buffer, bufferLen);
+}
+
+// Test isNormalizedUTF8 Performance
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8_NFC_NFC_Text(){
+    return newUTF8Function(nfc, UTF8_IS_NORMALIZED, NFCFileLines, NFCBuffer, NFCBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8_NFC_Orig_Text(){
+    return newUTF8Function(nfc, UTF8_IS_NORMALIZED, lines, buffer, bufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8_NFD_NFD_Text(){
+    return newUTF8Function(nfd, UTF8_IS_NORMALIZED, NFDFileLines, NFDBuffer, NFDBufferLen);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8_NFD_Orig_Text(){
+    return newUTF8Function(nfd, UTF8_IS_NORMALIZED, lines, buffer, bufferLen);
+}
+
 int main(int argc, const char* argv[]){
     UErrorCode status = U_ZERO_ERROR;
     NormalizerPerformanceTest test(argc, argv, status);
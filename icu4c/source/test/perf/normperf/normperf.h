@@ -13,10 +13,13 @@
 #define _NORMPERF_H
 
 #include "unicode/unorm.h"
+#include "unicode/bytestream.h"
+#include "unicode/normalizer2.h"
 #include "unicode/ustring.h"
 
 #include "unicode/uperf.h"
 #include <stdlib.h>
+#include <string>
 
 //  Stubs for Windows API functions when building on UNIXes.
 //
@@ -178,6 +181,64 @@ public:
 
 
 
+// Normalizes UTF-8 text with Normalizer2::normalizeUTF8(),
+// or for comparison by converting to UTF-16, normalizing, and converting back,
+// or checks it with Normalizer2::isNormalizedUTF8().
+// Operations are counted in UTF-16 units like for the other tests.
+enum NormUTF8Mode { UTF8_NORMALIZE, UTF8_ROUND_TRIP, UTF8_IS_NORMALIZED };
+
+class NormUTF8PerfFunction : public UPerfFunction{
+private:
+    const Normalizer2* n2;
+    NormUTF8Mode mode;
+    UBool retVal;
+    std::string* strings;
+    int32_t numStrings;
+    int32_t numUChars;
+    std::string dest;
+
+    void setString(int32_t i, const UChar* s, int32_t len){
+        UnicodeString(FALSE, s, len).toUTF8String(strings[i]);
+        numUChars += len;
+    }
+
+public:
+    virtual void call(UErrorCode* status){
+        for(int32_t i = 0; i< numStrings; i++){
+            if(mode==UTF8_IS_NORMALIZED){
+                retVal = n2->isNormalizedUTF8(strings[i], *status);
+                continue;
+            }
+            dest.clear();
+            StringByteSink<std::string> sink(&dest);
+            if(mode==UTF8_ROUND_TRIP){
+                n2->normalize(UnicodeString::fromUTF8(strings[i]), *status).toUTF8(sink);
+            }else{
+                n2->normalizeUTF8(0, strings[i], sink, NULL, *status);
+            }
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return numUChars;
+    }
+    NormUTF8PerfFunction(const Normalizer2* normalizer, NormUTF8Mode _mode, ULine* srcLines,int32_t srcNumLines)
+            : n2(normalizer), mode(_mode), retVal(FALSE), numStrings(srcNumLines), numUChars(0) {
+        strings = new std::string[numStrings];
+        for(int32_t i = 0; i< numStrings; i++){
+            setString(i, srcLines[i].name, srcLines[i].len);
+        }
+    }
+    NormUTF8PerfFunction(const Normalizer2* normalizer, NormUTF8Mode _mode, const UChar* source,int32_t sourceLen)
+            : n2(normalizer), mode(_mode), retVal(FALSE), numStrings(1), numUChars(0) {
+        strings = new std::string[1];
+        setString(0, source, sourceLen);
+    }
+    ~NormUTF8PerfFunction(){
+        delete[] strings;
+    }
+};
+
+
 class  NormalizerPerformanceTest : public UPerfTest{
 private:
     ULine* NFDFileLines;
@@ -189,9 +250,15 @@ private:
     int32_t NFDBufferLen;
     int32_t NFCBufferLen;
     int32_t options;
+    const Normalizer2* nfc;
+    const Normalizer2* nfd;
+    const Normalizer2* nfkc;
+    const Normalizer2* nfkd;
 
     void normalizeInput(ULine* dest,const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
     UChar* normalizeInput(int32_t& len, const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
+    UPerfFunction* newUTF8Function(const Normalizer2* n2, NormUTF8Mode mode,
+                                   ULine* fileLines, const UChar* buf, int32_t bufLen);
 
 public:
 
@@ -249,6 +316,35 @@ public:
     UPerfFunction* TestIsNormalized_FCD_NFC_Text();
     UPerfFunction* TestIsNormalized_FCD_Orig_Text();
 
+    /* UTF-8 performance */
+    UPerfFunction* TestICU_NFC_UTF8_NFD_Text();
+    UPerfFunction* TestICU_NFC_UTF8_NFC_Text();
+    UPerfFunction* TestICU_NFC_UTF8_Orig_Text();
+
+    UPerfFunction* TestICU_NFD_UTF8_NFD_Text();
+    UPerfFunction* TestICU_NFD_UTF8_NFC_Text();
+    UPerfFunction* TestICU_NFD_UTF8_Orig_Text();
+
+    UPerfFunction* TestICU_NFKC_UTF8_NFD_Text();
+    UPerfFunction* TestICU_NFKC_UTF8_NFC_Text();
+    UPerfFunction* TestICU_NFKC_UTF8_Orig_Text();
+
+    UPerfFunction* TestICU_NFKD_UTF8_NFD_Text();
+    UPerfFunction* TestICU_NFKD_UTF8_NFC_Text();
+    UPerfFunction* TestICU_NFKD_UTF8_Orig_Text();
+
+    /* UTF-8 via UTF-16 performance, for comparison */
+    UPerfFunction* TestICU_NFC_UTF8RoundTrip_Orig_Text();
+    UPerfFunction* TestICU_NFD_UTF8RoundTrip_Orig_Text();
+    UPerfFunction* TestICU_NFKC_UTF8RoundTrip_Orig_Text();
+    UPerfFunction* TestICU_NFKD_UTF8RoundTrip_Orig_Text();
+
+    /* isNormalizedUTF8 performance */
+    UPerfFunction* TestIsNormalizedUTF8_NFC_NFC_Text();
+    UPerfFunction* TestIsNormalizedUTF8_NFC_Orig_Text();
+    UPerfFunction* TestIsNormalizedUTF8_NFD_NFD_Text();
+    UPerfFunction* TestIsNormalizedUTF8_NFD_Orig_Text();
+
 };
 
 //---------------------------------------------------------------------------------------
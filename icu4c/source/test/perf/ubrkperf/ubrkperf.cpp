@@ -160,6 +160,21 @@ UPerfFunction* BreakIteratorPerformanceTest::TestICUIsBound()
   return new ICUIsBound(locale, m_mode_, m_file_, m_fileLen_);
 }
 
+UPerfFunction* BreakIteratorPerformanceTest::TestICUForwardUTF8()
+{
+  return new ICUForwardUTF8(locale, m_mode_, m_file_, m_fileLen_);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetAllBoundaries()
+{
+  return new ICUGetAllBoundaries(locale, m_mode_, m_file_, m_fileLen_);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetAllBoundariesParallel()
+{
+  return new ICUGetAllBoundariesParallel(locale, m_mode_, m_file_, m_fileLen_);
+}
+
 UPerfFunction* BreakIteratorPerformanceTest::TestDarwinForward()
 {
   return NULL;
@@ -179,6 +194,9 @@ UPerfFunction* BreakIteratorPerformanceTest::runIndexedTest(int32_t index, UBool
 		TESTCASE(1, TestICUIsBound);
 		TESTCASE(2, TestDarwinForward);
 		TESTCASE(3, TestDarwinIsBound);
+		TESTCASE(4, TestICUForwardUTF8);
+		TESTCASE(5, TestICUGetAllBoundaries);
+		TESTCASE(6, TestICUGetAllBoundariesParallel);
         default: 
             name = ""; 
             return NULL;
@@ -192,15 +210,12 @@ UOption options[]={
 
 
 BreakIteratorPerformanceTest::BreakIteratorPerformanceTest(int32_t argc, const char* argv[], UErrorCode& status)
-: UPerfTest(argc,argv,status),
+: UPerfTest(argc,argv,options,UPRV_LENGTHOF(options),NULL,status),
 m_mode_(NULL),
 m_file_(NULL),
 m_fileLen_(0)
 {
 
-    _remainingArgc = u_parseArgs(_remainingArgc, (char**)argv, UPRV_LENGTHOF(options), options);
-
-
     if(options[0].doesOccur) {
       m_mode_ = options[0].value;
       switch(options[0].value[0]) {
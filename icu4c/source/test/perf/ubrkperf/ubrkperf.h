@@ -15,12 +15,19 @@
 #include "unicode/uperf.h"
 
 #include <unicode/brkiter.h>
+#include <unicode/rbbi.h>
+#include <unicode/ustring.h>
+#include <unicode/utext.h>
+
+#include <thread>
+#include <vector>
 
 class ICUBreakFunction : public UPerfFunction {
 protected:
   BreakIterator *m_brkIt_;
   const UChar *m_file_;
   int32_t m_fileLen_;
+  UnicodeString m_text_;  // aliases m_file_, must outlive the text set on m_brkIt_
   int32_t m_noBreaks_;
   UErrorCode m_status_;
 public:
@@ -28,6 +35,7 @@ public:
       m_brkIt_(NULL),
       m_file_(file),
       m_fileLen_(file_len),
+      m_text_(FALSE, file, file_len),
       m_noBreaks_(-1),
       m_status_(U_ZERO_ERROR)
   {
@@ -64,7 +72,7 @@ public:
       ICUBreakFunction(locale, mode, file, file_len)
   {
     m_noBreaks_ = 0;
-    m_brkIt_->setText(UnicodeString(m_file_, m_fileLen_));
+    m_brkIt_->setText(m_text_);
     m_brkIt_->first();
     int32_t j = 0;
     for(j = 0; j < m_fileLen_; j++) {
@@ -91,12 +99,51 @@ public:
       ICUBreakFunction(locale, mode, file, file_len)
   {
     m_noBreaks_ = 0;
-    m_brkIt_->setText(UnicodeString(m_file_, m_fileLen_));
+    m_brkIt_->setText(m_text_);
+    m_brkIt_->first();
+    while(m_brkIt_->next() != BreakIterator::DONE) {
+      m_noBreaks_++;
+    }
+  }
+  virtual void call(UErrorCode *status) 
+  {
+    m_noBreaks_ = 0;
+    m_brkIt_->first();
+    while(m_brkIt_->next() != BreakIterator::DONE) {
+      m_noBreaks_++;
+    }
+  }
+};
+
+class ICUForwardUTF8 : public ICUBreakFunction {
+private:
+  char *m_utf8_;
+  UText *m_text_;
+public:
+  ICUForwardUTF8(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_utf8_(NULL),
+      m_text_(NULL)
+  {
+    int32_t utf8Len = 0;
+    UErrorCode preflightStatus = U_ZERO_ERROR;
+    u_strToUTF8(NULL, 0, &utf8Len, m_file_, m_fileLen_, &preflightStatus);
+    m_utf8_ = new char[utf8Len + 1];
+    u_strToUTF8(m_utf8_, utf8Len + 1, NULL, m_file_, m_fileLen_, &m_status_);
+    m_text_ = utext_openUTF8(NULL, m_utf8_, utf8Len, &m_status_);
+    m_brkIt_->setText(m_text_, m_status_);
+    m_noBreaks_ = 0;
     m_brkIt_->first();
     while(m_brkIt_->next() != BreakIterator::DONE) {
       m_noBreaks_++;
     }
   }
+  ~ICUForwardUTF8() {
+    delete m_brkIt_;
+    m_brkIt_ = NULL;  // before the text that it refers to is closed
+    utext_close(m_text_);
+    delete[] m_utf8_;
+  }
   virtual void call(UErrorCode *status) 
   {
     m_noBreaks_ = 0;
@@ -107,6 +154,62 @@ public:
   }
 };
 
+class ICUGetAllBoundaries : public ICUBreakFunction {
+protected:
+  int32_t *m_boundaries_;
+  int32_t *m_statuses_;
+  int32_t m_capacity_;
+public:
+  ICUGetAllBoundaries(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len),
+      m_boundaries_(NULL),
+      m_statuses_(NULL),
+      m_capacity_(0)
+  {
+    m_brkIt_->setText(m_text_);
+    UErrorCode preflightStatus = U_ZERO_ERROR;
+    m_capacity_ = m_brkIt_->getAllBoundaries(NULL, NULL, 0, preflightStatus);
+    m_boundaries_ = new int32_t[m_capacity_];
+    m_statuses_ = new int32_t[m_capacity_];
+    m_noBreaks_ = m_capacity_ - 1;  // not counting the start of the text, like ICUForward
+  }
+  ~ICUGetAllBoundaries() {
+    delete[] m_boundaries_;
+    delete[] m_statuses_;
+  }
+  virtual void call(UErrorCode *status)
+  {
+    m_brkIt_->getAllBoundaries(m_boundaries_, m_statuses_, m_capacity_, *status);
+  }
+};
+
+class ICUGetAllBoundariesParallel : public ICUGetAllBoundaries {
+public:
+  ICUGetAllBoundariesParallel(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUGetAllBoundaries(locale, mode, file, file_len) {}
+  virtual void call(UErrorCode *status)
+  {
+    // All of the standard break iterators are rule-based.
+    static_cast<RuleBasedBreakIterator *>(m_brkIt_)->getAllBoundariesParallel(
+        m_boundaries_, m_statuses_, m_capacity_, (int32_t)std::thread::hardware_concurrency(),
+        runTasks, NULL, *status);
+  }
+private:
+  // Runs task 0 on this thread and each other task on a new thread.
+  static void U_CALLCONV runTasks(const void * /*context*/, UBreakIteratorTask *task, void *taskContext,
+                                  int32_t count)
+  {
+    std::vector<std::thread> threads;
+    for (int32_t i = 1; i < count; ++i) {
+      threads.push_back(std::thread(task, taskContext, i));
+    }
+    task(taskContext, 0);
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+  }
+};
+
 class DarwinBreakFunction : public UPerfFunction {
 public:
   virtual void call(UErrorCode *status) {};
@@ -127,6 +230,9 @@ public:
 
   UPerfFunction* TestICUForward();
   UPerfFunction* TestICUIsBound();
+  UPerfFunction* TestICUForwardUTF8();
+  UPerfFunction* TestICUGetAllBoundaries();
+  UPerfFunction* TestICUGetAllBoundariesParallel();
 
   UPerfFunction* TestDarwinForward();
   UPerfFunction* TestDarwinIsBound();
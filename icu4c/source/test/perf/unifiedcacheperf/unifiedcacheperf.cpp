@@ -0,0 +1,169 @@
+// © 2018 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+ ***********************************************************************
+ *  file name:  unifiedcacheperf.cpp
+ *  encoding:   UTF-8
+ *  tab size:   8 (not used)
+ *  indentation:4
+ *
+ *  Multithreaded performance test program for UnifiedCache hits.
+ *
+ *  Each test runs a fixed number of threads which repeatedly fetch
+ *  already-cached values from the global UnifiedCache. With little lock
+ *  contention, operations per second grow close to linearly with the
+ *  number of threads, up to the number of cores.
+ *
+ * Usage from within <ICU build tree>/test/perf/unifiedcacheperf/ :
+ * (Linux)
+ *  make
+ *  export LD_LIBRARY_PATH=../../../lib:../../../stubdata:../../../tools/ctestfw
+ *  ./unifiedcacheperf --passes 3 --iterations 20
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include "unicode/uperf.h"
+#include "cmemory.h"
+#include "unifiedcache.h"
+
+// Cache value type private to this test.
+class UCPItem : public SharedObject {
+};
+
+U_NAMESPACE_BEGIN
+
+template<> U_EXPORT
+const UCPItem *LocaleCacheKey<UCPItem>::createObject(
+        const void * /*unused*/, UErrorCode &status) const {
+    UCPItem *result = new UCPItem();
+    if (result == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    result->addRef();
+    return result;
+}
+
+U_NAMESPACE_END
+
+static const char *gLocales[] = {
+    "ar", "bg", "ca", "cs", "da", "de", "de_AT", "de_CH",
+    "el", "en", "en_GB", "en_US", "es", "es_MX", "et", "fa",
+    "fi", "fr", "fr_CA", "he", "hi", "hr", "hu", "id",
+    "it", "ja", "ko", "lt", "lv", "ms", "nb", "nl",
+    "pl", "pt", "pt_PT", "ro", "ru", "sk", "sl", "sr",
+    "sv", "th", "tr", "uk", "vi", "zh", "zh_Hant", "zu"
+};
+
+// Number of cache lookups per thread per iteration.
+static const int32_t HITS_PER_THREAD = 20000;
+
+// Test object.
+class UnifiedCachePerfTest : public UPerfTest {
+public:
+    UnifiedCachePerfTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, NULL, 0, "", status), cache(NULL) {
+        cache = UnifiedCache::getInstance(status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        // Populate the cache so that all timed lookups are hits.
+        // Keep one reference to each value so that none of them is evicted.
+        for (int32_t i = 0; i < UPRV_LENGTHOF(gLocales); ++i) {
+            items[i] = NULL;
+            cache->get(LocaleCacheKey<UCPItem>(gLocales[i]), items[i], status);
+        }
+    }
+
+    virtual ~UnifiedCachePerfTest() {
+        for (int32_t i = 0; i < UPRV_LENGTHOF(gLocales); ++i) {
+            SharedObject::clearPtr(items[i]);
+        }
+    }
+
+    virtual UPerfFunction *runIndexedTest(int32_t index, UBool exec, const char *&name, char *par=NULL);
+
+    const UnifiedCache *cache;
+    const UCPItem *items[UPRV_LENGTHOF(gLocales)];
+};
+
+// Runs numThreads threads, each fetching HITS_PER_THREAD cached values.
+class CacheHits : public UPerfFunction {
+public:
+    CacheHits(const UnifiedCachePerfTest &testcase, int32_t threads)
+            : cache(testcase.cache), numThreads(threads), failures(0) {}
+
+    virtual void call(UErrorCode *pErrorCode) {
+        std::thread *threads = new std::thread[numThreads];
+        for (int32_t t = 0; t < numThreads; ++t) {
+            threads[t] = std::thread(&CacheHits::run, this, t);
+        }
+        for (int32_t t = 0; t < numThreads; ++t) {
+            threads[t].join();
+        }
+        delete[] threads;
+        if (U_SUCCESS(*pErrorCode) && umtx_loadAcquire(failures) != 0) {
+            *pErrorCode = U_INTERNAL_PROGRAM_ERROR;
+        }
+    }
+
+    virtual long getOperationsPerIteration() {
+        return (long)numThreads * HITS_PER_THREAD;
+    }
+
+private:
+    void run(int32_t threadIndex) {
+        UErrorCode status = U_ZERO_ERROR;
+        const UCPItem *item = NULL;
+        // Start each thread at a different key so that threads hit
+        // different stripes, as independent clients would.
+        int32_t localeIndex = threadIndex * 7;
+        for (int32_t i = 0; i < HITS_PER_THREAD; ++i) {
+            localeIndex = (localeIndex + 1) % UPRV_LENGTHOF(gLocales);
+            cache->get(LocaleCacheKey<UCPItem>(gLocales[localeIndex]), item, status);
+            SharedObject::clearPtr(item);
+        }
+        if (U_FAILURE(status)) {
+            umtx_atomic_inc(&failures);
+        }
+    }
+
+    const UnifiedCache *cache;
+    int32_t numThreads;
+    u_atomic_int32_t failures;
+};
+
+UPerfFunction *UnifiedCachePerfTest::runIndexedTest(int32_t index, UBool exec, const char *&name, char * /*par*/) {
+    switch (index) {
+        case 0: name = "CacheHits1Thread";      if (exec) return new CacheHits(*this, 1); break;
+        case 1: name = "CacheHits2Threads";     if (exec) return new CacheHits(*this, 2); break;
+        case 2: name = "CacheHits4Threads";     if (exec) return new CacheHits(*this, 4); break;
+        case 3: name = "CacheHits8Threads";     if (exec) return new CacheHits(*this, 8); break;
+        case 4: name = "CacheHits16Threads";    if (exec) return new CacheHits(*this, 16); break;
+        case 5: name = "CacheHits32Threads";    if (exec) return new CacheHits(*this, 32); break;
+        case 6: name = "CacheHits64Threads";    if (exec) return new CacheHits(*this, 64); break;
+        default: name = ""; break;
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[]) {
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCachePerfTest test(argc, argv, status);
+
+    if (U_FAILURE(status)){
+        printf("The error is %s\n", u_errorName(status));
+        test.usage();
+        return status;
+    }
+
+    if (test.run() == FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run please check the "
+                        "arguments.\n");
+        return -1;
+    }
+
+    return 0;
+}
@@ -328,11 +328,59 @@ protected:
     int32_t input8Length;
 };
 
+// Test u_strFromUTF8WithSub(), which does not use a converter.
+class StrFromUTF8 : public UPerfFunction {
+public:
+    StrFromUTF8(const UtfPerformanceTest &) {}
+    virtual void call(UErrorCode* pErrorCode){
+        u_strFromUTF8WithSub(output, OUTPUT_CAPACITY, &outputLength, utf8, utf8Length,
+                             0xfffd, NULL, pErrorCode);
+    }
+    virtual long getOperationsPerIteration(){
+        return countInputCodePoints;
+    }
+};
+
+// Test u_validateUTF8(), which checks UTF-8 and computes its UTF-16 length.
+class ValidateUTF8 : public UPerfFunction {
+public:
+    ValidateUTF8(const UtfPerformanceTest &) {}
+    virtual void call(UErrorCode* pErrorCode){
+        if (u_validateUTF8(utf8, utf8Length, &outputLength, pErrorCode) >= 0 &&
+                U_SUCCESS(*pErrorCode)) {
+            *pErrorCode = U_INVALID_CHAR_FOUND;
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return countInputCodePoints;
+    }
+};
+
+// Test u_strToUTF8WithSub(), which does not use a converter.
+class StrToUTF8 : public UPerfFunction {
+public:
+    StrToUTF8(const UtfPerformanceTest &testcase)
+            : input(testcase.getBuffer()), inputLength(testcase.getBufferLen()) {}
+    virtual void call(UErrorCode* pErrorCode){
+        u_strToUTF8WithSub(intermediate, OUTPUT_CAPACITY, &encodedLength, input, inputLength,
+                           0xfffd, NULL, pErrorCode);
+    }
+    virtual long getOperationsPerIteration(){
+        return countInputCodePoints;
+    }
+private:
+    const UChar *input;
+    int32_t inputLength;
+};
+
 UPerfFunction* UtfPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* par) {
     switch (index) {
         case 0: name = "Roundtrip";     if (exec) return Roundtrip::get(*this); break;
         case 1: name = "FromUnicode";   if (exec) return FromUnicode::get(*this); break;
         case 2: name = "FromUTF8";      if (exec) return FromUTF8::get(*this); break;
+        case 3: name = "StrFromUTF8";   if (exec) return new StrFromUTF8(*this); break;
+        case 4: name = "StrToUTF8";     if (exec) return new StrToUTF8(*this); break;
+        case 5: name = "ValidateUTF8";  if (exec) return new ValidateUTF8(*this); break;
         default: name = ""; break;
     }
     return NULL;
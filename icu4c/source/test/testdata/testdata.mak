@@ -81,7 +81,7 @@ $(TEST_RES_FILES:.res =.res
 # The -q option is there on purpose, so we don't see it normally.
 {$(TESTDATA)}.txt.res:: 
 	@echo Making Test Resource Bundle files $<
-	@"$(ICUTOOLS)\genrb\$(CFG)\genrb" -q -s"$(TESTDATA)" -d"$(TESTDATABLD)" $<
+	@"$(ICUTOOLS)\genrb\$(CFG)\genrb" -q --writeUTF8Strings -s"$(TESTDATA)" -d"$(TESTDATABLD)" $<
 
 "$(TESTDATABLD)\encoded.res": "$(TESTDATA)\encoded.utf16be"
 	@echo Making Test Resource Bundle file with encoding
@@ -100,7 +100,7 @@ $(TEST_RES_FILES:.res =.res
 	"$(ICUTOOLS)\gentest\$(CFG)\gentest" -r -d"$(TESTDATABLD)"
 
 "$(TESTDATABLD)\testtable32.res": "$(TESTDATABLD)\testtable32.txt"
-	"$(ICUTOOLS)\genrb\$(CFG)\genrb" -s"$(TESTDATABLD)" -d"$(TESTDATABLD)" testtable32.txt
+	"$(ICUTOOLS)\genrb\$(CFG)\genrb" --writeUTF8Strings -s"$(TESTDATABLD)" -d"$(TESTDATABLD)" testtable32.txt
 
 # Targets for nfscsi.spp
 "$(TESTDATABLD)\nfscsi.spp" : {"$(ICUTOOLS)\gensprep\$(CFG)"}gensprep.exe "$(TESTDATA)\nfs4_cs_prep_ci.txt"
@@ -976,6 +976,126 @@ createNormalizedAliasStrings(char *normalizedStrings, const char *origStringBloc
     }
 }
 
+/*
+ * Build a perfect hash of the normalized unique aliases with "hash and displace":
+ * Each alias goes into a bucket, and each bucket gets the smallest displacement
+ * value that moves all of its aliases into empty slots.
+ * Buckets with more aliases are placed first.
+ * See the description of section 10 in ucnv_io.cpp.
+ */
+typedef struct {
+    uint32_t bucket;
+    uint32_t count;
+} HashBucket;
+
+static int
+compareBucketCounts(const void *bucket1, const void *bucket2) {
+    const HashBucket *b1 = (const HashBucket *)bucket1;
+    const HashBucket *b2 = (const HashBucket *)bucket2;
+    if (b1->count != b2->count) {
+        return b1->count > b2->count ? -1 : 1;
+    }
+    return b1->bucket < b2->bucket ? -1 : (b1->bucket > b2->bucket ? 1 : 0);
+}
+
+static uint32_t
+createAliasHash(uint16_t **pAliasHash, const uint16_t *uniqueAliases, uint32_t uniqueAliasesSize, uint16_t aliasOffset) {
+    uint32_t bucketCount = (uniqueAliasesSize + 3) / 4;
+    /* the slot count and the slot indexes must fit into 16 bits */
+    uint32_t slotCount = uniqueAliasesSize + uniqueAliasesSize / 4 + 1;
+    uint32_t hashSize;
+    uint16_t *aliasHash, *displacements, *slots;
+    char (*names)[UCNV_MAX_CONVERTER_NAME_LENGTH] =
+        (char (*)[UCNV_MAX_CONVERTER_NAME_LENGTH])uprv_malloc(uniqueAliasesSize * UCNV_MAX_CONVERTER_NAME_LENGTH);
+    uint32_t *aliasBuckets = (uint32_t *)uprv_malloc(uniqueAliasesSize * sizeof(uint32_t));
+    HashBucket *buckets = (HashBucket *)uprv_malloc(bucketCount * sizeof(HashBucket));
+    uint32_t *bucketSlots = (uint32_t *)uprv_malloc(MAX_ALIAS_COUNT * sizeof(uint32_t));
+    uint32_t i, j, k, n;
+
+    if (slotCount > 0xffff) {
+        slotCount = 0xffff;
+    }
+    hashSize = 2 + bucketCount + slotCount;
+    aliasHash = (uint16_t *)uprv_malloc(hashSize * sizeof(uint16_t));
+    displacements = aliasHash + 2;
+    slots = displacements + bucketCount;
+
+    if (aliasHash == NULL || names == NULL || aliasBuckets == NULL || buckets == NULL || bucketSlots == NULL) {
+        fprintf(stderr, "gencnval: error: out of memory for the alias hash\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
+
+    aliasHash[0] = (uint16_t)bucketCount;
+    aliasHash[1] = (uint16_t)slotCount;
+    uprv_memset(displacements, 0, bucketCount * sizeof(uint16_t));
+    uprv_memset(slots, 0xff, slotCount * sizeof(uint16_t));
+
+    for (i = 0; i < bucketCount; ++i) {
+        buckets[i].bucket = i;
+        buckets[i].count = 0;
+    }
+    for (i = 0; i < uniqueAliasesSize; ++i) {
+        const char *alias = GET_ALIAS_STR(uniqueAliases[i] - aliasOffset);
+        if (uprv_strlen(alias) >= UCNV_MAX_CONVERTER_NAME_LENGTH) {
+            /* such an alias cannot be looked up anyway, but then write no hash */
+            if (!quiet) {
+                fprintf(stderr, "%s: warning: alias %s is too long, not writing the alias hash\n", path, alias);
+            }
+            uprv_free(bucketSlots);
+            uprv_free(buckets);
+            uprv_free(aliasBuckets);
+            uprv_free(names);
+            uprv_free(aliasHash);
+            *pAliasHash = NULL;
+            return 0;
+        }
+        ucnv_io_stripForCompare(names[i], alias);
+        aliasBuckets[i] = ucnv_io_hashNormalizedName(names[i], 0) % bucketCount;
+        ++buckets[aliasBuckets[i]].count;
+    }
+    qsort(buckets, bucketCount, sizeof(HashBucket), compareBucketCounts);
+
+    for (i = 0; i < bucketCount && buckets[i].count > 0; ++i) {
+        uint32_t bucket = buckets[i].bucket;
+        uint32_t displacement;
+        for (displacement = 1; displacement <= 0xffff; ++displacement) {
+            /* try to place all aliases of this bucket */
+            n = 0;
+            for (j = 0; j < uniqueAliasesSize; ++j) {
+                if (aliasBuckets[j] == bucket) {
+                    uint32_t slot = ucnv_io_hashNormalizedName(names[j], displacement) % slotCount;
+                    if (slots[slot] != 0xffff) {
+                        break;
+                    }
+                    for (k = 0; k < n && (bucketSlots[k] >> 16) != slot; ++k) {}
+                    if (k < n) {
+                        break;
+                    }
+                    bucketSlots[n++] = (slot << 16) | j;
+                }
+            }
+            if (j == uniqueAliasesSize) {
+                break;
+            }
+        }
+        if (displacement > 0xffff) {
+            fprintf(stderr, "gencnval: error: unable to build the alias hash\n");
+            exit(U_INTERNAL_PROGRAM_ERROR);
+        }
+        displacements[bucket] = (uint16_t)displacement;
+        for (k = 0; k < n; ++k) {
+            slots[bucketSlots[k] >> 16] = (uint16_t)bucketSlots[k];
+        }
+    }
+
+    uprv_free(bucketSlots);
+    uprv_free(buckets);
+    uprv_free(aliasBuckets);
+    uprv_free(names);
+    *pAliasHash = aliasHash;
+    return hashSize;
+}
+
 static void
 writeAliasTable(UNewDataMemory *out) {
     uint32_t i, j;
@@ -984,9 +1104,14 @@ writeAliasTable(UNewDataMemory *out) {
     uint16_t *aliasArrLists = (uint16_t *)uprv_malloc(tagCount * converterCount * sizeof(uint16_t));
     uint16_t *uniqueAliases = (uint16_t *)uprv_malloc(knownAliasesCount * sizeof(uint16_t));
     uint16_t *uniqueAliasesToConverter = (uint16_t *)uprv_malloc(knownAliasesCount * sizeof(uint16_t));
+    uint16_t *aliasHash = NULL;
+    uint32_t aliasHashSize = 0;
 
     qsort(knownAliases, knownAliasesCount, sizeof(knownAliases[0]), compareAliases);
     uniqueAliasesSize = resolveAliases(uniqueAliases, uniqueAliasesToConverter, aliasOffset);
+    if (tableOptions.stringNormalizationType != UCNV_IO_UNNORMALIZED && uniqueAliasesSize > 0) {
+        aliasHashSize = createAliasHash(&aliasHash, uniqueAliases, uniqueAliasesSize, aliasOffset);
+    }
 
     /* Array index starts at 1. aliasLists[0] is the size of the lists section. */
     aliasListsSize = 0;
@@ -1003,7 +1128,7 @@ writeAliasTable(UNewDataMemory *out) {
         udata_write32(out, 8);
     }
     else {
-        udata_write32(out, 9);
+        udata_write32(out, 10);
     }
 
     /* Write the sizes of each section */
@@ -1018,6 +1143,7 @@ writeAliasTable(UNewDataMemory *out) {
     udata_write32(out, (tagBlock.top + stringBlock.top) / sizeof(uint16_t));
     if (tableOptions.stringNormalizationType != UCNV_IO_UNNORMALIZED) {
         udata_write32(out, (tagBlock.top + stringBlock.top) / sizeof(uint16_t));
+        udata_write32(out, aliasHashSize);
     }
 
     /* write the table of converters */
@@ -1070,6 +1196,12 @@ writeAliasTable(UNewDataMemory *out) {
         /* Write out the complete normalized array. */
         udata_writeString(out, normalizedStrings, tagBlock.top + stringBlock.top);
         uprv_free(normalizedStrings);
+
+        /* Write the perfect hash of the normalized aliases. */
+        if (aliasHash != NULL) {
+            udata_writeBlock(out, aliasHash, aliasHashSize * sizeof(uint16_t));
+            uprv_free(aliasHash);
+        }
     }
 
     uprv_free(uniqueAliasesToConverter);
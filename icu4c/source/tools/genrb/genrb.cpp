@@ -76,7 +76,8 @@ enum
     FORMAT_VERSION,
     WRITE_POOL_BUNDLE,
     USE_POOL_BUNDLE,
-    INCLUDE_UNIHAN_COLL
+    INCLUDE_UNIHAN_COLL,
+    WRITE_UTF8_STRINGS
 };
 
 UOption options[]={
@@ -102,6 +103,7 @@ UOption options[]={
                       UOPTION_DEF("writePoolBundle", '\x01', UOPT_NO_ARG),/* 19 */
                       UOPTION_DEF("usePoolBundle", '\x01', UOPT_OPTIONAL_ARG),/* 20 */
                       UOPTION_DEF("includeUnihanColl", '\x01', UOPT_NO_ARG),/* 21 */ /* temporary, don't display in usage info */
+                      UOPTION_DEF("writeUTF8Strings", '\x01', UOPT_NO_ARG),/* 22 */
                   };
 
 static     UBool       write_java = FALSE;
@@ -148,9 +150,10 @@ main(int argc,
             fprintf(stderr, "%s: unsupported --formatVersion %s\n", argv[0], s);
             illegalArg = TRUE;
         } else if(s[0] == '1' &&
-                  (options[WRITE_POOL_BUNDLE].doesOccur || options[USE_POOL_BUNDLE].doesOccur)
+                  (options[WRITE_POOL_BUNDLE].doesOccur || options[USE_POOL_BUNDLE].doesOccur ||
+                   options[WRITE_UTF8_STRINGS].doesOccur)
         ) {
-            fprintf(stderr, "%s: cannot combine --formatVersion 1 with --writePoolBundle or --usePoolBundle\n", argv[0]);
+            fprintf(stderr, "%s: cannot combine --formatVersion 1 with --writePoolBundle, --usePoolBundle or --writeUTF8Strings\n", argv[0]);
             illegalArg = TRUE;
         } else {
             setFormatVersion(s[0] - '0');
@@ -228,6 +231,9 @@ main(int argc,
                 "\t      --usePoolBundle [path-to-pool.res]  point to keys from the pool.res keys pool bundle if they are available there;\n"
                 "\t                           makes .res files smaller but dependent on the pool bundle\n"
                 "\t                           (--writePoolBundle and --usePoolBundle cannot be combined)\n");
+        fprintf(stderr,
+                "\t      --writeUTF8Strings   also write UTF-8 copies of the string values;\n"
+                "\t                           makes .res files larger but lets ures_getUTF8String() return them without conversion\n");
 
         return illegalArg ? U_ILLEGAL_ARGUMENT_ERROR : U_ZERO_ERROR;
     }
@@ -236,6 +242,10 @@ main(int argc,
         setVerbose(TRUE);
     }
 
+    if(options[WRITE_UTF8_STRINGS].doesOccur) {
+        setWriteUTF8Strings(TRUE);
+    }
+
     if(options[QUIET].doesOccur) {
         setShowWarning(FALSE);
     }
@@ -66,6 +66,7 @@ U_NAMESPACE_USE
 
 static UBool gIncludeCopyright = FALSE;
 static UBool gUsePoolBundle = FALSE;
+static UBool gWriteUTF8Strings = FALSE;
 static UBool gIsDefaultFormatVersion = TRUE;
 static int32_t gFormatVersion = 3;
 
@@ -136,6 +137,10 @@ void setUsePoolBundle(UBool use) {
     gUsePoolBundle = use;
 }
 
+void setWriteUTF8Strings(UBool write) {
+    gWriteUTF8Strings = write;
+}
+
 // TODO: return const pointer, or find another way to express "none"
 struct SResource* res_none() {
     return &kNoResource;
@@ -883,6 +888,9 @@ void SRBRoot::write(const char *outputDir, const char *outputPkg,
     }
     if (fStringsForm == STRINGS_UTF16_V2 && f16BitStringsLength > 0) {
         compactStringsV2(stringSet, errorCode);
+        if (gWriteUTF8Strings) {
+            collectUTF8Strings(stringSet, errorCode);
+        }
     }
     uhash_close(stringSet);
     if (U_FAILURE(errorCode)) {
@@ -931,6 +939,19 @@ void SRBRoot::write(const char *outputDir, const char *outputPkg,
     /* total size including the root item */
     top = byteOffset;
 
+    /* size including the optional UTF-8 strings after the resources */
+    uint32_t bundleTop = top;
+    int32_t utf8Count = fUTF8Strings.size() / 3;
+    if (utf8Count > 0) {
+        while (fUTF8Bytes.length() & 3) {
+            fUTF8Bytes.append((char)0xaa, errorCode);
+        }
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        bundleTop += (URES_UTF8_STRINGS_HEADER_LENGTH + fUTF8Strings.size()) * 4 + fUTF8Bytes.length();
+    }
+
     if (writtenFilename && writtenFilenameLen) {
         *writtenFilename = 0;
     }
@@ -1005,7 +1026,7 @@ void SRBRoot::write(const char *outputDir, const char *outputPkg,
     indexes[URES_INDEX_LENGTH]=             fIndexLength;
     indexes[URES_INDEX_KEYS_TOP]=           fKeysTop>>2;
     indexes[URES_INDEX_RESOURCES_TOP]=      (int32_t)(top>>2);
-    indexes[URES_INDEX_BUNDLE_TOP]=         indexes[URES_INDEX_RESOURCES_TOP];
+    indexes[URES_INDEX_BUNDLE_TOP]=         (int32_t)(bundleTop>>2);
     indexes[URES_INDEX_MAX_TABLE_LENGTH]=   fMaxTableLength;
 
     /*
@@ -1053,6 +1074,9 @@ void SRBRoot::write(const char *outputDir, const char *outputPkg,
             indexes[URES_INDEX_POOL_CHECKSUM] = fUsePoolBundle->fChecksum;
         }
     }
+    if (utf8Count > 0) {
+        indexes[URES_INDEX_ATTRIBUTES] |= URES_ATT_HAS_UTF8_STRINGS;
+    }
     // formatVersion 3 (ICU 56):
     // share string values via pool bundle strings
     indexes[URES_INDEX_LENGTH] |= fPoolStringIndexLimit << 8;  // bits 23..0 -> 31..8
@@ -1074,10 +1098,23 @@ void SRBRoot::write(const char *outputDir, const char *outputPkg,
     fRoot->write(mem, &byteOffset);
     assert(byteOffset == top);
 
+    /* write the UTF-8 strings table: header, then each of the three int32_t columns, then the bytes */
+    if (utf8Count > 0) {
+        udata_write32(mem, utf8Count);
+        udata_write32(mem, f16BitUnits.length());
+        udata_write32(mem, fUTF8Bytes.length());
+        for (int32_t column = 0; column < 3; ++column) {
+            for (int32_t i = column; i < fUTF8Strings.size(); i += 3) {
+                udata_write32(mem, fUTF8Strings.elementAti(i));
+            }
+        }
+        udata_writeBlock(mem, fUTF8Bytes.data(), fUTF8Bytes.length());
+    }
+
     size = udata_finish(mem, &errorCode);
-    if(top != size) {
+    if(bundleTop != size) {
         fprintf(stderr, "genrb error: wrote %u bytes but counted %u\n",
-                (int)size, (int)top);
+                (int)size, (int)bundleTop);
         errorCode = U_INTERNAL_PROGRAM_ERROR;
     }
 }
@@ -1131,7 +1168,8 @@ SRBRoot::SRBRoot(const UString *comment, UBool isPoolBundle, UErrorCode &errorCo
           f16BitUnits(), f16BitStringsLength(0),
           fUsePoolBundle(&kNoPoolBundle),
           fPoolStringIndexLimit(0), fPoolStringIndex16Limit(0), fLocalStringIndexLimit(0),
-          fWritePoolBundle(NULL) {
+          fWritePoolBundle(NULL),
+          fUTF8Strings(errorCode), fUTF8Bytes() {
     if (U_FAILURE(errorCode)) {
         return;
     }
@@ -1691,3 +1729,95 @@ SRBRoot::compactStringsV2(UHashtable *stringSet, UErrorCode &errorCode) {
     // +1 to account for the initial zero in f16BitUnits
     assert(f16BitUnits.length() <= (f16BitStringsLength + 1));
 }
+
+namespace {
+
+struct UTF8StringCandidate {
+    int32_t stringIndex;
+    StringResource *res;
+};
+
+int32_t U_CALLCONV
+compareStringIndexes(const void * /*context*/, const void *l, const void *r) {
+    int32_t left = static_cast<const UTF8StringCandidate *>(l)->stringIndex;
+    int32_t right = static_cast<const UTF8StringCandidate *>(r)->stringIndex;
+    return left < right ? -1 : left > right ? 1 : 0;
+}
+
+}  // namespace
+
+/*
+ * Collects the local string-v2 values after compactStringsV2()
+ * and converts them to UTF-8 for the optional UTF-8 strings table.
+ * A suffix string points into the UTF-8 bytes of the string that contains it
+ * if those end with the suffix's UTF-8 bytes.
+ */
+void
+SRBRoot::collectUTF8Strings(UHashtable *stringSet, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    int32_t count = uhash_count(stringSet);
+    LocalArray<UTF8StringCandidate> candidates(new UTF8StringCandidate[count], errorCode);
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    // Pool bundle strings that are not used locally have fNumCopies==0,
+    // and used ones have offsets below fPoolStringIndexLimit.
+    int32_t numCandidates = 0;
+    for (int32_t pos = UHASH_FIRST, i = 0; i < count; ++i) {
+        StringResource *res = (StringResource *)uhash_nextElement(stringSet, &pos)->key.pointer;
+        int32_t offset = (int32_t)RES_GET_OFFSET(res->fRes);
+        if (RES_GET_TYPE(res->fRes) == URES_STRING_V2 && res->fNumCopies > 0 &&
+                offset >= fPoolStringIndexLimit && !res->fString.isEmpty()) {
+            candidates[numCandidates].stringIndex =
+                    offset - fPoolStringIndexLimit + res->fNumCharsForLength;
+            candidates[numCandidates].res = res;
+            ++numCandidates;
+        }
+    }
+    uprv_sortArray(candidates.getAlias(), numCandidates, (int32_t)sizeof(UTF8StringCandidate),
+                   compareStringIndexes, NULL, FALSE, &errorCode);
+
+    int32_t containerLimit = 0;  // 16-bit-units limit of the last non-suffix string
+    int32_t containerOffset8 = -1, containerLength8 = 0;
+    for (int32_t i = 0; i < numCandidates && U_SUCCESS(errorCode); ++i) {
+        const UTF8StringCandidate &c = candidates[i];
+        const UnicodeString &s = c.res->fString;
+        UBool isSuffix = c.stringIndex < containerLimit;
+        if (!isSuffix) {
+            containerLimit = c.stringIndex + s.length();
+            containerOffset8 = -1;
+        }
+        // Convert and append; skip strings with unpaired surrogates.
+        int32_t offset8 = fUTF8Bytes.length();
+        int32_t length8 = 0;
+        UErrorCode convErrorCode = U_ZERO_ERROR;
+        u_strToUTF8(NULL, 0, &length8, s.getBuffer(), s.length(), &convErrorCode);
+        if (convErrorCode == U_INVALID_CHAR_FOUND) {
+            continue;
+        }
+        int32_t capacity;
+        char *dest = fUTF8Bytes.getAppendBuffer(length8 + 1, length8 + 1, capacity, errorCode);
+        if (U_FAILURE(errorCode)) {
+            return;
+        }
+        convErrorCode = U_ZERO_ERROR;
+        u_strToUTF8(dest, capacity, NULL, s.getBuffer(), s.length(), &convErrorCode);
+        fUTF8Bytes.append(dest, length8, errorCode).append((char)0, errorCode);
+        if (isSuffix) {
+            if (containerOffset8 >= 0 && length8 <= containerLength8 &&
+                    uprv_memcmp(fUTF8Bytes.data() + containerOffset8 + containerLength8 - length8,
+                                fUTF8Bytes.data() + offset8, length8) == 0) {
+                fUTF8Bytes.truncate(offset8);
+                offset8 = containerOffset8 + containerLength8 - length8;
+            }
+        } else {
+            containerOffset8 = offset8;
+            containerLength8 = length8;
+        }
+        fUTF8Strings.addElement(c.stringIndex, errorCode);
+        fUTF8Strings.addElement(offset8, errorCode);
+        fUTF8Strings.addElement(length8, errorCode);
+    }
+}
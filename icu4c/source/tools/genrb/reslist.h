@@ -27,12 +27,14 @@
 #include "unicode/unistr.h"
 #include "unicode/ures.h"
 #include "unicode/ustring.h"
+#include "charstr.h"
 #include "cmemory.h"
 #include "cstring.h"
 #include "uhash.h"
 #include "unewdata.h"
 #include "uresdata.h"
 #include "ustr.h"
+#include "uvectr32.h"
 
 U_CDECL_BEGIN
 
@@ -89,6 +91,7 @@ struct SRBRoot {
 
 private:
     void compactStringsV2(UHashtable *stringSet, UErrorCode &errorCode);
+    void collectUTF8Strings(UHashtable *stringSet, UErrorCode &errorCode);
 
 public:
     // TODO: private
@@ -116,6 +119,11 @@ public:
   int32_t fPoolStringIndex16Limit;
   int32_t fLocalStringIndexLimit;
   SRBRoot *fWritePoolBundle;
+
+  // UTF-8 copies of local strings, see URES_ATT_HAS_UTF8_STRINGS:
+  // (stringIndex, utf8Offset, utf8Length) triples sorted by stringIndex
+  icu::UVector32 fUTF8Strings;
+  icu::CharString fUTF8Bytes;
 };
 
 /* write a java resource file */
@@ -416,6 +424,8 @@ int32_t getFormatVersion();
 
 void setUsePoolBundle(UBool use);
 
+void setWriteUTF8Strings(UBool write);
+
 /* in wrtxml.cpp */
 uint32_t computeCRC(const char *ptr, uint32_t len, uint32_t lastcrc);
 
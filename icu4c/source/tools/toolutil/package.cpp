@@ -59,6 +59,21 @@ static const UDataInfo dataInfo={
     {3, 0, 0, 0}                  /* dataVersion */
 };
 
+/* UDataInfo for the TOC hash table item, see UDataTOCHash in ucmndata.h */
+static const UDataInfo tocHashDataInfo={
+    (uint16_t)sizeof(UDataInfo),
+    0,
+
+    U_IS_BIG_ENDIAN,
+    U_CHARSET_FAMILY,
+    (uint8_t)sizeof(UChar),
+    0,
+
+    {0x54, 0x6f, 0x63, 0x48},     /* dataFormat="TocH" */
+    {1, 0, 0, 0},                 /* formatVersion */
+    {1, 0, 0, 0}                  /* dataVersion */
+};
+
 U_CDECL_BEGIN
 static void U_CALLCONV
 printPackageError(void *context, const char *fmt, va_list args) {
@@ -672,6 +687,9 @@ Package::readPackage(const char *filename) {
             // sort the item names for the local charset
             sortItems();
         }
+
+        // the TOC hash table is not a real item; writePackage() rebuilds it
+        removeItem(findItem(UDATA_TOC_HASH_ITEM_NAME));
     }
 
     udata_closeSwapper(ds);
@@ -685,13 +703,15 @@ Package::getInType() {
 void
 Package::writePackage(const char *filename, char outType, const char *comment) {
     char prefix[MAX_PKG_NAME_LENGTH+4];
-    UDataOffsetTOCEntry entry;
+    UDataOffsetTOCEntry entry, *localEntries;
     UDataSwapper *dsLocalToOut, *ds[TYPE_COUNT];
     FILE *file;
     Item *pItem;
     char *name;
     UErrorCode errorCode;
     int32_t i, length, prefixLength, maxItemLength, basenameOffset, offset, outInt32;
+    int32_t hashHeaderLength, hashLength, slotCount;
+    uint8_t *hashData;
     uint8_t outCharset;
     UBool outIsBigEndian;
 
@@ -723,6 +743,26 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
 
     makeTypeProps(outType, outCharset, outIsBigEndian);
 
+    // add an item for the TOC hash table, to be filled in when the TOC is known;
+    // replace any such item from the input
+    removeItem(findItem(UDATA_TOC_HASH_ITEM_NAME));
+    hashData=NULL;
+    hashHeaderLength=hashLength=slotCount=0;
+    if((itemCount+1)<UDATA_TOC_HASH_EMPTY) {
+        // at most half of the slots are used, which keeps probe sequences short
+        for(slotCount=2; slotCount<=2*(itemCount+1); slotCount<<=1) {}
+        hashHeaderLength=(int32_t)(sizeof(DataHeader)+15)&~15;
+        hashLength=(hashHeaderLength+16+2*slotCount+15)&~15;
+        hashData=(uint8_t *)uprv_malloc(hashLength);
+        if(hashData==NULL) {
+            fprintf(stderr, "icupkg: unable to allocate memory for the TOC hash table\n");
+            exit(U_MEMORY_ALLOCATION_ERROR);
+        }
+        memset(hashData, 0, hashLength);
+        // the item is created in the output type and is not swapped again
+        addItem(UDATA_TOC_HASH_ITEM_NAME, hashData, hashLength, TRUE, outType);
+    }
+
     // open (TYPE_COUNT-2) swappers
     // one is a no-op for local type==outType
     // one type (TYPE_LE) is bogus
@@ -832,9 +872,15 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
 
     // then write the item entries (and collect the maxItemLength)
     maxItemLength=0;
+    localEntries=(UDataOffsetTOCEntry *)uprv_malloc((itemCount>0 ? itemCount : 1)*sizeof(UDataOffsetTOCEntry));
+    if(localEntries==NULL) {
+        fprintf(stderr, "icupkg: unable to allocate memory for the item entries\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
     for(i=0; i<itemCount; ++i) {
         entry.nameOffset=(uint32_t)(basenameOffset+(items[i].name-outStrings));
         entry.dataOffset=(uint32_t)offset;
+        localEntries[i]=entry;
         if(dsLocalToOut!=NULL) {
             dsLocalToOut->swapArray32(dsLocalToOut, &entry, 8, &entry, &errorCode);
             if(U_FAILURE(errorCode)) {
@@ -855,6 +901,42 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
         offset+=length;
     }
 
+    // fill in the TOC hash table for the output item names
+    if(hashData!=NULL) {
+        DataHeader *pHashHeader=(DataHeader *)hashData;
+        UDataTOCHash *hash=(UDataTOCHash *)(hashData+hashHeaderLength);
+        uint32_t mask=(uint32_t)slotCount-1;
+
+        pHashHeader->dataHeader.headerSize=(uint16_t)hashHeaderLength;
+        pHashHeader->dataHeader.magic1=0xda;
+        pHashHeader->dataHeader.magic2=0x27;
+        memcpy(&pHashHeader->info, &tocHashDataInfo, sizeof(UDataInfo));
+
+        hash->itemCount=(uint32_t)itemCount;
+        hash->checksum=udata_checksumOffsetTOC(localEntries, itemCount);
+        hash->slotCount=(uint32_t)slotCount;
+        hash->reserved=0;
+        memset(hash->slots, 0xff, 2*slotCount);
+        for(i=0; i<itemCount; ++i) {
+            uint32_t j=udata_hashTOCName(items[i].name)&mask;
+            while(hash->slots[j]!=UDATA_TOC_HASH_EMPTY) {
+                j=(j+1)&mask;
+            }
+            hash->slots[j]=(uint16_t)i;
+        }
+
+        if(dsLocalToOut!=NULL) {
+            udata_swapDataHeader(dsLocalToOut, hashData, hashHeaderLength, hashData, &errorCode);
+            dsLocalToOut->swapArray32(dsLocalToOut, hash, 16, hash, &errorCode);
+            dsLocalToOut->swapArray16(dsLocalToOut, hash->slots, 2*slotCount, hash->slots, &errorCode);
+            if(U_FAILURE(errorCode)) {
+                fprintf(stderr, "icupkg: swapping the TOC hash table failed - %s\n", u_errorName(errorCode));
+                exit(errorCode);
+            }
+        }
+    }
+    uprv_free(localEntries);
+
     // write the item names
     length=(int32_t)fwrite(outStrings, 1, outStringTop, file);
     if(length!=outStringTop) {
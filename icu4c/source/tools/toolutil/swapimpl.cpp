@@ -702,6 +702,74 @@ test_swap(const UDataSwapper *ds,
     return headerSize+size;
 }
 
+/* Swap a .dat package's TOC hash table item, see UDataTOCHash in ucmndata.h */
+static int32_t U_CALLCONV
+tochash_swap(const UDataSwapper *ds,
+             const void *inData, int32_t length, void *outData,
+             UErrorCode *pErrorCode) {
+    const UDataInfo *pInfo;
+    int32_t headerSize;
+
+    const UDataTOCHash *inHash;
+    UDataTOCHash *outHash;
+    int32_t size;
+
+    /* udata_swapDataHeader checks the arguments */
+    headerSize=udata_swapDataHeader(ds, inData, length, outData, pErrorCode);
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    /* check data format and format version */
+    pInfo=(const UDataInfo *)((const char *)inData+4);
+    if(!(
+        pInfo->dataFormat[0]==0x54 &&   /* dataFormat="TocH" */
+        pInfo->dataFormat[1]==0x6f &&
+        pInfo->dataFormat[2]==0x63 &&
+        pInfo->dataFormat[3]==0x48 &&
+        pInfo->formatVersion[0]==1
+    )) {
+        udata_printError(ds, "tochash_swap(): data format %02x.%02x.%02x.%02x (format version %02x) is not recognized as a TOC hash table\n",
+                         pInfo->dataFormat[0], pInfo->dataFormat[1],
+                         pInfo->dataFormat[2], pInfo->dataFormat[3],
+                         pInfo->formatVersion[0]);
+        *pErrorCode=U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+
+    inHash=(const UDataTOCHash *)((const char *)inData+headerSize);
+    outHash=(UDataTOCHash *)((char *)outData+headerSize);
+
+    if(length>=0 && (length-headerSize)<16) {
+        udata_printError(ds, "tochash_swap(): too few bytes (%d after header) for a TOC hash table\n",
+                         length-headerSize);
+        *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+        return 0;
+    }
+    size=16+2*(int32_t)ds->readUInt32(inHash->slotCount);
+
+    if(length>=0) {
+        if((length-headerSize)<size) {
+            udata_printError(ds, "tochash_swap(): too few bytes (%d after header) for a TOC hash table\n",
+                             length-headerSize);
+            *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+
+        ds->swapArray32(ds, inHash, 16, outHash, pErrorCode);
+        ds->swapArray16(ds, inHash->slots, size-16, outHash->slots, pErrorCode);
+        if(ds->inCharset!=ds->outCharset) {
+            /*
+             * The item names hash differently and sort differently in the other charset.
+             * Invalidate the table; readers then fall back to a binary search.
+             */
+            ds->writeUInt32(&outHash->itemCount, 0);
+        }
+    }
+
+    return headerSize+size;
+}
+
 /* swap any data (except a .dat package) ------------------------------------ */
 
 static const struct {
@@ -744,6 +812,7 @@ static const struct {
 #if !UCONFIG_NO_NORMALIZATION
     { { 0x43, 0x66, 0x75, 0x20 }, uspoof_swap },         /* dataFormat="Cfu " */
 #endif
+    { { 0x54, 0x6f, 0x63, 0x48 }, tochash_swap },       /* dataFormat="TocH" */
     { { 0x54, 0x65, 0x73, 0x74 }, test_swap }            /* dataFormat="Test" */
 };
 
@@ -136,6 +136,11 @@ final class UConverterAlias {
             if (tableStart < minTocLength) {
                 throw new IOException("Invalid data format.");
             }
+            if (tableStart > offsetsCount - 1) {
+                // Skip the sizes of newer sections (e.g., the ICU4C alias hash),
+                // which follow the sections read here.
+                ICUBinary.skipBytes(b, (tableStart - (offsetsCount - 1)) * 4);
+            }
             gConverterList = ICUBinary.getChars(b, tableArray[converterListIndex], 0);
             gTagList = ICUBinary.getChars(b, tableArray[tagListIndex], 0);
             gAliasList = ICUBinary.getChars(b, tableArray[aliasListIndex], 0);